@@ -388,11 +388,11 @@ void cstCharacter::UpdateAnimation(float deltaTime)
 
 	if (currentSpeed > 30.0f)
 	{
-		SkelMeshComponent->PlayAnimation(AnimRunForwardLoop, 1.0f, true);
+		SkelMeshComponent->BlendAnimation(AnimRunForwardLoop, 0.2f, 1.0f, true);
 	}
 	else
 	{
-		SkelMeshComponent->PlayAnimation(AnimIdle0, 1.0f, true);
+		SkelMeshComponent->BlendAnimation(AnimIdle0, 0.2f, 1.0f, true);
 	}
 }
 
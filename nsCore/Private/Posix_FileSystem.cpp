@@ -0,0 +1,384 @@
+#include "nsFileSystem.h"
+#include "nsLogger.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+
+#define NS_ValidatePathLength(path) const int len = path.GetLength(); NS_Validate(len <= NS_PLATFORM_MAX_PATH)
+
+
+
+// Multibyte (UTF-8) copy of wide path for POSIX API
+class nsFileSystemNativePath
+{
+private:
+	char Path[NS_PLATFORM_MAX_PATH * 4 + 1];
+
+public:
+	nsFileSystemNativePath(const nsString& path) noexcept
+	{
+		const int n = nsPlatform::String_ConvertToChar(Path, *path, static_cast<int>(sizeof(Path)) - 1);
+		Path[n > 0 ? n : 0] = '\0';
+	}
+
+
+	NS_INLINE const char* operator*() const noexcept
+	{
+		return Path;
+	}
+
+};
+
+
+
+static bool ns_IsDirectory(const char* nativePath) noexcept
+{
+	struct stat fileStat;
+	return stat(nativePath, &fileStat) == 0 && S_ISDIR(fileStat.st_mode);
+}
+
+
+
+bool nsFileSystem::FolderExists(const nsString& folderPath) noexcept
+{
+	if (folderPath.IsEmpty())
+	{
+		return false;
+	}
+
+	NS_ValidatePathLength(folderPath);
+
+	return ns_IsDirectory(*nsFileSystemNativePath(folderPath));
+}
+
+
+bool nsFileSystem::FolderCreate(const nsString& folderPath) noexcept
+{
+	if (folderPath.IsEmpty())
+	{
+		return false;
+	}
+
+	if (FolderExists(folderPath))
+	{
+		return true;
+	}
+
+	NS_ValidatePathLength(folderPath);
+
+	return mkdir(*nsFileSystemNativePath(folderPath), 0755) == 0 || errno == EEXIST;
+}
+
+
+bool nsFileSystem::FolderDelete(const nsString& folderPath) noexcept
+{
+	if (!FolderExists(folderPath))
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to delete folder. Folder [%s] does not exists!"), *folderPath);
+		return false;
+	}
+
+	DIR* dir = opendir(*nsFileSystemNativePath(folderPath));
+
+	if (dir)
+	{
+		dirent* entry = nullptr;
+
+		while ((entry = readdir(dir)) != nullptr)
+		{
+			const nsString fileName = entry->d_name;
+
+			if (fileName == TEXT(".") || fileName == TEXT(".."))
+			{
+				continue;
+			}
+
+			const nsString file = folderPath + TEXT("/") + fileName;
+			const nsFileSystemNativePath nativeFile(file);
+
+			if (ns_IsDirectory(*nativeFile))
+			{
+				FolderDelete(file);
+			}
+			else
+			{
+				unlink(*nativeFile);
+			}
+		}
+
+		closedir(dir);
+	}
+
+	rmdir(*nsFileSystemNativePath(folderPath));
+
+	return true;
+}
+
+
+void nsFileSystem::FolderIterate(nsTArray<nsString>& outFolders, const nsString& folderPath, bool bIncludeSubfolders) noexcept
+{
+	if (!FolderExists(folderPath))
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to iterate folder. Folder [%s] does not exists!"), *folderPath);
+		return;
+	}
+
+	DIR* dir = opendir(*nsFileSystemNativePath(folderPath));
+
+	if (dir == nullptr)
+	{
+		return;
+	}
+
+	dirent* entry = nullptr;
+
+	while ((entry = readdir(dir)) != nullptr)
+	{
+		const nsString fileName = entry->d_name;
+
+		if (fileName == TEXT(".") || fileName == TEXT(".."))
+		{
+			continue;
+		}
+
+		const nsString subDir = folderPath + TEXT("/") + fileName;
+
+		if (ns_IsDirectory(*nsFileSystemNativePath(subDir)))
+		{
+			outFolders.Add(subDir);
+
+			if (bIncludeSubfolders)
+			{
+				FolderIterate(outFolders, subDir, bIncludeSubfolders);
+			}
+		}
+	}
+
+	closedir(dir);
+}
+
+
+
+bool nsFileSystem::FileExists(const nsString& filePath) noexcept
+{
+	if (filePath.IsEmpty())
+	{
+		return false;
+	}
+
+	NS_ValidatePathLength(filePath);
+
+	return nsPlatform::File_Exists(*filePath);
+}
+
+
+bool nsFileSystem::FileCreate(const nsString& filePath) noexcept
+{
+	nsPlatformFileHandle fileHandle = nsPlatform::File_Open(*filePath, nsEPlatformFileOpenMode::WRITE_OVERWRITE_EXISTING);
+
+	if (fileHandle == nullptr)
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to create file [%s]!"), *filePath);
+		return false;
+	}
+
+	nsPlatform::File_Close(fileHandle);
+
+	return true;
+}
+
+
+bool nsFileSystem::FileDelete(const nsString& filePath) noexcept
+{
+	if (!FileExists(filePath))
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to delete file. File [%s] does not exists!"), *filePath);
+		return false;
+	}
+
+	return nsPlatform::File_Delete(*filePath);
+}
+
+
+bool nsFileSystem::FileCopy(const nsString& srcFilePath, const nsString& dstFilePath) noexcept
+{
+	if (!FileExists(srcFilePath))
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to copy file. Source file [%s] does not exists!"), *srcFilePath);
+		return false;
+	}
+
+	if (dstFilePath.IsEmpty())
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to copy file. Destination file path is empty!"));
+		return false;
+	}
+
+	NS_ValidatePathLength(dstFilePath);
+
+	return nsPlatform::File_Copy(*srcFilePath, *dstFilePath);
+}
+
+
+bool nsFileSystem::FileMove(const nsString& srcFilePath, const nsString& dstFilePath) noexcept
+{
+	if (!FileExists(srcFilePath))
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to move file. Source file [%s] does not exists!"), *srcFilePath);
+		return false;
+	}
+
+	if (dstFilePath.IsEmpty())
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to move file. Destination file path is empty!"));
+		return false;
+	}
+
+	NS_ValidatePathLength(dstFilePath);
+
+	return rename(*nsFileSystemNativePath(srcFilePath), *nsFileSystemNativePath(dstFilePath)) == 0;
+}
+
+
+bool nsFileSystem::FileGetAttributes(const nsString& filePath, nsFileAttributes& outAttributes) noexcept
+{
+	struct stat fileStat;
+
+	if (filePath.IsEmpty() || stat(*nsFileSystemNativePath(filePath), &fileStat) != 0 || S_ISDIR(fileStat.st_mode))
+	{
+		return false;
+	}
+
+	outAttributes.ModifiedTime = static_cast<uint64>(fileStat.st_mtim.tv_sec) * 1000000000ULL + static_cast<uint64>(fileStat.st_mtim.tv_nsec);
+	outAttributes.Size = static_cast<int64>(fileStat.st_size);
+
+	return true;
+}
+
+
+void nsFileSystem::FileIterate(nsTArray<nsString>& outFiles, const nsString& folderPath, bool bIncludeSubfolders, const nsString& optExtension) noexcept
+{
+	if (!FolderExists(folderPath))
+	{
+		NS_LogWarning(nsSystemLog, TEXT("Fail to iterate file in folder. Folder [%s] does not exists!"), *folderPath);
+		return;
+	}
+
+	DIR* dir = opendir(*nsFileSystemNativePath(folderPath));
+
+	if (dir == nullptr)
+	{
+		return;
+	}
+
+	dirent* entry = nullptr;
+
+	while ((entry = readdir(dir)) != nullptr)
+	{
+		const nsString fileName = entry->d_name;
+
+		if (fileName == TEXT(".") || fileName == TEXT(".."))
+		{
+			continue;
+		}
+
+		const nsString file = folderPath + TEXT("/") + fileName;
+
+		if (ns_IsDirectory(*nsFileSystemNativePath(file)))
+		{
+			if (bIncludeSubfolders)
+			{
+				FileIterate(outFiles, file, bIncludeSubfolders, optExtension);
+			}
+		}
+		else if (!optExtension.IsEmpty())
+		{
+			const nsString ext = FileGetExtension(file);
+
+			if (ext == optExtension)
+			{
+				outFiles.Add(file);
+			}
+		}
+		else
+		{
+			outFiles.Add(file);
+		}
+	}
+
+	closedir(dir);
+}
+
+
+bool nsFileSystem::FileMap(const nsString& filePath, nsFileMappedView& outView) noexcept
+{
+	FileUnmap(outView);
+
+	if (!FileExists(filePath))
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file. File [%s] does not exists!"), *filePath);
+		return false;
+	}
+
+	const nsFileSystemNativePath nativePath(filePath);
+	const int fd = open(*nativePath, O_RDONLY);
+
+	if (fd == -1)
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file. Open file [%s] failed!"), *filePath);
+		return false;
+	}
+
+	struct stat fileStat;
+
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0 || fileStat.st_size > INT32_MAX)
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file [%s]. Invalid file size!"), *filePath);
+		close(fd);
+		return false;
+	}
+
+	void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// Mapping keeps its own reference to the file
+	close(fd);
+
+	if (data == MAP_FAILED)
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file [%s]!"), *filePath);
+		return false;
+	}
+
+	madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+	outView.Data = static_cast<const uint8*>(data);
+	outView.Size = static_cast<int>(fileStat.st_size);
+
+	return true;
+}
+
+
+void nsFileSystem::FileUnmap(nsFileMappedView& view) noexcept
+{
+	if (view.Data)
+	{
+		munmap(const_cast<uint8*>(view.Data), static_cast<size_t>(view.Size));
+	}
+
+	view.Data = nullptr;
+	view.Size = 0;
+	view.PlatformFile = nullptr;
+	view.PlatformMapping = nullptr;
+}
+
+
+nsString nsFileSystem::OpenFileDialog_ImportAsset() noexcept
+{
+	NS_LogWarning(nsSystemLog, TEXT("Open file dialog is not supported on this platform!"));
+
+	return TEXT("");
+}
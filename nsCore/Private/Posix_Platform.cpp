@@ -0,0 +1,1124 @@
+#include "nsPlatform.h"
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <locale.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif // __linux__
+
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif // __APPLE__
+
+
+#define NS_PLATFORM_NATIVE_PATH_SIZE		(NS_PLATFORM_MAX_PATH * 4 + 1)
+
+
+static wchar_t PlatformDirectoryPath[NS_PLATFORM_MAX_PATH];
+
+
+
+// Convert wide path to multibyte (UTF-8) path used by POSIX API
+static bool ns_ConvertToNativePath(char* outPath, const wchar_t* path) noexcept
+{
+	const size_t n = wcstombs(outPath, path, NS_PLATFORM_NATIVE_PATH_SIZE - 1);
+
+	if (n == static_cast<size_t>(-1))
+	{
+		outPath[0] = '\0';
+		return false;
+	}
+
+	outPath[n] = '\0';
+
+	return true;
+}
+
+
+// MSVC treats %s/%c as wide in wide format functions, glibc treats them as narrow.
+// Convert %s -> %ls and %c -> %lc, and MSVC narrow %hs/%hc -> %s/%c.
+static void ns_ConvertWideFormat(wchar_t* outFormat, int outFormatCount, const wchar_t* format) noexcept
+{
+	int o = 0;
+	const int maxCount = outFormatCount - 2;
+
+	while (*format && o < maxCount)
+	{
+		if (*format != L'%')
+		{
+			outFormat[o++] = *format++;
+			continue;
+		}
+
+		outFormat[o++] = *format++;
+
+		if (*format == L'%')
+		{
+			outFormat[o++] = *format++;
+			continue;
+		}
+
+		// Flags, width, precision
+		while (*format && o < maxCount && wcschr(L"-+ #0123456789.*", *format))
+		{
+			outFormat[o++] = *format++;
+		}
+
+		bool bLengthModifier = false;
+		bool bShortModifier = false;
+
+		while (*format && o < maxCount && wcschr(L"hlLqjzt", *format))
+		{
+			if (*format == L'h')
+			{
+				bShortModifier = true;
+				format++;
+				continue;
+			}
+
+			bLengthModifier = true;
+			outFormat[o++] = *format++;
+		}
+
+		if (*format == L's' || *format == L'c' || *format == L'S' || *format == L'C')
+		{
+			const bool bWide = (*format == L's' || *format == L'c') ? !bShortModifier : bShortModifier;
+
+			if (bWide && !bLengthModifier)
+			{
+				outFormat[o++] = L'l';
+			}
+
+			outFormat[o++] = (*format == L'S' || *format == L's') ? L's' : L'c';
+			format++;
+		}
+		else if (bShortModifier)
+		{
+			// Keep short modifier for integer conversions
+			outFormat[o++] = L'h';
+		}
+	}
+
+	outFormat[o] = L'\0';
+}
+
+
+
+
+// ============================================================================================================================================ //
+// CRITICAL SECTION
+// ============================================================================================================================================ //
+nsCriticalSection::nsCriticalSection() noexcept
+{
+	// Recursive, same as win32 critical section
+	pthread_mutexattr_t attributes;
+	pthread_mutexattr_init(&attributes);
+	pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&Mutex, &attributes);
+	pthread_mutexattr_destroy(&attributes);
+}
+
+
+nsCriticalSection::~nsCriticalSection() noexcept
+{
+	pthread_mutex_destroy(&Mutex);
+}
+
+
+void nsCriticalSection::Enter() noexcept
+{
+	pthread_mutex_lock(&Mutex);
+}
+
+
+bool nsCriticalSection::TryEnter() noexcept
+{
+	return pthread_mutex_trylock(&Mutex) == 0;
+}
+
+
+void nsCriticalSection::Leave() noexcept
+{
+	pthread_mutex_unlock(&Mutex);
+}
+
+
+
+
+// ============================================================================================================================================ //
+// SEMAPHORE
+// ============================================================================================================================================ //
+nsSemaphore::nsSemaphore() noexcept
+	: Count(0)
+{
+	pthread_mutex_init(&Mutex, nullptr);
+	pthread_cond_init(&Condition, nullptr);
+}
+
+
+nsSemaphore::~nsSemaphore() noexcept
+{
+	pthread_cond_destroy(&Condition);
+	pthread_mutex_destroy(&Mutex);
+}
+
+
+void nsSemaphore::Wait() noexcept
+{
+	pthread_mutex_lock(&Mutex);
+
+	while (Count == 0)
+	{
+		pthread_cond_wait(&Condition, &Mutex);
+	}
+
+	Count--;
+
+	pthread_mutex_unlock(&Mutex);
+}
+
+
+void nsSemaphore::Signal(int count) noexcept
+{
+	NS_Assert(count > 0);
+
+	pthread_mutex_lock(&Mutex);
+	Count += count;
+	pthread_mutex_unlock(&Mutex);
+
+	if (count == 1)
+	{
+		pthread_cond_signal(&Condition);
+	}
+	else
+	{
+		pthread_cond_broadcast(&Condition);
+	}
+}
+
+
+
+
+// ============================================================================================================================================ //
+// ATOMIC
+// ============================================================================================================================================ //
+nsAtomic::nsAtomic() noexcept
+	: Value(0)
+{
+}
+
+
+int nsAtomic::Add(int add) noexcept
+{
+	return __atomic_add_fetch(&Value, add, __ATOMIC_SEQ_CST);
+}
+
+
+int nsAtomic::Set(int newValue) noexcept
+{
+	return __atomic_exchange_n(&Value, newValue, __ATOMIC_SEQ_CST);
+}
+
+
+int nsAtomic::Increment() noexcept
+{
+	return __atomic_add_fetch(&Value, 1, __ATOMIC_SEQ_CST);
+}
+
+
+int nsAtomic::Decrement() noexcept
+{
+	return __atomic_sub_fetch(&Value, 1, __ATOMIC_SEQ_CST);
+}
+
+
+int nsAtomic::Get() const noexcept
+{
+	return __atomic_load_n(&Value, __ATOMIC_SEQ_CST);
+}
+
+
+int nsAtomic::CompareExchange(int exchange, int comparand) noexcept
+{
+	__atomic_compare_exchange_n(&Value, &comparand, exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+
+	// On failure, comparand is updated with the current value
+	return comparand;
+}
+
+
+
+
+// ============================================================================================================================================ //
+// PLATFORM
+// ============================================================================================================================================ //
+void nsPlatform::Initialize() noexcept
+{
+	// Use environment locale for multibyte <-> wide conversion
+	if (setlocale(LC_CTYPE, "") == nullptr)
+	{
+		setlocale(LC_CTYPE, "C.UTF-8");
+	}
+
+	char executablePath[NS_PLATFORM_NATIVE_PATH_SIZE] = {};
+
+#ifdef __APPLE__
+	uint32_t executablePathSize = NS_PLATFORM_NATIVE_PATH_SIZE - 1;
+	_NSGetExecutablePath(executablePath, &executablePathSize);
+#else
+	const ssize_t n = readlink("/proc/self/exe", executablePath, NS_PLATFORM_NATIVE_PATH_SIZE - 1);
+	executablePath[n > 0 ? n : 0] = '\0';
+#endif // __APPLE__
+
+	const size_t len = mbstowcs(PlatformDirectoryPath, executablePath, NS_PLATFORM_MAX_PATH - 1);
+	PlatformDirectoryPath[len == static_cast<size_t>(-1) ? 0 : len] = '\0';
+
+	// Get directory path
+	{
+		const int pathLength = String_Length(PlatformDirectoryPath);
+
+		for (int i = pathLength - 1; i >= 0; --i)
+		{
+			if (PlatformDirectoryPath[i] == '/')
+			{
+				PlatformDirectoryPath[i] = '\0';
+				break;
+			}
+		}
+	}
+
+	ConsoleOutput(TEXT("Initialize platform [Posix]\n"));
+}
+
+
+void nsPlatform::Shutdown() noexcept
+{
+	fflush(stdout);
+}
+
+
+const wchar_t* nsPlatform::GetDirectoryPath() noexcept
+{
+	return PlatformDirectoryPath;
+}
+
+
+void nsPlatform::ConsoleOutput(const wchar_t* message, nsPlatformConsoleTextColorMasks colorMasks) noexcept
+{
+	const int len = String_Length(message);
+
+	if (len == 0)
+	{
+		return;
+	}
+
+	// Write as multibyte, stdout may already be byte oriented
+	char outputBuffer[NS_PLATFORM_OUTPUT_BUFFER_SIZE * 4];
+	char* output = outputBuffer;
+	size_t outputSize = wcstombs(nullptr, message, 0);
+
+	if (outputSize == static_cast<size_t>(-1))
+	{
+		return;
+	}
+
+	if (outputSize >= sizeof(outputBuffer))
+	{
+		output = static_cast<char*>(Memory_Alloc(outputSize + 1));
+	}
+
+	wcstombs(output, message, outputSize + 1);
+
+	const bool bColor = colorMasks != 0 && isatty(STDOUT_FILENO);
+
+	if (bColor)
+	{
+		// ANSI color index matches red/green/blue bits
+		fprintf(stdout, "\033[3%im", static_cast<int>(colorMasks & 7));
+	}
+
+	fwrite(output, 1, outputSize, stdout);
+
+	if (bColor)
+	{
+		fputs("\033[0m", stdout);
+	}
+
+	fflush(stdout);
+
+	if (output != outputBuffer)
+	{
+		Memory_Free(output);
+	}
+}
+
+
+void nsPlatform::ConsoleOutputFormat(nsPlatformConsoleTextColorMasks colorMasks, const wchar_t* format, ...) noexcept
+{
+	if (format == nullptr)
+	{
+		return;
+	}
+
+	wchar_t posixFormat[NS_PLATFORM_OUTPUT_BUFFER_SIZE];
+	ns_ConvertWideFormat(posixFormat, NS_PLATFORM_OUTPUT_BUFFER_SIZE, format);
+
+	wchar_t outputBuffer[NS_PLATFORM_OUTPUT_BUFFER_SIZE];
+
+	va_list args;
+	va_start(args, format);
+	int charCount = vswprintf(outputBuffer, NS_PLATFORM_OUTPUT_BUFFER_SIZE, posixFormat, args);
+	va_end(args);
+
+	// glibc returns -1 when output is truncated
+	if (charCount < 0)
+	{
+		charCount = NS_PLATFORM_OUTPUT_BUFFER_SIZE - 3;
+	}
+
+	NS_Assert(charCount < NS_PLATFORM_OUTPUT_BUFFER_SIZE - 2);
+	outputBuffer[charCount++] = '\n';
+	outputBuffer[charCount++] = '\0';
+	NS_Assert(charCount <= NS_PLATFORM_OUTPUT_BUFFER_SIZE);
+
+	ConsoleOutput(outputBuffer, colorMasks);
+}
+
+
+void nsPlatform::Memory_Zero(void* dst, uint64 size) noexcept
+{
+	NS_Assert(dst);
+	NS_Assert(size > 0);
+
+	memset(dst, 0, size);
+}
+
+
+void nsPlatform::Memory_Set(void* dst, int value, uint64 size) noexcept
+{
+	NS_Assert(dst);
+	NS_Assert(size > 0);
+
+	memset(dst, value, size);
+}
+
+
+void nsPlatform::Memory_Copy(void* dst, const void* src, uint64 size) noexcept
+{
+	NS_Assert(dst);
+	NS_Assert(src);
+	NS_Assert(size > 0);
+
+	memcpy(dst, src, size);
+}
+
+
+void nsPlatform::Memory_Move(void* dst, const void* src, uint64 size) noexcept
+{
+	NS_Assert(dst);
+	NS_Assert(src);
+	NS_Assert(size > 0);
+
+	memmove(dst, src, size);
+}
+
+
+void* nsPlatform::Memory_Alloc(uint64 size) noexcept
+{
+	NS_Assert(size > 0);
+
+	return malloc(size);
+}
+
+
+void* nsPlatform::Memory_Realloc(void* oldData, uint64 size) noexcept
+{
+	NS_Assert(size > 0);
+
+	return realloc(oldData, size);
+}
+
+
+void nsPlatform::Memory_Free(void* data) noexcept
+{
+	NS_Assert(data);
+
+	free(data);
+}
+
+
+int nsPlatform::String_Length(const char* cstr) noexcept
+{
+	if (cstr == nullptr)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(strlen(cstr));
+}
+
+
+int nsPlatform::String_Length(const wchar_t* wstr) noexcept
+{
+	if (wstr == nullptr)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(wcslen(wstr));
+}
+
+
+void nsPlatform::String_Copy(char* dst, const char* src) noexcept
+{
+	strcpy(dst, src);
+}
+
+
+void nsPlatform::String_Copy(wchar_t* dst, const wchar_t* src) noexcept
+{
+	wcscpy(dst, src);
+}
+
+
+int nsPlatform::String_Format(char* buffer, int bufferCount, const char* format, ...) noexcept
+{
+	if (buffer == nullptr || bufferCount <= 0 || format == nullptr)
+	{
+		return 0;
+	}
+
+	va_list args;
+	va_start(args, format);
+	const int n = vsnprintf(buffer, bufferCount, format, args);
+	va_end(args);
+
+	return n;
+}
+
+
+int nsPlatform::String_Format(wchar_t* buffer, int bufferCount, const wchar_t* format, ...) noexcept
+{
+	if (buffer == nullptr || bufferCount <= 0 || format == nullptr)
+	{
+		return 0;
+	}
+
+	wchar_t posixFormat[NS_PLATFORM_OUTPUT_BUFFER_SIZE];
+	ns_ConvertWideFormat(posixFormat, NS_PLATFORM_OUTPUT_BUFFER_SIZE, format);
+
+	va_list args;
+	va_start(args, format);
+	int n = vswprintf(buffer, bufferCount, posixFormat, args);
+	va_end(args);
+
+	// glibc returns -1 when output is truncated, buffer content is still written up to bufferCount
+	if (n < 0)
+	{
+		buffer[bufferCount - 1] = '\0';
+		n = String_Length(buffer);
+	}
+
+	return n;
+}
+
+
+bool nsPlatform::String_Compare(const char* cstrA, const char* cstrB, bool bIgnoreCase) noexcept
+{
+	if (cstrA == cstrB)
+	{
+		return true;
+	}
+
+	const int lenA = String_Length(cstrA);
+	const int lenB = String_Length(cstrB);
+
+	if (lenA == 0 && lenB == 0)
+	{
+		return true;
+	}
+
+	if (lenA != lenB)
+	{
+		return false;
+	}
+
+	if (bIgnoreCase)
+	{
+		for (int i = 0; i < lenA; ++i)
+		{
+			if (tolower(cstrA[i]) != tolower(cstrB[i]))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	return strcmp(cstrA, cstrB) == 0;
+}
+
+
+bool nsPlatform::String_Compare(const wchar_t* wstrA, const wchar_t* wstrB, bool bIgnoreCase) noexcept
+{
+	if (wstrA == wstrB)
+	{
+		return true;
+	}
+
+	const int lenA = String_Length(wstrA);
+	const int lenB = String_Length(wstrB);
+
+	if (lenA == 0 && lenB == 0)
+	{
+		return true;
+	}
+
+	if (lenA != lenB)
+	{
+		return false;
+	}
+
+	bool bEquals = true;
+
+	if (bIgnoreCase)
+	{
+		for (int i = 0; i < lenA; ++i)
+		{
+			if (towlower(wstrA[i]) != towlower(wstrB[i]))
+			{
+				bEquals = false;
+				break;
+			}
+		}
+	}
+	else
+	{
+		bEquals = wcscmp(wstrA, wstrB) == 0;
+	}
+
+	return bEquals;
+}
+
+
+int nsPlatform::String_ConvertToWide(wchar_t* dst, const char* src, int length)
+{
+	return static_cast<int>(mbstowcs(dst, src, length));
+}
+
+
+int nsPlatform::String_ConvertToChar(char* dst, const wchar_t* src, int length)
+{
+	return static_cast<int>(wcstombs(dst, src, length));
+}
+
+
+void nsPlatform::String_ToLower(char* cstr) noexcept
+{
+	const int len = String_Length(cstr);
+
+	for (int i = 0; i < len; ++i)
+	{
+		cstr[i] = static_cast<char>(tolower(cstr[i]));
+	}
+}
+
+
+void nsPlatform::String_ToLower(wchar_t* wstr) noexcept
+{
+	const int len = String_Length(wstr);
+
+	for (int i = 0; i < len; ++i)
+	{
+		wstr[i] = static_cast<wchar_t>(towlower(wstr[i]));
+	}
+}
+
+
+void nsPlatform::String_ToUpper(char* cstr) noexcept
+{
+	const int len = String_Length(cstr);
+
+	for (int i = 0; i < len; ++i)
+	{
+		cstr[i] = static_cast<char>(toupper(cstr[i]));
+	}
+}
+
+
+void nsPlatform::String_ToUpper(wchar_t* wstr) noexcept
+{
+	const int len = String_Length(wstr);
+
+	for (int i = 0; i < len; ++i)
+	{
+		wstr[i] = static_cast<wchar_t>(towupper(wstr[i]));
+	}
+}
+
+
+int nsPlatform::String_ToInt(const char* cstr) noexcept
+{
+	if (String_Length(cstr) == 0)
+	{
+		return 0;
+	}
+
+	return atoi(cstr);
+}
+
+
+int nsPlatform::String_ToInt(const wchar_t* wstr) noexcept
+{
+	if (String_Length(wstr) == 0)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(wcstol(wstr, nullptr, 10));
+}
+
+
+float nsPlatform::String_ToFloat(const char* cstr) noexcept
+{
+	if (String_Length(cstr) == 0)
+	{
+		return 0.0f;
+	}
+
+	return static_cast<float>(atof(cstr));
+}
+
+
+float nsPlatform::String_ToFloat(const wchar_t* wstr) noexcept
+{
+	if (String_Length(wstr) == 0)
+	{
+		return 0.0f;
+	}
+
+	return wcstof(wstr, nullptr);
+}
+
+
+uint64 nsPlatform::String_Hash(const char* cstr) noexcept
+{
+	const int length = String_Length(cstr);
+
+	if (length == 0)
+	{
+		return 0;
+	}
+
+	uint64 hash = 0;
+
+	for (int i = 0; i < length; ++i)
+	{
+		hash += cstr[i];
+		hash += (hash << 10);
+		hash ^= (hash >> 6);
+	}
+
+	hash += (hash << 3);
+	hash ^= (hash >> 11);
+	hash += (hash << 15);
+
+	return hash;
+}
+
+
+uint64 nsPlatform::String_Hash(const wchar_t* wstr) noexcept
+{
+	const int length = String_Length(wstr);
+
+	if (length == 0)
+	{
+		return 0;
+	}
+
+	uint64 hash = 0;
+
+	for (int i = 0; i < length; ++i)
+	{
+		hash += wstr[i];
+		hash += (hash << 10);
+		hash ^= (hash >> 6);
+	}
+
+	hash += (hash << 3);
+	hash ^= (hash >> 11);
+	hash += (hash << 15);
+
+	return hash;
+}
+
+
+bool nsPlatform::File_Exists(const wchar_t* filePath) noexcept
+{
+	const int len = String_Length(filePath);
+
+	if (len == 0)
+	{
+		return false;
+	}
+
+	NS_Validate(len <= NS_PLATFORM_MAX_PATH);
+
+	char nativePath[NS_PLATFORM_NATIVE_PATH_SIZE];
+
+	if (!ns_ConvertToNativePath(nativePath, filePath))
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+
+	return stat(nativePath, &fileStat) == 0 && S_ISREG(fileStat.st_mode);
+}
+
+
+nsPlatformFileHandle nsPlatform::File_Open(const wchar_t* filePath, nsEPlatformFileOpenMode mode) noexcept
+{
+	const int len = String_Length(filePath);
+
+	if (len == 0)
+	{
+		return nullptr;
+	}
+
+	NS_Validate(len <= NS_PLATFORM_MAX_PATH);
+
+	char nativePath[NS_PLATFORM_NATIVE_PATH_SIZE];
+	ns_ConvertToNativePath(nativePath, filePath);
+
+	const char* openMode = "rb";
+
+	if (mode == nsEPlatformFileOpenMode::WRITE_OVERWRITE_EXISTING)
+	{
+		openMode = "wb";
+	}
+	else if (mode == nsEPlatformFileOpenMode::WRITE_APPEND)
+	{
+		openMode = "ab";
+	}
+
+	nsPlatformFileHandle handle = fopen(nativePath, openMode);
+
+	if (handle == nullptr)
+	{
+		ConsoleOutputFormat(nsEPlatformConsoleOutputColor::Red, TEXT("\nOpen file [%s] failed. Error: %hs\n"), filePath, strerror(errno));
+	}
+
+	NS_ValidateV(handle, TEXT("Fail to open file!"));
+
+	return handle;
+}
+
+
+bool nsPlatform::File_Seek(nsPlatformFileHandle fileHandle, int byteOffset, nsEPlatformFileSeekMode mode) noexcept
+{
+	if (fileHandle == nullptr)
+	{
+		ConsoleOutput(TEXT("Fail to set file pointer (seek). Invalid file handle!\n"), nsEPlatformConsoleOutputColor::Red);
+		return false;
+	}
+
+	int origin = SEEK_SET;
+
+	if (mode == nsEPlatformFileSeekMode::CURRENT)
+	{
+		origin = SEEK_CUR;
+	}
+	else if (mode == nsEPlatformFileSeekMode::END)
+	{
+		origin = SEEK_END;
+	}
+
+	return fseek(fileHandle, byteOffset, origin) == 0;
+}
+
+
+bool nsPlatform::File_Read(nsPlatformFileHandle fileHandle, void* outResult, int byteSize) noexcept
+{
+	if (fileHandle == nullptr)
+	{
+		return false;
+	}
+
+	if (byteSize <= 0)
+	{
+		return true;
+	}
+
+	fread(outResult, 1, static_cast<size_t>(byteSize), fileHandle);
+
+	return ferror(fileHandle) == 0;
+}
+
+
+bool nsPlatform::File_Write(nsPlatformFileHandle fileHandle, const void* data, int dataSize) noexcept
+{
+	if (fileHandle == nullptr)
+	{
+		ConsoleOutput(TEXT("Fail to write file. Invalid file handle!\n"), nsEPlatformConsoleOutputColor::Red);
+		return false;
+	}
+
+	if (data == nullptr)
+	{
+		return false;
+	}
+
+	NS_Assert(dataSize > 0);
+
+	return fwrite(data, 1, static_cast<size_t>(dataSize), fileHandle) == static_cast<size_t>(dataSize);
+}
+
+
+void nsPlatform::File_Close(nsPlatformFileHandle& fileHandle) noexcept
+{
+	if (fileHandle)
+	{
+		fclose(fileHandle);
+		fileHandle = nullptr;
+	}
+}
+
+
+bool nsPlatform::File_Copy(const wchar_t* srcFilePath, const wchar_t* dstFilePath) noexcept
+{
+	NS_Assert(srcFilePath && String_Length(srcFilePath) > 0 && String_Length(srcFilePath) <= NS_PLATFORM_MAX_PATH);
+	NS_Assert(dstFilePath && String_Length(dstFilePath) > 0 && String_Length(dstFilePath) <= NS_PLATFORM_MAX_PATH);
+
+	char nativeSrcPath[NS_PLATFORM_NATIVE_PATH_SIZE];
+	char nativeDstPath[NS_PLATFORM_NATIVE_PATH_SIZE];
+	ns_ConvertToNativePath(nativeSrcPath, srcFilePath);
+	ns_ConvertToNativePath(nativeDstPath, dstFilePath);
+
+	FILE* srcFile = fopen(nativeSrcPath, "rb");
+
+	if (srcFile == nullptr)
+	{
+		return false;
+	}
+
+	FILE* dstFile = fopen(nativeDstPath, "wb");
+
+	if (dstFile == nullptr)
+	{
+		fclose(srcFile);
+		return false;
+	}
+
+	bool bSuccess = true;
+	uint8 buffer[NS_MEMORY_SIZE_KiB(16)];
+	size_t readSize = 0;
+
+	while ((readSize = fread(buffer, 1, sizeof(buffer), srcFile)) > 0)
+	{
+		if (fwrite(buffer, 1, readSize, dstFile) != readSize)
+		{
+			bSuccess = false;
+			break;
+		}
+	}
+
+	fclose(dstFile);
+	fclose(srcFile);
+
+	return bSuccess;
+}
+
+
+bool nsPlatform::File_Delete(const wchar_t* filePath) noexcept
+{
+	const int len = String_Length(filePath);
+
+	if (len == 0)
+	{
+		return false;
+	}
+
+	NS_Validate(len <= NS_PLATFORM_MAX_PATH);
+
+	char nativePath[NS_PLATFORM_NATIVE_PATH_SIZE];
+	ns_ConvertToNativePath(nativePath, filePath);
+
+	return unlink(nativePath) == 0;
+}
+
+
+int nsPlatform::File_GetSize(nsPlatformFileHandle fileHandle) noexcept
+{
+	if (fileHandle == nullptr)
+	{
+		ConsoleOutput(TEXT("Fail to get file size. Invalid file handle!"), nsEPlatformConsoleOutputColor::Red);
+		return 0;
+	}
+
+	struct stat fileStat;
+
+	if (fstat(fileno(fileHandle), &fileStat) != 0)
+	{
+		return 0;
+	}
+
+	return static_cast<int>(fileStat.st_size);
+}
+
+
+nsPlatformModuleHandle nsPlatform::Module_Load(const wchar_t* moduleFile) noexcept
+{
+	NS_Assert(moduleFile);
+
+	char nativePath[NS_PLATFORM_NATIVE_PATH_SIZE];
+	ns_ConvertToNativePath(nativePath, moduleFile);
+
+	return dlopen(nativePath, RTLD_NOW | RTLD_LOCAL);
+}
+
+
+void nsPlatform::Module_Unload(nsPlatformModuleHandle& moduleHandle) noexcept
+{
+	if (moduleHandle)
+	{
+		dlclose(moduleHandle);
+		moduleHandle = nullptr;
+	}
+}
+
+
+void* nsPlatform::Module_GetFunction(nsPlatformModuleHandle moduleHandle, const char* functionName) noexcept
+{
+	NS_ValidateV(moduleHandle, TEXT("Invalid module handle!"));
+
+	return dlsym(moduleHandle, functionName);
+}
+
+
+int64 nsPlatform::PerformanceQuery_Frequency() noexcept
+{
+	// Nanoseconds
+	return 1000000000LL;
+}
+
+
+int64 nsPlatform::PerformanceQuery_Counter() noexcept
+{
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return static_cast<int64>(time.tv_sec) * 1000000000LL + static_cast<int64>(time.tv_nsec);
+}
+
+
+// No cursor on headless platform
+void nsPlatform::Mouse_ShowCursor(bool /*bShow*/) noexcept
+{
+}
+
+
+void nsPlatform::Mouse_SetCursorShape(nsEMouseCursorShape /*shape*/) noexcept
+{
+}
+
+
+void nsPlatform::Mouse_SetCapture(nsPlatformWindowHandle /*windowHandle*/, bool /*bCapture*/) noexcept
+{
+}
+
+
+void nsPlatform::Mouse_SetCursorWindowPosition(nsPlatformWindowHandle /*windowHandle*/, const nsPointInt& /*position*/) noexcept
+{
+}
+
+
+void nsPlatform::Mouse_ClipCursor(bool /*bClip*/, nsPlatformWindowHandle /*windowHandle*/, const nsRectInt& /*rect*/) noexcept
+{
+}
+
+
+bool nsPlatform::Mouse_IsCursorHidden() noexcept
+{
+	return false;
+}
+
+
+void nsPlatform::Thread_Sleep(int ms) noexcept
+{
+	NS_Assert(ms >= 0);
+
+	timespec time;
+	time.tv_sec = ms / 1000;
+	time.tv_nsec = static_cast<long>(ms % 1000) * 1000000L;
+
+	while (nanosleep(&time, &time) == -1 && errno == EINTR)
+	{
+	}
+}
+
+
+struct nsPlatformThreadStartData
+{
+	void(*Function)(void*);
+	void* UserData;
+};
+
+
+static void* ns_PlatformThreadProc(void* parameter) noexcept
+{
+	nsPlatformThreadStartData* startData = static_cast<nsPlatformThreadStartData*>(parameter);
+	void(*function)(void*) = startData->Function;
+	void* userData = startData->UserData;
+	nsPlatform::Memory_Free(startData);
+
+	function(userData);
+
+	return nullptr;
+}
+
+
+nsPlatformThreadHandle nsPlatform::Thread_Create(void(*function)(void*), void* userData) noexcept
+{
+	NS_Assert(function);
+
+	nsPlatformThreadStartData* startData = static_cast<nsPlatformThreadStartData*>(Memory_Alloc(sizeof(nsPlatformThreadStartData)));
+	startData->Function = function;
+	startData->UserData = userData;
+
+	pthread_t thread;
+	const int result = pthread_create(&thread, nullptr, ns_PlatformThreadProc, startData);
+	NS_ValidateV(result == 0, TEXT("Fail to create thread!"));
+
+	return thread;
+}
+
+
+void nsPlatform::Thread_Join(nsPlatformThreadHandle& threadHandle) noexcept
+{
+	pthread_join(threadHandle, nullptr);
+	threadHandle = nsPlatformThreadHandle();
+}
+
+
+uint32 nsPlatform::Thread_GetCurrentId() noexcept
+{
+#if defined(__linux__)
+	return static_cast<uint32>(syscall(SYS_gettid));
+#elif defined(__APPLE__)
+	uint64_t threadId = 0;
+	pthread_threadid_np(nullptr, &threadId);
+	return static_cast<uint32>(threadId);
+#endif // __linux__
+}
+
+
+int nsPlatform::Thread_GetProcessorCount() noexcept
+{
+	return static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+}
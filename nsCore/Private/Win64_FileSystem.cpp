@@ -209,7 +209,23 @@ bool nsFileSystem::FileMove(const nsString& srcFilePath, const nsString& dstFile
 
 	NS_ValidatePathLength(dstFilePath);
 
-	return (bool)MoveFile(*srcFilePath, *dstFilePath);
+	return (bool)MoveFileEx(*srcFilePath, *dstFilePath, MOVEFILE_REPLACE_EXISTING);
+}
+
+
+bool nsFileSystem::FileGetAttributes(const nsString& filePath, nsFileAttributes& outAttributes) noexcept
+{
+	WIN32_FILE_ATTRIBUTE_DATA fileData{};
+
+	if (filePath.IsEmpty() || !GetFileAttributesEx(*filePath, GetFileExInfoStandard, &fileData) || (fileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+	{
+		return false;
+	}
+
+	outAttributes.ModifiedTime = (static_cast<uint64>(fileData.ftLastWriteTime.dwHighDateTime) << 32) | static_cast<uint64>(fileData.ftLastWriteTime.dwLowDateTime);
+	outAttributes.Size = static_cast<int64>((static_cast<uint64>(fileData.nFileSizeHigh) << 32) | static_cast<uint64>(fileData.nFileSizeLow));
+
+	return true;
 }
 
 
@@ -268,6 +284,74 @@ void nsFileSystem::FileIterate(nsTArray<nsString>& outFiles, const nsString& fol
 }
 
 
+bool nsFileSystem::FileMap(const nsString& filePath, nsFileMappedView& outView) noexcept
+{
+	FileUnmap(outView);
+
+	if (!FileExists(filePath))
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file. File [%s] does not exists!"), *filePath);
+		return false;
+	}
+
+	HANDLE fileHandle = CreateFile(*filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file. Open file [%s] failed!"), *filePath);
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0 || fileSize.QuadPart > INT32_MAX)
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file [%s]. Invalid file size!"), *filePath);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	HANDLE mappingHandle = CreateFileMapping(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	const void* data = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+	if (data == nullptr)
+	{
+		NS_LogError(nsSystemLog, TEXT("Fail to map file [%s]!"), *filePath);
+
+		if (mappingHandle)
+		{
+			CloseHandle(mappingHandle);
+		}
+
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	outView.Data = static_cast<const uint8*>(data);
+	outView.Size = static_cast<int>(fileSize.QuadPart);
+	outView.PlatformFile = fileHandle;
+	outView.PlatformMapping = mappingHandle;
+
+	return true;
+}
+
+
+void nsFileSystem::FileUnmap(nsFileMappedView& view) noexcept
+{
+	if (view.Data)
+	{
+		UnmapViewOfFile(view.Data);
+		CloseHandle(view.PlatformMapping);
+		CloseHandle(view.PlatformFile);
+	}
+
+	view.Data = nullptr;
+	view.Size = 0;
+	view.PlatformFile = nullptr;
+	view.PlatformMapping = nullptr;
+}
+
+
 nsString nsFileSystem::OpenFileDialog_ImportAsset() noexcept
 {
 	wchar_t filePath[1024];
@@ -41,6 +41,36 @@ void nsCriticalSection::Leave() noexcept
 
 
 
+// ============================================================================================================================================ //
+// SEMAPHORE
+// ============================================================================================================================================ //
+nsSemaphore::nsSemaphore() noexcept
+{
+	Handle = CreateSemaphore(NULL, 0, INT32_MAX, NULL);
+}
+
+
+nsSemaphore::~nsSemaphore() noexcept
+{
+	CloseHandle(Handle);
+}
+
+
+void nsSemaphore::Wait() noexcept
+{
+	WaitForSingleObject(Handle, INFINITE);
+}
+
+
+void nsSemaphore::Signal(int count) noexcept
+{
+	NS_Assert(count > 0);
+	ReleaseSemaphore(Handle, count, NULL);
+}
+
+
+
+
 // ============================================================================================================================================ //
 // ATOMIC
 // ============================================================================================================================================ //
@@ -79,6 +109,12 @@ int nsAtomic::Get() const noexcept
 }
 
 
+int nsAtomic::CompareExchange(int exchange, int comparand) noexcept
+{
+	return static_cast<int>(InterlockedCompareExchange(reinterpret_cast<volatile LONG*>(&Value), static_cast<LONG>(exchange), static_cast<LONG>(comparand)));
+}
+
+
 
 
 // ============================================================================================================================================ //
@@ -901,3 +937,64 @@ void nsPlatform::Thread_Sleep(int ms) noexcept
 
 	Sleep(static_cast<DWORD>(ms));
 }
+
+
+struct nsPlatformThreadStartData
+{
+	void(*Function)(void*);
+	void* UserData;
+};
+
+
+static DWORD WINAPI ns_PlatformThreadProc(_In_ LPVOID lpParameter) noexcept
+{
+	nsPlatformThreadStartData* startData = reinterpret_cast<nsPlatformThreadStartData*>(lpParameter);
+	void(*function)(void*) = startData->Function;
+	void* userData = startData->UserData;
+	nsPlatform::Memory_Free(startData);
+
+	function(userData);
+
+	return 0;
+}
+
+
+nsPlatformThreadHandle nsPlatform::Thread_Create(void(*function)(void*), void* userData) noexcept
+{
+	NS_Assert(function);
+
+	nsPlatformThreadStartData* startData = static_cast<nsPlatformThreadStartData*>(Memory_Alloc(sizeof(nsPlatformThreadStartData)));
+	startData->Function = function;
+	startData->UserData = userData;
+
+	HANDLE handle = CreateThread(NULL, 0, ns_PlatformThreadProc, startData, 0, NULL);
+	NS_ValidateV(handle, TEXT("Fail to create thread!"));
+
+	return handle;
+}
+
+
+void nsPlatform::Thread_Join(nsPlatformThreadHandle& threadHandle) noexcept
+{
+	if (threadHandle)
+	{
+		WaitForSingleObject(threadHandle, INFINITE);
+		CloseHandle(threadHandle);
+		threadHandle = NULL;
+	}
+}
+
+
+uint32 nsPlatform::Thread_GetCurrentId() noexcept
+{
+	return static_cast<uint32>(GetCurrentThreadId());
+}
+
+
+int nsPlatform::Thread_GetProcessorCount() noexcept
+{
+	SYSTEM_INFO sysInfo{};
+	GetSystemInfo(&sysInfo);
+
+	return static_cast<int>(sysInfo.dwNumberOfProcessors);
+}
@@ -0,0 +1,167 @@
+#include "nsAsyncLoad.h"
+
+
+
+nsAsyncLoadQueue::nsAsyncLoadQueue() noexcept
+	: IoThread()
+	, Sequence(0)
+{
+}
+
+
+void nsAsyncLoadQueue::Initialize() noexcept
+{
+	bIoThreadRunning.Set(1);
+	IoThread = nsPlatform::Thread_Create(IoThreadFunction, this);
+}
+
+
+void nsAsyncLoadQueue::Shutdown() noexcept
+{
+	if (bIoThreadRunning.Get() == 0)
+	{
+		return;
+	}
+
+	bIoThreadRunning.Set(0);
+	IoSemaphore.Signal();
+	nsPlatform::Thread_Join(IoThread);
+
+	IoQueue.Clear();
+}
+
+
+void nsAsyncLoadQueue::Prepare(nsAsyncLoadRequest* request, int priority) noexcept
+{
+	NS_Assert(request);
+	NS_Assert(request->GetState() == AsyncLoadState_Queued);
+
+	request->Priority = priority;
+	request->Sequence = Sequence++;
+}
+
+
+void nsAsyncLoadQueue::Submit(nsAsyncLoadRequest* request, int priority) noexcept
+{
+	Prepare(request, priority);
+
+	IoQueueCS.Enter();
+	IoQueue.Add(request);
+	IoQueueCS.Leave();
+
+	IoSemaphore.Signal();
+}
+
+
+void nsAsyncLoadQueue::SetPriority(nsAsyncLoadRequest* request, int priority) noexcept
+{
+	IoQueueCS.Enter();
+	request->Priority = priority;
+	IoQueueCS.Leave();
+}
+
+
+bool nsAsyncLoadQueue::Cancel(nsAsyncLoadRequest* request) noexcept
+{
+	IoQueueCS.Enter();
+	const bool bRemovedFromQueue = IoQueue.Remove(request);
+	IoQueueCS.Leave();
+
+	if (bRemovedFromQueue)
+	{
+		return true;
+	}
+
+	// Still used by IO thread or worker thread, try again later
+	return request->GetState() != AsyncLoadState_Reading && request->DecodeCounter.IsDone();
+}
+
+
+void nsAsyncLoadQueue::Wait(nsAsyncLoadRequest* request) noexcept
+{
+	IoQueueCS.Enter();
+	IoQueue.Remove(request);
+	IoQueueCS.Leave();
+
+	if (request->GetState() == AsyncLoadState_Queued)
+	{
+		request->State.Set(request->Read() ? AsyncLoadState_ReadDone : AsyncLoadState_Failed);
+	}
+
+	while (request->GetState() == AsyncLoadState_Reading)
+	{
+		nsPlatform::Thread_Sleep(1);
+	}
+
+	if (request->GetState() == AsyncLoadState_ReadDone)
+	{
+		request->State.Set(request->Decode() ? AsyncLoadState_Decoded : AsyncLoadState_Failed);
+	}
+
+	nsThreadPool::WaitForCounter(request->DecodeCounter);
+}
+
+
+bool nsAsyncLoadQueue::SubmitDecode(nsAsyncLoadRequest* request, nsThreadAffinityMasks affinityMasks) noexcept
+{
+	if (request->GetState() != AsyncLoadState_ReadDone)
+	{
+		return false;
+	}
+
+	request->State.Set(AsyncLoadState_Decoding);
+	request->Task.Reset();
+
+	nsIThreadTask* task = &request->Task;
+	nsThreadPool::SubmitTasks(&task, 1, affinityMasks, &request->DecodeCounter);
+
+	return true;
+}
+
+
+void nsAsyncLoadQueue::IoThreadFunction(void* userData) noexcept
+{
+	nsAsyncLoadQueue* loadQueue = static_cast<nsAsyncLoadQueue*>(userData);
+
+	while (true)
+	{
+		loadQueue->IoSemaphore.Wait();
+
+		if (loadQueue->bIoThreadRunning.Get() == 0)
+		{
+			break;
+		}
+
+		nsAsyncLoadRequest* request = nullptr;
+
+		loadQueue->IoQueueCS.Enter();
+		{
+			nsTArray<nsAsyncLoadRequest*>& queue = loadQueue->IoQueue;
+			int selected = NS_ARRAY_INDEX_INVALID;
+
+			for (int i = 0; i < queue.GetCount(); ++i)
+			{
+				if (selected == NS_ARRAY_INDEX_INVALID || queue[i]->Priority > queue[selected]->Priority || (queue[i]->Priority == queue[selected]->Priority && queue[i]->Sequence < queue[selected]->Sequence))
+				{
+					selected = i;
+				}
+			}
+
+			if (selected != NS_ARRAY_INDEX_INVALID)
+			{
+				request = queue[selected];
+				queue.RemoveAt(selected);
+				request->State.Set(AsyncLoadState_Reading);
+			}
+		}
+		loadQueue->IoQueueCS.Leave();
+
+		// Request has been taken by owner thread (cancelled or waited)
+		if (request == nullptr)
+		{
+			continue;
+		}
+
+		request->State.Set(request->Read() ? AsyncLoadState_ReadDone : AsyncLoadState_Failed);
+	}
+}
@@ -0,0 +1,548 @@
+#include "nsCompression.h"
+#include "nsThreadPool.h"
+
+
+
+// ============================================================================================================================================ //
+// LZ4 BLOCK
+// ============================================================================================================================================ //
+// Sequence: token (literal length << 4 | match length - MIN_MATCH), [literal length bytes], literals, offset (uint16 LE), [match length bytes].
+// Lengths >= 15 continue with bytes of 255 until a byte < 255. Last sequence has literals only.
+#define NS_COMPRESSION_MIN_MATCH				(4)
+#define NS_COMPRESSION_LAST_LITERALS			(5)
+#define NS_COMPRESSION_MATCH_FIND_LIMIT			(12)
+#define NS_COMPRESSION_MAX_OFFSET				(65535)
+#define NS_COMPRESSION_HASH_LOG					(14)
+#define NS_COMPRESSION_HIGH_HASH_LOG			(16)
+#define NS_COMPRESSION_HIGH_MAX_ATTEMPTS		(64)
+#define NS_COMPRESSION_BLOCK_RAW_FLAG			(0x80000000u)
+
+
+static NS_INLINE uint32 ns_CompressionRead32(const uint8* data) noexcept
+{
+	uint32 value;
+	nsPlatform::Memory_Copy(&value, data, sizeof(uint32));
+	return value;
+}
+
+
+static NS_INLINE uint32 ns_CompressionHash(uint32 value, int hashLog) noexcept
+{
+	return (value * 2654435761u) >> (32 - hashLog);
+}
+
+
+static NS_INLINE int ns_CompressionMatchLength(const uint8* ip, const uint8* match, const uint8* matchLimit) noexcept
+{
+	const uint8* start = ip;
+
+	while (ip < matchLimit && *ip == *match)
+	{
+		++ip;
+		++match;
+	}
+
+	return static_cast<int>(ip - start);
+}
+
+
+// Write one sequence, returns new output position or nullptr if it does not fit
+static NS_INLINE uint8* ns_CompressionWriteSequence(uint8* op, const uint8* opEnd, const uint8* anchor, int literalLength, int offset, int matchLength) noexcept
+{
+	if (1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1 > opEnd - op)
+	{
+		return nullptr;
+	}
+
+	uint8* token = op++;
+
+	if (literalLength >= 15)
+	{
+		*token = 15 << 4;
+		int length = literalLength - 15;
+
+		for (; length >= 255; length -= 255)
+		{
+			*op++ = 255;
+		}
+
+		*op++ = static_cast<uint8>(length);
+	}
+	else
+	{
+		*token = static_cast<uint8>(literalLength << 4);
+	}
+
+	if (literalLength > 0)
+	{
+		nsPlatform::Memory_Copy(op, anchor, literalLength);
+		op += literalLength;
+	}
+
+	// Last literals
+	if (matchLength == 0)
+	{
+		return op;
+	}
+
+	*op++ = static_cast<uint8>(offset & 0xFF);
+	*op++ = static_cast<uint8>(offset >> 8);
+
+	int length = matchLength - NS_COMPRESSION_MIN_MATCH;
+
+	if (length >= 15)
+	{
+		*token |= 15;
+		length -= 15;
+
+		for (; length >= 255; length -= 255)
+		{
+			*op++ = 255;
+		}
+
+		*op++ = static_cast<uint8>(length);
+	}
+	else
+	{
+		*token |= static_cast<uint8>(length);
+	}
+
+	return op;
+}
+
+
+static int ns_CompressionCompressFast(const uint8* src, int srcSize, uint8* dst, int dstCapacity) noexcept
+{
+	const uint8* ip = src;
+	const uint8* anchor = src;
+	const uint8* end = src + srcSize;
+	const uint8* matchLimit = end - NS_COMPRESSION_LAST_LITERALS;
+	const uint8* findLimit = end - NS_COMPRESSION_MATCH_FIND_LIMIT;
+	uint8* op = dst;
+	const uint8* opEnd = dst + dstCapacity;
+
+	if (srcSize > NS_COMPRESSION_MATCH_FIND_LIMIT)
+	{
+		// Position of last occurrence for each hash, relative to src
+		int hashTable[1 << NS_COMPRESSION_HASH_LOG] = {};
+		++ip;
+
+		while (ip < findLimit)
+		{
+			const uint32 hash = ns_CompressionHash(ns_CompressionRead32(ip), NS_COMPRESSION_HASH_LOG);
+			const uint8* match = src + hashTable[hash];
+			hashTable[hash] = static_cast<int>(ip - src);
+
+			if (ip - match > NS_COMPRESSION_MAX_OFFSET || ns_CompressionRead32(match) != ns_CompressionRead32(ip))
+			{
+				// Skip faster through data that does not compress
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+
+			while (ip > anchor && match > src && ip[-1] == match[-1])
+			{
+				--ip;
+				--match;
+			}
+
+			const int matchLength = NS_COMPRESSION_MIN_MATCH + ns_CompressionMatchLength(ip + NS_COMPRESSION_MIN_MATCH, match + NS_COMPRESSION_MIN_MATCH, matchLimit);
+			op = ns_CompressionWriteSequence(op, opEnd, anchor, static_cast<int>(ip - anchor), static_cast<int>(ip - match), matchLength);
+
+			if (op == nullptr)
+			{
+				return 0;
+			}
+
+			ip += matchLength;
+			anchor = ip;
+
+			if (ip < findLimit)
+			{
+				hashTable[ns_CompressionHash(ns_CompressionRead32(ip - 2), NS_COMPRESSION_HASH_LOG)] = static_cast<int>(ip - 2 - src);
+			}
+		}
+	}
+
+	op = ns_CompressionWriteSequence(op, opEnd, anchor, static_cast<int>(end - anchor), 0, 0);
+
+	return op ? static_cast<int>(op - dst) : 0;
+}
+
+
+static int ns_CompressionCompressHigh(const uint8* src, int srcSize, uint8* dst, int dstCapacity) noexcept
+{
+	const uint8* ip = src;
+	const uint8* anchor = src;
+	const uint8* end = src + srcSize;
+	const uint8* matchLimit = end - NS_COMPRESSION_LAST_LITERALS;
+	const uint8* findLimit = end - NS_COMPRESSION_MATCH_FIND_LIMIT;
+	uint8* op = dst;
+	const uint8* opEnd = dst + dstCapacity;
+
+	if (srcSize > NS_COMPRESSION_MATCH_FIND_LIMIT)
+	{
+		// Head holds last position (+1) for each hash, chain holds distance to previous position with same hash within window
+		nsTArray<int> hashHeads(1 << NS_COMPRESSION_HIGH_HASH_LOG);
+		nsTArray<uint16> hashChains(NS_COMPRESSION_MAX_OFFSET + 1);
+		int nextInsert = 0;
+
+		while (ip < findLimit)
+		{
+			const int position = static_cast<int>(ip - src);
+
+			for (; nextInsert <= position; ++nextInsert)
+			{
+				const uint32 hash = ns_CompressionHash(ns_CompressionRead32(src + nextInsert), NS_COMPRESSION_HIGH_HASH_LOG);
+				const int distance = hashHeads[hash] == 0 ? 0 : nextInsert - (hashHeads[hash] - 1);
+				hashChains[nextInsert & NS_COMPRESSION_MAX_OFFSET] = static_cast<uint16>(distance > NS_COMPRESSION_MAX_OFFSET ? 0 : distance);
+				hashHeads[hash] = nextInsert + 1;
+			}
+
+			const uint32 value = ns_CompressionRead32(ip);
+			int bestLength = 0;
+			int bestPosition = 0;
+			int candidate = position - hashChains[position & NS_COMPRESSION_MAX_OFFSET];
+
+			for (int attempt = 0; attempt < NS_COMPRESSION_HIGH_MAX_ATTEMPTS && candidate < position && position - candidate <= NS_COMPRESSION_MAX_OFFSET; ++attempt)
+			{
+				if (ns_CompressionRead32(src + candidate) == value)
+				{
+					const int length = NS_COMPRESSION_MIN_MATCH + ns_CompressionMatchLength(ip + NS_COMPRESSION_MIN_MATCH, src + candidate + NS_COMPRESSION_MIN_MATCH, matchLimit);
+
+					if (length > bestLength)
+					{
+						bestLength = length;
+						bestPosition = candidate;
+					}
+				}
+
+				const int distance = hashChains[candidate & NS_COMPRESSION_MAX_OFFSET];
+
+				if (distance == 0)
+				{
+					break;
+				}
+
+				candidate -= distance;
+			}
+
+			if (bestLength == 0)
+			{
+				++ip;
+				continue;
+			}
+
+			const uint8* match = src + bestPosition;
+
+			while (ip > anchor && match > src && ip[-1] == match[-1])
+			{
+				--ip;
+				--match;
+				++bestLength;
+			}
+
+			op = ns_CompressionWriteSequence(op, opEnd, anchor, static_cast<int>(ip - anchor), static_cast<int>(ip - match), bestLength);
+
+			if (op == nullptr)
+			{
+				return 0;
+			}
+
+			ip += bestLength;
+			anchor = ip;
+		}
+	}
+
+	op = ns_CompressionWriteSequence(op, opEnd, anchor, static_cast<int>(end - anchor), 0, 0);
+
+	return op ? static_cast<int>(op - dst) : 0;
+}
+
+
+int nsCompression::GetCompressBound(int srcSize) noexcept
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+
+int nsCompression::CompressBlock(const uint8* src, int srcSize, uint8* dst, int dstCapacity, nsECompression compression) noexcept
+{
+	NS_Assert(src && srcSize >= 0);
+	NS_Assert(dst && dstCapacity >= 0);
+
+	switch (compression)
+	{
+		case nsECompression::LZ4: return ns_CompressionCompressFast(src, srcSize, dst, dstCapacity);
+		case nsECompression::LZ4_HIGH: return ns_CompressionCompressHigh(src, srcSize, dst, dstCapacity);
+		default: break;
+	}
+
+	NS_ValidateV(0, TEXT("Invalid compression!"));
+	return 0;
+}
+
+
+static NS_INLINE bool ns_CompressionReadLength(const uint8*& ip, const uint8* end, int maxLength, int& length) noexcept
+{
+	uint8 value;
+
+	do
+	{
+		if (ip >= end)
+		{
+			return false;
+		}
+
+		value = *ip++;
+		length += value;
+
+		if (length > maxLength)
+		{
+			return false;
+		}
+	}
+	while (value == 255);
+
+	return true;
+}
+
+
+bool nsCompression::DecompressBlock(const uint8* src, int srcSize, uint8* dst, int dstSize) noexcept
+{
+	NS_Assert(src && srcSize >= 0);
+	NS_Assert(dst || dstSize == 0);
+
+	const uint8* ip = src;
+	const uint8* end = src + srcSize;
+	uint8* op = dst;
+	uint8* opEnd = dst + dstSize;
+
+	while (true)
+	{
+		if (ip >= end)
+		{
+			return false;
+		}
+
+		const uint8 token = *ip++;
+		int literalLength = token >> 4;
+
+		if (literalLength == 15 && !ns_CompressionReadLength(ip, end, dstSize, literalLength))
+		{
+			return false;
+		}
+
+		if (literalLength > end - ip || literalLength > opEnd - op)
+		{
+			return false;
+		}
+
+		if (literalLength > 0)
+		{
+			nsPlatform::Memory_Copy(op, ip, literalLength);
+			ip += literalLength;
+			op += literalLength;
+		}
+
+		if (ip == end)
+		{
+			break;
+		}
+
+		if (end - ip < 2)
+		{
+			return false;
+		}
+
+		const int offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+
+		if (offset == 0 || offset > op - dst)
+		{
+			return false;
+		}
+
+		int matchLength = token & 15;
+
+		if (matchLength == 15 && !ns_CompressionReadLength(ip, end, dstSize, matchLength))
+		{
+			return false;
+		}
+
+		matchLength += NS_COMPRESSION_MIN_MATCH;
+
+		if (matchLength > opEnd - op)
+		{
+			return false;
+		}
+
+		const uint8* match = op - offset;
+
+		if (offset >= matchLength)
+		{
+			nsPlatform::Memory_Copy(op, match, matchLength);
+			op += matchLength;
+		}
+		else
+		{
+			// Overlapped copy repeats last <offset> bytes
+			for (int i = 0; i < matchLength; ++i)
+			{
+				*op++ = *match++;
+			}
+		}
+	}
+
+	return op == opEnd;
+}
+
+
+
+// ============================================================================================================================================ //
+// BLOCK STREAM
+// ============================================================================================================================================ //
+void nsCompression::Compress(const uint8* data, int dataSize, nsECompression compression, nsTArray<uint8>& outData) noexcept
+{
+	NS_Assert(data || dataSize == 0);
+	NS_Assert(dataSize >= 0);
+
+	const int blockCount = (dataSize + NS_COMPRESSION_BLOCK_SIZE - 1) / NS_COMPRESSION_BLOCK_SIZE;
+	const int blockBound = GetCompressBound(NS_COMPRESSION_BLOCK_SIZE);
+
+	nsTArray<uint8> blockDatas(blockCount * blockBound);
+	nsTArray<uint32> blockSizes(blockCount);
+
+	nsParallelFor(0, blockCount, 1, [&](int blockIndex)
+	{
+		const int offset = blockIndex * NS_COMPRESSION_BLOCK_SIZE;
+		const int size = (dataSize - offset) < NS_COMPRESSION_BLOCK_SIZE ? (dataSize - offset) : NS_COMPRESSION_BLOCK_SIZE;
+		uint8* blockData = blockDatas.GetData() + blockIndex * blockBound;
+
+		// Compressed result must be smaller than raw, otherwise keep raw
+		const int compressedSize = CompressBlock(data + offset, size, blockData, size - 1, compression);
+
+		if (compressedSize > 0)
+		{
+			blockSizes[blockIndex] = static_cast<uint32>(compressedSize);
+		}
+		else
+		{
+			nsPlatform::Memory_Copy(blockData, data + offset, size);
+			blockSizes[blockIndex] = static_cast<uint32>(size) | NS_COMPRESSION_BLOCK_RAW_FLAG;
+		}
+	});
+
+	int totalSize = 8 + blockCount * 4;
+
+	for (int i = 0; i < blockCount; ++i)
+	{
+		totalSize += static_cast<int>(blockSizes[i] & ~NS_COMPRESSION_BLOCK_RAW_FLAG);
+	}
+
+	const int outOffset = outData.GetCount();
+	outData.Resize(outOffset + totalSize);
+	uint8* out = outData.GetData() + outOffset;
+
+	const uint32 uncompressedSize = static_cast<uint32>(dataSize);
+	const uint32 count = static_cast<uint32>(blockCount);
+	nsPlatform::Memory_Copy(out, &uncompressedSize, 4);
+	nsPlatform::Memory_Copy(out + 4, &count, 4);
+
+	if (blockCount == 0)
+	{
+		return;
+	}
+
+	nsPlatform::Memory_Copy(out + 8, blockSizes.GetData(), blockCount * 4);
+	out += 8 + blockCount * 4;
+
+	for (int i = 0; i < blockCount; ++i)
+	{
+		const int size = static_cast<int>(blockSizes[i] & ~NS_COMPRESSION_BLOCK_RAW_FLAG);
+		nsPlatform::Memory_Copy(out, blockDatas.GetData() + i * blockBound, size);
+		out += size;
+	}
+}
+
+
+bool nsCompression::Decompress(const uint8* data, int dataSize, nsTArray<uint8>& outData) noexcept
+{
+	NS_Assert(data || dataSize == 0);
+
+	if (dataSize < 8)
+	{
+		return false;
+	}
+
+	uint32 uncompressedSize = 0;
+	uint32 count = 0;
+	nsPlatform::Memory_Copy(&uncompressedSize, data, 4);
+	nsPlatform::Memory_Copy(&count, data + 4, 4);
+
+	if (uncompressedSize >= INT32_MAX)
+	{
+		return false;
+	}
+
+	const int blockCount = static_cast<int>(count);
+
+	if (blockCount != (static_cast<int>(uncompressedSize) + NS_COMPRESSION_BLOCK_SIZE - 1) / NS_COMPRESSION_BLOCK_SIZE || dataSize - 8 < blockCount * 4)
+	{
+		return false;
+	}
+
+	const uint8* blockSizeData = data + 8;
+	nsTArray<int> blockOffsets(blockCount);
+	int offset = 8 + blockCount * 4;
+
+	for (int i = 0; i < blockCount; ++i)
+	{
+		uint32 blockSize;
+		nsPlatform::Memory_Copy(&blockSize, blockSizeData + i * 4, 4);
+		const int size = static_cast<int>(blockSize & ~NS_COMPRESSION_BLOCK_RAW_FLAG);
+
+		if (size > dataSize - offset)
+		{
+			return false;
+		}
+
+		blockOffsets[i] = offset;
+		offset += size;
+	}
+
+	if (offset != dataSize)
+	{
+		return false;
+	}
+
+	outData.Resize(static_cast<int>(uncompressedSize));
+	nsAtomic failedCount;
+
+	nsParallelFor(0, blockCount, 1, [&](int blockIndex)
+	{
+		const int outOffset = blockIndex * NS_COMPRESSION_BLOCK_SIZE;
+		const int outSize = (static_cast<int>(uncompressedSize) - outOffset) < NS_COMPRESSION_BLOCK_SIZE ? (static_cast<int>(uncompressedSize) - outOffset) : NS_COMPRESSION_BLOCK_SIZE;
+		const int inEnd = (blockIndex + 1 < blockCount) ? blockOffsets[blockIndex + 1] : dataSize;
+		const int inSize = inEnd - blockOffsets[blockIndex];
+		uint32 blockSize;
+		nsPlatform::Memory_Copy(&blockSize, blockSizeData + blockIndex * 4, 4);
+
+		if (blockSize & NS_COMPRESSION_BLOCK_RAW_FLAG)
+		{
+			if (inSize != outSize)
+			{
+				failedCount.Increment();
+				return;
+			}
+
+			nsPlatform::Memory_Copy(outData.GetData() + outOffset, data + blockOffsets[blockIndex], inSize);
+		}
+		else if (!DecompressBlock(data + blockOffsets[blockIndex], inSize, outData.GetData() + outOffset, outSize))
+		{
+			failedCount.Increment();
+		}
+	});
+
+	return failedCount.Get() == 0;
+}
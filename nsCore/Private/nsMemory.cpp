@@ -1,5 +1,6 @@
 #include "nsMemory.h"
 #include "nsPlatform.h"
+#include "nsMath.h"
 
 
 
@@ -210,3 +211,675 @@ void nsMemory::Clear(bool bFreeMemory) noexcept
 		}
 	}
 }
+
+
+
+
+// ================================================================================================================================== //
+// MEMORY POOL
+// ================================================================================================================================== //
+#define NS_MEMORY_POOL_LARGE_BLOCK_MAGIC		(0x4C524753)
+#define NS_MEMORY_POOL_MAX_CACHE_BATCH			(32)
+
+
+static constexpr int ns_MemoryPoolSizeClassSizes[NS_MEMORY_POOL_SIZE_CLASS_COUNT] =
+{
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024,
+	1280, 1536, 1792, 2048,
+	2560, 3072, 3584, 4096,
+};
+
+static_assert(ns_MemoryPoolSizeClassSizes[NS_MEMORY_POOL_SIZE_CLASS_COUNT - 1] == NS_MEMORY_POOL_MAX_SMALL_SIZE, "Last memory pool size class must be NS_MEMORY_POOL_MAX_SMALL_SIZE!");
+
+
+// Size (in 16 bytes granularity) to size-class index
+struct nsMemoryPoolSizeClassTable
+{
+	uint8 Indices[NS_MEMORY_POOL_MAX_SMALL_SIZE / 16 + 1];
+
+	constexpr nsMemoryPoolSizeClassTable() noexcept
+		: Indices()
+	{
+		int sizeClassIndex = 0;
+
+		for (int i = 0; i <= NS_MEMORY_POOL_MAX_SMALL_SIZE / 16; ++i)
+		{
+			while (ns_MemoryPoolSizeClassSizes[sizeClassIndex] < i * 16)
+			{
+				sizeClassIndex++;
+			}
+
+			Indices[i] = static_cast<uint8>(sizeClassIndex);
+		}
+	}
+};
+
+static constexpr nsMemoryPoolSizeClassTable ns_MemoryPoolSizeClassTable;
+
+
+// Number of blocks moved between thread cache and size-class free list at once
+NS_NODISCARD_INLINE static int ns_MemoryPoolGetCacheBatchCount(int sizeClassIndex) noexcept
+{
+	return nsMath::Clamp(NS_MEMORY_POOL_PAGE_SIZE / ns_MemoryPoolSizeClassSizes[sizeClassIndex] / 4, 1, NS_MEMORY_POOL_MAX_CACHE_BATCH);
+}
+
+
+static nsAtomic ns_MemoryPoolThreadCount;
+static thread_local int ns_MemoryPoolThreadCacheIndex = NS_ARRAY_INDEX_INVALID;
+
+
+
+nsMemoryPool::nsMemoryPool() noexcept
+	: Pages(nullptr)
+	, PageSizeClasses(nullptr)
+	, PageCount(0)
+	, LargeBlocks(nullptr)
+	, LargeAllocatedSize(0)
+{
+	for (int i = 0; i < NS_MEMORY_POOL_SIZE_CLASS_COUNT; ++i)
+	{
+		SizeClasses[i].FreeList = nullptr;
+		SizeClasses[i].FreeCount = 0;
+	}
+
+	for (int i = 0; i < NS_MEMORY_POOL_THREAD_CACHE_COUNT; ++i)
+	{
+		ThreadCache& cache = ThreadCaches[i];
+		cache.AllocatedSize = 0;
+		nsPlatform::Memory_Zero(cache.FreeLists, sizeof(cache.FreeLists));
+		nsPlatform::Memory_Zero(cache.FreeCounts, sizeof(cache.FreeCounts));
+	}
+}
+
+
+nsMemoryPool::nsMemoryPool(nsName name, int totalSize, int defaultAlignment) noexcept
+	: nsMemoryPool()
+{
+	Initialize(name, totalSize, defaultAlignment);
+}
+
+
+nsMemoryPool::~nsMemoryPool() noexcept
+{
+	Clear(true);
+}
+
+
+void nsMemoryPool::Initialize(nsName name, int totalSize, int defaultAlignment) noexcept
+{
+	NS_Assert(totalSize >= 0);
+	NS_AssertV(defaultAlignment >= 4 && defaultAlignment <= 16, TEXT("Memory pool default alignment must be within [4, 16]!"));
+	NS_AssertV(Pages == nullptr, TEXT("Memory allocator already initialized!"));
+
+	Name = name;
+	PageCount = (totalSize + NS_MEMORY_POOL_PAGE_SIZE - 1) / NS_MEMORY_POOL_PAGE_SIZE;
+	TotalSize = PageCount * NS_MEMORY_POOL_PAGE_SIZE;
+	AllocatedSize = 0;
+	DefaultAlignmentSize = defaultAlignment;
+	NextPageIndex.Set(0);
+
+	if (PageCount > 0)
+	{
+		Pages = static_cast<uint8*>(nsPlatform::Memory_Alloc(TotalSize));
+		PageSizeClasses = static_cast<uint8*>(nsPlatform::Memory_Alloc(PageCount));
+	}
+}
+
+
+nsMemoryPool::ThreadCache& nsMemoryPool::GetThreadCache() noexcept
+{
+	if (ns_MemoryPoolThreadCacheIndex == NS_ARRAY_INDEX_INVALID)
+	{
+		ns_MemoryPoolThreadCacheIndex = (ns_MemoryPoolThreadCount.Increment() - 1) % NS_MEMORY_POOL_THREAD_CACHE_COUNT;
+	}
+
+	// More threads than caches will share a cache, hence the spin lock
+	ThreadCache& cache = ThreadCaches[ns_MemoryPoolThreadCacheIndex];
+
+	while (cache.Lock.CompareExchange(1, 0) != 0)
+	{
+		NS_YieldProcessor();
+	}
+
+	return cache;
+}
+
+
+bool nsMemoryPool::RefillThreadCache(ThreadCache& cache, int sizeClassIndex) noexcept
+{
+	SizeClass& sizeClass = SizeClasses[sizeClassIndex];
+	sizeClass.CriticalSection.Enter();
+
+	if (sizeClass.FreeCount == 0)
+	{
+		// Carve new page into blocks
+		const int pageIndex = NextPageIndex.Increment() - 1;
+
+		if (pageIndex >= PageCount)
+		{
+			NextPageIndex.Set(PageCount);
+			sizeClass.CriticalSection.Leave();
+
+			return false;
+		}
+
+		PageSizeClasses[pageIndex] = static_cast<uint8>(sizeClassIndex);
+
+		const int blockSize = ns_MemoryPoolSizeClassSizes[sizeClassIndex];
+		const int blockCount = NS_MEMORY_POOL_PAGE_SIZE / blockSize;
+		uint8* page = Pages + static_cast<uint64>(pageIndex) * NS_MEMORY_POOL_PAGE_SIZE;
+
+		for (int i = blockCount - 1; i >= 0; --i)
+		{
+			FreeBlock* block = reinterpret_cast<FreeBlock*>(page + i * blockSize);
+			block->Next = sizeClass.FreeList;
+			sizeClass.FreeList = block;
+		}
+
+		sizeClass.FreeCount = blockCount;
+	}
+
+	const int batchCount = nsMath::Min(ns_MemoryPoolGetCacheBatchCount(sizeClassIndex), sizeClass.FreeCount);
+
+	for (int i = 0; i < batchCount; ++i)
+	{
+		FreeBlock* block = sizeClass.FreeList;
+		sizeClass.FreeList = block->Next;
+		block->Next = cache.FreeLists[sizeClassIndex];
+		cache.FreeLists[sizeClassIndex] = block;
+	}
+
+	sizeClass.FreeCount -= batchCount;
+	cache.FreeCounts[sizeClassIndex] += batchCount;
+
+	sizeClass.CriticalSection.Leave();
+
+	return true;
+}
+
+
+void nsMemoryPool::ReleaseThreadCache(ThreadCache& cache, int sizeClassIndex, int releaseCount) noexcept
+{
+	if (releaseCount == 0)
+	{
+		return;
+	}
+
+	SizeClass& sizeClass = SizeClasses[sizeClassIndex];
+	sizeClass.CriticalSection.Enter();
+
+	for (int i = 0; i < releaseCount; ++i)
+	{
+		FreeBlock* block = cache.FreeLists[sizeClassIndex];
+		cache.FreeLists[sizeClassIndex] = block->Next;
+		block->Next = sizeClass.FreeList;
+		sizeClass.FreeList = block;
+	}
+
+	sizeClass.FreeCount += releaseCount;
+	cache.FreeCounts[sizeClassIndex] -= releaseCount;
+
+	sizeClass.CriticalSection.Leave();
+}
+
+
+void* nsMemoryPool::AllocateLarge(int size, int alignment) noexcept
+{
+	NS_Assert(alignment >= 16 && (alignment & (alignment - 1)) == 0);
+
+	uint8* data = static_cast<uint8*>(nsPlatform::Memory_Alloc(static_cast<uint64>(size) + sizeof(LargeBlock) + alignment));
+	NS_ValidateV(data, TEXT("Memory allocation failed. Fail to allocate large block! [Memory:%s] [RequestedSize:%i]"), *Name.ToString(), size);
+
+	const uint64 address = reinterpret_cast<uint64>(data) + sizeof(LargeBlock);
+	uint8* alignedData = reinterpret_cast<uint8*>((address + alignment - 1) & ~static_cast<uint64>(alignment - 1));
+
+	LargeBlock* block = reinterpret_cast<LargeBlock*>(alignedData) - 1;
+	block->Prev = nullptr;
+	block->Data = data;
+	block->Size = size;
+	block->Magic = NS_MEMORY_POOL_LARGE_BLOCK_MAGIC;
+
+	LargeCriticalSection.Enter();
+	{
+		block->Next = LargeBlocks;
+
+		if (LargeBlocks)
+		{
+			LargeBlocks->Prev = block;
+		}
+
+		LargeBlocks = block;
+		LargeAllocatedSize += size;
+	}
+	LargeCriticalSection.Leave();
+
+	return alignedData;
+}
+
+
+void nsMemoryPool::DeallocateLarge(void* data) noexcept
+{
+	LargeBlock* block = static_cast<LargeBlock*>(data) - 1;
+	NS_ValidateV(block->Magic == NS_MEMORY_POOL_LARGE_BLOCK_MAGIC, TEXT("Invalid pointer memory!"));
+
+	LargeCriticalSection.Enter();
+	{
+		if (block->Prev)
+		{
+			block->Prev->Next = block->Next;
+		}
+		else
+		{
+			LargeBlocks = block->Next;
+		}
+
+		if (block->Next)
+		{
+			block->Next->Prev = block->Prev;
+		}
+
+		LargeAllocatedSize -= block->Size;
+	}
+	LargeCriticalSection.Leave();
+
+	block->Magic = 0;
+	nsPlatform::Memory_Free(block->Data);
+}
+
+
+void* nsMemoryPool::Allocate(int size, nsName /*debugName*/) noexcept
+{
+	NS_AssertV(size > 0, TEXT("size must be greater than 0!"));
+
+	if (size > NS_MEMORY_POOL_MAX_SMALL_SIZE)
+	{
+		return AllocateLarge(size, 16);
+	}
+
+	const int sizeClassIndex = ns_MemoryPoolSizeClassTable.Indices[(size + 15) / 16];
+	ThreadCache& cache = GetThreadCache();
+
+	if (cache.FreeCounts[sizeClassIndex] == 0 && !RefillThreadCache(cache, sizeClassIndex))
+	{
+		cache.Lock.Set(0);
+
+		// Out of pages
+		return AllocateLarge(size, 16);
+	}
+
+	FreeBlock* block = cache.FreeLists[sizeClassIndex];
+	cache.FreeLists[sizeClassIndex] = block->Next;
+	cache.FreeCounts[sizeClassIndex]--;
+	cache.AllocatedSize += ns_MemoryPoolSizeClassSizes[sizeClassIndex];
+	cache.Lock.Set(0);
+
+	return block;
+}
+
+
+void* nsMemoryPool::AllocateAligned(int size, int alignment, nsName debugName) noexcept
+{
+	NS_AssertV(size > 0, TEXT("size must be greater than 0!"));
+
+	// Blocks are 16 bytes aligned
+	if (alignment <= 16)
+	{
+		return Allocate(size, debugName);
+	}
+
+	return AllocateLarge(size, alignment);
+}
+
+
+void nsMemoryPool::Deallocate(void* data) noexcept
+{
+	NS_Assert(data);
+
+	uint8* dataPtr = static_cast<uint8*>(data);
+
+	if (dataPtr < Pages || dataPtr >= Pages + TotalSize)
+	{
+		DeallocateLarge(data);
+		return;
+	}
+
+	const uint64 offset = static_cast<uint64>(dataPtr - Pages);
+	const int pageIndex = static_cast<int>(offset / NS_MEMORY_POOL_PAGE_SIZE);
+	NS_ValidateV(pageIndex < NextPageIndex.Get(), TEXT("Invalid pointer memory!"));
+
+	const int sizeClassIndex = PageSizeClasses[pageIndex];
+	const int blockSize = ns_MemoryPoolSizeClassSizes[sizeClassIndex];
+	NS_ValidateV((offset % NS_MEMORY_POOL_PAGE_SIZE) % blockSize == 0, TEXT("Invalid pointer memory!"));
+
+#ifdef _DEBUG
+	nsPlatform::Memory_Set(data, -11, blockSize);
+#endif // _DEBUG
+
+	ThreadCache& cache = GetThreadCache();
+
+	FreeBlock* block = static_cast<FreeBlock*>(data);
+	block->Next = cache.FreeLists[sizeClassIndex];
+	cache.FreeLists[sizeClassIndex] = block;
+	cache.FreeCounts[sizeClassIndex]++;
+	cache.AllocatedSize -= blockSize;
+
+	// Keep cache bounded, so blocks freed by one thread can be reused by other threads
+	const int batchCount = ns_MemoryPoolGetCacheBatchCount(sizeClassIndex);
+
+	if (cache.FreeCounts[sizeClassIndex] > batchCount * 2)
+	{
+		ReleaseThreadCache(cache, sizeClassIndex, batchCount);
+	}
+
+	cache.Lock.Set(0);
+}
+
+
+void nsMemoryPool::Defragment() noexcept
+{
+	for (int i = 0; i < NS_MEMORY_POOL_THREAD_CACHE_COUNT; ++i)
+	{
+		ThreadCache& cache = ThreadCaches[i];
+
+		while (cache.Lock.CompareExchange(1, 0) != 0)
+		{
+			NS_YieldProcessor();
+		}
+
+		for (int s = 0; s < NS_MEMORY_POOL_SIZE_CLASS_COUNT; ++s)
+		{
+			ReleaseThreadCache(cache, s, cache.FreeCounts[s]);
+		}
+
+		cache.Lock.Set(0);
+	}
+}
+
+
+void nsMemoryPool::Clear(bool bFreeMemory) noexcept
+{
+	// Not thread-safe, must not be called while other threads allocate from this pool
+	for (int i = 0; i < NS_MEMORY_POOL_SIZE_CLASS_COUNT; ++i)
+	{
+		SizeClasses[i].FreeList = nullptr;
+		SizeClasses[i].FreeCount = 0;
+	}
+
+	for (int i = 0; i < NS_MEMORY_POOL_THREAD_CACHE_COUNT; ++i)
+	{
+		ThreadCache& cache = ThreadCaches[i];
+		cache.AllocatedSize = 0;
+		nsPlatform::Memory_Zero(cache.FreeLists, sizeof(cache.FreeLists));
+		nsPlatform::Memory_Zero(cache.FreeCounts, sizeof(cache.FreeCounts));
+	}
+
+	NextPageIndex.Set(0);
+
+	while (LargeBlocks)
+	{
+		LargeBlock* next = LargeBlocks->Next;
+		LargeBlocks->Magic = 0;
+		nsPlatform::Memory_Free(LargeBlocks->Data);
+		LargeBlocks = next;
+	}
+
+	LargeAllocatedSize = 0;
+
+	if (bFreeMemory && Pages)
+	{
+		nsPlatform::Memory_Free(Pages);
+		nsPlatform::Memory_Free(PageSizeClasses);
+		Pages = nullptr;
+		PageSizeClasses = nullptr;
+		PageCount = 0;
+		TotalSize = 0;
+		DefaultAlignmentSize = 0;
+	}
+}
+
+
+int nsMemoryPool::GetAllocatedSize() const noexcept
+{
+	int allocatedSize = 0;
+
+	for (int i = 0; i < NS_MEMORY_POOL_THREAD_CACHE_COUNT; ++i)
+	{
+		ThreadCache& cache = ThreadCaches[i];
+
+		while (cache.Lock.CompareExchange(1, 0) != 0)
+		{
+			NS_YieldProcessor();
+		}
+
+		allocatedSize += cache.AllocatedSize;
+		cache.Lock.Set(0);
+	}
+
+	LargeCriticalSection.Enter();
+	allocatedSize += LargeAllocatedSize;
+	LargeCriticalSection.Leave();
+
+	return allocatedSize;
+}
+
+
+
+
+// ================================================================================================================================== //
+// MEMORY LINEAR
+// ================================================================================================================================== //
+nsMemoryLinear::nsMemoryLinear() noexcept
+	: Buffer(nullptr)
+	, Offset(0)
+	, LastAllocationOffset(NS_ARRAY_INDEX_INVALID)
+	, OverflowBlocks(nullptr)
+	, OverflowSize(0)
+{
+}
+
+
+nsMemoryLinear::nsMemoryLinear(nsName name, int totalSize, int defaultAlignment) noexcept
+	: nsMemoryLinear()
+{
+	Initialize(name, totalSize, defaultAlignment);
+}
+
+
+nsMemoryLinear::~nsMemoryLinear() noexcept
+{
+	Clear(true);
+}
+
+
+void nsMemoryLinear::Initialize(nsName name, int totalSize, int defaultAlignment) noexcept
+{
+	NS_Assert(totalSize >= 0);
+	NS_Assert(defaultAlignment >= 4);
+	NS_AssertV(Buffer == nullptr, TEXT("Memory allocator already initialized!"));
+
+	Name = name;
+	TotalSize = totalSize;
+	AllocatedSize = 0;
+	DefaultAlignmentSize = defaultAlignment;
+	Offset = 0;
+	LastAllocationOffset = NS_ARRAY_INDEX_INVALID;
+
+	if (TotalSize > 0)
+	{
+		Buffer = static_cast<uint8*>(nsPlatform::Memory_Alloc(TotalSize));
+	}
+}
+
+
+void* nsMemoryLinear::AllocateOverflow(int size, int alignment) noexcept
+{
+	const int headerSize = static_cast<int>(sizeof(OverflowBlock));
+	OverflowBlock* block = static_cast<OverflowBlock*>(nsPlatform::Memory_Alloc(headerSize + size + alignment));
+	NS_ValidateV(block, TEXT("Memory linear overflow alloc failed!"));
+
+	block->Next = OverflowBlocks;
+	block->Size = size + alignment;
+	OverflowBlocks = block;
+	OverflowSize += size + alignment;
+
+	const uint64 address = reinterpret_cast<uint64>(block) + headerSize;
+
+	return reinterpret_cast<void*>((address + alignment - 1) & ~static_cast<uint64>(alignment - 1));
+}
+
+
+void* nsMemoryLinear::Allocate(int size, nsName debugName) noexcept
+{
+	return AllocateAligned(size, DefaultAlignmentSize, debugName);
+}
+
+
+void* nsMemoryLinear::AllocateAligned(int size, int alignment, nsName /*debugName*/) noexcept
+{
+	NS_AssertV(size > 0, TEXT("size must be greater than 0!"));
+	NS_AssertV(alignment > 0 && (alignment & (alignment - 1)) == 0, TEXT("alignment must be power of two!"));
+
+	AllocatedSize += size;
+
+	if (Buffer)
+	{
+		const uint64 bufferAddress = reinterpret_cast<uint64>(Buffer);
+		const uint64 alignedAddress = (bufferAddress + Offset + alignment - 1) & ~static_cast<uint64>(alignment - 1);
+		const int alignedOffset = static_cast<int>(alignedAddress - bufferAddress);
+
+		if (alignedOffset + size <= TotalSize)
+		{
+			LastAllocationOffset = alignedOffset;
+			Offset = alignedOffset + size;
+
+			return Buffer + alignedOffset;
+		}
+	}
+
+	LastAllocationOffset = NS_ARRAY_INDEX_INVALID;
+
+	return AllocateOverflow(size, alignment);
+}
+
+
+void nsMemoryLinear::Deallocate(void* data) noexcept
+{
+	NS_Assert(data);
+	NS_AssertV(IsOwned(data), TEXT("Invalid pointer memory!"));
+
+	if (LastAllocationOffset != NS_ARRAY_INDEX_INVALID && data == Buffer + LastAllocationOffset)
+	{
+		AllocatedSize -= Offset - LastAllocationOffset;
+		Offset = LastAllocationOffset;
+		LastAllocationOffset = NS_ARRAY_INDEX_INVALID;
+	}
+}
+
+
+void nsMemoryLinear::Defragment() noexcept
+{
+}
+
+
+void nsMemoryLinear::Clear(bool bFreeMemory) noexcept
+{
+	const int requiredSize = Offset + OverflowSize;
+
+	while (OverflowBlocks)
+	{
+		OverflowBlock* next = OverflowBlocks->Next;
+		nsPlatform::Memory_Free(OverflowBlocks);
+		OverflowBlocks = next;
+	}
+
+	Offset = 0;
+	LastAllocationOffset = NS_ARRAY_INDEX_INVALID;
+	OverflowSize = 0;
+	AllocatedSize = 0;
+
+	if (bFreeMemory)
+	{
+		if (Buffer)
+		{
+			nsPlatform::Memory_Free(Buffer);
+			Buffer = nullptr;
+		}
+
+		TotalSize = 0;
+		DefaultAlignmentSize = 0;
+
+		return;
+	}
+
+	if (requiredSize > TotalSize)
+	{
+		TotalSize = nsMath::Max(TotalSize * 2, requiredSize);
+
+		if (Buffer)
+		{
+			nsPlatform::Memory_Free(Buffer);
+		}
+
+		Buffer = static_cast<uint8*>(nsPlatform::Memory_Alloc(TotalSize));
+		NS_ValidateV(Buffer, TEXT("Memory linear alloc failed!"));
+	}
+
+#ifdef _DEBUG
+	if (Buffer)
+	{
+		nsPlatform::Memory_Set(Buffer, -11, TotalSize);
+	}
+#endif // _DEBUG
+}
+
+
+void* nsMemoryLinear::Reallocate(void* data, int oldSize, int newSize, int alignment) noexcept
+{
+	NS_Assert(newSize > 0);
+
+	if (data == nullptr)
+	{
+		return AllocateAligned(newSize, alignment);
+	}
+
+	NS_AssertV(IsOwned(data), TEXT("Invalid pointer memory!"));
+
+	if (LastAllocationOffset != NS_ARRAY_INDEX_INVALID && data == Buffer + LastAllocationOffset && LastAllocationOffset + newSize <= TotalSize)
+	{
+		AllocatedSize += newSize - (Offset - LastAllocationOffset);
+		Offset = LastAllocationOffset + newSize;
+
+		return data;
+	}
+
+	void* newData = AllocateAligned(newSize, alignment);
+	nsPlatform::Memory_Copy(newData, data, nsMath::Min(oldSize, newSize));
+
+	return newData;
+}
+
+
+bool nsMemoryLinear::IsOwned(const void* data) const noexcept
+{
+	const uint8* ptr = static_cast<const uint8*>(data);
+
+	if (Buffer && ptr >= Buffer && ptr < Buffer + TotalSize)
+	{
+		return true;
+	}
+
+	for (const OverflowBlock* block = OverflowBlocks; block; block = block->Next)
+	{
+		const uint8* blockData = reinterpret_cast<const uint8*>(block + 1);
+
+		if (ptr >= blockData && ptr < blockData + block->Size)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
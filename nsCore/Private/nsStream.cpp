@@ -25,21 +25,32 @@ nsBinaryStreamReader::nsBinaryStreamReader(nsTArray<uint8> data) noexcept
 	: Buffer(std::move(data))
 	, Offset(0)
 {
+	Data = Buffer.GetData();
+	Size = Buffer.GetCount();
+}
+
+
+nsBinaryStreamReader::nsBinaryStreamReader(const uint8* data, int dataSize) noexcept
+	: Data(data)
+	, Size(dataSize)
+	, Offset(0)
+{
+	NS_Assert(data || dataSize == 0);
 }
 
 
 void nsBinaryStreamReader::SerializeData(void* data, int dataSize) noexcept
 {
-	if (Buffer.IsEmpty())
+	if (Size == 0)
 	{
 		return;
 	}
 
 	NS_Assert(data);
 	NS_Assert(dataSize > 0);
-	NS_Assert(Offset + dataSize <= Buffer.GetCount());
+	NS_Assert(Offset + dataSize <= Size);
 
-	nsPlatform::Memory_Copy(data, Buffer.GetData() + Offset, dataSize);
+	nsPlatform::Memory_Copy(data, Data + Offset, dataSize);
 	Offset += dataSize;
 }
 
@@ -0,0 +1,917 @@
+#include "nsThreadPool.h"
+#include "nsLogger.h"
+
+
+
+#define NS_THREAD_MAX_COUNT						(32)
+#define NS_THREAD_TASK_QUEUE_CAPACITY			(4096)
+#define NS_THREAD_SPIN_COUNT_BEFORE_SLEEP		(256)
+
+static_assert((NS_THREAD_TASK_QUEUE_CAPACITY & (NS_THREAD_TASK_QUEUE_CAPACITY - 1)) == 0, "NS_THREAD_TASK_QUEUE_CAPACITY must be power of two!");
+
+
+
+// ============================================================================================================================================ //
+// THREAD POOL
+// ============================================================================================================================================ //
+// Work stealing task queue (Chase-Lev deque)
+// Push/Pop are called by owner thread only and operate on bottom (LIFO)
+// Steal can be called from any thread and operates on top (FIFO)
+// Queued tasks may run on every worker thread (SubmitTasks pins narrower affinity), affinity only decides whether main thread may run them.
+// Main thread stops stealing from a queue at first task it may not run, tasks behind it are left to worker threads
+class nsThreadTaskQueue
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsThreadTaskQueue)
+
+private:
+	// Affinity is stored with task pointer, a task must not be dereferenced before it is claimed (it may be executed and freed by another thread)
+	struct Slot
+	{
+		nsIThreadTask* volatile Task;
+		volatile nsThreadAffinityMasks AffinityMasks;
+	};
+
+	nsAtomic Top;
+	nsAtomic Bottom;
+	Slot Slots[NS_THREAD_TASK_QUEUE_CAPACITY];
+
+
+private:
+	// Top/Bottom indices are allowed to wrap around
+	NS_NODISCARD static NS_INLINE int OffsetIndex(int index, int offset) noexcept
+	{
+		return static_cast<int>(static_cast<uint32>(index) + static_cast<uint32>(offset));
+	}
+
+
+	NS_NODISCARD static NS_INLINE int GetDistance(int from, int to) noexcept
+	{
+		return static_cast<int>(static_cast<uint32>(to) - static_cast<uint32>(from));
+	}
+
+
+public:
+	nsThreadTaskQueue() noexcept
+		: Slots()
+	{
+	}
+
+
+	// [Owner thread] Returns false if queue is full
+	NS_NODISCARD bool Push(nsIThreadTask* task, nsThreadAffinityMasks affinityMasks) noexcept
+	{
+		const int bottom = Bottom.Get();
+		const int top = Top.Get();
+
+		if (GetDistance(top, bottom) >= NS_THREAD_TASK_QUEUE_CAPACITY)
+		{
+			return false;
+		}
+
+		Slot& slot = Slots[bottom & (NS_THREAD_TASK_QUEUE_CAPACITY - 1)];
+		slot.Task = task;
+		slot.AffinityMasks = affinityMasks;
+
+		// Publish task (full barrier)
+		Bottom.Set(OffsetIndex(bottom, 1));
+
+		return true;
+	}
+
+
+	// [Owner thread] Get affinity of the task that will be returned by Pop() without removing it, 0 if queue is empty
+	NS_NODISCARD nsThreadAffinityMasks PeekBottomAffinityMasks() const noexcept
+	{
+		const int bottom = Bottom.Get();
+
+		if (GetDistance(Top.Get(), bottom) <= 0)
+		{
+			return 0;
+		}
+
+		return Slots[OffsetIndex(bottom, -1) & (NS_THREAD_TASK_QUEUE_CAPACITY - 1)].AffinityMasks;
+	}
+
+
+	// [Owner thread]
+	NS_NODISCARD nsIThreadTask* Pop() noexcept
+	{
+		const int bottom = OffsetIndex(Bottom.Get(), -1);
+		Bottom.Set(bottom);
+
+		const int top = Top.Get();
+		const int lastIndex = GetDistance(top, bottom);
+
+		if (lastIndex < 0)
+		{
+			// Empty
+			Bottom.Set(top);
+			return nullptr;
+		}
+
+		nsIThreadTask* task = Slots[bottom & (NS_THREAD_TASK_QUEUE_CAPACITY - 1)].Task;
+
+		if (lastIndex > 0)
+		{
+			return task;
+		}
+
+		// Last task in queue, race against thieves
+		if (Top.CompareExchange(OffsetIndex(top, 1), top) != top)
+		{
+			task = nullptr;
+		}
+
+		Bottom.Set(OffsetIndex(top, 1));
+
+		return task;
+	}
+
+
+	// [Any thread] Steal oldest task if it is allowed to run on <threadMask>
+	NS_NODISCARD nsIThreadTask* Steal(nsThreadAffinityMasks threadMask) noexcept
+	{
+		const int top = Top.Get();
+		const int bottom = Bottom.Get();
+
+		if (GetDistance(top, bottom) <= 0)
+		{
+			return nullptr;
+		}
+
+		// Slot values are only trusted after CAS below claims it, slot can not be reused before Top moves past it
+		const Slot& slot = Slots[top & (NS_THREAD_TASK_QUEUE_CAPACITY - 1)];
+		nsIThreadTask* task = slot.Task;
+
+		if ((slot.AffinityMasks & threadMask) == 0)
+		{
+			return nullptr;
+		}
+
+		if (Top.CompareExchange(OffsetIndex(top, 1), top) != top)
+		{
+			return nullptr;
+		}
+
+		return task;
+	}
+
+};
+
+
+
+struct nsThreadWorker
+{
+	nsPlatformThreadHandle Handle;
+	nsThreadId Id;
+	int Index;
+	uint32 Affinity;
+	nsName Name;
+	nsThreadTaskQueue Queue;
+	nsTArray<nsIThreadTask*> PinnedTasks;
+	nsAtomic PinnedTaskCount;
+	nsCriticalSection CriticalSection;
+	nsSemaphore WakeSemaphore;
+};
+
+
+static nsLogCategory ThreadPoolLog(TEXT("nsThreadPoolLog"), nsELogVerbosity::LV_DEBUG);
+static nsThreadId MainThreadId;
+static nsThreadWorker ThreadWorkers[NS_THREAD_MAX_COUNT];
+static int NumThreads;
+static nsThreadAffinityMasks AllThreadMasks;
+static nsThreadAffinityMasks WorkerThreadMasks;
+static nsAtomic WakeWorkerIndex;
+static nsAtomic StartedWorkerCount;
+static nsAtomic bShuttingDown;
+static bool bInitialized;
+static thread_local int CurrentThreadIndex = NS_ARRAY_INDEX_INVALID;
+
+
+
+static void ns_ExecuteTask(nsIThreadTask* task) noexcept
+{
+	// Task may be reset and resubmitted by owner as soon as it is done, read counter before execute
+	nsThreadTaskCounter* counter = task->SubmitCounter;
+
+#ifdef _DEBUG
+	NS_LogDebug(ThreadPoolLog, TEXT("[Thread-%i] execute task [%s]"), CurrentThreadIndex, *task->GetDebugName());
+#endif // _DEBUG
+
+	task->Execute();
+
+	if (counter)
+	{
+		counter->Decrement();
+	}
+}
+
+
+static nsIThreadTask* ns_FindTask(int threadIndex) noexcept
+{
+	nsThreadWorker& worker = ThreadWorkers[threadIndex];
+	const nsThreadAffinityMasks threadMask = (1u << threadIndex);
+	nsIThreadTask* task = nullptr;
+
+	// Tasks pinned to this thread
+	if (worker.PinnedTaskCount.Get() > 0)
+	{
+		worker.CriticalSection.Enter();
+		{
+			if (worker.PinnedTasks.GetCount() > 0)
+			{
+				task = worker.PinnedTasks[0];
+				worker.PinnedTasks.RemoveAt(0);
+				worker.PinnedTaskCount.Decrement();
+			}
+		}
+		worker.CriticalSection.Leave();
+
+		if (task)
+		{
+			return task;
+		}
+	}
+
+	// Own queue (newest first)
+	if (worker.Queue.PeekBottomAffinityMasks() & threadMask)
+	{
+		task = worker.Queue.Pop();
+
+		if (task)
+		{
+			return task;
+		}
+	}
+
+	// Steal from other threads (oldest first)
+	for (int i = 1; i < NumThreads; ++i)
+	{
+		const int victimIndex = (threadIndex + i) % NumThreads;
+		task = ThreadWorkers[victimIndex].Queue.Steal(threadMask);
+
+		if (task)
+		{
+			return task;
+		}
+	}
+
+	// Own queue (oldest first), in case the newest task is not allowed to run on this thread
+	return worker.Queue.Steal(threadMask);
+}
+
+
+static void ns_ThreadProc(void* userData) noexcept
+{
+	nsThreadWorker* worker = static_cast<nsThreadWorker*>(userData);
+	worker->Id = nsPlatform::Thread_GetCurrentId();
+	CurrentThreadIndex = worker->Index;
+	StartedWorkerCount.Increment();
+
+	int spinCount = 0;
+
+	while (bShuttingDown.Get() == 0)
+	{
+		nsIThreadTask* task = ns_FindTask(worker->Index);
+
+		if (task)
+		{
+			ns_ExecuteTask(task);
+			spinCount = 0;
+			continue;
+		}
+
+		if (++spinCount < NS_THREAD_SPIN_COUNT_BEFORE_SLEEP)
+		{
+			NS_YieldProcessor();
+			continue;
+		}
+
+		spinCount = 0;
+		worker->WakeSemaphore.Wait();
+	}
+}
+
+
+static void ns_WakeWorkers(int count) noexcept
+{
+	const int workerCount = NumThreads - 1;
+
+	if (workerCount <= 0)
+	{
+		return;
+	}
+
+	if (count > workerCount)
+	{
+		count = workerCount;
+	}
+
+	for (int i = 0; i < count; ++i)
+	{
+		const int workerIndex = 1 + static_cast<int>(static_cast<uint32>(WakeWorkerIndex.Increment()) % static_cast<uint32>(workerCount));
+
+		if (workerIndex != CurrentThreadIndex)
+		{
+			ThreadWorkers[workerIndex].WakeSemaphore.Signal();
+		}
+	}
+}
+
+
+
+void nsThreadPool::Initialize() noexcept
+{
+	if (bInitialized)
+	{
+		return;
+	}
+
+	MainThreadId = nsPlatform::Thread_GetCurrentId();
+	CurrentThreadIndex = 0;
+
+	NumThreads = nsPlatform::Thread_GetProcessorCount();
+
+	if (NumThreads < 1)
+	{
+		NumThreads = 1;
+	}
+
+	if (NumThreads > NS_THREAD_MAX_COUNT)
+	{
+		NumThreads = NS_THREAD_MAX_COUNT;
+	}
+
+	AllThreadMasks = (NumThreads == NS_THREAD_MAX_COUNT) ? static_cast<nsThreadAffinityMasks>(nsEThreadAffinity::Thread_ALL) : ((1u << NumThreads) - 1);
+	WorkerThreadMasks = AllThreadMasks & ~static_cast<nsThreadAffinityMasks>(nsEThreadAffinity::Thread_Main);
+
+	nsThreadWorker& mainThread = ThreadWorkers[0];
+	mainThread.Handle = nsPlatformThreadHandle();
+	mainThread.Id = MainThreadId;
+	mainThread.Index = 0;
+	mainThread.Affinity = 1;
+
+	bShuttingDown.Set(0);
+	StartedWorkerCount.Set(0);
+
+	for (int i = 1; i < NumThreads; ++i)
+	{
+		nsThreadWorker& worker = ThreadWorkers[i];
+		worker.Index = i;
+		worker.Affinity = (1u << i);
+		worker.Handle = nsPlatform::Thread_Create(ns_ThreadProc, &worker);
+	}
+
+	// Worker thread ids are assigned by the worker threads
+	while (StartedWorkerCount.Get() < NumThreads - 1)
+	{
+		NS_YieldProcessor();
+	}
+
+	bInitialized = true;
+
+	NS_LogInfo(ThreadPoolLog, TEXT("Initialize thread pool [NumWorkerThreads: %i]"), NumThreads - 1);
+}
+
+
+void nsThreadPool::Shutdown() noexcept
+{
+	if (bInitialized)
+	{
+		NS_LogInfo(ThreadPoolLog, TEXT("Shutdown threadpool"));
+
+		bShuttingDown.Set(1);
+
+		for (int i = 1; i < NumThreads; ++i)
+		{
+			ThreadWorkers[i].WakeSemaphore.Signal();
+		}
+
+		for (int i = 1; i < NumThreads; ++i)
+		{
+			nsPlatform::Thread_Join(ThreadWorkers[i].Handle);
+		}
+
+		bInitialized = false;
+	}
+}
+
+
+void nsThreadPool::SubmitTasks(nsIThreadTask** tasks, int taskCount, nsThreadAffinityMasks threadAffinityMasks, nsThreadTaskCounter* optCounter) noexcept
+{
+	NS_Assert(bInitialized);
+	NS_ValidateV(CurrentThreadIndex != NS_ARRAY_INDEX_INVALID, TEXT("SubmitTasks must be called from main thread or worker thread!"));
+
+	if (tasks == nullptr || taskCount <= 0)
+	{
+		return;
+	}
+
+	threadAffinityMasks &= AllThreadMasks;
+
+	if (threadAffinityMasks == 0)
+	{
+		threadAffinityMasks = AllThreadMasks;
+	}
+
+	if (optCounter)
+	{
+		optCounter->Add(taskCount);
+	}
+
+	for (int i = 0; i < taskCount; ++i)
+	{
+		nsIThreadTask* task = tasks[i];
+		task->SubmitCounter = optCounter;
+		task->SubmitAffinityMasks = threadAffinityMasks;
+	}
+
+	// Pinned to main thread
+	if (threadAffinityMasks == nsEThreadAffinity::Thread_Main)
+	{
+		if (CurrentThreadIndex == 0)
+		{
+			for (int i = 0; i < taskCount; ++i)
+			{
+				ns_ExecuteTask(tasks[i]);
+			}
+		}
+		else
+		{
+			nsThreadWorker& main = ThreadWorkers[0];
+
+			main.CriticalSection.Enter();
+			{
+				main.PinnedTasks.InsertAt(tasks, taskCount);
+				main.PinnedTaskCount.Add(taskCount);
+			}
+			main.CriticalSection.Leave();
+		}
+
+		return;
+	}
+
+	// Can run on any worker thread, push to own queue and let idle threads steal
+	if ((threadAffinityMasks & WorkerThreadMasks) == WorkerThreadMasks)
+	{
+		nsThreadWorker& worker = ThreadWorkers[CurrentThreadIndex];
+
+		for (int i = 0; i < taskCount; ++i)
+		{
+			if (!worker.Queue.Push(tasks[i], threadAffinityMasks))
+			{
+				// Queue is full, execute immediately
+				ns_ExecuteTask(tasks[i]);
+			}
+		}
+
+		ns_WakeWorkers(taskCount);
+
+		return;
+	}
+
+	// Pinned to subset of worker threads, distribute evenly
+	nsTArrayInline<nsThreadWorker*, NS_THREAD_MAX_COUNT> workers;
+
+	for (int i = 1; i < NumThreads; ++i)
+	{
+		if (threadAffinityMasks & ThreadWorkers[i].Affinity)
+		{
+			workers.Add(&ThreadWorkers[i]);
+		}
+	}
+
+	const int workerCount = workers.GetCount();
+	NS_Assert(workerCount > 0);
+
+	for (int i = 0; i < taskCount; ++i)
+	{
+		nsThreadWorker* worker = workers[i % workerCount];
+
+		worker->CriticalSection.Enter();
+		{
+			worker->PinnedTasks.Add(tasks[i]);
+			worker->PinnedTaskCount.Increment();
+		}
+		worker->CriticalSection.Leave();
+	}
+
+	const int wakeCount = taskCount < workerCount ? taskCount : workerCount;
+
+	for (int i = 0; i < wakeCount; ++i)
+	{
+		workers[i]->WakeSemaphore.Signal();
+	}
+}
+
+
+void nsThreadPool::WaitForCounter(const nsThreadTaskCounter& counter) noexcept
+{
+	NS_Assert(bInitialized);
+	NS_ValidateV(CurrentThreadIndex != NS_ARRAY_INDEX_INVALID, TEXT("WaitForCounter must be called from main thread or worker thread!"));
+
+	const int threadIndex = CurrentThreadIndex;
+
+	while (!counter.IsDone())
+	{
+		nsIThreadTask* task = ns_FindTask(threadIndex);
+
+		if (task)
+		{
+			ns_ExecuteTask(task);
+		}
+		else
+		{
+			NS_YieldProcessor();
+		}
+	}
+}
+
+
+nsTArrayInline<nsThreadId, 32> nsThreadPool::GetWorkerThreads() noexcept
+{
+	NS_Assert(bInitialized);
+
+	nsTArrayInline<nsThreadId, 32> threadWorkers;
+
+	for (int i = 0; i < NumThreads; ++i)
+	{
+		threadWorkers.Add(ThreadWorkers[i].Id);
+	}
+
+	return threadWorkers;
+}
+
+
+int nsThreadPool::GetThreadCount() noexcept
+{
+	NS_Assert(bInitialized);
+	return NumThreads;
+}
+
+
+bool nsThreadPool::IsMainThread() noexcept
+{
+	NS_Assert(bInitialized);
+	return nsPlatform::Thread_GetCurrentId() == MainThreadId;
+}
+
+
+
+
+// ============================================================================================================================================ //
+// THREAD TASK GRAPH NODE
+// ============================================================================================================================================ //
+nsThreadTaskGraphNode::nsThreadTaskGraphNode() noexcept
+	: Graph(nullptr)
+	, Task(nullptr)
+	, AffinityMasks(nsEThreadAffinity::Thread_ALL)
+	, DependencyCount(0)
+{
+	bDone.Set(1);
+}
+
+
+void nsThreadTaskGraphNode::Reset() noexcept
+{
+	bDone.Set(0);
+	PendingDependencyCount.Set(DependencyCount);
+}
+
+
+void nsThreadTaskGraphNode::Execute() noexcept
+{
+	NS_Assert(Graph);
+	NS_Assert(Task);
+	NS_Assert(PendingDependencyCount.Get() == 0);
+
+	Task->Execute();
+	bDone.Set(1);
+
+	for (int i = 0; i < Continuations.GetCount(); ++i)
+	{
+		nsThreadTaskGraphNode& continuation = Graph->Nodes[Continuations[i]];
+
+		if (continuation.PendingDependencyCount.Decrement() == 0)
+		{
+			// Pushed to this thread queue, most likely executed next by this thread
+			nsIThreadTask* submitTask = &continuation;
+			nsThreadPool::SubmitTasks(&submitTask, 1, continuation.AffinityMasks, &Graph->Counter);
+		}
+	}
+}
+
+
+bool nsThreadTaskGraphNode::IsIdle() const noexcept
+{
+	return IsDone();
+}
+
+
+bool nsThreadTaskGraphNode::IsRunning() const noexcept
+{
+	return !IsDone();
+}
+
+
+bool nsThreadTaskGraphNode::IsDone() const noexcept
+{
+	return bDone.Get() == 1;
+}
+
+
+#ifdef _DEBUG
+
+nsString nsThreadTaskGraphNode::GetDebugName() const noexcept
+{
+	return nsString::Format(TEXT("nsThreadTaskGraphNode:%s"), Task ? *Task->GetDebugName() : TEXT(""));
+}
+
+#endif // _DEBUG
+
+
+
+
+// ============================================================================================================================================ //
+// THREAD TASK GRAPH
+// ============================================================================================================================================ //
+nsThreadTaskGraph::nsThreadTaskGraph() noexcept
+{
+	Nodes.Reserve(16);
+}
+
+
+int nsThreadTaskGraph::AddTask(nsIThreadTask* task, nsThreadAffinityMasks threadAffinityMasks) noexcept
+{
+	NS_Assert(task);
+	NS_ValidateV(Counter.IsDone(), TEXT("Cannot add task while task graph is running!"));
+
+	const int index = Nodes.GetCount();
+
+	nsThreadTaskGraphNode& node = Nodes.Add();
+	node.Graph = this;
+	node.Task = task;
+	node.AffinityMasks = threadAffinityMasks;
+
+	return index;
+}
+
+
+void nsThreadTaskGraph::AddDependency(int node, int dependency) noexcept
+{
+	NS_ValidateV(Counter.IsDone(), TEXT("Cannot add dependency while task graph is running!"));
+	NS_ValidateV(node >= 0 && node < Nodes.GetCount(), TEXT("Invalid task graph node [%i]!"), node);
+	NS_ValidateV(dependency >= 0 && dependency < Nodes.GetCount(), TEXT("Invalid task graph node [%i]!"), dependency);
+	NS_ValidateV(node != dependency, TEXT("Task graph node [%i] cannot depend on itself!"), node);
+
+	if (Nodes[dependency].Continuations.AddUnique(node))
+	{
+		Nodes[node].DependencyCount++;
+	}
+}
+
+
+void nsThreadTaskGraph::Submit() noexcept
+{
+	NS_ValidateV(Counter.IsDone(), TEXT("Task graph is still running!"));
+
+	const int nodeCount = Nodes.GetCount();
+
+	if (nodeCount == 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		Nodes[i].Reset();
+	}
+
+#ifdef _DEBUG
+	// Validate acyclic (Kahn's algorithm)
+	{
+		nsTArray<int> pendingCounts(nodeCount);
+		nsTArray<int> readyNodes;
+		readyNodes.Reserve(nodeCount);
+
+		for (int i = 0; i < nodeCount; ++i)
+		{
+			pendingCounts[i] = Nodes[i].DependencyCount;
+
+			if (pendingCounts[i] == 0)
+			{
+				readyNodes.Add(i);
+			}
+		}
+
+		for (int r = 0; r < readyNodes.GetCount(); ++r)
+		{
+			const nsTArray<int>& continuations = Nodes[readyNodes[r]].Continuations;
+
+			for (int c = 0; c < continuations.GetCount(); ++c)
+			{
+				if (--pendingCounts[continuations[c]] == 0)
+				{
+					readyNodes.Add(continuations[c]);
+				}
+			}
+		}
+
+		NS_ValidateV(readyNodes.GetCount() == nodeCount, TEXT("Task graph has cyclic dependencies!"));
+	}
+#endif // _DEBUG
+
+	// Keep counter from reaching zero while root tasks are being submitted
+	Counter.Add(1);
+
+	for (int i = 0; i < nodeCount; ++i)
+	{
+		nsThreadTaskGraphNode& node = Nodes[i];
+
+		if (node.DependencyCount == 0)
+		{
+			nsIThreadTask* submitTask = &node;
+			nsThreadPool::SubmitTasks(&submitTask, 1, node.AffinityMasks, &Counter);
+		}
+	}
+
+	Counter.Decrement();
+}
+
+
+void nsThreadTaskGraph::Wait() noexcept
+{
+	nsThreadPool::WaitForCounter(Counter);
+}
+
+
+void nsThreadTaskGraph::Clear() noexcept
+{
+	NS_ValidateV(Counter.IsDone(), TEXT("Cannot clear task graph while it is running!"));
+
+	Nodes.Clear();
+}
+
+
+
+
+// ============================================================================================================================================ //
+// THREAD POOL - PARALLEL FOR
+// ============================================================================================================================================ //
+struct nsParallelForContext
+{
+	nsParallelForFunction Function;
+	void* UserData;
+	nsAtomic NextIndex;
+	int EndIndex;
+	int GrainSize;
+	int ThreadCount;
+};
+
+
+class nsParallelForTask : public nsIThreadTask
+{
+private:
+	nsAtomic bDone;
+
+public:
+	nsParallelForContext* Context;
+
+
+public:
+	nsParallelForTask() noexcept
+		: Context(nullptr)
+	{
+		bDone.Set(1);
+	}
+
+
+	virtual void Reset() noexcept override
+	{
+		bDone.Set(0);
+	}
+
+
+	virtual void Execute() noexcept override
+	{
+		NS_Assert(Context);
+
+		const int endIndex = Context->EndIndex;
+		const int grainSize = Context->GrainSize;
+		const int divisor = Context->ThreadCount * 2;
+
+		while (true)
+		{
+			const int chunkBegin = Context->NextIndex.Get();
+
+			if (chunkBegin >= endIndex)
+			{
+				break;
+			}
+
+			// Take a share of remaining range, but never smaller than grain size
+			int chunkSize = (endIndex - chunkBegin) / divisor;
+
+			if (chunkSize < grainSize)
+			{
+				chunkSize = grainSize;
+			}
+
+			const int chunkEnd = (chunkSize >= endIndex - chunkBegin) ? endIndex : chunkBegin + chunkSize;
+
+			if (Context->NextIndex.CompareExchange(chunkEnd, chunkBegin) == chunkBegin)
+			{
+				Context->Function(chunkBegin, chunkEnd, Context->UserData);
+			}
+		}
+
+		bDone.Set(1);
+	}
+
+
+	virtual bool IsIdle() const noexcept override
+	{
+		return IsDone();
+	}
+
+
+	virtual bool IsRunning() const noexcept override
+	{
+		return !IsDone();
+	}
+
+
+	virtual bool IsDone() const noexcept override
+	{
+		return bDone.Get() == 1;
+	}
+
+};
+
+
+
+void nsThreadPool::ParallelFor(int begin, int end, int grainSize, nsParallelForFunction function, void* userData, int maxThreadCount) noexcept
+{
+	NS_Assert(function);
+
+	const int count = end - begin;
+
+	if (count <= 0)
+	{
+		return;
+	}
+
+	int threadCount = GetThreadCount();
+
+	if (maxThreadCount > 0 && maxThreadCount < threadCount)
+	{
+		threadCount = maxThreadCount;
+	}
+
+	if (grainSize <= 0)
+	{
+		grainSize = count / (threadCount * 8);
+
+		if (grainSize < 1)
+		{
+			grainSize = 1;
+		}
+	}
+
+	if (threadCount <= 1 || count <= grainSize)
+	{
+		function(begin, end, userData);
+		return;
+	}
+
+	// No point to wake more threads than number of chunks
+	const int maxChunkCount = (count + grainSize - 1) / grainSize;
+
+	if (threadCount > maxChunkCount)
+	{
+		threadCount = maxChunkCount;
+	}
+
+	nsParallelForContext context;
+	context.Function = function;
+	context.UserData = userData;
+	context.NextIndex.Set(begin);
+	context.EndIndex = end;
+	context.GrainSize = grainSize;
+	context.ThreadCount = threadCount;
+
+	// One task per thread, each task keeps taking chunks until range is exhausted. Calling thread takes part while waiting
+	nsParallelForTask tasks[NS_THREAD_MAX_COUNT];
+	nsIThreadTask* submitTasks[NS_THREAD_MAX_COUNT];
+
+	for (int i = 0; i < threadCount; ++i)
+	{
+		tasks[i].Context = &context;
+		tasks[i].Reset();
+		submitTasks[i] = &tasks[i];
+	}
+
+	nsThreadTaskCounter counter;
+	SubmitTasks(submitTasks, threadCount, nsEThreadAffinity::Thread_ALL, &counter);
+	WaitForCounter(counter);
+}
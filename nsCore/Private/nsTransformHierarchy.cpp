@@ -0,0 +1,574 @@
+#include "nsTransformHierarchy.h"
+
+
+
+// ============================================================================================================================================ //
+// SOA OPERATIONS
+// ============================================================================================================================================ //
+// Kernels are written once over lane type, float is used when SIMD is disabled
+template<typename TVec> static NS_INLINE TVec ns_SoALoad(const float* data) noexcept;
+template<typename TVec> static NS_INLINE TVec ns_SoASet(float value) noexcept;
+
+template<> NS_INLINE float ns_SoALoad<float>(const float* data) noexcept { return *data; }
+template<> NS_INLINE float ns_SoASet<float>(float value) noexcept { return value; }
+static NS_INLINE void ns_SoAStore(float* data, float value) noexcept { *data = value; }
+static NS_INLINE float ns_SoAAdd(float a, float b) noexcept { return a + b; }
+static NS_INLINE float ns_SoASub(float a, float b) noexcept { return a - b; }
+static NS_INLINE float ns_SoAMul(float a, float b) noexcept { return a * b; }
+static NS_INLINE float ns_SoADiv(float a, float b) noexcept { return a / b; }
+static NS_INLINE float ns_SoAMax(float a, float b) noexcept { return a > b ? a : b; }
+static NS_INLINE float ns_SoASqrt(float a) noexcept { return nsMath::Sqrt(a); }
+static NS_INLINE float ns_SoANegateIfNegative(float value, float sign) noexcept { return sign < 0.0f ? -value : value; }
+
+#if NS_MATH_SIMD
+template<> NS_INLINE __m128 ns_SoALoad<__m128>(const float* data) noexcept { return _mm_loadu_ps(data); }
+template<> NS_INLINE __m128 ns_SoASet<__m128>(float value) noexcept { return _mm_set1_ps(value); }
+static NS_INLINE void ns_SoAStore(float* data, __m128 value) noexcept { _mm_storeu_ps(data, value); }
+static NS_INLINE __m128 ns_SoAAdd(__m128 a, __m128 b) noexcept { return _mm_add_ps(a, b); }
+static NS_INLINE __m128 ns_SoASub(__m128 a, __m128 b) noexcept { return _mm_sub_ps(a, b); }
+static NS_INLINE __m128 ns_SoAMul(__m128 a, __m128 b) noexcept { return _mm_mul_ps(a, b); }
+static NS_INLINE __m128 ns_SoADiv(__m128 a, __m128 b) noexcept { return _mm_div_ps(a, b); }
+static NS_INLINE __m128 ns_SoAMax(__m128 a, __m128 b) noexcept { return _mm_max_ps(a, b); }
+static NS_INLINE __m128 ns_SoASqrt(__m128 a) noexcept { return _mm_sqrt_ps(a); }
+static NS_INLINE __m128 ns_SoANegateIfNegative(__m128 value, __m128 sign) noexcept { return _mm_xor_ps(value, _mm_and_ps(sign, _mm_set1_ps(-0.0f))); }
+
+#ifdef __AVX__
+static NS_INLINE __m256 ns_SoAAdd(__m256 a, __m256 b) noexcept { return _mm256_add_ps(a, b); }
+static NS_INLINE __m256 ns_SoASub(__m256 a, __m256 b) noexcept { return _mm256_sub_ps(a, b); }
+static NS_INLINE __m256 ns_SoAMul(__m256 a, __m256 b) noexcept { return _mm256_mul_ps(a, b); }
+static NS_INLINE __m256 ns_SoADiv(__m256 a, __m256 b) noexcept { return _mm256_div_ps(a, b); }
+#endif // __AVX__
+
+#endif // NS_MATH_SIMD
+
+
+
+// ============================================================================================================================================ //
+// POSE BLENDING
+// ============================================================================================================================================ //
+template<typename TVec>
+struct nsTransformSoALanes
+{
+	TVec Position[3];
+	TVec Rotation[4];
+	TVec Scale[3];
+
+
+	NS_INLINE void Load(const nsTransformSoA& transforms, int index) noexcept
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			Position[c] = ns_SoALoad<TVec>(transforms.GetComponent(static_cast<nsTransformSoA::EComponent>(nsTransformSoA::POSITION_X + c)) + index);
+			Scale[c] = ns_SoALoad<TVec>(transforms.GetComponent(static_cast<nsTransformSoA::EComponent>(nsTransformSoA::SCALE_X + c)) + index);
+		}
+
+		for (int c = 0; c < 4; ++c)
+		{
+			Rotation[c] = ns_SoALoad<TVec>(transforms.GetComponent(static_cast<nsTransformSoA::EComponent>(nsTransformSoA::ROTATION_X + c)) + index);
+		}
+	}
+
+
+	NS_INLINE void Store(nsTransformSoA& transforms, int index) const noexcept
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			ns_SoAStore(transforms.GetComponent(static_cast<nsTransformSoA::EComponent>(nsTransformSoA::POSITION_X + c)) + index, Position[c]);
+			ns_SoAStore(transforms.GetComponent(static_cast<nsTransformSoA::EComponent>(nsTransformSoA::SCALE_X + c)) + index, Scale[c]);
+		}
+
+		for (int c = 0; c < 4; ++c)
+		{
+			ns_SoAStore(transforms.GetComponent(static_cast<nsTransformSoA::EComponent>(nsTransformSoA::ROTATION_X + c)) + index, Rotation[c]);
+		}
+	}
+
+};
+
+
+template<typename TVec>
+static NS_INLINE TVec ns_SoAQuatDot(const TVec* a, const TVec* b) noexcept
+{
+	return ns_SoAAdd(ns_SoAAdd(ns_SoAMul(a[0], b[0]), ns_SoAMul(a[1], b[1])), ns_SoAAdd(ns_SoAMul(a[2], b[2]), ns_SoAMul(a[3], b[3])));
+}
+
+
+template<typename TVec>
+static NS_INLINE void ns_SoAQuatNormalize(TVec* q) noexcept
+{
+	const TVec invLength = ns_SoADiv(ns_SoASet<TVec>(1.0f), ns_SoASqrt(ns_SoAMax(ns_SoAQuatDot(q, q), ns_SoASet<TVec>(1e-12f))));
+
+	for (int c = 0; c < 4; ++c)
+	{
+		q[c] = ns_SoAMul(q[c], invLength);
+	}
+}
+
+
+// Hamilton product a * b, same as nsQuaternion::operator* without normalization
+template<typename TVec>
+static NS_INLINE void ns_SoAQuatMultiply(const TVec* a, const TVec* b, TVec* out) noexcept
+{
+	out[0] = ns_SoAAdd(ns_SoAAdd(ns_SoAMul(a[3], b[0]), ns_SoAMul(a[0], b[3])), ns_SoASub(ns_SoAMul(a[1], b[2]), ns_SoAMul(a[2], b[1])));
+	out[1] = ns_SoAAdd(ns_SoAAdd(ns_SoAMul(a[3], b[1]), ns_SoAMul(a[1], b[3])), ns_SoASub(ns_SoAMul(a[2], b[0]), ns_SoAMul(a[0], b[2])));
+	out[2] = ns_SoAAdd(ns_SoAAdd(ns_SoAMul(a[3], b[2]), ns_SoAMul(a[2], b[3])), ns_SoASub(ns_SoAMul(a[0], b[1]), ns_SoAMul(a[1], b[0])));
+	out[3] = ns_SoASub(ns_SoAMul(a[3], b[3]), ns_SoAAdd(ns_SoAAdd(ns_SoAMul(a[0], b[0]), ns_SoAMul(a[1], b[1])), ns_SoAMul(a[2], b[2])));
+}
+
+
+template<typename TVec>
+static NS_INLINE void ns_TransformBlendPoses(const nsTransformSoA* const* poses, const float* poseWeights, int poseCount, const float* boneWeights, nsTransformSoA& inOutPose, int index) noexcept
+{
+	nsTransformSoALanes<TVec> blended;
+	blended.Load(*poses[0], index);
+
+	// Rotations are summed in hemisphere of first pose, so q and -q do not cancel out
+	const TVec firstWeight = ns_SoASet<TVec>(poseWeights[0]);
+	const TVec hemisphere[4] = { blended.Rotation[0], blended.Rotation[1], blended.Rotation[2], blended.Rotation[3] };
+
+	for (int c = 0; c < 3; ++c)
+	{
+		blended.Position[c] = ns_SoAMul(blended.Position[c], firstWeight);
+		blended.Scale[c] = ns_SoAMul(blended.Scale[c], firstWeight);
+	}
+
+	for (int c = 0; c < 4; ++c)
+	{
+		blended.Rotation[c] = ns_SoAMul(blended.Rotation[c], firstWeight);
+	}
+
+	for (int i = 1; i < poseCount; ++i)
+	{
+		nsTransformSoALanes<TVec> pose;
+		pose.Load(*poses[i], index);
+
+		const TVec weight = ns_SoASet<TVec>(poseWeights[i]);
+		const TVec dot = ns_SoAQuatDot(hemisphere, pose.Rotation);
+
+		for (int c = 0; c < 3; ++c)
+		{
+			blended.Position[c] = ns_SoAAdd(blended.Position[c], ns_SoAMul(pose.Position[c], weight));
+			blended.Scale[c] = ns_SoAAdd(blended.Scale[c], ns_SoAMul(pose.Scale[c], weight));
+		}
+
+		for (int c = 0; c < 4; ++c)
+		{
+			blended.Rotation[c] = ns_SoAAdd(blended.Rotation[c], ns_SoAMul(ns_SoANegateIfNegative(pose.Rotation[c], dot), weight));
+		}
+	}
+
+	if (boneWeights)
+	{
+		ns_SoAQuatNormalize(blended.Rotation);
+
+		nsTransformSoALanes<TVec> base;
+		base.Load(inOutPose, index);
+
+		const TVec boneWeight = ns_SoALoad<TVec>(boneWeights + index);
+		const TVec dot = ns_SoAQuatDot(base.Rotation, blended.Rotation);
+
+		for (int c = 0; c < 3; ++c)
+		{
+			blended.Position[c] = ns_SoAAdd(base.Position[c], ns_SoAMul(ns_SoASub(blended.Position[c], base.Position[c]), boneWeight));
+			blended.Scale[c] = ns_SoAAdd(base.Scale[c], ns_SoAMul(ns_SoASub(blended.Scale[c], base.Scale[c]), boneWeight));
+		}
+
+		for (int c = 0; c < 4; ++c)
+		{
+			blended.Rotation[c] = ns_SoAAdd(base.Rotation[c], ns_SoAMul(ns_SoASub(ns_SoANegateIfNegative(blended.Rotation[c], dot), base.Rotation[c]), boneWeight));
+		}
+	}
+
+	ns_SoAQuatNormalize(blended.Rotation);
+	blended.Store(inOutPose, index);
+}
+
+
+template<typename TVec>
+static NS_INLINE void ns_TransformAddPoses(const nsTransformSoA* const* poses, const nsTransformSoA* const* referencePoses, const float* poseWeights, int poseCount, const float* boneWeights, nsTransformSoA& inOutPose, int index) noexcept
+{
+	const TVec zero = ns_SoASet<TVec>(0.0f);
+	const TVec one = ns_SoASet<TVec>(1.0f);
+	nsTransformSoALanes<TVec> delta;
+
+	for (int c = 0; c < 3; ++c)
+	{
+		delta.Position[c] = zero;
+		delta.Scale[c] = zero;
+	}
+
+	for (int c = 0; c < 4; ++c)
+	{
+		delta.Rotation[c] = zero;
+	}
+
+	for (int i = 0; i < poseCount; ++i)
+	{
+		nsTransformSoALanes<TVec> pose;
+		pose.Load(*poses[i], index);
+
+		nsTransformSoALanes<TVec> reference;
+		reference.Load(*referencePoses[i], index);
+
+		const TVec weight = ns_SoASet<TVec>(poseWeights[i]);
+
+		for (int c = 0; c < 3; ++c)
+		{
+			delta.Position[c] = ns_SoAAdd(delta.Position[c], ns_SoAMul(ns_SoASub(pose.Position[c], reference.Position[c]), weight));
+			delta.Scale[c] = ns_SoAAdd(delta.Scale[c], ns_SoAMul(ns_SoADiv(pose.Scale[c], reference.Scale[c]), weight));
+		}
+
+		// conjugate(reference) * rotation, summed in hemisphere of identity
+		reference.Rotation[0] = ns_SoASub(zero, reference.Rotation[0]);
+		reference.Rotation[1] = ns_SoASub(zero, reference.Rotation[1]);
+		reference.Rotation[2] = ns_SoASub(zero, reference.Rotation[2]);
+
+		TVec rotation[4];
+		ns_SoAQuatMultiply(reference.Rotation, pose.Rotation, rotation);
+
+		for (int c = 0; c < 4; ++c)
+		{
+			delta.Rotation[c] = ns_SoAAdd(delta.Rotation[c], ns_SoAMul(ns_SoANegateIfNegative(rotation[c], rotation[3]), weight));
+		}
+	}
+
+	nsTransformSoALanes<TVec> base;
+	base.Load(inOutPose, index);
+
+	// Scale delta towards identity by bone weight
+	const TVec boneWeight = boneWeights ? ns_SoALoad<TVec>(boneWeights + index) : one;
+
+	for (int c = 0; c < 3; ++c)
+	{
+		base.Position[c] = ns_SoAAdd(base.Position[c], ns_SoAMul(delta.Position[c], boneWeight));
+		base.Scale[c] = ns_SoAMul(base.Scale[c], ns_SoAAdd(one, ns_SoAMul(ns_SoASub(delta.Scale[c], one), boneWeight)));
+	}
+
+	delta.Rotation[0] = ns_SoAMul(delta.Rotation[0], boneWeight);
+	delta.Rotation[1] = ns_SoAMul(delta.Rotation[1], boneWeight);
+	delta.Rotation[2] = ns_SoAMul(delta.Rotation[2], boneWeight);
+	delta.Rotation[3] = ns_SoAAdd(one, ns_SoAMul(ns_SoASub(delta.Rotation[3], one), boneWeight));
+	ns_SoAQuatNormalize(delta.Rotation);
+
+	TVec rotation[4];
+	ns_SoAQuatMultiply(base.Rotation, delta.Rotation, rotation);
+	ns_SoAQuatNormalize(rotation);
+
+	for (int c = 0; c < 4; ++c)
+	{
+		base.Rotation[c] = rotation[c];
+	}
+
+	base.Store(inOutPose, index);
+}
+
+
+void nsTransformHierarchy::BlendPoses(const nsTransformSoA* const* poses, const float* poseWeights, int poseCount, const float* boneWeights, nsTransformSoA& inOutPose) noexcept
+{
+	NS_Assert(poseCount > 0);
+	const int count = inOutPose.GetPaddedCount();
+
+	for (int i = 0; i < poseCount; ++i)
+	{
+		NS_Assert(poses[i]->GetPaddedCount() == count);
+	}
+
+#if NS_MATH_SIMD
+	for (int i = 0; i < count; i += 4)
+	{
+		ns_TransformBlendPoses<__m128>(poses, poseWeights, poseCount, boneWeights, inOutPose, i);
+	}
+#else
+	for (int i = 0; i < count; ++i)
+	{
+		ns_TransformBlendPoses<float>(poses, poseWeights, poseCount, boneWeights, inOutPose, i);
+	}
+#endif // NS_MATH_SIMD
+}
+
+
+void nsTransformHierarchy::AddPoses(const nsTransformSoA* const* poses, const nsTransformSoA* const* referencePoses, const float* poseWeights, int poseCount, const float* boneWeights, nsTransformSoA& inOutPose) noexcept
+{
+	const int count = inOutPose.GetPaddedCount();
+
+	for (int i = 0; i < poseCount; ++i)
+	{
+		NS_Assert(poses[i]->GetPaddedCount() == count && referencePoses[i]->GetPaddedCount() == count);
+	}
+
+#if NS_MATH_SIMD
+	for (int i = 0; i < count; i += 4)
+	{
+		ns_TransformAddPoses<__m128>(poses, referencePoses, poseWeights, poseCount, boneWeights, inOutPose, i);
+	}
+#else
+	for (int i = 0; i < count; ++i)
+	{
+		ns_TransformAddPoses<float>(poses, referencePoses, poseWeights, poseCount, boneWeights, inOutPose, i);
+	}
+#endif // NS_MATH_SIMD
+}
+
+
+
+// ============================================================================================================================================ //
+// HIERARCHY
+// ============================================================================================================================================ //
+bool nsTransformHierarchy::SortParentFirst(const int* parentIds, int count, int* outOrder) noexcept
+{
+	// Position of each transform in sorted order, -1 if not sorted yet
+	nsTArray<int> positions;
+	positions.ResizeConstructs(count, -1);
+
+	int sortedCount = 0;
+
+	while (sortedCount < count)
+	{
+		const int prevSortedCount = sortedCount;
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (positions[i] != -1)
+			{
+				continue;
+			}
+
+			const int parentId = parentIds[i];
+
+			if (parentId < -1 || parentId >= count || parentId == i)
+			{
+				return false;
+			}
+
+			if (parentId == -1 || positions[parentId] != -1)
+			{
+				positions[i] = sortedCount;
+				outOrder[sortedCount++] = i;
+			}
+		}
+
+		if (sortedCount == prevSortedCount)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+#if NS_MATH_SIMD
+
+// Upper 3x3 of local matrix (Scale * Rotation) for each lane. Quaternion is normalized through s = 2 / |q|^2
+template<typename TVec>
+static NS_INLINE void ns_TransformHierarchyLocalAxes(TVec qx, TVec qy, TVec qz, TVec qw, TVec sx, TVec sy, TVec sz, TVec one, TVec two, TVec outAxes[3][3]) noexcept
+{
+	const TVec lengthSq = ns_SoAAdd(ns_SoAAdd(ns_SoAMul(qx, qx), ns_SoAMul(qy, qy)), ns_SoAAdd(ns_SoAMul(qz, qz), ns_SoAMul(qw, qw)));
+	const TVec s = ns_SoADiv(two, lengthSq);
+	const TVec xs = ns_SoAMul(qx, s);
+	const TVec ys = ns_SoAMul(qy, s);
+	const TVec zs = ns_SoAMul(qz, s);
+	const TVec xx = ns_SoAMul(qx, xs);
+	const TVec xy = ns_SoAMul(qx, ys);
+	const TVec xz = ns_SoAMul(qx, zs);
+	const TVec xw = ns_SoAMul(qw, xs);
+	const TVec yy = ns_SoAMul(qy, ys);
+	const TVec yz = ns_SoAMul(qy, zs);
+	const TVec yw = ns_SoAMul(qw, ys);
+	const TVec zz = ns_SoAMul(qz, zs);
+	const TVec zw = ns_SoAMul(qw, zs);
+
+	outAxes[0][0] = ns_SoAMul(ns_SoASub(one, ns_SoAAdd(yy, zz)), sx);
+	outAxes[0][1] = ns_SoAMul(ns_SoAAdd(xy, zw), sx);
+	outAxes[0][2] = ns_SoAMul(ns_SoASub(xz, yw), sx);
+
+	outAxes[1][0] = ns_SoAMul(ns_SoASub(xy, zw), sy);
+	outAxes[1][1] = ns_SoAMul(ns_SoASub(one, ns_SoAAdd(xx, zz)), sy);
+	outAxes[1][2] = ns_SoAMul(ns_SoAAdd(yz, xw), sy);
+
+	outAxes[2][0] = ns_SoAMul(ns_SoAAdd(xz, yw), sz);
+	outAxes[2][1] = ns_SoAMul(ns_SoASub(yz, xw), sz);
+	outAxes[2][2] = ns_SoAMul(ns_SoASub(one, ns_SoAAdd(xx, yy)), sz);
+}
+
+
+// Build local matrices of NS_TRANSFORM_SOA_WIDTH transforms starting at <index>, outRows[n] are matrix rows of n-th transform
+static NS_INLINE void ns_TransformHierarchyBuildLocals(const nsTransformSoA& transforms, int index, __m128 outRows[NS_TRANSFORM_SOA_WIDTH][4]) noexcept
+{
+#ifdef __AVX__
+	const __m256 one = _mm256_set1_ps(1.0f);
+	__m256 axes[3][3];
+	ns_TransformHierarchyLocalAxes(
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_X) + index),
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_Y) + index),
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_Z) + index),
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_W) + index),
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::SCALE_X) + index),
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::SCALE_Y) + index),
+		_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::SCALE_Z) + index),
+		one, _mm256_set1_ps(2.0f), axes
+	);
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 columns[4][4] =
+	{
+		{ axes[0][0], axes[0][1], axes[0][2], zero },
+		{ axes[1][0], axes[1][1], axes[1][2], zero },
+		{ axes[2][0], axes[2][1], axes[2][2], zero },
+		{
+			_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::POSITION_X) + index),
+			_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::POSITION_Y) + index),
+			_mm256_loadu_ps(transforms.GetComponent(nsTransformSoA::POSITION_Z) + index),
+			one
+		},
+	};
+
+	for (int r = 0; r < 4; ++r)
+	{
+		// 4x4 transpose within each 128-bit lane, low lane holds transforms [0, 3], high lane [4, 7]
+		const __m256 t0 = _mm256_unpacklo_ps(columns[r][0], columns[r][1]);
+		const __m256 t1 = _mm256_unpackhi_ps(columns[r][0], columns[r][1]);
+		const __m256 t2 = _mm256_unpacklo_ps(columns[r][2], columns[r][3]);
+		const __m256 t3 = _mm256_unpackhi_ps(columns[r][2], columns[r][3]);
+		const __m256 rows[4] =
+		{
+			_mm256_shuffle_ps(t0, t2, MakeShuffleMask(0, 1, 0, 1)),
+			_mm256_shuffle_ps(t0, t2, MakeShuffleMask(2, 3, 2, 3)),
+			_mm256_shuffle_ps(t1, t3, MakeShuffleMask(0, 1, 0, 1)),
+			_mm256_shuffle_ps(t1, t3, MakeShuffleMask(2, 3, 2, 3)),
+		};
+
+		for (int n = 0; n < 4; ++n)
+		{
+			outRows[n][r] = _mm256_castps256_ps128(rows[n]);
+			outRows[n + 4][r] = _mm256_extractf128_ps(rows[n], 1);
+		}
+	}
+
+#else
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 axes[3][3];
+	ns_TransformHierarchyLocalAxes(
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_X) + index),
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_Y) + index),
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_Z) + index),
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::ROTATION_W) + index),
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::SCALE_X) + index),
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::SCALE_Y) + index),
+		_mm_loadu_ps(transforms.GetComponent(nsTransformSoA::SCALE_Z) + index),
+		one, _mm_set1_ps(2.0f), axes
+	);
+
+	const __m128 zero = _mm_setzero_ps();
+
+	for (int r = 0; r < 3; ++r)
+	{
+		__m128 row0 = axes[r][0];
+		__m128 row1 = axes[r][1];
+		__m128 row2 = axes[r][2];
+		__m128 row3 = zero;
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		outRows[0][r] = row0;
+		outRows[1][r] = row1;
+		outRows[2][r] = row2;
+		outRows[3][r] = row3;
+	}
+
+	__m128 row0 = _mm_loadu_ps(transforms.GetComponent(nsTransformSoA::POSITION_X) + index);
+	__m128 row1 = _mm_loadu_ps(transforms.GetComponent(nsTransformSoA::POSITION_Y) + index);
+	__m128 row2 = _mm_loadu_ps(transforms.GetComponent(nsTransformSoA::POSITION_Z) + index);
+	__m128 row3 = one;
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+	outRows[0][3] = row0;
+	outRows[1][3] = row1;
+	outRows[2][3] = row2;
+	outRows[3][3] = row3;
+
+#endif // __AVX__
+}
+
+
+// row * m, where row has W = 0
+static NS_INLINE __m128 ns_TransformHierarchyMultiplyRow3(__m128 row, const __m128* m) noexcept
+{
+	__m128 result = _mm_mul_ps(VecSwizzle1(row, 0), m[0]);
+	result = _mm_add_ps(result, _mm_mul_ps(VecSwizzle1(row, 1), m[1]));
+	result = _mm_add_ps(result, _mm_mul_ps(VecSwizzle1(row, 2), m[2]));
+
+	return result;
+}
+
+
+// row * m
+static NS_INLINE __m128 ns_TransformHierarchyMultiplyRow4(__m128 row, const __m128* m) noexcept
+{
+	return _mm_add_ps(ns_TransformHierarchyMultiplyRow3(row, m), _mm_mul_ps(VecSwizzle1(row, 3), m[3]));
+}
+
+
+void nsTransformHierarchy::ComputeMatrices(const nsTransformSoA& localTransforms, const int* parentIds, const nsMatrix4* inverseBindPoses, const int* skinIds, nsMatrix4* outModelMatrices, nsMatrix4* outSkinMatrices) noexcept
+{
+	const int count = localTransforms.GetCount();
+	__m128 localRows[NS_TRANSFORM_SOA_WIDTH][4];
+
+	for (int i = 0; i < count; i += NS_TRANSFORM_SOA_WIDTH)
+	{
+		ns_TransformHierarchyBuildLocals(localTransforms, i, localRows);
+
+		const int blockCount = nsMath::Min(NS_TRANSFORM_SOA_WIDTH, count - i);
+
+		for (int n = 0; n < blockCount; ++n)
+		{
+			const int index = i + n;
+			const int parentId = parentIds[index];
+			NS_Assert(parentId < index);
+
+			const __m128* local = localRows[n];
+			__m128* model = outModelMatrices[index].Xmms;
+
+			// Local rows 0-2 have W = 0, translation row has W = 1
+			if (parentId == -1)
+			{
+				model[0] = local[0];
+				model[1] = local[1];
+				model[2] = local[2];
+				model[3] = local[3];
+			}
+			else
+			{
+				const __m128* parent = outModelMatrices[parentId].Xmms;
+				model[0] = ns_TransformHierarchyMultiplyRow3(local[0], parent);
+				model[1] = ns_TransformHierarchyMultiplyRow3(local[1], parent);
+				model[2] = ns_TransformHierarchyMultiplyRow3(local[2], parent);
+				model[3] = _mm_add_ps(ns_TransformHierarchyMultiplyRow3(local[3], parent), parent[3]);
+			}
+
+			const __m128* inverseBindPose = inverseBindPoses[index].Xmms;
+			__m128* skin = outSkinMatrices[skinIds[index]].Xmms;
+			skin[0] = ns_TransformHierarchyMultiplyRow4(inverseBindPose[0], model);
+			skin[1] = ns_TransformHierarchyMultiplyRow4(inverseBindPose[1], model);
+			skin[2] = ns_TransformHierarchyMultiplyRow4(inverseBindPose[2], model);
+			skin[3] = ns_TransformHierarchyMultiplyRow4(inverseBindPose[3], model);
+		}
+	}
+}
+
+#else
+
+void nsTransformHierarchy::ComputeMatrices(const nsTransformSoA& localTransforms, const int* parentIds, const nsMatrix4* inverseBindPoses, const int* skinIds, nsMatrix4* outModelMatrices, nsMatrix4* outSkinMatrices) noexcept
+{
+	const int count = localTransforms.GetCount();
+
+	for (int i = 0; i < count; ++i)
+	{
+		const int parentId = parentIds[i];
+		NS_Assert(parentId < i);
+
+		const nsMatrix4 local = localTransforms.Get(i).ToMatrix();
+		outModelMatrices[i] = parentId == -1 ? local : local * outModelMatrices[parentId];
+		outSkinMatrices[skinIds[i]] = inverseBindPoses[i] * outModelMatrices[i];
+	}
+}
+
+#endif // NS_MATH_SIMD
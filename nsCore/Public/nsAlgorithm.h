@@ -1,6 +1,8 @@
 #pragma once
 
 #include "nsPlatform.h"
+#include <utility>
+#include <type_traits>
 
 
 
@@ -9,76 +11,366 @@ namespace nsAlgorithm
 	template<typename T>
 	static NS_INLINE void Swap(T& first, T& second) noexcept
 	{
-		T temp = first;
-		first = second;
-		second = temp;
+		T temp = std::move(first);
+		first = std::move(second);
+		second = std::move(temp);
 	}
 
 
-	template<typename T>
-	static NS_INLINE void Sort_Swap(T* data, int first, int second) noexcept
+
+	// ================================================================================================================================== //
+	// INTROSORT
+	// ================================================================================================================================== //
+	// Ranges smaller than this are finished with insertion sort
+	constexpr int SORT_INSERTION_THRESHOLD = 16;
+
+
+	template<typename T, typename TPredicate>
+	static NS_INLINE void Sort_Insertion(T* data, int first, int last, TPredicate& predicate) noexcept
 	{
-		if (first == second)
+		for (int i = first + 1; i < last; ++i)
 		{
-			return;
+			if (!predicate(data[i], data[i - 1]))
+			{
+				continue;
+			}
+
+			T value = std::move(data[i]);
+			int j = i;
+
+			do
+			{
+				data[j] = std::move(data[j - 1]);
+				--j;
+			}
+			while (j > first && predicate(value, data[j - 1]));
+
+			data[j] = std::move(value);
+		}
+	}
+
+
+	template<typename T, typename TPredicate>
+	static NS_INLINE void Sort_HeapSiftDown(T* data, int first, int root, int count, TPredicate& predicate) noexcept
+	{
+		T value = std::move(data[first + root]);
+
+		while (true)
+		{
+			int child = root * 2 + 1;
+
+			if (child >= count)
+			{
+				break;
+			}
+
+			if (child + 1 < count && predicate(data[first + child], data[first + child + 1]))
+			{
+				++child;
+			}
+
+			if (!predicate(value, data[first + child]))
+			{
+				break;
+			}
+
+			data[first + root] = std::move(data[first + child]);
+			root = child;
 		}
 
-		Swap(data[first], data[second]);
+		data[first + root] = std::move(value);
 	}
 
 
 	template<typename T, typename TPredicate>
-	static NS_INLINE int Sort_Partition(T* data, int count, int left, int right, TPredicate predicate) noexcept
+	static NS_INLINE void Sort_Heap(T* data, int first, int last, TPredicate& predicate) noexcept
 	{
-		NS_ValidateV(left >= 0 && left < count, TEXT("Out of range!"));
-		NS_ValidateV(right >= 0 && right < count, TEXT("Out of range!"));
-		NS_Validate(left < right);
+		const int count = last - first;
 
-		const T pivot = data[right];
-		int i = left;
+		for (int i = count / 2 - 1; i >= 0; --i)
+		{
+			Sort_HeapSiftDown(data, first, i, count, predicate);
+		}
 
-		for (int j = left; j < right; ++j)
+		for (int i = count - 1; i > 0; --i)
 		{
-			if (predicate(data[j], pivot))
+			Swap(data[first], data[first + i]);
+			Sort_HeapSiftDown(data, first, 0, i, predicate);
+		}
+	}
+
+
+	// Move median of (first + 1, mid, last - 1) into first as pivot, last - 1 becomes sentinel for partition
+	template<typename T, typename TPredicate>
+	static NS_INLINE void Sort_MedianOfThree(T* data, int first, int last, TPredicate& predicate) noexcept
+	{
+		const int a = first + 1;
+		const int b = first + (last - first) / 2;
+		const int c = last - 1;
+
+		if (predicate(data[b], data[a]))
+		{
+			Swap(data[a], data[b]);
+		}
+
+		if (predicate(data[c], data[b]))
+		{
+			Swap(data[b], data[c]);
+
+			if (predicate(data[b], data[a]))
+			{
+				Swap(data[a], data[b]);
+			}
+		}
+
+		Swap(data[first], data[b]);
+	}
+
+
+	// Hoare partition around data[first], returns final pivot index
+	template<typename T, typename TPredicate>
+	static NS_INLINE int Sort_Partition(T* data, int first, int last, TPredicate& predicate) noexcept
+	{
+		Sort_MedianOfThree(data, first, last, predicate);
+
+		int i = first;
+		int j = last;
+
+		while (true)
+		{
+			do
 			{
-				Sort_Swap(data, i, j);
 				++i;
 			}
+			while (predicate(data[i], data[first]));
+
+			do
+			{
+				--j;
+			}
+			while (predicate(data[first], data[j]));
+
+			if (i >= j)
+			{
+				break;
+			}
+
+			Swap(data[i], data[j]);
 		}
 
-		Sort_Swap(data, i, right);
+		if (j != first)
+		{
+			Swap(data[first], data[j]);
+		}
 
-		return i;
+		return j;
 	}
 
 
 	template<typename T, typename TPredicate>
-	static NS_INLINE void Sort_Internal(T* data, int count, int left, int right, TPredicate predicate) noexcept
+	static NS_INLINE void Sort_Intro(T* data, int first, int last, int depthLimit, TPredicate& predicate) noexcept
 	{
-		if (left < right)
+		while (last - first > SORT_INSERTION_THRESHOLD)
 		{
-			int p = Sort_Partition(data, count, left, right, predicate);
-			Sort_Internal(data, count, left, p - 1, predicate);
-			Sort_Internal(data, count, p + 1, right, predicate);
+			if (depthLimit == 0)
+			{
+				Sort_Heap(data, first, last, predicate);
+				return;
+			}
+
+			--depthLimit;
+			const int p = Sort_Partition(data, first, last, predicate);
+
+			// Recurse into smaller side, loop on larger side to keep stack depth O(log n)
+			if (p - first < last - p)
+			{
+				Sort_Intro(data, first, p, depthLimit, predicate);
+				first = p + 1;
+			}
+			else
+			{
+				Sort_Intro(data, p + 1, last, depthLimit, predicate);
+				last = p;
+			}
 		}
 	}
 
 
+	// Unstable sort, predicate(a, b) returns true if a must be ordered before b
 	template<typename T, typename TPredicate>
 	static NS_INLINE void Sort(T* data, int count, TPredicate predicate) noexcept
 	{
-		if (count == 0 || count == 1)
+		NS_Assert(count >= 0);
+
+		if (count < 2)
 		{
 			return;
 		}
 
-		if (count == 2)
+		int depthLimit = 0;
+
+		for (int n = count; n > 1; n >>= 1)
+		{
+			depthLimit += 2;
+		}
+
+		Sort_Intro(data, 0, count, depthLimit, predicate);
+		Sort_Insertion(data, 0, count, predicate);
+	}
+
+
+
+	// ================================================================================================================================== //
+	// RADIX SORT
+	// ================================================================================================================================== //
+	// Stable LSD radix sort by unsigned 32/64-bit key, getKey(element) returns the key.
+	// Scratch must have room for count elements, passes where every key has the same digit are skipped.
+	template<typename T, typename TGetKey>
+	static NS_INLINE void SortRadix(T* data, int count, T* scratch, TGetKey getKey) noexcept
+	{
+		typedef typename std::decay<decltype(getKey(data[0]))>::type TKey;
+		static_assert(std::is_unsigned<TKey>::value && (sizeof(TKey) == 4 || sizeof(TKey) == 8), "Radix sort key must be uint32 or uint64!");
+
+		constexpr int PASS_COUNT = static_cast<int>(sizeof(TKey));
+
+		NS_Assert(count >= 0);
+
+		if (count < 2)
 		{
-			predicate(data[0], data[1]);
 			return;
 		}
 
-		Sort_Internal(data, count, 0, count - 1, predicate);
+		NS_Assert(scratch);
+
+		int histograms[PASS_COUNT][256] = {};
+
+		for (int i = 0; i < count; ++i)
+		{
+			const TKey key = getKey(data[i]);
+
+			for (int p = 0; p < PASS_COUNT; ++p)
+			{
+				histograms[p][(key >> (p * 8)) & 0xFF]++;
+			}
+		}
+
+		const TKey firstKey = getKey(data[0]);
+		T* src = data;
+		T* dst = scratch;
+
+		for (int p = 0; p < PASS_COUNT; ++p)
+		{
+			int* histogram = histograms[p];
+			const int shift = p * 8;
+
+			if (histogram[(firstKey >> shift) & 0xFF] == count)
+			{
+				continue;
+			}
+
+			int offset = 0;
+
+			for (int d = 0; d < 256; ++d)
+			{
+				const int digitCount = histogram[d];
+				histogram[d] = offset;
+				offset += digitCount;
+			}
+
+			for (int i = 0; i < count; ++i)
+			{
+				dst[histogram[(getKey(src[i]) >> shift) & 0xFF]++] = std::move(src[i]);
+			}
+
+			T* temp = src;
+			src = dst;
+			dst = temp;
+		}
+
+		if (src != data)
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				data[i] = std::move(src[i]);
+			}
+		}
+	}
+
+
+
+	// ================================================================================================================================== //
+	// SORTED SEARCH
+	// ================================================================================================================================== //
+	// Binary search in data sorted by getKey(element), returns index of first element with key greater than <value> (count if none)
+	template<typename T, typename TValue, typename TGetKey>
+	static NS_INLINE int UpperBound(const T* data, int count, const TValue& value, TGetKey getKey) noexcept
+	{
+		NS_Assert(count >= 0);
+
+		int first = 0;
+
+		while (count > 0)
+		{
+			const int half = count / 2;
+
+			if (value < getKey(data[first + half]))
+			{
+				count = half;
+			}
+			else
+			{
+				first += half + 1;
+				count -= half + 1;
+			}
+		}
+
+		return first;
+	}
+
+
+	// Keys checked linearly from cursor before FindInterval falls back to binary search
+	constexpr int FIND_INTERVAL_CURSOR_STEP = 4;
+
+
+	// Find interval index i in data sorted by getKey(element) where key[i] <= value < key[i + 1], result is clamped to [0, count - 2].
+	// <cursor> is interval returned by previous call and is updated with result. Search starts from cursor when value moves forward,
+	// binary search is used when value moves backward (seek, loop) or too far ahead.
+	template<typename T, typename TValue, typename TGetKey>
+	static NS_INLINE int FindInterval(const T* data, int count, const TValue& value, int& cursor, TGetKey getKey) noexcept
+	{
+		NS_Assert(count >= 2);
+
+		const int last = count - 2;
+		int index = cursor;
+
+		if (index >= 0 && index <= last && !(value < getKey(data[index])))
+		{
+			for (int step = 0; step < FIND_INTERVAL_CURSOR_STEP; ++step)
+			{
+				if (index == last || value < getKey(data[index + 1]))
+				{
+					cursor = index;
+					return index;
+				}
+
+				++index;
+			}
+		}
+
+		index = UpperBound(data, count, value, getKey) - 1;
+
+		if (index < 0)
+		{
+			index = 0;
+		}
+		else if (index > last)
+		{
+			index = last;
+		}
+
+		cursor = index;
+
+		return index;
 	}
 
 };
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "nsThreadPool.h"
+#include "nsAlgorithm.h"
+
+
+
+// Queued -> Reading (IO thread) -> ReadDone -> Decoding (worker thread) -> Decoded/Failed. Read failure goes to Failed directly
+enum nsEAsyncLoadState : int
+{
+	AsyncLoadState_Queued = 0,
+	AsyncLoadState_Reading,
+	AsyncLoadState_ReadDone,
+	AsyncLoadState_Decoding,
+	AsyncLoadState_Decoded,
+	AsyncLoadState_Failed,
+};
+
+
+
+class NS_CORE_API nsAsyncLoadRequest
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsAsyncLoadRequest)
+
+private:
+	class DecodeTask : public nsIThreadTask
+	{
+	private:
+		nsAtomic bDone;
+
+	public:
+		nsAsyncLoadRequest* Request;
+
+
+	public:
+		DecodeTask() noexcept
+			: Request(nullptr)
+		{
+		}
+
+
+		virtual void Reset() noexcept override
+		{
+			bDone.Set(0);
+		}
+
+
+		virtual void Execute() noexcept override
+		{
+			Request->State.Set(Request->Decode() ? AsyncLoadState_Decoded : AsyncLoadState_Failed);
+			bDone.Set(1);
+		}
+
+
+		virtual bool IsIdle() const noexcept override
+		{
+			return IsDone();
+		}
+
+
+		virtual bool IsRunning() const noexcept override
+		{
+			return !IsDone();
+		}
+
+
+		virtual bool IsDone() const noexcept override
+		{
+			return bDone.Get() == 1;
+		}
+
+	};
+
+	DecodeTask Task;
+	nsThreadTaskCounter DecodeCounter;
+
+public:
+	// Higher priority is read and finalized first, same priority in submit order. [Shared with IO thread] Use nsAsyncLoadQueue::SetPriority once submitted
+	int Priority;
+	uint64 Sequence;
+	nsAtomic State;
+
+
+public:
+	nsAsyncLoadRequest() noexcept
+		: Priority(0)
+		, Sequence(0)
+	{
+		Task.Request = this;
+	}
+
+	virtual ~nsAsyncLoadRequest() noexcept {}
+
+	// [IO thread] Read file data. Returns false if failed
+	virtual bool Read() noexcept = 0;
+
+	// [Worker thread] Decode data from Read(), only touches data owned by this request. Returns false if failed
+	virtual bool Decode() noexcept = 0;
+
+
+	NS_NODISCARD_INLINE int GetState() const noexcept
+	{
+		return State.Get();
+	}
+
+
+	// Not used by worker thread
+	NS_NODISCARD_INLINE bool IsDecodeDone() const noexcept
+	{
+		return DecodeCounter.IsDone();
+	}
+
+
+	// Block until decode task is done, calling thread may execute tasks while waiting
+	NS_INLINE void WaitDecode() noexcept
+	{
+		nsThreadPool::WaitForCounter(DecodeCounter);
+	}
+
+
+	friend class nsAsyncLoadQueue;
+
+};
+
+
+
+// Requests are read one at a time on dedicated IO thread, decoded on worker threads and finalized by owner thread.
+// Owner thread keeps ownership of requests, queue only references them until read started.
+class NS_CORE_API nsAsyncLoadQueue
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsAsyncLoadQueue)
+
+private:
+	nsPlatformThreadHandle IoThread;
+	nsSemaphore IoSemaphore;
+	nsAtomic bIoThreadRunning;
+
+	// [Shared with IO thread] Requests waiting for file read, protected by IoQueueCS
+	nsCriticalSection IoQueueCS;
+	nsTArray<nsAsyncLoadRequest*> IoQueue;
+	uint64 Sequence;
+
+
+public:
+	nsAsyncLoadQueue() noexcept;
+	void Initialize() noexcept;
+
+	// Stop IO thread. Requests in queue are removed and stay queued, requests being decoded must be waited by owner
+	void Shutdown() noexcept;
+
+	// Assign submit order and priority to request. Request is read later by Wait() on calling thread
+	void Prepare(nsAsyncLoadRequest* request, int priority) noexcept;
+
+	// Prepare request and add it to IO queue
+	void Submit(nsAsyncLoadRequest* request, int priority) noexcept;
+
+	// Raise priority of request that is waiting for read
+	void SetPriority(nsAsyncLoadRequest* request, int priority) noexcept;
+
+	// Remove request from IO queue. Returns true if request can be destroyed now (not used by IO thread or worker thread)
+	NS_NODISCARD bool Cancel(nsAsyncLoadRequest* request) noexcept;
+
+	// Finish read/decode of request on calling thread, waits if request is being read or decoded. Request state is Decoded or Failed after this call
+	void Wait(nsAsyncLoadRequest* request) noexcept;
+
+	// Submit decode task if request has been read. Returns true if submitted
+	bool SubmitDecode(nsAsyncLoadRequest* request, nsThreadAffinityMasks affinityMasks) noexcept;
+
+private:
+	static void IoThreadFunction(void* userData) noexcept;
+
+
+public:
+	// Sort decoded requests (by priority, then submit order) and call finalize(request) until <budgetMs> is spent. At least one request is finalized.
+	// Returns number of finalized requests
+	template<typename TRequest, typename TFinalize>
+	static int FinalizeRequests(TRequest** requests, int count, float budgetMs, TFinalize finalize) noexcept
+	{
+		nsAlgorithm::Sort(requests, count, [](const TRequest* a, const TRequest* b)
+		{
+			return a->Priority > b->Priority || (a->Priority == b->Priority && a->Sequence < b->Sequence);
+		});
+
+		const int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+		const int64 budgetCounter = static_cast<int64>(static_cast<double>(budgetMs) * 0.001 * static_cast<double>(nsPlatform::PerformanceQuery_Frequency()));
+		int finalizedCount = 0;
+
+		for (int i = 0; i < count; ++i)
+		{
+			if (i > 0 && nsPlatform::PerformanceQuery_Counter() - startCounter >= budgetCounter)
+			{
+				break;
+			}
+
+			finalize(requests[i]);
+			++finalizedCount;
+		}
+
+		return finalizedCount;
+	}
+
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "nsString.h"
+
+
+
+enum class nsECompression : uint8
+{
+	NONE = 0,
+
+	// LZ4 block format, single hash probe per position. Fast compress, very fast decompress
+	LZ4,
+
+	// LZ4 block format, hash chain match search. Slower compress with better ratio, same decompress speed as LZ4
+	LZ4_HIGH,
+};
+
+
+// Data is compressed in independent blocks of this size, so blocks can be compressed/decompressed in parallel
+#define NS_COMPRESSION_BLOCK_SIZE		NS_MEMORY_SIZE_KiB(256)
+
+
+
+namespace nsCompression
+{
+	// Get maximum compressed size of single block with <srcSize> bytes
+	NS_NODISCARD extern NS_CORE_API int GetCompressBound(int srcSize) noexcept;
+
+	// Compress single block into <dst>. Returns compressed size, or 0 if result does not fit in <dstCapacity>
+	NS_NODISCARD extern NS_CORE_API int CompressBlock(const uint8* src, int srcSize, uint8* dst, int dstCapacity, nsECompression compression) noexcept;
+
+	// Decompress single block into <dst>. Returns false if block is corrupted or does not decompress to exactly <dstSize> bytes
+	NS_NODISCARD extern NS_CORE_API bool DecompressBlock(const uint8* src, int srcSize, uint8* dst, int dstSize) noexcept;
+
+	// [Main/Worker thread only] Compress <data> in blocks (in parallel) and append result to <outData>.
+	// Layout: uint32 uncompressed size, uint32 block count, uint32 block sizes[block count], block data.
+	// Blocks that do not compress are stored raw (highest bit of block size is set).
+	extern NS_CORE_API void Compress(const uint8* data, int dataSize, nsECompression compression, nsTArray<uint8>& outData) noexcept;
+
+	// [Main/Worker thread only] Decompress data written by Compress() into <outData>, blocks are decompressed in parallel. Returns false if data is corrupted
+	NS_NODISCARD extern NS_CORE_API bool Decompress(const uint8* data, int dataSize, nsTArray<uint8>& outData) noexcept;
+
+};
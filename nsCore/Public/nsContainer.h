@@ -13,9 +13,63 @@
 
 
 
+// Default nsTArray allocator, uses platform heap
+class nsTArrayDefaultAllocator
+{
+public:
+	NS_NODISCARD_INLINE static void* Reallocate(void* data, int /*oldSize*/, int newSize, int /*alignment*/) noexcept
+	{
+		return nsPlatform::Memory_Realloc(data, newSize);
+	}
+
+
+	NS_INLINE static void Free(void* data, int /*size*/) noexcept
+	{
+		nsPlatform::Memory_Free(data);
+	}
+
+};
+
+
+
+// Inline storage of nsTArray small-buffer optimization
+template<typename T, int INLINE_CAPACITY>
+struct nsTArrayInlineStorage
+{
+	alignas(T) uint8 InlineBuffer[sizeof(T) * INLINE_CAPACITY];
+
+
+	NS_NODISCARD_INLINE T* GetInlineData() noexcept
+	{
+		return reinterpret_cast<T*>(InlineBuffer);
+	}
+
+};
+
+
 template<typename T>
-class nsTArray
+struct nsTArrayInlineStorage<T, 0>
+{
+	NS_NODISCARD_INLINE T* GetInlineData() noexcept
+	{
+		return nullptr;
+	}
+
+};
+
+
+
+// TAllocator must provide static Reallocate(data, oldSize, newSize, alignment) and Free(data, size).
+// If INLINE_CAPACITY > 0, first INLINE_CAPACITY elements are stored inside the array object (no allocation), which makes the array not bitwise relocatable.
+template<typename T, typename TAllocator = nsTArrayDefaultAllocator, int INLINE_CAPACITY = 0>
+class nsTArray : private nsTArrayInlineStorage<T, INLINE_CAPACITY>
 {
+	static_assert(INLINE_CAPACITY >= 0, "nsTArray <INLINE_CAPACITY> must not be negative!");
+
+	// Trivially copyable types are copied with memcpy, types that can not be moved are relocated bitwise (previous behavior)
+	static constexpr bool bCopyBitwise = std::is_trivially_copyable<T>::value;
+	static constexpr bool bRelocateBitwise = bCopyBitwise || !std::is_move_constructible<T>::value;
+
 private:
 	int Capacity;
 	int Count;
@@ -24,9 +78,9 @@ private:
 
 public:
 	nsTArray(int count = 0) noexcept
-		: Capacity(0)
+		: Capacity(INLINE_CAPACITY)
 		, Count(0)
-		, Data(nullptr)
+		, Data(this->GetInlineData())
 	{
 		if (count > 0)
 		{
@@ -37,9 +91,9 @@ public:
 
 	template<typename...TConstructorArgs>
 	nsTArray(int count = 0, TConstructorArgs&&... args) noexcept
-		: Capacity(0)
+		: Capacity(INLINE_CAPACITY)
 		, Count(0)
-		, Data(nullptr)
+		, Data(this->GetInlineData())
 	{
 		if (count > 0)
 		{
@@ -49,40 +103,35 @@ public:
 
 
 	nsTArray(const nsTArray& other) noexcept
-		: Capacity(0)
+		: Capacity(INLINE_CAPACITY)
 		, Count(0)
-		, Data(nullptr)
+		, Data(this->GetInlineData())
 	{
 		//nsPlatform::Output("nsTArray copy constructor\n");
 
-		Resize(other.Count);
-		CopyElements(0, other.Data, other.Count);
+		CopyFrom(other.Data, other.Count);
 	}
 
 
 	nsTArray(nsTArray&& other) noexcept
-		: Capacity(other.Capacity)
-		, Count(other.Count)
-		, Data(other.Data)
+		: Capacity(INLINE_CAPACITY)
+		, Count(0)
+		, Data(this->GetInlineData())
 	{
 		//nsPlatform::Output("nsTArray move constructor\n");
 
-		other.Data = nullptr;
-		other.Capacity = 0;
-		other.Count = 0;
+		MoveFrom(other);
 	}
 
 
 	nsTArray(const std::initializer_list<T>& initializerList) noexcept
-		: Capacity(0)
+		: Capacity(INLINE_CAPACITY)
 		, Count(0)
-		, Data(nullptr)
+		, Data(this->GetInlineData())
 	{
 		//nsPlatform::Output("nsTArray initializeList constructor\n");
 
-		const int count = static_cast<int>(initializerList.size());
-		Resize(count);
-		CopyElements(0, initializerList.begin(), count);
+		CopyFrom(initializerList.begin(), static_cast<int>(initializerList.size()));
 	}
 
 
@@ -95,7 +144,21 @@ public:
 
 
 private:
-	NS_INLINE void CopyElements(int dstIndex, const T* source, int count) noexcept
+	NS_NODISCARD_INLINE bool IsInline() const noexcept
+	{
+		if constexpr (INLINE_CAPACITY > 0)
+		{
+			return Data == reinterpret_cast<const T*>(this->InlineBuffer);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+
+	// Copy-construct elements into uninitialized range [dstIndex, dstIndex + count)
+	NS_INLINE void CopyConstructs(int dstIndex, const T* source, int count) noexcept
 	{
 		if (source == nullptr || count <= 0)
 		{
@@ -103,11 +166,9 @@ private:
 		}
 
 		NS_ARRAY_ValidateIndex(dstIndex);
+		NS_ARRAY_ValidateIndex(dstIndex + count - 1);
 
-		const int endIndex = dstIndex + count;
-		NS_ARRAY_ValidateIndex(endIndex - 1);
-
-		if constexpr (std::is_arithmetic<T>::value)
+		if constexpr (bCopyBitwise)
 		{
 			nsPlatform::Memory_Copy(Data + dstIndex, source, sizeof(T) * count);
 		}
@@ -115,12 +176,31 @@ private:
 		{
 			for (int i = 0; i < count; ++i)
 			{
-				Data[dstIndex + i] = source[i];
+				new (Data + dstIndex + i)T(source[i]);
 			}
 		}
 	}
 
 
+	// Move elements to another memory, source elements are destructed
+	static NS_INLINE void RelocateElements(T* dst, T* src, int count) noexcept
+	{
+		if constexpr (bRelocateBitwise)
+		{
+			nsPlatform::Memory_Copy(dst, src, sizeof(T) * count);
+		}
+		else
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				new (dst + i)T(std::move(src[i]));
+				(src + i)->~T();
+			}
+		}
+	}
+
+
+	// Move elements within array, destination slots outside source range must not hold constructed elements
 	NS_INLINE void ShiftElements(int dstIndex, int srcIndex, int count) noexcept
 	{
 		NS_ARRAY_ValidateIndex(dstIndex);
@@ -128,7 +208,51 @@ private:
 		NS_ARRAY_ValidateIndex(dstIndex + count - 1);
 		NS_ARRAY_ValidateIndex(srcIndex + count - 1);
 
-		nsPlatform::Memory_Move(Data + dstIndex, Data + srcIndex, sizeof(T) * count);
+		if constexpr (bRelocateBitwise)
+		{
+			nsPlatform::Memory_Move(Data + dstIndex, Data + srcIndex, sizeof(T) * count);
+		}
+		else if (dstIndex > srcIndex)
+		{
+			for (int i = count - 1; i >= 0; --i)
+			{
+				RelocateElements(Data + dstIndex + i, Data + srcIndex + i, 1);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				RelocateElements(Data + dstIndex + i, Data + srcIndex + i, 1);
+			}
+		}
+	}
+
+
+	NS_INLINE void CopyFrom(const T* source, int count) noexcept
+	{
+		Reserve(count);
+		Count = count;
+		CopyConstructs(0, source, count);
+	}
+
+
+	NS_INLINE void MoveFrom(nsTArray& other) noexcept
+	{
+		if (other.IsInline())
+		{
+			RelocateElements(Data, other.Data, other.Count);
+		}
+		else
+		{
+			Data = other.Data;
+			Capacity = other.Capacity;
+			other.Data = other.GetInlineData();
+			other.Capacity = INLINE_CAPACITY;
+		}
+
+		Count = other.Count;
+		other.Count = 0;
 	}
 
 
@@ -147,12 +271,15 @@ private:
 
 	NS_INLINE void Destructs(int startIndex, int count) noexcept
 	{
-		const int endIndex = startIndex + count;
-
-		for (int i = startIndex; i < endIndex; ++i)
+		if constexpr (!std::is_trivially_destructible<T>::value)
 		{
-			NS_ARRAY_ValidateIndex(i);
-			(Data + i)->~T();
+			const int endIndex = startIndex + count;
+
+			for (int i = startIndex; i < endIndex; ++i)
+			{
+				NS_ARRAY_ValidateIndex(i);
+				(Data + i)->~T();
+			}
 		}
 	}
 
@@ -165,12 +292,42 @@ public:
 			return;
 		}
 
-		Data = static_cast<T*>(nsPlatform::Memory_Realloc(Data, sizeof(T) * newCapacity));
-		NS_ValidateV(Data, TEXT("nsTArray memory realloc failed!"));
+		if (bRelocateBitwise && !IsInline())
+		{
+			Data = static_cast<T*>(TAllocator::Reallocate(Data, sizeof(T) * Capacity, sizeof(T) * newCapacity, alignof(T)));
+			NS_ValidateV(Data, TEXT("nsTArray memory realloc failed!"));
+		}
+		else
+		{
+			T* newData = static_cast<T*>(TAllocator::Reallocate(nullptr, 0, sizeof(T) * newCapacity, alignof(T)));
+			NS_ValidateV(newData, TEXT("nsTArray memory realloc failed!"));
+			RelocateElements(newData, Data, Count);
+
+			if (Data && !IsInline())
+			{
+				TAllocator::Free(Data, sizeof(T) * Capacity);
+			}
+
+			Data = newData;
+		}
+
 		Capacity = newCapacity;
 	}
 
 
+private:
+	// Grow capacity geometrically, used by Add/InsertAt so appending one element at a time is amortized O(1)
+	NS_INLINE void ReserveGrow(int newCount) noexcept
+	{
+		if (newCount > Capacity)
+		{
+			const int grownCapacity = Capacity * 2;
+			Reserve(newCount > grownCapacity ? newCount : grownCapacity);
+		}
+	}
+
+
+public:
 	NS_INLINE void Resize(int newCount) noexcept
 	{
 		NS_Assert(newCount >= 0 && newCount < INT32_MAX);
@@ -190,11 +347,7 @@ public:
 		}
 		else
 		{
-			if constexpr (!std::is_arithmetic<T>::value)
-			{
-				Destructs(newCount, lastIndex - newCount);
-			}
-
+			Destructs(newCount, lastIndex - newCount);
 			Count = newCount;
 		}
 	}
@@ -295,6 +448,7 @@ public:
 	template<typename...TConstructorArgs>
 	NS_INLINE T& Add(TConstructorArgs&&... args) noexcept
 	{
+		ReserveGrow(Count + 1);
 		ResizeConstructs(Count + 1, std::forward<TConstructorArgs>(args)...);
 		return Data[Count - 1];
 	}
@@ -328,20 +482,21 @@ public:
 			return;
 		}
 
+		ReserveGrow(Count + count);
+		const int prevCount = Count;
+
 		if ( (Count == 0) || (dstIndex == Count - 1) || (dstIndex == NS_ARRAY_INDEX_LAST) )
 		{
-			const int lastIndex = Count;
-			Resize(Count + count);
-			CopyElements(lastIndex, source, count);
+			Count += count;
+			CopyConstructs(prevCount, source, count);
 		}
 		else
 		{
-			const int PrevCount = Count;
-			NS_Assert(PrevCount > dstIndex);
+			NS_Assert(prevCount > dstIndex);
 
-			Resize(Count + count);
-			ShiftElements(dstIndex + count, dstIndex, PrevCount - dstIndex);
-			CopyElements(dstIndex, source, count);
+			Count += count;
+			ShiftElements(dstIndex + count, dstIndex, prevCount - dstIndex);
+			CopyConstructs(dstIndex, source, count);
 		}
 	}
 
@@ -377,11 +532,7 @@ public:
 		}
 
 		NS_ARRAY_ValidateIndex(index);
-
-		if constexpr (!std::is_arithmetic<T>::value)
-		{
-			Destructs(index, 1);
-		}
+		Destructs(index, 1);
 
 		if (Count == 1 || index == (Count - 1) || index == NS_ARRAY_INDEX_LAST)
 		{
@@ -396,7 +547,8 @@ public:
 		}
 		else
 		{
-			Data[index] = Data[Count - 1];
+			// Element at index has been destructed, relocate last element instead of assigning
+			ShiftElements(index, Count - 1, 1);
 		}
 
 		Count--;
@@ -424,11 +576,7 @@ public:
 
 		NS_ARRAY_ValidateIndex(index);
 		NS_Assert(index + count <= Count);
-
-		if constexpr (!std::is_arithmetic<T>::value)
-		{
-			Destructs(index, count);
-		}
+		Destructs(index, count);
 
 		if (Count > (index + count))
 		{
@@ -475,11 +623,11 @@ public:
 	{
 		Resize(0);
 
-		if (Data && bFree)
+		if (Data && bFree && !IsInline())
 		{
-			nsPlatform::Memory_Free(Data);
-			Data = nullptr;
-			Capacity = 0;
+			TAllocator::Free(Data, sizeof(T) * Capacity);
+			Data = this->GetInlineData();
+			Capacity = INLINE_CAPACITY;
 		}
 	}
 
@@ -502,6 +650,12 @@ public:
 	}
 
 
+	NS_NODISCARD_INLINE int GetCapacity() const noexcept
+	{
+		return Capacity;
+	}
+
+
 	NS_NODISCARD_INLINE bool IsEmpty() const noexcept
 	{
 		return Count == 0;
@@ -527,8 +681,8 @@ public:
 		{
 			//nsPlatform::Output("nsTArray copy assignment\n");
 
-			Resize(rhs.Count);
-			CopyElements(0, rhs.Data, rhs.Count);
+			Clear();
+			CopyFrom(rhs.Data, rhs.Count);
 		}
 
 		return *this;
@@ -542,12 +696,7 @@ public:
 			//nsPlatform::Output("nsTArray move assignment\n");
 
 			Clear(true);
-			Data = rhs.Data;
-			Capacity = rhs.Capacity;
-			Count = rhs.Count;
-			rhs.Data = nullptr;
-			rhs.Capacity = 0;
-			rhs.Count = 0;
+			MoveFrom(rhs);
 		}
 
 		return *this;
@@ -556,9 +705,8 @@ public:
 
 	NS_INLINE nsTArray& operator=(const std::initializer_list<T>& rhs) noexcept
 	{
-		const int count = static_cast<int>(rhs.size());
-		Resize(count);
-		CopyElements(0, rhs.begin(), count);
+		Clear();
+		CopyFrom(rhs.begin(), static_cast<int>(rhs.size()));
 
 		return *this;
 	}
@@ -627,7 +775,7 @@ private:
 		const int endIndex = dstIndex + count;
 		NS_ARRAY_ValidateIndex(endIndex - 1);
 
-		if constexpr (std::is_arithmetic<T>::value)
+		if constexpr (std::is_trivially_copyable<T>::value)
 		{
 			nsPlatform::Memory_Copy(Data + dstIndex, source, sizeof(T) * count);
 		}
@@ -648,7 +796,24 @@ private:
 		NS_ARRAY_ValidateIndex(dstIndex + count - 1);
 		NS_ARRAY_ValidateIndex(srcIndex + count - 1);
 
-		nsPlatform::Memory_Move(Data + dstIndex, Data + srcIndex, sizeof(T) * count);
+		if constexpr (std::is_trivially_copyable<T>::value)
+		{
+			nsPlatform::Memory_Move(Data + dstIndex, Data + srcIndex, sizeof(T) * count);
+		}
+		else if (dstIndex > srcIndex)
+		{
+			for (int i = count - 1; i >= 0; --i)
+			{
+				Data[dstIndex + i] = std::move(Data[srcIndex + i]);
+			}
+		}
+		else
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				Data[dstIndex + i] = std::move(Data[srcIndex + i]);
+			}
+		}
 	}
 
 
@@ -1075,47 +1240,56 @@ public:
 
 
 
+// Array with stable indices, removed slots are reused by next Add.
+// Each slot has generation counter (odd means slot is in use) that is incremented on every Add/RemoveAt, so handle that stores index + generation can detect stale access in O(1).
+// Valid indices are also kept packed (unordered) for iteration without skipping removed slots.
 template<typename T>
 class nsTArrayFreeList
 {
 	static_assert(sizeof(T) >= sizeof(int), "nsTArrayFreeList sizeof(T) must be >= than sizeof(int)!");
 
 private:
-	int Count;
 	int NextFreeIndex;
 	nsTArray<T> Array;
+	nsTArray<uint32> Generations;
+
+	// Packed valid indices
+	nsTArray<int> Indices;
+
+	// Slot index -> position in Indices
+	nsTArray<int> IndexPositions;
 
 
 public:
 	nsTArrayFreeList() noexcept
-		: Count(0)
-		, NextFreeIndex(NS_ARRAY_INDEX_INVALID)
+		: NextFreeIndex(NS_ARRAY_INDEX_INVALID)
 	{
 	}
 
 
 	nsTArrayFreeList(const nsTArrayFreeList& other) noexcept
-		: Count(other.Count)
-		, NextFreeIndex(other.NextFreeIndex)
-		, Array(other.Array)
+		: NextFreeIndex(NS_ARRAY_INDEX_INVALID)
 	{
+		CopyFrom(other);
 	}
 
 
 	nsTArrayFreeList(nsTArrayFreeList&& other) noexcept
-		: Count(other.Count)
-		, NextFreeIndex(other.NextFreeIndex)
+		: NextFreeIndex(other.NextFreeIndex)
 		, Array(std::move(other.Array))
+		, Generations(std::move(other.Generations))
+		, Indices(std::move(other.Indices))
+		, IndexPositions(std::move(other.IndexPositions))
 	{
+		other.NextFreeIndex = NS_ARRAY_INDEX_INVALID;
 	}
 
 
 	nsTArrayFreeList(const std::initializer_list<T>& initializerList) noexcept
-		: Count(0)
-		, NextFreeIndex(NS_ARRAY_INDEX_INVALID)
+		: NextFreeIndex(NS_ARRAY_INDEX_INVALID)
 	{
 		const int count = static_cast<int>(initializerList.size());
-		Array.Reserve(count);
+		Reserve(count);
 
 		for (int i = 0; i < count; ++i)
 		{
@@ -1124,36 +1298,105 @@ public:
 	}
 
 
-	~nsTArrayFreeList() noexcept = default;
+	~nsTArrayFreeList() noexcept
+	{
+		Clear(true);
+	}
 
 
-public:
-	NS_NODISCARD_INLINE bool IsValid(int index) const noexcept
+private:
+	NS_INLINE void ConstructFreeSlots() noexcept
 	{
-		if (index < 0 || index >= Array.GetCount() || index == NextFreeIndex)
+		// Removed slots are already destructed, construct them back so Array can destruct every element
+		int index = NextFreeIndex;
+
+		while (index != NS_ARRAY_INDEX_INVALID)
 		{
-			return false;
+			const int nextIndex = *(const int*)&Array[index];
+			new (&Array[index])T();
+			index = nextIndex;
 		}
 
-		int check = NextFreeIndex;
+		NextFreeIndex = NS_ARRAY_INDEX_INVALID;
+	}
+
+
+	NS_INLINE void CopyFrom(const nsTArrayFreeList& other) noexcept
+	{
+		Clear();
 
-		while (check != NS_ARRAY_INDEX_INVALID)
+		const int count = other.Array.GetCount();
+		Array.Reserve(count);
+
+		for (int i = 0; i < count; ++i)
 		{
-			if (check == index)
+			if (other.IsValid(i))
 			{
-				return false;
+				Array.Add(other.Array[i]);
+			}
+			else
+			{
+				T& data = Array.Add();
+				data.~T();
+				*(int*)&data = *(const int*)&other.Array[i];
 			}
-
-			check = *(const int*)&Array[check];
 		}
 
-		return true;
+		NextFreeIndex = other.NextFreeIndex;
+		Generations = other.Generations;
+		Indices = other.Indices;
+		IndexPositions = other.IndexPositions;
+	}
+
+
+public:
+	NS_NODISCARD_INLINE bool IsValid(int index) const noexcept
+	{
+		return index >= 0 && index < Generations.GetCount() && (Generations.GetData()[index] & 1);
+	}
+
+
+	NS_NODISCARD_INLINE bool IsValid(int index, uint32 generation) const noexcept
+	{
+		return index >= 0 && index < Generations.GetCount() && Generations.GetData()[index] == generation && (generation & 1);
+	}
+
+
+	NS_NODISCARD_INLINE uint32 GetGeneration(int index) const noexcept
+	{
+		return Generations[index];
 	}
 
 
 	NS_INLINE void Reserve(int newCapacity) noexcept
 	{
+		if (NextFreeIndex != NS_ARRAY_INDEX_INVALID && newCapacity > Array.GetCapacity())
+		{
+			// Array growth may move-construct elements, removed slots must be constructed while relocating
+			nsTArray<int> freeIndices;
+
+			for (int index = NextFreeIndex; index != NS_ARRAY_INDEX_INVALID; index = *(const int*)&Array[index])
+			{
+				freeIndices.Add(index);
+			}
+
+			ConstructFreeSlots();
+			Array.Reserve(newCapacity);
+
+			for (int i = freeIndices.GetCount() - 1; i >= 0; --i)
+			{
+				const int index = freeIndices[i];
+				Array[index].~T();
+				nsPlatform::Memory_Set(&Array[index], 0xCC, sizeof(int));
+				*(int*)&Array[index] = NextFreeIndex;
+				NextFreeIndex = index;
+			}
+		}
+
 		Array.Reserve(newCapacity);
+		Generations.Reserve(newCapacity);
+		Indices.Reserve(newCapacity);
+		IndexPositions.Reserve(newCapacity);
 	}
 
 
@@ -1166,15 +1409,19 @@ public:
 		{
 			index = Array.GetCount();
 			Array.Add(std::forward<TConstructorArgs>(args)...);
+			Generations.Add(1);
+			IndexPositions.Add(Indices.GetCount());
 		}
 		else
 		{
 			index = NextFreeIndex;
 			NextFreeIndex = *(const int*)&Array[index];
 			new (&Array[index])T(std::forward<TConstructorArgs>(args)...);
+			Generations[index]++;
+			IndexPositions[index] = Indices.GetCount();
 		}
 
-		Count++;
+		Indices.Add(index);
 
 		return index;
 	}
@@ -1189,33 +1436,52 @@ public:
 		nsPlatform::Memory_Set(&Array[index], 0xCC, sizeof(int));
 		*(int*)&Array[index] = NextFreeIndex;
 		NextFreeIndex = index;
-		Count--;
+		Generations[index]++;
+
+		// Move last packed index into removed position
+		const int position = IndexPositions[index];
+		Indices.RemoveAt(position, false);
+
+		if (position < Indices.GetCount())
+		{
+			IndexPositions[Indices[position]] = position;
+		}
 	}
 
 
 	NS_INLINE void Clear(bool bFree = false) noexcept
 	{
+		ConstructFreeSlots();
 		Array.Clear(bFree);
-		Count = 0;
-		NextFreeIndex = NS_ARRAY_INDEX_INVALID;
+		Generations.Clear(bFree);
+		Indices.Clear(bFree);
+		IndexPositions.Clear(bFree);
 	}
 
 
+	// Underlying storage, contains removed slots
 	NS_NODISCARD_INLINE const nsTArray<T>& GetArray() const noexcept
 	{
 		return Array;
 	}
 
 
+	// Packed valid indices, order is not preserved after RemoveAt
+	NS_NODISCARD_INLINE const nsTArray<int>& GetIndices() const noexcept
+	{
+		return Indices;
+	}
+
+
 	NS_NODISCARD_INLINE int GetCount() const noexcept
 	{
-		return Count;
+		return Indices.GetCount();
 	}
 
 
 	NS_NODISCARD_INLINE bool IsEmpty() const noexcept
 	{
-		return Count == 0;
+		return Indices.GetCount() == 0;
 	}
 
 
@@ -1224,9 +1490,7 @@ public:
 	{
 		if (this != &rhs)
 		{
-			Array = rhs.Array;
-			Count = rhs.Count;
-			NextFreeIndex = rhs.NextFreeIndex;
+			CopyFrom(rhs);
 		}
 
 		return *this;
@@ -1237,9 +1501,13 @@ public:
 	{
 		if (this != &rhs)
 		{
+			Clear();
 			Array = std::move(rhs.Array);
-			Count = rhs.Count;
+			Generations = std::move(rhs.Generations);
+			Indices = std::move(rhs.Indices);
+			IndexPositions = std::move(rhs.IndexPositions);
 			NextFreeIndex = rhs.NextFreeIndex;
+			rhs.NextFreeIndex = NS_ARRAY_INDEX_INVALID;
 		}
 
 		return *this;
@@ -1248,13 +1516,17 @@ public:
 
 	NS_INLINE nsTArrayFreeList& operator=(const std::initializer_list<T>& initializerList) noexcept
 	{
+		Clear();
+
 		const int count = static_cast<int>(initializerList.size());
-		Array.Reserve(count);
+		Reserve(count);
 
 		for (int i = 0; i < count; ++i)
 		{
 			Add(*(initializerList.begin() + i));
 		}
+
+		return *this;
 	}
 
 
@@ -1276,67 +1548,51 @@ public:
 	class Iterator
 	{
 		nsTArrayFreeList* Data;
-		int Index;
+		int Position;
 
 	public:
 		Iterator() noexcept
 			: Data(nullptr)
-			, Index(-1)
+			, Position(0)
 		{
 		}
 
 		Iterator(nsTArrayFreeList* data) noexcept
 			: Data(data)
-			, Index(-1)
+			, Position(0)
 		{
-			IterateNextValidIndex();
-		}
-
-	private:
-		inline void IterateNextValidIndex() noexcept
-		{
-			const int lastIndex = Data->GetArray().GetCount() - 1;
-			int i = Index + 1;
-
-			while (i <= lastIndex)
-			{
-				if (Data->IsValid(i)) break;
-				i++;
-			}
-
-			Index = i;
 		}
 
 	public:
 		NS_NODISCARD_INLINE int GetIndex() const noexcept
 		{
-			return Index;
+			return Data->Indices[Position];
 		}
 
 		NS_NODISCARD_INLINE T& GetValue() const noexcept
 		{
-			return (*Data)[Index];
+			return Data->Array[GetIndex()];
 		}
 
 		NS_INLINE Iterator& operator++() noexcept
 		{
-			IterateNextValidIndex();
+			Position++;
 			return *this;
 		}
 
 		NS_INLINE T& operator*() noexcept
 		{
-			return (*Data)[Index];
+			return GetValue();
 		}
 
 		NS_INLINE T* operator->() noexcept
 		{
-			return &(*Data)[Index];
+			return &GetValue();
 		}
 
 		NS_INLINE bool operator==(const Iterator& rhs) const noexcept
 		{
-			return Data == rhs.Data && Index == rhs.Index;
+			return Data == rhs.Data && Position == rhs.Position;
 		}
 
 		NS_INLINE bool operator!=(const Iterator& rhs) const noexcept
@@ -1346,19 +1602,7 @@ public:
 
 		NS_INLINE operator bool() const noexcept
 		{
-			if (Data == nullptr || Index == -1)
-			{
-				return false;
-			}
-
-			const int lastIndex = Data->GetArray().GetCount() - 1;
-
-			if (Index >= lastIndex)
-			{
-				return Data->IsValid(Index);
-			}
-
-			return Index >= 0 && Index <= lastIndex;
+			return Data && Position < Data->Indices.GetCount();
 		}
 
 	};
@@ -1367,67 +1611,51 @@ public:
 	class ConstIterator
 	{
 		const nsTArrayFreeList* Data;
-		int Index;
+		int Position;
 
 	public:
 		ConstIterator() noexcept
 			: Data(nullptr)
-			, Index(-1)
+			, Position(0)
 		{
 		}
 
 		ConstIterator(const nsTArrayFreeList* data) noexcept
 			: Data(data)
-			, Index(-1)
-		{
-			IterateNextValidIndex();
-		}
-
-	private:
-		void IterateNextValidIndex() noexcept
+			, Position(0)
 		{
-			const int lastIndex = Data->GetArray().GetCount() - 1;
-			int i = Index + 1;
-
-			while (i <= lastIndex)
-			{
-				if (Data->IsValid(i)) break;
-				i++;
-			}
-
-			Index = i;
 		}
 
 	public:
 		NS_NODISCARD_INLINE int GetIndex() const noexcept
 		{
-			return Index;
+			return Data->Indices[Position];
 		}
 
 		NS_NODISCARD_INLINE const T& GetValue() const noexcept
 		{
-			return (*Data)[Index];
+			return Data->Array[GetIndex()];
 		}
 
 		NS_INLINE ConstIterator& operator++() noexcept
 		{
-			IterateNextValidIndex();
+			Position++;
 			return *this;
 		}
 
 		NS_INLINE const T& operator*() const noexcept
 		{
-			return (*Data)[Index];
+			return GetValue();
 		}
 
 		NS_INLINE const T* operator->() const noexcept
 		{
-			return &(*Data)[Index];
+			return &GetValue();
 		}
 
 		NS_INLINE bool operator==(const ConstIterator& rhs) const noexcept
 		{
-			return Data == rhs.Data && Index == rhs.Index;
+			return Data == rhs.Data && Position == rhs.Position;
 		}
 
 		NS_INLINE bool operator!=(const ConstIterator& rhs) const noexcept
@@ -1437,19 +1665,7 @@ public:
 
 		NS_INLINE operator bool() const noexcept
 		{
-			const int lastIndex = Data->GetArray().GetCount() - 1;
-
-			if (Data == nullptr || Index == -1 || Index > lastIndex)
-			{
-				return false;
-			}
-
-			if (Index == lastIndex)
-			{
-				return Data->IsValid(Index);
-			}
-
-			return Index >= 0 && Index <= lastIndex;
+			return Data && Position < Data->Indices.GetCount();
 		}
 
 	};
@@ -1464,15 +1680,28 @@ public:
 
 
 
-#define NS_MAP_CHECK_COLLISION	1
+#define NS_MAP_MIN_BUCKET_COUNT		(8)
 
+
+// Hash map with dense key/value storage and Robin Hood open addressing index.
+// Keys and values are stored contiguously and can be iterated with index [0, GetCount()), removal (unordered) moves the last element into the removed slot.
+// Lookup compares cached 32-bit hash first, then the key itself, so hash collision never aliases two different keys.
 template<typename TUniqueKey, typename TValue>
 class nsTMap
 {
 private:
-	nsTArray<uint64> Hashes;
+	struct Bucket
+	{
+		uint32 Hash;
+
+		// Index to Keys/Values + 1, zero means empty bucket
+		int Index;
+	};
+
+	nsTArray<uint32> Hashes;
 	nsTArray<TUniqueKey> Keys;
 	nsTArray<TValue> Values;
+	nsTArray<Bucket> Buckets;
 
 
 public:
@@ -1488,6 +1717,7 @@ public:
 		: Hashes(other.Hashes)
 		, Keys(other.Keys)
 		, Values(other.Values)
+		, Buckets(other.Buckets)
 	{
 	}
 
@@ -1496,6 +1726,7 @@ public:
 		: Hashes(std::move(other.Hashes))
 		, Keys(std::move(other.Keys))
 		, Values(std::move(other.Values))
+		, Buckets(std::move(other.Buckets))
 	{
 	}
 
@@ -1504,17 +1735,167 @@ public:
 
 
 private:
-	NS_NODISCARD_INLINE int FindIndex(const uint64 hashValue) const noexcept
+	NS_NODISCARD_INLINE static uint32 HashKey(const TUniqueKey& key) noexcept
 	{
-		for (int i = 0; i < Hashes.GetCount(); ++i)
+		// Mix the key hash, since ns_GetHash for integers and pointers returns the value itself
+		uint64 hash = ns_GetHash(key);
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdULL;
+		hash ^= hash >> 33;
+
+		return static_cast<uint32>(hash);
+	}
+
+
+	NS_NODISCARD_INLINE uint32 GetProbeDistance(uint32 hash, int bucketIndex) const noexcept
+	{
+		const uint32 mask = static_cast<uint32>(Buckets.GetCount() - 1);
+		return (static_cast<uint32>(bucketIndex) - (hash & mask)) & mask;
+	}
+
+
+	NS_NODISCARD_INLINE int FindBucket(const TUniqueKey& key, uint32 hash) const noexcept
+	{
+		if (Buckets.GetCount() == 0)
 		{
-			if (Hashes[i] == hashValue)
+			return NS_ARRAY_INDEX_INVALID;
+		}
+
+		const Bucket* buckets = Buckets.GetData();
+		const TUniqueKey* keys = Keys.GetData();
+		const int mask = Buckets.GetCount() - 1;
+		int bucketIndex = static_cast<int>(hash & mask);
+		uint32 distance = 0;
+
+		while (true)
+		{
+			const Bucket& bucket = buckets[bucketIndex];
+
+			// Robin Hood invariant, key would have been placed before any bucket that is closer to its home
+			if (bucket.Index == 0 || GetProbeDistance(bucket.Hash, bucketIndex) < distance)
 			{
-				return i;
+				return NS_ARRAY_INDEX_INVALID;
 			}
+
+			if (bucket.Hash == hash && keys[bucket.Index - 1] == key)
+			{
+				return bucketIndex;
+			}
+
+			bucketIndex = (bucketIndex + 1) & mask;
+			distance++;
 		}
+	}
 
-		return NS_ARRAY_INDEX_INVALID;
+
+	NS_INLINE void InsertBucket(uint32 hash, int index) noexcept
+	{
+		Bucket* buckets = Buckets.GetData();
+		const int mask = Buckets.GetCount() - 1;
+		int bucketIndex = static_cast<int>(hash & mask);
+		uint32 distance = 0;
+		Bucket insert = { hash, index + 1 };
+
+		while (true)
+		{
+			Bucket& bucket = buckets[bucketIndex];
+
+			if (bucket.Index == 0)
+			{
+				bucket = insert;
+				return;
+			}
+
+			// Take the slot from the entry closer to its home bucket, then continue inserting the displaced one
+			const uint32 bucketDistance = GetProbeDistance(bucket.Hash, bucketIndex);
+
+			if (bucketDistance < distance)
+			{
+				const Bucket temp = bucket;
+				bucket = insert;
+				insert = temp;
+				distance = bucketDistance;
+			}
+
+			bucketIndex = (bucketIndex + 1) & mask;
+			distance++;
+		}
+	}
+
+
+	NS_INLINE void RemoveBucket(int bucketIndex) noexcept
+	{
+		Bucket* buckets = Buckets.GetData();
+		const int mask = Buckets.GetCount() - 1;
+		int nextIndex = (bucketIndex + 1) & mask;
+
+		// Backward shift deletion, no tombstone needed
+		while (buckets[nextIndex].Index != 0 && GetProbeDistance(buckets[nextIndex].Hash, nextIndex) > 0)
+		{
+			buckets[bucketIndex] = buckets[nextIndex];
+			bucketIndex = nextIndex;
+			nextIndex = (nextIndex + 1) & mask;
+		}
+
+		buckets[bucketIndex] = {};
+	}
+
+
+	NS_INLINE void Rehash(int newBucketCount) noexcept
+	{
+		NS_Assert((newBucketCount & (newBucketCount - 1)) == 0);
+
+		Buckets.Clear();
+		Buckets.Resize(newBucketCount);
+
+		for (int i = 0; i < Hashes.GetCount(); ++i)
+		{
+			InsertBucket(Hashes[i], i);
+		}
+	}
+
+
+	NS_INLINE void ReserveBuckets(int count) noexcept
+	{
+		// Keep load factor below 7/8
+		int bucketCount = Buckets.GetCount() > 0 ? Buckets.GetCount() : NS_MAP_MIN_BUCKET_COUNT;
+
+		while (static_cast<int64>(count) * 8 > static_cast<int64>(bucketCount) * 7)
+		{
+			bucketCount *= 2;
+		}
+
+		if (bucketCount != Buckets.GetCount())
+		{
+			Rehash(bucketCount);
+		}
+	}
+
+
+	NS_NODISCARD_INLINE int FindIndex(const TUniqueKey& key) const noexcept
+	{
+		const int bucketIndex = FindBucket(key, HashKey(key));
+		return bucketIndex == NS_ARRAY_INDEX_INVALID ? NS_ARRAY_INDEX_INVALID : Buckets[bucketIndex].Index - 1;
+	}
+
+
+	NS_INLINE int AddKey(const TUniqueKey& key, uint32 hash) noexcept
+	{
+		const int index = Hashes.GetCount();
+
+		// nsTArray::Add grows by exact count, grow geometrically to keep insertion amortized O(1)
+		if (index == Hashes.GetCapacity())
+		{
+			Reserve(index * 2);
+		}
+
+		ReserveBuckets(index + 1);
+
+		Hashes.Add(hash);
+		Keys.Add(key);
+		InsertBucket(hash, index);
+
+		return index;
 	}
 
 
@@ -1524,74 +1905,95 @@ public:
 		Hashes.Reserve(newCapacity);
 		Keys.Reserve(newCapacity);
 		Values.Reserve(newCapacity);
+		ReserveBuckets(newCapacity);
 	}
 
 
 	NS_INLINE TValue& Add(const TUniqueKey& key) noexcept
 	{
-		const uint64 hash = ns_GetHash(key);
-		int index = FindIndex(hash);
+		const uint32 hash = HashKey(key);
+		const int bucketIndex = FindBucket(key, hash);
 
-		if (index == NS_ARRAY_INDEX_INVALID)
-		{
-			index = Hashes.GetCount();
-			Hashes.Add(hash);
-			Keys.Add(key);
-			Values.Add();
-		}
-		else
+		if (bucketIndex != NS_ARRAY_INDEX_INVALID)
 		{
-		#if NS_MAP_CHECK_COLLISION
-			const int keyIndex = Keys.Find(key);
-			NS_ValidateV(keyIndex != NS_ARRAY_INDEX_INVALID, TEXT("nsTMap collision!"));
-		#endif // NS_MAP_CHECK_COLLISION
+			return Values[Buckets[bucketIndex].Index - 1];
 		}
 
-		return Values[index];
+		AddKey(key, hash);
+
+		return Values.Add();
 	}
 
 
 	template<typename...TConstructorArgs>
 	NS_INLINE void Add(const TUniqueKey& key, TConstructorArgs&&... args) noexcept
 	{
-		const uint64 hash = ns_GetHash(key);
-		int index = FindIndex(hash);
+		const uint32 hash = HashKey(key);
+		const int bucketIndex = FindBucket(key, hash);
 
-		if (index == NS_ARRAY_INDEX_INVALID)
+		if (bucketIndex != NS_ARRAY_INDEX_INVALID)
 		{
-			index = Hashes.GetCount();
-			Hashes.Add(hash);
-			Keys.Add(key);
-			Values.Add(std::forward<TConstructorArgs>(args)...);
+			Values[Buckets[bucketIndex].Index - 1] = TValue(std::forward<TConstructorArgs>(args)...);
+			return;
 		}
-		else
-		{
-		#if NS_MAP_CHECK_COLLISION
-			const int keyIndex = Keys.Find(key);
-			NS_ValidateV(keyIndex != NS_ARRAY_INDEX_INVALID, TEXT("nsTMap collision!"));
-		#endif // NS_MAP_CHECK_COLLISION
 
-			Values[index] = TValue(std::forward<TConstructorArgs>(args)...);
-		}
+		AddKey(key, hash);
+		Values.Add(std::forward<TConstructorArgs>(args)...);
 	}
 
 
 	NS_INLINE void Remove(const TUniqueKey& key, bool bKeepOrdered = false) noexcept
 	{
-		const int index = FindIndex(ns_GetHash(key));
+		const int bucketIndex = FindBucket(key, HashKey(key));
 
-		if (index != NS_ARRAY_INDEX_INVALID)
+		if (bucketIndex == NS_ARRAY_INDEX_INVALID)
 		{
-			Hashes.RemoveAt(index, bKeepOrdered);
-			Keys.RemoveAt(index, bKeepOrdered);
-			Values.RemoveAt(index, bKeepOrdered);
+			return;
+		}
+
+		const int index = Buckets[bucketIndex].Index - 1;
+		const int lastIndex = Hashes.GetCount() - 1;
+		RemoveBucket(bucketIndex);
+
+		if (index != lastIndex)
+		{
+			Bucket* buckets = Buckets.GetData();
+
+			if (bKeepOrdered)
+			{
+				// Every element after removed index shifts down by one
+				for (int i = 0; i < Buckets.GetCount(); ++i)
+				{
+					if (buckets[i].Index > index + 1)
+					{
+						buckets[i].Index--;
+					}
+				}
+			}
+			else
+			{
+				// Last element moves into removed index
+				const int mask = Buckets.GetCount() - 1;
+				int lastBucketIndex = static_cast<int>(Hashes[lastIndex] & mask);
+
+				while (buckets[lastBucketIndex].Index != lastIndex + 1)
+				{
+					lastBucketIndex = (lastBucketIndex + 1) & mask;
+				}
+
+				buckets[lastBucketIndex].Index = index + 1;
+			}
 		}
+
+		Hashes.RemoveAt(index, bKeepOrdered);
+		Keys.RemoveAt(index, bKeepOrdered);
+		Values.RemoveAt(index, bKeepOrdered);
 	}
 
 
 	NS_NODISCARD_INLINE bool Exists(const TUniqueKey& key) const noexcept
 	{
-		return FindIndex(ns_GetHash(key)) != NS_ARRAY_INDEX_INVALID;
+		return FindIndex(key) != NS_ARRAY_INDEX_INVALID;
 	}
 
 
@@ -1615,7 +2017,7 @@ public:
 
 	NS_NODISCARD_INLINE TValue* GetValueByKey(const TUniqueKey& key) noexcept
 	{
-		const int index = FindIndex(ns_GetHash(key));
+		const int index = FindIndex(key);
 
 		if (index == NS_ARRAY_INDEX_INVALID)
 		{
@@ -1628,7 +2030,7 @@ public:
 
 	NS_NODISCARD_INLINE const TValue* GetValueByKey(const TUniqueKey& key) const noexcept
 	{
-		const int index = FindIndex(ns_GetHash(key));
+		const int index = FindIndex(key);
 
 		if (index == NS_ARRAY_INDEX_INVALID)
 		{
@@ -1657,11 +2059,20 @@ public:
 	}
 
 
-	NS_NODISCARD_INLINE void Clear(bool bFree = false) noexcept
+	NS_INLINE void Clear(bool bFree = false) noexcept
 	{
 		Hashes.Clear(bFree);
 		Keys.Clear(bFree);
 		Values.Clear(bFree);
+
+		if (bFree)
+		{
+			Buckets.Clear(true);
+		}
+		else if (Buckets.GetCount() > 0)
+		{
+			nsPlatform::Memory_Zero(Buckets.GetData(), sizeof(Bucket) * Buckets.GetCount());
+		}
 	}
 
 
@@ -1679,6 +2090,7 @@ public:
 			Hashes = rhs.Hashes;
 			Keys = rhs.Keys;
 			Values = rhs.Values;
+			Buckets = rhs.Buckets;
 		}
 
 		return *this;
@@ -1692,6 +2104,7 @@ public:
 			Hashes = std::move(rhs.Hashes);
 			Keys = std::move(rhs.Keys);
 			Values = std::move(rhs.Values);
+			Buckets = std::move(rhs.Buckets);
 		}
 
 		return *this;
@@ -1706,7 +2119,7 @@ public:
 
 	NS_INLINE const TValue& operator[](const TUniqueKey& key) const
 	{
-		const int index = FindIndex(ns_GetHash(key));
+		const int index = FindIndex(key);
 		NS_ValidateV(index != NS_ARRAY_INDEX_INVALID, TEXT("nsTMap key not found!"));
 
 		return Values[index];
@@ -1,11 +1,18 @@
 #pragma once
 
+#ifdef _MSC_VER
+
 #ifdef __NS_CORE_BUILD__
 #define NS_CORE_API __declspec(dllexport)
 #else
 #define NS_CORE_API __declspec(dllimport)
 #endif // __NS_CORE_BUILD__
 
+#else
+#define NS_CORE_API __attribute__((visibility("default")))
+
+#endif // _MSC_VER
+
 
 #define NS_NODISCARD			[[nodiscard]]
 #define NS_INLINE				inline
@@ -39,6 +46,7 @@ static NS_INLINE type& Get() noexcept { static type _singleton; return _singleto
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <utility>
 #include <new>
 #include <float.h>
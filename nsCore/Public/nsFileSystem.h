@@ -4,6 +4,48 @@
 
 
 
+// Read-only memory-mapped file, unmapped on destruction
+class nsFileMappedView
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsFileMappedView)
+
+public:
+	const uint8* Data;
+	int Size;
+	void* PlatformFile;
+	void* PlatformMapping;
+
+
+public:
+	nsFileMappedView() noexcept
+		: Data(nullptr)
+		, Size(0)
+		, PlatformFile(nullptr)
+		, PlatformMapping(nullptr)
+	{
+	}
+
+	~nsFileMappedView() noexcept;
+
+
+	NS_NODISCARD_INLINE bool IsValid() const noexcept
+	{
+		return Data != nullptr;
+	}
+
+};
+
+
+
+// File modified time and size, modified time is platform specific and only meant for comparison
+struct nsFileAttributes
+{
+	uint64 ModifiedTime;
+	int64 Size;
+};
+
+
+
 namespace nsFileSystem
 {
 	NS_NODISCARD extern NS_CORE_API bool FolderExists(const nsString& folderPath) noexcept;
@@ -22,12 +64,20 @@ namespace nsFileSystem
 
 	extern NS_CORE_API bool FileCopy(const nsString& srcFilePath, const nsString& dstFilePath) noexcept;
 
+	// Destination file is replaced if exists. Replace is atomic if both files are on same volume
 	extern NS_CORE_API bool FileMove(const nsString& srcFilePath, const nsString& dstFilePath) noexcept;
 
+	NS_NODISCARD extern NS_CORE_API bool FileGetAttributes(const nsString& filePath, nsFileAttributes& outAttributes) noexcept;
+
 	extern NS_CORE_API void FileIterate(nsTArray<nsString>& outFiles, const nsString& folderPath, bool bIncludeSubfolders, const nsString& optExtension = TEXT("")) noexcept;
 
 	extern NS_CORE_API bool FileReadBinary(const nsString& filePath, nsTArray<uint8>& outResult) noexcept;
 
+	// Map whole file as read-only memory, pages are loaded by the OS on first access
+	extern NS_CORE_API bool FileMap(const nsString& filePath, nsFileMappedView& outView) noexcept;
+
+	extern NS_CORE_API void FileUnmap(nsFileMappedView& view) noexcept;
+
 	extern NS_CORE_API bool FileReadText(const nsString& filePath, nsString& outResult) noexcept;
 
 	extern NS_CORE_API bool FileReadText(const nsString& filePath, nsTArray<char>& outResult) noexcept;
@@ -59,3 +109,10 @@ namespace nsFileSystem
 	NS_NODISCARD extern NS_CORE_API nsString OpenFileDialog_ImportAsset() noexcept;
 
 };
+
+
+
+NS_INLINE nsFileMappedView::~nsFileMappedView() noexcept
+{
+	nsFileSystem::FileUnmap(*this);
+}
@@ -92,7 +92,7 @@ extern NS_CORE_API nsLogCategory nsSystemLog;
 
 
 
-#define NS_LogDebug(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_DEBUG, format, __VA_ARGS__)
-#define NS_LogInfo(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_INFO, format, __VA_ARGS__)
-#define NS_LogWarning(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_WARNING, format, __VA_ARGS__)
-#define NS_LogError(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_ERROR, format, __VA_ARGS__)
+#define NS_LogDebug(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_DEBUG, format, ##__VA_ARGS__)
+#define NS_LogInfo(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_INFO, format, ##__VA_ARGS__)
+#define NS_LogWarning(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_WARNING, format, ##__VA_ARGS__)
+#define NS_LogError(category, format, ...) nsLogger::Get().OutputLogCategory(category, nsELogVerbosity::LV_ERROR, format, ##__VA_ARGS__)
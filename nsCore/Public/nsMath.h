@@ -47,13 +47,13 @@ namespace nsMath
 
 	NS_NODISCARD_INLINE bool IsNaN(float value) noexcept
 	{
-		return isnan(value);
+		return std::isnan(value);
 	}
 
 
 	NS_NODISCARD_INLINE bool IsInfinity(float value) noexcept
 	{
-		return isinf(value);
+		return std::isinf(value);
 	}
 
 
@@ -102,7 +102,7 @@ public:
 	}
 
 
-	NS_INLINE int GetAllocatedSize() const noexcept
+	NS_INLINE virtual int GetAllocatedSize() const noexcept
 	{
 		return AllocatedSize;
 	}
@@ -114,3 +114,149 @@ public:
 	}
 
 };
+
+
+
+#define NS_MEMORY_POOL_PAGE_SIZE				NS_MEMORY_SIZE_KiB(16)
+#define NS_MEMORY_POOL_MAX_SMALL_SIZE			NS_MEMORY_SIZE_KiB(4)
+#define NS_MEMORY_POOL_SIZE_CLASS_COUNT			(28)
+#define NS_MEMORY_POOL_THREAD_CACHE_COUNT		(16)
+
+
+// nsMemoryPool
+// Thread-safe allocator with fixed size-class pages.
+// Total size is reserved up front and split into pages, each page serves one size class (16 bytes up to NS_MEMORY_POOL_MAX_SMALL_SIZE).
+// Threads allocate from per-thread cache and refill in batch from the size-class free list, so allocate/deallocate are O(1).
+// Larger size, alignment greater than 16 or out of pages will fallback to platform heap allocation.
+class NS_CORE_API nsMemoryPool : public nsMemory
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsMemoryPool)
+
+private:
+	struct FreeBlock
+	{
+		FreeBlock* Next;
+	};
+
+
+	struct LargeBlock
+	{
+		LargeBlock* Prev;
+		LargeBlock* Next;
+		void* Data;
+		int Size;
+		uint32 Magic;
+	};
+
+
+	struct SizeClass
+	{
+		nsCriticalSection CriticalSection;
+		FreeBlock* FreeList;
+		int FreeCount;
+	};
+
+
+	struct alignas(64) ThreadCache
+	{
+		nsAtomic Lock;
+		int AllocatedSize;
+		FreeBlock* FreeLists[NS_MEMORY_POOL_SIZE_CLASS_COUNT];
+		int FreeCounts[NS_MEMORY_POOL_SIZE_CLASS_COUNT];
+	};
+
+
+	uint8* Pages;
+	uint8* PageSizeClasses;
+	int PageCount;
+	nsAtomic NextPageIndex;
+
+	SizeClass SizeClasses[NS_MEMORY_POOL_SIZE_CLASS_COUNT];
+	mutable ThreadCache ThreadCaches[NS_MEMORY_POOL_THREAD_CACHE_COUNT];
+
+	mutable nsCriticalSection LargeCriticalSection;
+	LargeBlock* LargeBlocks;
+	int LargeAllocatedSize;
+
+
+public:
+	nsMemoryPool() noexcept;
+	nsMemoryPool(nsName name, int totalSize, int defaultAlignment = 16) noexcept;
+	virtual ~nsMemoryPool() noexcept;
+	virtual void Initialize(nsName name, int totalSize, int defaultAlignment = 16) noexcept override;
+
+
+private:
+	NS_NODISCARD ThreadCache& GetThreadCache() noexcept;
+	NS_NODISCARD bool RefillThreadCache(ThreadCache& cache, int sizeClassIndex) noexcept;
+	void ReleaseThreadCache(ThreadCache& cache, int sizeClassIndex, int releaseCount) noexcept;
+	NS_NODISCARD void* AllocateLarge(int size, int alignment) noexcept;
+	void DeallocateLarge(void* data) noexcept;
+
+
+public:
+	NS_NODISCARD virtual void* Allocate(int size, nsName debugName = "") noexcept override;
+	NS_NODISCARD virtual void* AllocateAligned(int size, int alignment, nsName debugName = "") noexcept override;
+	virtual void Deallocate(void* data) noexcept override;
+
+	// Return all blocks cached by threads back to size-class free lists
+	virtual void Defragment() noexcept override;
+
+	virtual void Clear(bool bFreeMemory) noexcept override;
+	NS_NODISCARD virtual int GetAllocatedSize() const noexcept override;
+
+};
+
+
+
+// nsMemoryLinear
+// Linear (bump) allocator, allocations are released all at once with Clear().
+// When the buffer runs out, allocations fallback to platform heap and the buffer grows on next Clear(), so steady-state usage never hits the heap.
+// Not thread-safe.
+class NS_CORE_API nsMemoryLinear : public nsMemory
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsMemoryLinear)
+
+private:
+	struct OverflowBlock
+	{
+		OverflowBlock* Next;
+		int Size;
+	};
+
+	uint8* Buffer;
+	int Offset;
+	int LastAllocationOffset;
+	OverflowBlock* OverflowBlocks;
+	int OverflowSize;
+
+
+public:
+	nsMemoryLinear() noexcept;
+	nsMemoryLinear(nsName name, int totalSize, int defaultAlignment = 16) noexcept;
+	virtual ~nsMemoryLinear() noexcept;
+	virtual void Initialize(nsName name, int totalSize, int defaultAlignment = 16) noexcept override;
+
+
+private:
+	NS_NODISCARD void* AllocateOverflow(int size, int alignment) noexcept;
+
+
+public:
+	NS_NODISCARD virtual void* Allocate(int size, nsName debugName = "") noexcept override;
+	NS_NODISCARD virtual void* AllocateAligned(int size, int alignment, nsName debugName = "") noexcept override;
+
+	// Only the last allocation is given back, other blocks are released on Clear()
+	virtual void Deallocate(void* data) noexcept override;
+
+	virtual void Defragment() noexcept override;
+
+	// Release all allocations. Grows the buffer if previous allocations did not fit
+	virtual void Clear(bool bFreeMemory) noexcept override;
+
+	// Grow in place if data is the last allocation, otherwise allocate new block and copy
+	NS_NODISCARD void* Reallocate(void* data, int oldSize, int newSize, int alignment) noexcept;
+
+	NS_NODISCARD bool IsOwned(const void* data) const noexcept;
+
+};
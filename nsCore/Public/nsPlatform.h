@@ -23,6 +23,46 @@ typedef HANDLE		nsPlatformFileHandle;
 #define NS_DebugBreak()
 #endif // _DEBUG
 
+#define NS_YieldProcessor()	YieldProcessor()
+
+typedef HANDLE		nsPlatformThreadHandle;
+
+
+#elif defined(__linux__) || defined(__APPLE__)
+#define NS_PLATFORM_POSIX
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include <wctype.h>
+#include <ctype.h>
+
+typedef void*		nsPlatformWindowHandle;
+typedef void*		nsPlatformModuleHandle;
+typedef FILE*		nsPlatformFileHandle;
+typedef pthread_t	nsPlatformThreadHandle;
+
+#define __NS_TEXT(s)		L##s
+#define TEXT(s)				__NS_TEXT(s)
+
+#define NS_Abort()			abort()
+
+#ifdef _DEBUG
+#define NS_DebugBreak()		raise(SIGTRAP)
+#else
+#define NS_DebugBreak()
+#endif // _DEBUG
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NS_YieldProcessor()	__builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define NS_YieldProcessor()	__asm__ __volatile__("yield")
+#else
+#define NS_YieldProcessor()
+#endif // __x86_64__ || __i386__
+
+
 #else
 #error Unknown Platform
 
@@ -75,6 +115,10 @@ private:
 	CRITICAL_SECTION CS;
 #endif // NS_PLATFORM_WINDOWS
 
+#ifdef NS_PLATFORM_POSIX
+	pthread_mutex_t Mutex;
+#endif // NS_PLATFORM_POSIX
+
 
 public:
 	nsCriticalSection() noexcept;
@@ -87,6 +131,36 @@ public:
 
 
 
+class NS_CORE_API nsSemaphore
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsSemaphore)
+
+private:
+#ifdef NS_PLATFORM_WINDOWS
+	HANDLE Handle;
+#endif // NS_PLATFORM_WINDOWS
+
+#ifdef NS_PLATFORM_POSIX
+	pthread_mutex_t Mutex;
+	pthread_cond_t Condition;
+	int Count;
+#endif // NS_PLATFORM_POSIX
+
+
+public:
+	nsSemaphore() noexcept;
+	~nsSemaphore() noexcept;
+
+	// Block calling thread until count is greater than zero, then decrement it
+	void Wait() noexcept;
+
+	// Increment count by <count>, wakes up to <count> waiting threads
+	void Signal(int count = 1) noexcept;
+
+};
+
+
+
 class NS_CORE_API nsAtomic
 {
 private:
@@ -100,6 +174,9 @@ public:
 	int Decrement() noexcept;
 	int Get() const noexcept;
 
+	// Set value to <exchange> if current value equals <comparand>. Returns the initial value
+	int CompareExchange(int exchange, int comparand) noexcept;
+
 };
 
 
@@ -369,13 +446,24 @@ namespace nsPlatform
 
 	extern NS_CORE_API void Thread_Sleep(int ms) noexcept;
 
+	// Create and start thread that calls <function>(<userData>)
+	NS_NODISCARD extern NS_CORE_API nsPlatformThreadHandle Thread_Create(void(*function)(void*), void* userData) noexcept;
+
+	// Wait until thread exits and release the handle
+	extern NS_CORE_API void Thread_Join(nsPlatformThreadHandle& threadHandle) noexcept;
+
+	NS_NODISCARD extern NS_CORE_API uint32 Thread_GetCurrentId() noexcept;
+
+	// Number of logical processors
+	NS_NODISCARD extern NS_CORE_API int Thread_GetProcessorCount() noexcept;
+
 };
 
 
 
 #define NS_AssertOutputV(expr, message, ...) \
 wchar_t messageBuffer[1024]; \
-nsPlatform::String_Format(messageBuffer, 1024, message, __VA_ARGS__); \
+nsPlatform::String_Format(messageBuffer, 1024, message, ##__VA_ARGS__); \
 nsPlatform::ConsoleOutputFormat(nsEPlatformConsoleOutputColor::Red, TEXT("\nAssertion failed! (%s)\nMessage: %s\nFile: %s\nLine: %i\n"), TEXT(#expr), messageBuffer, TEXT(__FILE__), __LINE__) \
 
 #define NS_AssertOutput(expr) nsPlatform::ConsoleOutputFormat(nsEPlatformConsoleOutputColor::Red, TEXT("\nAssertion failed! (%s)\nFile: %s\nLine: %i\n"), TEXT(#expr), TEXT(__FILE__), __LINE__)
@@ -384,12 +472,10 @@ nsPlatform::ConsoleOutputFormat(nsEPlatformConsoleOutputColor::Red, TEXT("\nAsse
 
 #ifdef _DEBUG
 
-#ifdef NS_PLATFORM_WINDOWS
-
 #define NS_AssertV(expr, message, ...)				\
 if (!(expr))										\
 {													\
-	NS_AssertOutputV(expr, message, __VA_ARGS__);	\
+	NS_AssertOutputV(expr, message, ##__VA_ARGS__);	\
 	NS_DebugBreak();								\
 }
 
@@ -400,8 +486,6 @@ if (!(expr))					\
 	NS_DebugBreak();			\
 }
 
-#endif // NS_PLATFORM_WINDOWS
-
 #else
 #define NS_AssertV(expr, message, ...)
 #define NS_Assert(expr)
@@ -412,7 +496,7 @@ if (!(expr))					\
 #define NS_ValidateV(expr, message, ...)			\
 if (!(expr))										\
 {													\
-	NS_AssertOutputV(expr, message, __VA_ARGS__);	\
+	NS_AssertOutputV(expr, message, ##__VA_ARGS__);	\
 	NS_Abort();										\
 }
 
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "nsMath.h"
+
+
+
+namespace nsQuantization
+{
+	// Quantize value in range [rangeMin, rangeMin + rangeExtent] to 16 bits. Zero extent always encodes to 0
+	NS_NODISCARD_INLINE uint16 EncodeRange16(float value, float rangeMin, float rangeExtent) noexcept
+	{
+		const float normalizedValue = rangeExtent > 0.0f ? (value - rangeMin) / rangeExtent : 0.0f;
+		return static_cast<uint16>(nsMath::Clamp(static_cast<int>(normalizedValue * 65535.0f + 0.5f), 0, 65535));
+	}
+
+
+	NS_NODISCARD_INLINE float DecodeRange16(uint16 value, float rangeMin, float rangeExtent) noexcept
+	{
+		return rangeMin + rangeExtent * (static_cast<float>(value) * (1.0f / 65535.0f));
+	}
+
+
+	// Smallest three (48 bits). Three smallest components at 15 bits each, index of largest component is stored in top bits of outValues[0] (bit 0) and outValues[1] (bit 1)
+	NS_INLINE void EncodeQuaternion48(const nsQuaternion& rotation, uint16* outValues) noexcept
+	{
+		const nsQuaternion normalized = rotation.GetNormalized();
+		const float components[4] = { normalized.X, normalized.Y, normalized.Z, normalized.W };
+		int largest = 0;
+
+		for (int i = 1; i < 4; ++i)
+		{
+			if (nsMath::Abs(components[i]) > nsMath::Abs(components[largest]))
+			{
+				largest = i;
+			}
+		}
+
+		// q and -q are the same rotation, flip so largest component is positive and can be reconstructed
+		const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+		int index = 0;
+
+		for (int i = 0; i < 4; ++i)
+		{
+			if (i != largest)
+			{
+				const float normalizedValue = (components[i] * sign + 0.70710678f) * (32767.0f / 1.41421356f);
+				outValues[index++] = static_cast<uint16>(nsMath::Clamp(static_cast<int>(normalizedValue + 0.5f), 0, 32767));
+			}
+		}
+
+		outValues[0] |= static_cast<uint16>((largest & 1) << 15);
+		outValues[1] |= static_cast<uint16>((largest >> 1) << 15);
+	}
+
+
+	NS_NODISCARD_INLINE nsQuaternion DecodeQuaternion48(const uint16* values) noexcept
+	{
+		// Smallest three components are in range [-1/sqrt(2), 1/sqrt(2)]
+		const float scale = 1.41421356f / 32767.0f;
+		const int largest = (values[0] >> 15) | ((values[1] >> 15) << 1);
+		const float a = static_cast<float>(values[0] & 0x7FFF) * scale - 0.70710678f;
+		const float b = static_cast<float>(values[1] & 0x7FFF) * scale - 0.70710678f;
+		const float c = static_cast<float>(values[2] & 0x7FFF) * scale - 0.70710678f;
+		const float d = nsMath::Sqrt(nsMath::Max(0.0f, 1.0f - a * a - b * b - c * c));
+
+		switch (largest)
+		{
+			case 0: return nsQuaternion(d, a, b, c);
+			case 1: return nsQuaternion(a, d, b, c);
+			case 2: return nsQuaternion(a, b, d, c);
+			default: break;
+		}
+
+		return nsQuaternion(a, b, c, d);
+	}
+
+};
@@ -4,6 +4,26 @@
 
 
 
+class nsStream;
+
+
+// Detects custom serialization operator (friend NS_INLINE void operator|(nsStream&, T&)), found by ADL
+template<typename T, typename = void>
+struct nsTStreamHasCustomOperator : std::false_type {};
+
+template<typename T>
+struct nsTStreamHasCustomOperator<T, decltype(operator|(std::declval<nsStream&>(), std::declval<T&>()), void())> : std::true_type {};
+
+
+// Array of T can be serialized as one memory block if T is trivially copyable and has no custom serialization
+template<typename T>
+struct nsTStreamBitwise
+{
+	static constexpr bool Value = std::is_trivially_copyable<T>::value && !std::is_same<T, nsName>::value && !nsTStreamHasCustomOperator<T>::value;
+};
+
+
+
 class NS_CORE_API nsStream
 {
 	NS_DECLARE_NOCOPY(nsStream)
@@ -17,6 +37,26 @@ public:
 	virtual bool IsLoading() const noexcept = 0;
 
 
+private:
+	template<typename T>
+	NS_INLINE void SerializeElements(T* data, int count) noexcept
+	{
+		if constexpr (nsTStreamBitwise<T>::Value)
+		{
+			SerializeData(data, static_cast<int>(sizeof(T)) * count);
+		}
+		else
+		{
+			for (int i = 0; i < count; ++i)
+			{
+				*this | data[i];
+			}
+		}
+	}
+
+
+public:
+
 	template<typename T>
 	NS_INLINE nsStream& operator|(T& rhs) noexcept
 	{
@@ -38,10 +78,7 @@ public:
 				rhs.Resize(count);
 			}
 
-			for (int i = 0; i < count; ++i)
-			{
-				*this | rhs[i];
-			}
+			SerializeElements(rhs.GetData(), count);
 		}
 
 		return *this;
@@ -61,10 +98,7 @@ public:
 				rhs.Resize(count);
 			}
 
-			for (int i = 0; i < count; ++i)
-			{
-				*this | rhs[i];
-			}
+			SerializeElements(rhs.GetData(), count);
 		}
 
 		return *this;
@@ -144,25 +178,33 @@ public:
 class NS_CORE_API nsBinaryStreamReader : public nsStream
 {
 private:
+	// Owned buffer, empty if reader views external memory
 	nsTArray<uint8> Buffer;
+
+	const uint8* Data;
+	int Size;
 	int Offset;
 
 
 public:
 	nsBinaryStreamReader(nsTArray<uint8> data) noexcept;
+
+	// View external memory (e.g. nsFileMappedView) without copy, data must outlive the reader
+	nsBinaryStreamReader(const uint8* data, int dataSize) noexcept;
+
 	virtual void SerializeData(void* data, int dataSize) noexcept override;
 	virtual bool IsLoading() const noexcept override { return true; }
 
 
 	NS_NODISCARD_INLINE const uint8* GetBufferData() const noexcept
 	{
-		return Buffer.GetData();
+		return Data;
 	}
 
 
 	NS_NODISCARD_INLINE int GetBufferSize() const noexcept
 	{
-		return Buffer.GetCount();
+		return Size;
 	}
 
 
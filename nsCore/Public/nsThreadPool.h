@@ -4,12 +4,118 @@
 
 
 
+typedef uint32 nsThreadId;
+
+
+namespace nsEThreadAffinity
+{
+	enum Mask
+	{
+		None				= (0),
+
+		Thread_Main			= (1 << 0),
+		Thread_Worker_00	= (1 << 1),
+		Thread_Worker_01	= (1 << 2),
+		Thread_Worker_02	= (1 << 3),
+		Thread_Worker_03	= (1 << 4),
+		Thread_Worker_04	= (1 << 5),
+		Thread_Worker_05	= (1 << 6),
+		Thread_Worker_06	= (1 << 7),
+		Thread_Worker_07	= (1 << 8),
+		Thread_Worker_08	= (1 << 9),
+		Thread_Worker_09	= (1 << 10),
+		Thread_Worker_10	= (1 << 11),
+		Thread_Worker_11	= (1 << 12),
+		Thread_Worker_12	= (1 << 13),
+		Thread_Worker_13	= (1 << 14),
+		Thread_Worker_14	= (1 << 15),
+		Thread_Worker_15	= (1 << 16),
+		Thread_Worker_16	= (1 << 16),
+		Thread_Worker_17	= (1 << 17),
+		Thread_Worker_18	= (1 << 18),
+		Thread_Worker_19	= (1 << 19),
+		Thread_Worker_20	= (1 << 20),
+		Thread_Worker_21	= (1 << 21),
+		Thread_Worker_22	= (1 << 22),
+		Thread_Worker_23	= (1 << 23),
+		Thread_Worker_24	= (1 << 24),
+		Thread_Worker_25	= (1 << 25),
+		Thread_Worker_26	= (1 << 26),
+		Thread_Worker_27	= (1 << 27),
+		Thread_Worker_28	= (1 << 28),
+		Thread_Worker_29	= (1 << 29),
+		Thread_Worker_30	= (1 << 30),
+		Thread_Worker_31	= (1 << 31),
+
+		Thread_ExcludeMain	= (UINT32_MAX - 1),
+		Thread_ALL			= (UINT32_MAX)
+	};
+};
+
+typedef uint32 nsThreadAffinityMasks;
+
+// Called with chunk range [chunkBegin, chunkEnd) by nsThreadPool::ParallelFor
+typedef void(*nsParallelForFunction)(int chunkBegin, int chunkEnd, void* userData);
+
+
+
+class nsThreadTaskCounter
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsThreadTaskCounter)
+
+private:
+	nsAtomic Value;
+
+public:
+	nsThreadTaskCounter() noexcept {}
+
+
+	NS_INLINE void Add(int count) noexcept
+	{
+		Value.Add(count);
+	}
+
+
+	NS_INLINE void Decrement() noexcept
+	{
+		Value.Decrement();
+	}
+
+
+	NS_NODISCARD_INLINE int GetValue() const noexcept
+	{
+		return Value.Get();
+	}
+
+
+	NS_NODISCARD_INLINE bool IsDone() const noexcept
+	{
+		return Value.Get() <= 0;
+	}
+
+};
+
+
+
 class NS_CORE_API nsIThreadTask
 {
 	NS_DECLARE_NOCOPY(nsIThreadTask)
 
 public:
-	nsIThreadTask() noexcept {}
+	// [Threadpool only] Counter to decrement after Execute(), assigned on submit
+	nsThreadTaskCounter* SubmitCounter;
+
+	// [Threadpool only] Threads that are allowed to execute this task, assigned on submit
+	nsThreadAffinityMasks SubmitAffinityMasks;
+
+
+public:
+	nsIThreadTask() noexcept 
+		: SubmitCounter(nullptr)
+		, SubmitAffinityMasks(0)
+	{
+	}
+
 	virtual ~nsIThreadTask() noexcept {}
 	virtual void Reset() noexcept = 0;
 	virtual void Execute() noexcept = 0;
@@ -67,55 +173,98 @@ public:
 };
 
 
-typedef uint32 nsThreadId;
+class nsThreadTaskGraph;
 
 
-namespace nsEThreadAffinity
+// [Internal] Wraps a task in task graph and schedules its continuations after executed
+class NS_CORE_API nsThreadTaskGraphNode : public nsIThreadTask
 {
-	enum Mask
-	{
-		None				= (0),
+public:
+	nsThreadTaskGraph* Graph;
+	nsIThreadTask* Task;
+	nsThreadAffinityMasks AffinityMasks;
+	int DependencyCount;
+	nsAtomic PendingDependencyCount;
+	nsTArray<int> Continuations;
 
-		Thread_Main			= (1 << 0),
-		Thread_Worker_00	= (1 << 1),
-		Thread_Worker_01	= (1 << 2),
-		Thread_Worker_02	= (1 << 3),
-		Thread_Worker_03	= (1 << 4),
-		Thread_Worker_04	= (1 << 5),
-		Thread_Worker_05	= (1 << 6),
-		Thread_Worker_06	= (1 << 7),
-		Thread_Worker_07	= (1 << 8),
-		Thread_Worker_08	= (1 << 9),
-		Thread_Worker_09	= (1 << 10),
-		Thread_Worker_10	= (1 << 11),
-		Thread_Worker_11	= (1 << 12),
-		Thread_Worker_12	= (1 << 13),
-		Thread_Worker_13	= (1 << 14),
-		Thread_Worker_14	= (1 << 15),
-		Thread_Worker_15	= (1 << 16),
-		Thread_Worker_16	= (1 << 16),
-		Thread_Worker_17	= (1 << 17),
-		Thread_Worker_18	= (1 << 18),
-		Thread_Worker_19	= (1 << 19),
-		Thread_Worker_20	= (1 << 20),
-		Thread_Worker_21	= (1 << 21),
-		Thread_Worker_22	= (1 << 22),
-		Thread_Worker_23	= (1 << 23),
-		Thread_Worker_24	= (1 << 24),
-		Thread_Worker_25	= (1 << 25),
-		Thread_Worker_26	= (1 << 26),
-		Thread_Worker_27	= (1 << 27),
-		Thread_Worker_28	= (1 << 28),
-		Thread_Worker_29	= (1 << 29),
-		Thread_Worker_30	= (1 << 30),
-		Thread_Worker_31	= (1 << 31),
+private:
+	nsAtomic bDone;
+
+
+public:
+	nsThreadTaskGraphNode() noexcept;
+	virtual void Reset() noexcept override;
+	virtual void Execute() noexcept override;
+	virtual bool IsIdle() const noexcept override;
+	virtual bool IsRunning() const noexcept override;
+	virtual bool IsDone() const noexcept override;
+
+#ifdef _DEBUG
+	virtual nsString GetDebugName() const noexcept override;
+#endif // _DEBUG
 
-		Thread_ExcludeMain	= (UINT32_MAX - 1),
-		Thread_ALL			= (UINT32_MAX)
-	};
 };
 
-typedef uint32 nsThreadAffinityMasks;
+
+
+// Directed acyclic graph of tasks (fork/join).
+// A task is submitted to thread pool as soon as all of its dependencies finished executing.
+// Graph can be submitted again after Wait() returns. Tasks are not owned by graph.
+class NS_CORE_API nsThreadTaskGraph
+{
+	NS_DECLARE_NOCOPY_NOMOVE(nsThreadTaskGraph)
+
+private:
+	nsTArray<nsThreadTaskGraphNode> Nodes;
+	nsThreadTaskCounter Counter;
+
+
+public:
+	nsThreadTaskGraph() noexcept;
+
+	// Add task to graph, returns node index
+	int AddTask(nsIThreadTask* task, nsThreadAffinityMasks threadAffinityMasks = nsEThreadAffinity::Thread_ALL) noexcept;
+
+	// Task at node index <node> will not start before task at node index <dependency> finished
+	void AddDependency(int node, int dependency) noexcept;
+
+	// Task at node index <continuation> starts after task at node index <node> finished
+	NS_INLINE void AddContinuation(int node, int continuation) noexcept
+	{
+		AddDependency(continuation, node);
+	}
+
+	// [Main/Worker thread only] Submit all tasks that have no dependencies. The rest are submitted when their dependencies finished
+	void Submit() noexcept;
+
+	// [Main/Worker thread only] Wait until all tasks in graph finished. Calling thread executes queued tasks while waiting
+	void Wait() noexcept;
+
+	// Remove all tasks
+	void Clear() noexcept;
+
+
+	NS_NODISCARD_INLINE bool IsDone() const noexcept
+	{
+		return Counter.IsDone();
+	}
+
+
+	NS_NODISCARD_INLINE int GetTaskCount() const noexcept
+	{
+		return Nodes.GetCount();
+	}
+
+
+	NS_NODISCARD_INLINE const nsThreadTaskCounter& GetCounter() const noexcept
+	{
+		return Counter;
+	}
+
+
+	friend class nsThreadTaskGraphNode;
+
+};
 
 
 
@@ -127,14 +276,30 @@ namespace nsThreadPool
 	// Shutdown threadpool. Will wait for all worker threads
 	extern NS_CORE_API void Shutdown() noexcept;
 
-	// [Main thread only] Submit tasks to specific thread mask.
+	// [Main/Worker thread only] Submit tasks to specific thread mask.
+	// Tasks that can run on all worker threads are pushed to calling thread queue and stolen by idle threads.
+	// Tasks pinned to subset of worker threads are distributed to those threads only.
+	// Tasks pinned to main thread only are executed immediately if called from main thread.
 	// Bit [0] = main thread
 	// Bit [1..31] = worker threads
-	extern NS_CORE_API void SubmitTasks(nsIThreadTask** tasks, int taskCount, nsThreadAffinityMasks threadAffinityMasks) noexcept;
+	// If <optCounter> is not null, it is incremented by taskCount and decremented each time a task finished executing
+	extern NS_CORE_API void SubmitTasks(nsIThreadTask** tasks, int taskCount, nsThreadAffinityMasks threadAffinityMasks, nsThreadTaskCounter* optCounter = nullptr) noexcept;
+
+	// [Main/Worker thread only] Wait until counter reaches zero. Calling thread executes (steals) queued tasks while waiting
+	extern NS_CORE_API void WaitForCounter(const nsThreadTaskCounter& counter) noexcept;
 
 	// Get worker threads (includes main thread at index 0)
 	NS_NODISCARD extern NS_CORE_API nsTArrayInline<nsThreadId, 32> GetWorkerThreads() noexcept;
 
+	// Get number of threads that execute tasks (includes main thread)
+	NS_NODISCARD extern NS_CORE_API int GetThreadCount() noexcept;
+
+	// [Main/Worker thread only] Call <function> for chunks of range [begin, end) across threads, returns when all chunks finished.
+	// Runs serially on calling thread if range is not bigger than <grainSize> or there is only one thread.
+	// <grainSize> is the minimum chunk size, if <= 0 it is computed from range and thread count.
+	// <maxThreadCount> limits number of threads that take part in the loop, if <= 0 all threads are used.
+	extern NS_CORE_API void ParallelFor(int begin, int end, int grainSize, nsParallelForFunction function, void* userData, int maxThreadCount = 0) noexcept;
+
 	// Check if current thread is main thread
 	NS_NODISCARD extern NS_CORE_API bool IsMainThread() noexcept;
 
@@ -143,3 +308,27 @@ namespace nsThreadPool
 
 
 #define NS_Validate_IsMainThread() NS_Validate(nsThreadPool::IsMainThread())
+
+
+
+// Data-parallel loop, calls <lambda>(int index) for each index in range [begin, end).
+// Chunks start big and shrink as the range runs out (guided scheduling), so threads that finish early take over the remaining work.
+// Lambda may be called concurrently from multiple threads.
+template<typename TLambda>
+NS_INLINE void nsParallelFor(int begin, int end, int grainSize, TLambda&& lambda, int maxThreadCount = 0) noexcept
+{
+	typedef typename std::remove_reference<TLambda>::type TLambdaType;
+
+	nsThreadPool::ParallelFor(begin, end, grainSize, 
+		[](int chunkBegin, int chunkEnd, void* userData)
+		{
+			TLambdaType& func = *static_cast<TLambdaType*>(userData);
+
+			for (int i = chunkBegin; i < chunkEnd; ++i)
+			{
+				func(i);
+			}
+		},
+		const_cast<void*>(static_cast<const void*>(&lambda)), maxThreadCount
+	);
+}
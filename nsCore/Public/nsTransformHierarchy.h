@@ -0,0 +1,143 @@
+#pragma once
+
+#include "nsContainer.h"
+#include "nsMath.h"
+
+
+
+// Number of transforms processed per SIMD instruction, SoA component streams are padded to multiple of this
+#if NS_MATH_SIMD && defined(__AVX__)
+#define NS_TRANSFORM_SOA_WIDTH		(8)
+#else
+#define NS_TRANSFORM_SOA_WIDTH		(4)
+#endif // NS_MATH_SIMD && __AVX__
+
+
+
+// Transforms stored as one stream per component (structure of arrays). Padding transforms are identity
+class nsTransformSoA
+{
+public:
+	enum EComponent
+	{
+		POSITION_X = 0,
+		POSITION_Y,
+		POSITION_Z,
+		ROTATION_X,
+		ROTATION_Y,
+		ROTATION_Z,
+		ROTATION_W,
+		SCALE_X,
+		SCALE_Y,
+		SCALE_Z,
+		COMPONENT_COUNT
+	};
+
+private:
+	nsTArray<float> Components;
+	int Count;
+	int PaddedCount;
+
+
+public:
+	nsTransformSoA() noexcept
+		: Count(0)
+		, PaddedCount(0)
+	{
+	}
+
+
+	// Resize to <count> transforms, all transforms are reset to identity
+	NS_INLINE void Resize(int count) noexcept
+	{
+		Count = count;
+		PaddedCount = (count + NS_TRANSFORM_SOA_WIDTH - 1) / NS_TRANSFORM_SOA_WIDTH * NS_TRANSFORM_SOA_WIDTH;
+		Components.Resize(PaddedCount * COMPONENT_COUNT);
+
+		for (int i = 0; i < PaddedCount; ++i)
+		{
+			Set(i, nsTransform());
+		}
+	}
+
+
+	NS_INLINE void Set(int index, const nsTransform& transform) noexcept
+	{
+		NS_Assert(index >= 0 && index < PaddedCount);
+
+		float* data = Components.GetData() + index;
+		data[POSITION_X * PaddedCount] = transform.Position.X;
+		data[POSITION_Y * PaddedCount] = transform.Position.Y;
+		data[POSITION_Z * PaddedCount] = transform.Position.Z;
+		data[ROTATION_X * PaddedCount] = transform.Rotation.X;
+		data[ROTATION_Y * PaddedCount] = transform.Rotation.Y;
+		data[ROTATION_Z * PaddedCount] = transform.Rotation.Z;
+		data[ROTATION_W * PaddedCount] = transform.Rotation.W;
+		data[SCALE_X * PaddedCount] = transform.Scale.X;
+		data[SCALE_Y * PaddedCount] = transform.Scale.Y;
+		data[SCALE_Z * PaddedCount] = transform.Scale.Z;
+	}
+
+
+	NS_NODISCARD_INLINE nsTransform Get(int index) const noexcept
+	{
+		NS_Assert(index >= 0 && index < PaddedCount);
+
+		const float* data = Components.GetData() + index;
+
+		return nsTransform(
+			nsVector3(data[POSITION_X * PaddedCount], data[POSITION_Y * PaddedCount], data[POSITION_Z * PaddedCount]),
+			nsQuaternion(data[ROTATION_X * PaddedCount], data[ROTATION_Y * PaddedCount], data[ROTATION_Z * PaddedCount], data[ROTATION_W * PaddedCount]),
+			nsVector3(data[SCALE_X * PaddedCount], data[SCALE_Y * PaddedCount], data[SCALE_Z * PaddedCount])
+		);
+	}
+
+
+	NS_NODISCARD_INLINE float* GetComponent(EComponent component) noexcept
+	{
+		return Components.GetData() + component * PaddedCount;
+	}
+
+
+	NS_NODISCARD_INLINE const float* GetComponent(EComponent component) const noexcept
+	{
+		return Components.GetData() + component * PaddedCount;
+	}
+
+
+	NS_NODISCARD_INLINE int GetCount() const noexcept
+	{
+		return Count;
+	}
+
+
+	NS_NODISCARD_INLINE int GetPaddedCount() const noexcept
+	{
+		return PaddedCount;
+	}
+
+};
+
+
+
+namespace nsTransformHierarchy
+{
+	// Sort hierarchy into parent-first order, outOrder[i] is index (in parentIds) of i-th transform.
+	// Order of transforms already in parent-first order is kept. Returns false if hierarchy has cycle or invalid parent
+	NS_NODISCARD extern NS_CORE_API bool SortParentFirst(const int* parentIds, int count, int* outOrder) noexcept;
+
+	// Compute model matrix (local * parent model) and skinning matrix (inverse bind pose * model) of each transform in single pass.
+	// Transforms are in parent-first order (parentIds[i] < i, -1 for root), skinning matrix of i-th transform is written to outSkinMatrices[skinIds[i]].
+	// Local matrices are built from SoA streams for NS_TRANSFORM_SOA_WIDTH transforms at a time
+	extern NS_CORE_API void ComputeMatrices(const nsTransformSoA& localTransforms, const int* parentIds, const nsMatrix4* inverseBindPoses, const int* skinIds, nsMatrix4* outModelMatrices, nsMatrix4* outSkinMatrices) noexcept;
+
+	// Blend <poseCount> poses by <poseWeights> (sum of 1) in single pass, rotations are normalized lerp.
+	// Result replaces <inOutPose>, or if <boneWeights> (one per padded transform) is set, <inOutPose> is lerped towards result by bone weight.
+	// <inOutPose> may be one of <poses>
+	extern NS_CORE_API void BlendPoses(const nsTransformSoA* const* poses, const float* poseWeights, int poseCount, const float* boneWeights, nsTransformSoA& inOutPose) noexcept;
+
+	// Add weighted delta of <poses> relative to <referencePoses> on top of <inOutPose>, delta is scaled per transform by <boneWeights> if set.
+	// Delta position is difference, delta rotation is conjugate(reference) * rotation applied as rotation * delta, delta scale is ratio
+	extern NS_CORE_API void AddPoses(const nsTransformSoA* const* poses, const nsTransformSoA* const* referencePoses, const float* poseWeights, int poseCount, const float* boneWeights, nsTransformSoA& inOutPose) noexcept;
+
+};
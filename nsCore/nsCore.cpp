@@ -2,13 +2,19 @@
 
 #ifdef NS_PLATFORM_WINDOWS
 #include "Private/Win64_Platform.cpp"
-#include "Private/Win64_Threadpool.cpp"
 #include "Private/Win64_Window.cpp"
 #include "Private/Win64_FileSystem.cpp"
 #endif // NS_PLATFORM_WINDOWS
 
+#ifdef NS_PLATFORM_POSIX
+#include "Private/Posix_Platform.cpp"
+#include "Private/Posix_FileSystem.cpp"
+#endif // NS_PLATFORM_POSIX
+
 #include "Private/nsReflection.cpp"
+#include "Private/nsAsyncLoad.cpp"
 #include "Private/nsCommandLines.cpp"
+#include "Private/nsCompression.cpp"
 #include "Private/nsFileSystem.cpp"
 #include "Private/nsLogger.cpp"
 #include "Private/nsMath.cpp"
@@ -16,3 +22,5 @@
 #include "Private/nsStream.cpp"
 #include "Private/nsString.cpp"
 #include "Private/nsObject.cpp"
+#include "Private/nsThreadPool.cpp"
+#include "Private/nsTransformHierarchy.cpp"
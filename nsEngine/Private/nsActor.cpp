@@ -8,7 +8,7 @@
 
 static nsLogCategory ActorLog(TEXT("nsActorLog"), nsELogVerbosity::LV_DEBUG);
 
-nsMemory nsActor::ComponentMemory("actor_components", NS_MEMORY_SIZE_MiB(1));
+nsMemoryPool nsActor::ComponentMemory("actor_components", NS_MEMORY_SIZE_MiB(1));
 
 
 
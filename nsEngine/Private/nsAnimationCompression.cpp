@@ -0,0 +1,306 @@
+#include "nsAnimationCompression.h"
+
+
+
+// Minimum distance (cm) used to measure rotation/scale error of bones without children
+#define NS_ANIMATION_COMPRESSION_MIN_SHELL_DISTANCE		(3.0f)
+
+// Maximum number of source keys removed between two kept keys, bounds compression time of near linear tracks
+#define NS_ANIMATION_COMPRESSION_MAX_KEY_SPAN			(256)
+
+
+typedef nsAnimationKeyFrame::TChannel<nsVector3> nsAnimationVectorKey;
+typedef nsAnimationKeyFrame::TChannel<nsQuaternion> nsAnimationRotationKey;
+
+
+
+static NS_INLINE float ns_AnimationVectorError(const nsVector3& a, const nsVector3& b, float scale) noexcept
+{
+	return (a - b).GetMagnitude() * scale;
+}
+
+
+// Displacement of point at <distance> rotated by difference between a and b (normalized)
+static NS_INLINE float ns_AnimationRotationError(const nsQuaternion& a, const nsQuaternion& b, float distance) noexcept
+{
+	const float sign = (a.X * b.X + a.Y * b.Y + a.Z * b.Z + a.W * b.W) < 0.0f ? -1.0f : 1.0f;
+	const float dx = a.X - b.X * sign;
+	const float dy = a.Y - b.Y * sign;
+	const float dz = a.Z - b.Z * sign;
+	const float dw = a.W - b.W * sign;
+
+	// Chord = 2 * sin(angle / 4), displacement = 2 * sin(angle / 2) * distance. Avoids acos/dot precision loss on small angles
+	const float chord = nsMath::Sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+
+	return 2.0f * chord * nsMath::Sqrt(nsMath::Max(0.0f, 1.0f - chord * chord * 0.25f)) * distance;
+}
+
+
+// Greedy key reduction, extend interval from last kept key while every key in between is interpolated within <maxError>.
+// Interpolation uses <decodedValues> (quantized -> dequantized key values) as sampled at runtime, error is measured against source keys
+template<typename T, typename TInterpolate, typename TError>
+static void ns_AnimationReduceKeys(const nsTArray<nsAnimationKeyFrame::TChannel<T>>& keys, const nsTArray<T>& decodedValues, float maxError, TInterpolate interpolate, TError error, nsTArray<int>& outKeptKeys) noexcept
+{
+	NS_Assert(keys.GetCount() == decodedValues.GetCount());
+
+	const int count = keys.GetCount();
+	outKeptKeys.Clear();
+	outKeptKeys.Add(0);
+
+	int anchor = 0;
+
+	for (int candidate = 2; candidate < count; ++candidate)
+	{
+		const float timeA = keys[anchor].Timestamp;
+		const float interval = keys[candidate].Timestamp - timeA;
+		bool bWithinError = candidate - anchor <= NS_ANIMATION_COMPRESSION_MAX_KEY_SPAN && interval > 0.0f;
+
+		for (int k = anchor + 1; k < candidate && bWithinError; ++k)
+		{
+			const float alpha = (keys[k].Timestamp - timeA) / interval;
+			bWithinError = error(interpolate(decodedValues[anchor], decodedValues[candidate], alpha), keys[k].Value) <= maxError;
+		}
+
+		if (!bWithinError)
+		{
+			anchor = candidate - 1;
+			outKeptKeys.Add(anchor);
+		}
+	}
+
+	if (count > 1)
+	{
+		outKeptKeys.Add(count - 1);
+	}
+}
+
+
+class nsAnimationClipCompressor
+{
+private:
+	const nsAnimationClipData& Clip;
+	nsAnimationCompressedClipData& Compressed;
+	float MaxError;
+	nsTArray<int> KeptKeys;
+	nsTArray<nsVector3> DecodedVectors;
+	nsTArray<nsQuaternion> DecodedRotations;
+
+
+public:
+	nsAnimationClipCompressor(const nsAnimationClipData& clip, nsAnimationCompressedClipData& compressed, float maxError) noexcept
+		: Clip(clip)
+		, Compressed(compressed)
+		, MaxError(maxError)
+	{
+	}
+
+
+private:
+	NS_NODISCARD uint16 QuantizeTime(float timestamp) const noexcept
+	{
+		return static_cast<uint16>(nsMath::Clamp(static_cast<int>(timestamp / Clip.Duration * 65535.0f + 0.5f), 0, 65535));
+	}
+
+
+	// Add kept keys with increasing quantized time to track. Keys that quantize to the same time as previous key are dropped.
+	// Returns false if less than 2 keys remain, track must be stored as constant
+	template<typename T, typename TEncode>
+	NS_NODISCARD bool AddAnimatedKeys(nsAnimationCompressedTrack& track, const nsTArray<nsAnimationKeyFrame::TChannel<T>>& keys, TEncode encode) noexcept
+	{
+		const int firstKey = Compressed.KeyTimes.GetCount();
+		int keyCount = 0;
+
+		for (int i = 0; i < KeptKeys.GetCount(); ++i)
+		{
+			const nsAnimationKeyFrame::TChannel<T>& key = keys[KeptKeys[i]];
+			const uint16 time = QuantizeTime(key.Timestamp);
+
+			if (keyCount > 0 && time <= Compressed.KeyTimes[firstKey + keyCount - 1])
+			{
+				continue;
+			}
+
+			uint16 values[3];
+			encode(key.Value, values);
+			Compressed.KeyTimes.Add(time);
+			Compressed.KeyValues.InsertAt(values, 3);
+			keyCount++;
+		}
+
+		if (keyCount < 2)
+		{
+			Compressed.KeyTimes.Resize(firstKey);
+			Compressed.KeyValues.Resize(firstKey * 3);
+			return false;
+		}
+
+		track.FirstKey = firstKey;
+		track.KeyCount = keyCount;
+
+		return true;
+	}
+
+
+	void SetConstant(nsAnimationCompressedTrack& track, const nsVector4& value) noexcept
+	{
+		track.FirstKey = Compressed.ConstantValues.GetCount();
+		track.KeyCount = 1;
+		Compressed.ConstantValues.Add(value);
+	}
+
+
+public:
+	void AddVectorTrack(const nsTArray<nsAnimationVectorKey>& keys, float errorScale) noexcept
+	{
+		nsAnimationCompressedTrack& track = Compressed.Tracks.Add();
+		nsPlatform::Memory_Zero(&track, sizeof(nsAnimationCompressedTrack));
+
+		if (keys.GetCount() == 0)
+		{
+			return;
+		}
+
+		const nsVector3& first = keys[0].Value;
+		bool bConstant = true;
+
+		for (int i = 1; i < keys.GetCount() && bConstant && Clip.Duration > 0.0f; ++i)
+		{
+			bConstant = ns_AnimationVectorError(keys[i].Value, first, errorScale) <= MaxError;
+		}
+
+		if (bConstant)
+		{
+			SetConstant(track, nsVector4(first.X, first.Y, first.Z, 0.0f));
+			return;
+		}
+
+		// Range covers all source keys so reduction can be measured on quantized values. Kept keys only differ by quantization (half 16-bit step of range)
+		nsVector3 rangeMin = first;
+		nsVector3 rangeMax = first;
+
+		for (int i = 1; i < keys.GetCount(); ++i)
+		{
+			const nsVector3& value = keys[i].Value;
+			rangeMin = nsVector3(nsMath::Min(rangeMin.X, value.X), nsMath::Min(rangeMin.Y, value.Y), nsMath::Min(rangeMin.Z, value.Z));
+			rangeMax = nsVector3(nsMath::Max(rangeMax.X, value.X), nsMath::Max(rangeMax.Y, value.Y), nsMath::Max(rangeMax.Z, value.Z));
+		}
+
+		track.RangeMin[0] = rangeMin.X;
+		track.RangeMin[1] = rangeMin.Y;
+		track.RangeMin[2] = rangeMin.Z;
+		track.RangeExtent[0] = rangeMax.X - rangeMin.X;
+		track.RangeExtent[1] = rangeMax.Y - rangeMin.Y;
+		track.RangeExtent[2] = rangeMax.Z - rangeMin.Z;
+
+		auto encode = [&track](const nsVector3& value, uint16* outValues)
+		{
+			outValues[0] = nsQuantization::EncodeRange16(value.X, track.RangeMin[0], track.RangeExtent[0]);
+			outValues[1] = nsQuantization::EncodeRange16(value.Y, track.RangeMin[1], track.RangeExtent[1]);
+			outValues[2] = nsQuantization::EncodeRange16(value.Z, track.RangeMin[2], track.RangeExtent[2]);
+		};
+
+		DecodedVectors.Resize(keys.GetCount());
+
+		for (int i = 0; i < keys.GetCount(); ++i)
+		{
+			uint16 values[3];
+			encode(keys[i].Value, values);
+			DecodedVectors[i] = nsAnimationCompression::DecodeVector(track, values);
+		}
+
+		ns_AnimationReduceKeys(keys, DecodedVectors, MaxError, &nsVector3::Lerp, [errorScale](const nsVector3& a, const nsVector3& b) { return ns_AnimationVectorError(a, b, errorScale); }, KeptKeys);
+		const bool bAnimated = AddAnimatedKeys(track, keys, encode);
+
+		if (!bAnimated)
+		{
+			SetConstant(track, nsVector4(first.X, first.Y, first.Z, 0.0f));
+		}
+	}
+
+
+	void AddRotationTrack(const nsTArray<nsAnimationRotationKey>& keys, float shellDistance) noexcept
+	{
+		nsAnimationCompressedTrack& track = Compressed.Tracks.Add();
+		nsPlatform::Memory_Zero(&track, sizeof(nsAnimationCompressedTrack));
+
+		if (keys.GetCount() == 0)
+		{
+			return;
+		}
+
+		const nsQuaternion first = keys[0].Value.GetNormalized();
+		bool bConstant = true;
+
+		for (int i = 1; i < keys.GetCount() && bConstant && Clip.Duration > 0.0f; ++i)
+		{
+			bConstant = ns_AnimationRotationError(keys[i].Value.GetNormalized(), first, shellDistance) <= MaxError;
+		}
+
+		if (bConstant)
+		{
+			SetConstant(track, nsVector4(first.X, first.Y, first.Z, first.W));
+			return;
+		}
+
+		DecodedRotations.Resize(keys.GetCount());
+
+		for (int i = 0; i < keys.GetCount(); ++i)
+		{
+			uint16 values[3];
+			nsQuantization::EncodeQuaternion48(keys[i].Value, values);
+			DecodedRotations[i] = nsAnimationCompression::DecodeRotation(values);
+		}
+
+		ns_AnimationReduceKeys(keys, DecodedRotations, MaxError, &nsQuaternion::Slerp, [shellDistance](const nsQuaternion& a, const nsQuaternion& b) { return ns_AnimationRotationError(a.GetNormalized(), b.GetNormalized(), shellDistance); }, KeptKeys);
+
+		if (!AddAnimatedKeys(track, keys, &nsQuantization::EncodeQuaternion48))
+		{
+			SetConstant(track, nsVector4(first.X, first.Y, first.Z, first.W));
+		}
+	}
+
+};
+
+
+
+void nsAnimationCompression::CompressClip(nsAnimationClipData& clip, const nsAnimationSkeletonData& skeleton) noexcept
+{
+	const int boneCount = clip.KeyFrames.GetCount();
+	NS_Assert(boneCount == skeleton.BoneDatas.GetCount());
+
+	const float maxError = skeleton.CompressionError > 0.0f ? skeleton.CompressionError : NS_ENGINE_ANIMATION_COMPRESSION_ERROR;
+
+	// Rotation/scale error of bone moves its children, measure it at farthest child
+	float shellDistances[NS_ENGINE_ANIMATION_SKELETON_MAX_BONE];
+
+	for (int j = 0; j < boneCount; ++j)
+	{
+		shellDistances[j] = NS_ANIMATION_COMPRESSION_MIN_SHELL_DISTANCE;
+	}
+
+	for (int j = 0; j < boneCount; ++j)
+	{
+		const nsAnimationSkeletonData::Bone& bone = skeleton.BoneDatas[j];
+
+		if (bone.ParentId != -1)
+		{
+			shellDistances[bone.ParentId] = nsMath::Max(shellDistances[bone.ParentId], bone.LocalTransform.Position.GetMagnitude());
+		}
+	}
+
+	nsAnimationCompressedClipData& compressed = clip.Compressed;
+	compressed = nsAnimationCompressedClipData();
+	compressed.Tracks.Reserve(boneCount * 3);
+
+	nsAnimationClipCompressor compressor(clip, compressed, maxError);
+
+	for (int j = 0; j < boneCount; ++j)
+	{
+		const nsAnimationKeyFrame& keyFrame = clip.KeyFrames[j];
+		compressor.AddVectorTrack(keyFrame.PositionChannels, 1.0f);
+		compressor.AddRotationTrack(keyFrame.RotationChannels, shellDistances[j]);
+		compressor.AddVectorTrack(keyFrame.ScaleChannels, shellDistances[j]);
+	}
+
+	clip.KeyFrames.Clear(true);
+}
@@ -1,13 +1,389 @@
 #include "nsAnimationGraph.h"
+#include "nsAnimationManager.h"
+
+
+static nsLogCategory AnimationGraphLog(TEXT("nsAnimationGraphLog"), nsELogVerbosity::LV_DEBUG);
 
 
 
 nsAnimationGraph::nsAnimationGraph()
+	: LastUpdateIndex(0)
+{
+
+}
+
+
+// Sample weights of 1D blend space, x is lerped between nearest samples on both sides
+static void ns_ComputeBlendWeights1D(nsAnimationLayer& layer, float x)
+{
+	int lower = -1;
+	int upper = -1;
+
+	for (int i = 0; i < layer.Samples.GetCount(); ++i)
+	{
+		const nsAnimationBlendSample& sample = layer.Samples[i];
+
+		if (sample.Weight < 0.0f)
+		{
+			continue;
+		}
+
+		const float position = sample.Position.X;
+
+		if (position <= x && (lower == -1 || position > layer.Samples[lower].Position.X))
+		{
+			lower = i;
+		}
+
+		if (position >= x && (upper == -1 || position < layer.Samples[upper].Position.X))
+		{
+			upper = i;
+		}
+	}
+
+	for (int i = 0; i < layer.Samples.GetCount(); ++i)
+	{
+		layer.Samples[i].Weight = 0.0f;
+	}
+
+	if (lower == -1 && upper == -1)
+	{
+		return;
+	}
+
+	// Outside of blend space range, clamp to nearest sample
+	if (lower == -1 || upper == -1 || lower == upper)
+	{
+		layer.Samples[lower == -1 ? upper : lower].Weight = 1.0f;
+		return;
+	}
+
+	const float lowerX = layer.Samples[lower].Position.X;
+	const float alpha = (x - lowerX) / (layer.Samples[upper].Position.X - lowerX);
+	layer.Samples[lower].Weight = 1.0f - alpha;
+	layer.Samples[upper].Weight = alpha;
+}
+
+
+// Sample weights of 2D blend space (gradient band interpolation)
+static void ns_ComputeBlendWeights2D(nsAnimationLayer& layer, const nsVector2& point)
+{
+	const int sampleCount = layer.Samples.GetCount();
+	bool bValids[NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE];
+
+	for (int i = 0; i < sampleCount; ++i)
+	{
+		bValids[i] = layer.Samples[i].Weight >= 0.0f;
+	}
+
+	float totalWeight = 0.0f;
+
+	for (int i = 0; i < sampleCount; ++i)
+	{
+		nsAnimationBlendSample& sample = layer.Samples[i];
+		sample.Weight = 0.0f;
+
+		if (!bValids[i])
+		{
+			continue;
+		}
+
+		const nsVector2 toPoint = point - sample.Position;
+		float weight = 1.0f;
+
+		for (int j = 0; j < sampleCount && weight > 0.0f; ++j)
+		{
+			if (j == i || !bValids[j])
+			{
+				continue;
+			}
+
+			const nsVector2 toOther = layer.Samples[j].Position - sample.Position;
+			const float distanceSqr = toOther.GetMagnitudeSqr();
+
+			if (distanceSqr <= 0.0f)
+			{
+				continue;
+			}
+
+			weight = nsMath::Min(weight, nsMath::Clamp(1.0f - nsVector2::DotProduct(toPoint, toOther) / distanceSqr, 0.0f, 1.0f));
+		}
+
+		sample.Weight = weight;
+		totalWeight += weight;
+	}
+
+	if (totalWeight > 0.0f)
+	{
+		for (int i = 0; i < sampleCount; ++i)
+		{
+			layer.Samples[i].Weight /= totalWeight;
+		}
+	}
+}
+
+
+void nsAnimationGraph::TickUpdate(float deltaTime, uint64 updateIndex)
+{
+	if (LastUpdateIndex == updateIndex)
+	{
+		return;
+	}
+
+	LastUpdateIndex = updateIndex;
+
+	const nsAnimationManager& animationManager = nsAnimationManager::Get();
+
+	for (int i = 0; i < Layers.GetCount(); ++i)
+	{
+		nsAnimationLayer& layer = Layers[i];
+		const int sampleCount = layer.Samples.GetCount();
+
+		float weight = layer.Weight;
+
+		if (layer.WeightParameter != nsName::NONE)
+		{
+			weight *= GetParameterFloat(layer.WeightParameter);
+		}
+
+		layer.EvaluatedWeight = nsMath::Clamp(weight, 0.0f, 1.0f);
+
+		if (sampleCount == 0)
+		{
+			layer.EvaluatedWeight = 0.0f;
+			continue;
+		}
+
+		// Mark invalid clips, they never receive weight
+		for (int s = 0; s < sampleCount; ++s)
+		{
+			nsAnimationBlendSample& sample = layer.Samples[s];
+			sample.Weight = animationManager.IsClipValid(sample.Clip) ? 0.0f : -1.0f;
+		}
+
+		if (layer.ParameterX == nsName::NONE)
+		{
+			for (int s = 0; s < sampleCount; ++s)
+			{
+				layer.Samples[s].Weight = s == 0 && layer.Samples[s].Weight == 0.0f ? 1.0f : 0.0f;
+			}
+		}
+		else if (layer.ParameterY == nsName::NONE)
+		{
+			ns_ComputeBlendWeights1D(layer, GetParameterFloat(layer.ParameterX));
+		}
+		else
+		{
+			ns_ComputeBlendWeights2D(layer, nsVector2(GetParameterFloat(layer.ParameterX), GetParameterFloat(layer.ParameterY)));
+		}
+
+		// Samples are time-synchronized, phase advances by weighted duration so blended cycles stay in step
+		float duration = 0.0f;
+
+		for (int s = 0; s < sampleCount; ++s)
+		{
+			const nsAnimationBlendSample& sample = layer.Samples[s];
+
+			if (sample.Weight > 0.0f)
+			{
+				duration += sample.Weight * animationManager.GetClipData(sample.Clip).Duration;
+			}
+		}
+
+		if (duration > 0.0f)
+		{
+			layer.Phase += deltaTime * layer.PlayRate / duration;
+		}
+
+		layer.Phase = layer.bLooping ? nsMath::ModF(layer.Phase, 1.0f) : nsMath::Clamp(layer.Phase, 0.0f, 1.0f);
+
+		for (int s = 0; s < sampleCount; ++s)
+		{
+			nsAnimationBlendSample& sample = layer.Samples[s];
+			sample.Timestamp = sample.Weight > 0.0f ? layer.Phase * animationManager.GetClipData(sample.Clip).Duration : 0.0f;
+		}
+	}
+}
+
+
+void nsAnimationGraph::SetParameterBool(const nsName& name, bool value)
+{
+	ParameterBools[name] = value;
+}
+
+
+void nsAnimationGraph::SetParameterInt(const nsName& name, int value)
+{
+	ParameterInts[name] = value;
+}
+
+
+void nsAnimationGraph::SetParameterFloat(const nsName& name, float value)
+{
+	ParameterFloats[name] = value;
+}
+
+
+void nsAnimationGraph::SetParameterVector(const nsName& name, const nsVector3& value)
+{
+	ParameterVectors[name] = value;
+}
+
+
+bool nsAnimationGraph::GetParameterBool(const nsName& name) const
+{
+	const bool* value = ParameterBools.GetValueByKey(name);
+	return value ? *value : false;
+}
+
+
+int nsAnimationGraph::GetParameterInt(const nsName& name) const
+{
+	const int* value = ParameterInts.GetValueByKey(name);
+	return value ? *value : 0;
+}
+
+
+float nsAnimationGraph::GetParameterFloat(const nsName& name) const
+{
+	const float* value = ParameterFloats.GetValueByKey(name);
+	return value ? *value : 0.0f;
+}
+
+
+nsVector3 nsAnimationGraph::GetParameterVector(const nsName& name) const
+{
+	const nsVector3* value = ParameterVectors.GetValueByKey(name);
+	return value ? *value : nsVector3::ZERO;
+}
+
+
+int nsAnimationGraph::AddLayer(const nsName& name, nsEAnimationLayerBlendMode blendMode, float weight)
+{
+	if (FindLayer(name) != -1)
+	{
+		NS_LogWarning(AnimationGraphLog, TEXT("Animation layer with name [%s] already exists!"), *name.ToString());
+	}
+
+	nsAnimationManager::Get().WaitAnimationPoses();
+
+	nsAnimationLayer& layer = Layers.Add();
+	layer.Name = name;
+	layer.BlendMode = blendMode;
+	layer.Weight = weight;
+	layer.WeightParameter = nsName::NONE;
+	layer.ParameterX = nsName::NONE;
+	layer.ParameterY = nsName::NONE;
+	layer.PlayRate = 1.0f;
+	layer.bLooping = true;
+	layer.Phase = 0.0f;
+	layer.EvaluatedWeight = 0.0f;
+
+	return Layers.GetCount() - 1;
+}
+
+
+int nsAnimationGraph::FindLayer(const nsName& name) const
 {
+	for (int i = 0; i < Layers.GetCount(); ++i)
+	{
+		if (Layers[i].Name == name)
+		{
+			return i;
+		}
+	}
 
+	return -1;
 }
 
 
-void nsAnimationGraph::TickUpdate(float deltaTime)
+void nsAnimationGraph::AddLayerSample(int layer, nsAnimationClipID clip, const nsVector2& position)
 {
+	NS_Assert(layer >= 0 && layer < Layers.GetCount());
+	nsAnimationManager::Get().WaitAnimationPoses();
+
+	nsAnimationLayer& animLayer = Layers[layer];
+
+	if (animLayer.Samples.GetCount() == NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE)
+	{
+		NS_LogWarning(AnimationGraphLog, TEXT("Animation layer [%s] exceeds maximum sample count!"), *animLayer.Name.ToString());
+		return;
+	}
+
+	nsAnimationBlendSample& sample = animLayer.Samples.Add();
+	sample.Clip = clip;
+	sample.Position = position;
+	sample.Weight = 0.0f;
+	sample.Timestamp = 0.0f;
+}
+
+
+void nsAnimationGraph::SetLayerBlendParameters(int layer, const nsName& parameterX, const nsName& parameterY)
+{
+	NS_Assert(layer >= 0 && layer < Layers.GetCount());
+
+	nsAnimationLayer& animLayer = Layers[layer];
+	animLayer.ParameterX = parameterX;
+	animLayer.ParameterY = parameterY;
+}
+
+
+void nsAnimationGraph::SetLayerWeight(int layer, float weight, const nsName& weightParameter)
+{
+	NS_Assert(layer >= 0 && layer < Layers.GetCount());
+
+	nsAnimationLayer& animLayer = Layers[layer];
+	animLayer.Weight = weight;
+	animLayer.WeightParameter = weightParameter;
+}
+
+
+void nsAnimationGraph::SetLayerPlayRate(int layer, float playRate, bool bLoop)
+{
+	NS_Assert(layer >= 0 && layer < Layers.GetCount());
+
+	nsAnimationLayer& animLayer = Layers[layer];
+	animLayer.PlayRate = playRate;
+	animLayer.bLooping = bLoop;
+}
+
+
+void nsAnimationGraph::SetLayerBoneMask(int layer, const nsTArray<float>& boneMask)
+{
+	NS_Assert(layer >= 0 && layer < Layers.GetCount());
+	nsAnimationManager::Get().WaitAnimationPoses();
+
+	Layers[layer].BoneMask = boneMask;
+}
+
+
+void nsAnimationGraph::SetLayerBoneMask(int layer, nsAnimationSkeletonID skeleton, const nsName& rootBoneName)
+{
+	NS_Assert(layer >= 0 && layer < Layers.GetCount());
+
+	const nsAnimationSkeletonData& skeletonData = nsAnimationManager::Get().GetSkeletonData(skeleton);
+	const int rootBoneId = skeletonData.BoneNames.Find(rootBoneName);
+
+	if (rootBoneId == NS_ARRAY_INDEX_INVALID)
+	{
+		NS_LogWarning(AnimationGraphLog, TEXT("Set animation layer [%s] bone mask. Bone [%s] not found!"), *Layers[layer].Name.ToString(), *rootBoneName.ToString());
+		return;
+	}
+
+	const int boneCount = skeletonData.BoneDatas.GetCount();
+	nsTArray<float>& boneMask = Layers[layer].BoneMask;
+	boneMask.Clear();
+	boneMask.Resize(boneCount);
+
+	for (int j = 0; j < boneCount; ++j)
+	{
+		int boneId = j;
+
+		while (boneId != -1 && boneId != rootBoneId)
+		{
+			boneId = skeletonData.BoneDatas[boneId].ParentId;
+		}
+
+		boneMask[j] = boneId == rootBoneId ? 1.0f : 0.0f;
+	}
 }
@@ -1,4 +1,6 @@
 #include "nsAnimationManager.h"
+#include "nsAnimationCompression.h"
+#include "nsAnimationGraph.h"
 #include "nsConsole.h"
 
 
@@ -10,11 +12,76 @@ NS_ENGINE_DEFINE_HANDLE(nsAnimationClipID);
 static nsLogCategory AnimationLog(TEXT("nsAnimationLog"), nsELogVerbosity::LV_DEBUG);
 
 
+// Minimum number of instances evaluated by single pose update task
+#define NS_ANIMATION_POSE_TASK_MIN_INSTANCE		8
+
+// Key-frame cursor slots of instance, followed by NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE slots per graph layer
+#define NS_ANIMATION_CURSOR_SLOT_CLIP			0
+#define NS_ANIMATION_CURSOR_SLOT_BLEND_FROM		1
+#define NS_ANIMATION_CURSOR_SLOT_GRAPH			2
+
+
+
+nsAnimationPoseUpdateTask::nsAnimationPoseUpdateTask() noexcept
+{
+	Reset();
+}
+
+
+void nsAnimationPoseUpdateTask::Reset() noexcept
+{
+	bDone.Set(0);
+	InstanceBegin = 0;
+	InstanceEnd = 0;
+	DeltaTime = 0.0f;
+}
+
+
+void nsAnimationPoseUpdateTask::Execute() noexcept
+{
+	nsAnimationManager& animationManager = nsAnimationManager::Get();
+
+	for (int i = InstanceBegin; i < InstanceEnd; ++i)
+	{
+		animationManager.UpdateInstancePose(i, DeltaTime, PosePool);
+	}
+
+	bDone.Set(1);
+}
+
+
+bool nsAnimationPoseUpdateTask::IsIdle() const noexcept
+{
+	return IsDone();
+}
+
+
+bool nsAnimationPoseUpdateTask::IsRunning() const noexcept
+{
+	return !IsDone();
+}
+
+
+bool nsAnimationPoseUpdateTask::IsDone() const noexcept
+{
+	return bDone.Get() == 1;
+}
+
+
+#ifdef _DEBUG
+nsString nsAnimationPoseUpdateTask::GetDebugName() const noexcept
+{
+	return nsString::Format(TEXT("nsAnimationPoseUpdateTask:%i-%i"), InstanceBegin, InstanceEnd);
+}
+#endif // _DEBUG
+
+
 
 nsAnimationManager::nsAnimationManager() noexcept
 	: bInitialized(false)
 	, FrameDatas()
 	, FrameIndex(0)
+	, UpdateIndex(0)
 {
 	SkeletonNames.Reserve(4);
 	SkeletonFlags.Reserve(4);
@@ -27,6 +94,8 @@ nsAnimationManager::nsAnimationManager() noexcept
 	InstanceNames.Reserve(16);
 	InstanceFlags.Reserve(16);
 	InstanceDatas.Reserve(16);
+	InstancePlayStates.Reserve(16);
+	InstanceBlendStates.Reserve(16);
 }
 
 
@@ -51,98 +120,382 @@ void nsAnimationManager::Initialize()
 
 void nsAnimationManager::UpdateAnimationPoses(float deltaTime)
 {
+	NS_Validate_IsMainThread();
+
+	WaitAnimationPoses();
+
 	if (InstanceDatas.IsEmpty())
 	{
 		return;
 	}
 
+	UpdateIndex++;
+
 	const int count = InstanceDatas.GetCount();
 
 	for (int i = 0; i < count; ++i)
 	{
-		if (!(InstanceFlags[i] & Flag_Instance_UpdatePose))
+		if ((InstanceFlags[i] & Flag_Instance_UpdatePose) && InstanceDatas[i].Graph)
 		{
-			continue;
+			UpdateInstanceGraph(i, deltaTime);
+		}
+	}
+
+	const int threadCount = nsThreadPool::GetThreadCount();
+
+	if (threadCount <= 1 || count <= NS_ANIMATION_POSE_TASK_MIN_INSTANCE)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			UpdateInstancePose(i, deltaTime, PosePool);
 		}
 
-		nsAnimationInstanceData& animInstanceData = InstanceDatas[i];
+		return;
+	}
+
+	// Few batches per thread, so threads that finish early can steal the rest
+	const int taskCount = nsMath::Min(threadCount * 4, (count + NS_ANIMATION_POSE_TASK_MIN_INSTANCE - 1) / NS_ANIMATION_POSE_TASK_MIN_INSTANCE);
+	const int batchSize = (count + taskCount - 1) / taskCount;
+
+	while (PoseUpdateTasks.GetCount() < taskCount)
+	{
+		PoseUpdateTasks.Add();
+	}
+
+	nsTArrayInline<nsIThreadTask*, 128> submitTasks;
+
+	for (int i = 0; i < count; i += batchSize)
+	{
+		nsAnimationPoseUpdateTask& task = PoseUpdateTasks[submitTasks.GetCount()];
+		task.Reset();
+		task.InstanceBegin = i;
+		task.InstanceEnd = nsMath::Min(i + batchSize, count);
+		task.DeltaTime = deltaTime;
+
+		submitTasks.Add(&task);
+	}
+
+	nsThreadPool::SubmitTasks(submitTasks.GetData(), submitTasks.GetCount(), nsEThreadAffinity::Thread_ALL, &PoseUpdateTaskCounter);
+}
+
+
+template<typename T>
+static NS_INLINE void ns_SampleKeyFrameChannel(const nsTArray<nsAnimationKeyFrame::TChannel<T>>& channels, float timestamp, int& cursor, T& outValue, T(*interpolate)(const T&, const T&, float))
+{
+	const int count = channels.GetCount();
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	if (count == 1)
+	{
+		outValue = channels[0].Value;
+		return;
+	}
 
-		nsAnimationPlayState& state = InstancePlayStates[i];
+	const int index = nsAlgorithm::FindInterval(channels.GetData(), count, timestamp, cursor, [](const nsAnimationKeyFrame::TChannel<T>& channel) { return channel.Timestamp; });
+	const nsAnimationKeyFrame::TChannel<T>& keyA = channels[index];
+	const nsAnimationKeyFrame::TChannel<T>& keyB = channels[index + 1];
+	const float interval = keyB.Timestamp - keyA.Timestamp;
+	const float alpha = interval > 0.0f ? nsMath::Clamp((timestamp - keyA.Timestamp) / interval, 0.0f, 1.0f) : 0.0f;
 
-		if (state.Clip == nsAnimationClipID::INVALID)
+	outValue = interpolate(keyA.Value, keyB.Value, alpha);
+}
+
+
+static void ns_AdvancePlayState(nsAnimationPlayState& state, const nsAnimationClipData& clipData, float deltaTime)
+{
+	state.Timestamp += deltaTime * state.PlayRate;
+
+	if (state.bLooping)
+	{
+		state.Timestamp = nsMath::ModF(state.Timestamp, clipData.Duration);
+	}
+	else
+	{
+		state.Timestamp = nsMath::Clamp(state.Timestamp, 0.0f, clipData.Duration);
+	}
+}
+
+
+static const nsAnimationAdditiveReference* ns_FindAdditiveReference(const nsAnimationInstanceData& instanceData, nsAnimationClipID clip)
+{
+	for (int i = 0; i < instanceData.AdditiveReferences.GetCount(); ++i)
+	{
+		if (instanceData.AdditiveReferences[i].Clip == clip)
 		{
-			continue;
+			return &instanceData.AdditiveReferences[i];
 		}
+	}
 
-		const nsAnimationClipData& clipData = ClipDatas[state.Clip.Id];
-		state.Timestamp += deltaTime * state.PlayRate;
-		
-		if (state.bLooping)
+	return nullptr;
+}
+
+
+void nsAnimationManager::UpdateInstanceGraph(int index, float deltaTime)
+{
+	nsAnimationInstanceData& animInstanceData = InstanceDatas[index];
+	nsAnimationGraph* graph = animInstanceData.Graph;
+	graph->TickUpdate(deltaTime, UpdateIndex);
+
+	const nsTArray<nsAnimationLayer>& layers = graph->GetLayers();
+	const int boneCount = animInstanceData.BoneHierarchyIds.GetCount();
+	const int cursorCount = (NS_ANIMATION_CURSOR_SLOT_GRAPH + layers.GetCount() * NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE) * boneCount;
+
+	if (animInstanceData.KeyFrameCursors.GetCount() < cursorCount)
+	{
+		animInstanceData.KeyFrameCursors.Resize(cursorCount);
+	}
+
+	for (int l = 0; l < layers.GetCount(); ++l)
+	{
+		const nsAnimationLayer& layer = layers[l];
+
+		if (layer.BlendMode != nsEAnimationLayerBlendMode::ADDITIVE)
 		{
-			state.Timestamp = nsMath::ModF(state.Timestamp, clipData.Duration);
+			continue;
 		}
-		else
+
+		for (int s = 0; s < layer.Samples.GetCount(); ++s)
 		{
-			state.Timestamp = nsMath::Clamp(state.Timestamp, 0.0f, clipData.Duration);
+			const nsAnimationClipID clip = layer.Samples[s].Clip;
+
+			if (IsClipValid(clip) && IsClipCompatible(animInstanceData, clip) && ns_FindAdditiveReference(animInstanceData, clip) == nullptr)
+			{
+				nsAnimationAdditiveReference& reference = animInstanceData.AdditiveReferences.Add();
+				reference.Clip = clip;
+				SampleClip(animInstanceData, clip, 0.0f, NS_ANIMATION_CURSOR_SLOT_GRAPH + l * NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE + s, reference.Pose);
+			}
 		}
-		
-		const int boneCount = animInstanceData.BoneTransforms.GetCount();
+	}
+}
+
+
+void nsAnimationManager::SampleClip(nsAnimationInstanceData& instanceData, nsAnimationClipID clip, float timestamp, int cursorSlot, nsTransformSoA& outPose)
+{
+	const nsAnimationClipData& clipData = ClipDatas[clip.Id];
+	const int boneCount = instanceData.BoneHierarchyIds.GetCount();
+	NS_Assert(instanceData.KeyFrameCursors.GetCount() >= (cursorSlot + 1) * boneCount);
+
+	// Pooled poses are shared by instances, padding transforms are identity after copy and never written
+	if (outPose.GetCount() != boneCount)
+	{
+		outPose = instanceData.BindLocalTransforms;
+	}
+
+	nsAnimationKeyFrameCursor* cursors = instanceData.KeyFrameCursors.GetData() + cursorSlot * boneCount;
+
+	if (clipData.Compressed.IsEmpty())
+	{
 		NS_Assert(clipData.KeyFrames.GetCount() == boneCount);
 
 		for (int j = 0; j < boneCount; ++j)
 		{
-			nsAnimationSkeletonData::Bone& bone = animInstanceData.BoneTransforms[j];
-			bone.bUpdated = false;
+			const int hierarchyId = instanceData.BoneHierarchyIds[j];
+			nsTransform localTransform = instanceData.BindLocalTransforms.Get(hierarchyId);
+
+			const nsAnimationKeyFrame& keyFrame = clipData.KeyFrames[j];
+			nsAnimationKeyFrameCursor& cursor = cursors[j];
+			ns_SampleKeyFrameChannel(keyFrame.PositionChannels, timestamp, cursor.Position, localTransform.Position, &nsVector3::Lerp);
+			ns_SampleKeyFrameChannel(keyFrame.RotationChannels, timestamp, cursor.Rotation, localTransform.Rotation, &nsQuaternion::Slerp);
+			ns_SampleKeyFrameChannel(keyFrame.ScaleChannels, timestamp, cursor.Scale, localTransform.Scale, &nsVector3::Lerp);
+
+			outPose.Set(hierarchyId, localTransform);
+		}
+	}
+	else
+	{
+		const nsAnimationCompressedClipData& compressed = clipData.Compressed;
+		NS_Assert(compressed.Tracks.GetCount() == boneCount * 3);
+
+		const float keyTime = nsAnimationCompression::GetKeyTime(clipData, timestamp);
+
+		for (int j = 0; j < boneCount; ++j)
+		{
+			const int hierarchyId = instanceData.BoneHierarchyIds[j];
+			nsTransform localTransform = instanceData.BindLocalTransforms.Get(hierarchyId);
+
+			nsAnimationKeyFrameCursor& cursor = cursors[j];
+			nsAnimationCompression::SampleVector(compressed, j * 3, keyTime, cursor.Position, localTransform.Position);
+			nsAnimationCompression::SampleRotation(compressed, j * 3 + 1, keyTime, cursor.Rotation, localTransform.Rotation);
+			nsAnimationCompression::SampleVector(compressed, j * 3 + 2, keyTime, cursor.Scale, localTransform.Scale);
+
+			outPose.Set(hierarchyId, localTransform);
+		}
+	}
+}
+
+
+bool nsAnimationManager::IsClipCompatible(const nsAnimationInstanceData& instanceData, nsAnimationClipID clip) const
+{
+	const nsAnimationClipData& clipData = ClipDatas[clip.Id];
+	const int boneCount = instanceData.BoneHierarchyIds.GetCount();
+
+	if (clipData.SkeletonName != instanceData.SkeletonName)
+	{
+		return false;
+	}
+
+	return clipData.Compressed.IsEmpty() ? clipData.KeyFrames.GetCount() == boneCount : clipData.Compressed.Tracks.GetCount() == boneCount * 3;
+}
+
+
+void nsAnimationManager::EvaluateGraphLayers(nsAnimationInstanceData& instanceData, nsAnimationPosePool& posePool)
+{
+	const nsTArray<nsAnimationLayer>& layers = instanceData.Graph->GetLayers();
+	nsTransformSoA& localTransforms = instanceData.LocalTransforms;
+	const int boneCount = localTransforms.GetCount();
+	const int paddedCount = localTransforms.GetPaddedCount();
+
+	for (int l = 0; l < layers.GetCount(); ++l)
+	{
+		const nsAnimationLayer& layer = layers[l];
+
+		if (layer.EvaluatedWeight <= 0.0f)
+		{
+			continue;
+		}
+
+		const bool bAdditive = layer.BlendMode == nsEAnimationLayerBlendMode::ADDITIVE;
+		const nsTransformSoA* poses[NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE];
+		const nsTransformSoA* referencePoses[NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE];
+		float poseWeights[NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE];
+		int poseCount = 0;
+
+		posePool.Reset();
+
+		for (int s = 0; s < layer.Samples.GetCount(); ++s)
+		{
+			const nsAnimationBlendSample& sample = layer.Samples[s];
 
-			const nsTArray<nsAnimationKeyFrame::TChannel<nsVector3>>& positionChannels = clipData.KeyFrames[j].PositionChannels;
-			for (int p = 0; p < positionChannels.GetCount() - 1; ++p)
+			if (sample.Weight <= 0.0f || !IsClipValid(sample.Clip) || !IsClipCompatible(instanceData, sample.Clip))
 			{
-				if (state.Timestamp >= positionChannels[p].Timestamp && state.Timestamp <= positionChannels[p + 1].Timestamp)
-				{
-					bone.LocalTransform.Position = nsVector3::Lerp(positionChannels[p].Value, positionChannels[p + 1].Value, (state.Timestamp - positionChannels[p].Timestamp) / (positionChannels[p + 1].Timestamp - positionChannels[p].Timestamp));
-					break;
-				}
+				continue;
 			}
 
-			const nsTArray<nsAnimationKeyFrame::TChannel<nsQuaternion>>& rotationChannels = clipData.KeyFrames[j].RotationChannels;
-			for (int r = 0; r < rotationChannels.GetCount() - 1; ++r)
+			const nsAnimationAdditiveReference* reference = bAdditive ? ns_FindAdditiveReference(instanceData, sample.Clip) : nullptr;
+
+			if (bAdditive && reference == nullptr)
 			{
-				if (state.Timestamp >= rotationChannels[r].Timestamp && state.Timestamp <= rotationChannels[r + 1].Timestamp)
-				{
-					bone.LocalTransform.Rotation = nsQuaternion::Slerp(rotationChannels[r].Value, rotationChannels[r + 1].Value, (state.Timestamp - rotationChannels[r].Timestamp) / (rotationChannels[r + 1].Timestamp - rotationChannels[r].Timestamp));
-					break;
-				}
+				continue;
 			}
 
-			const nsTArray<nsAnimationKeyFrame::TChannel<nsVector3>>& scaleChannels = clipData.KeyFrames[j].ScaleChannels;
-			for (int s = 0; s < scaleChannels.GetCount() - 1; ++s)
+			nsTransformSoA& pose = posePool.Allocate();
+			SampleClip(instanceData, sample.Clip, sample.Timestamp, NS_ANIMATION_CURSOR_SLOT_GRAPH + l * NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE + s, pose);
+
+			poses[poseCount] = &pose;
+			referencePoses[poseCount] = reference ? &reference->Pose : nullptr;
+			poseWeights[poseCount] = sample.Weight;
+			++poseCount;
+		}
+
+		if (poseCount == 0)
+		{
+			continue;
+		}
+
+		const float* boneWeights = nullptr;
+
+		if (!layer.BoneMask.IsEmpty() || layer.EvaluatedWeight < 1.0f)
+		{
+			nsTArray<float>& weights = posePool.BoneWeights;
+			weights.Resize(paddedCount);
+
+			for (int h = 0; h < paddedCount; ++h)
 			{
-				if (state.Timestamp >= scaleChannels[s].Timestamp && state.Timestamp <= scaleChannels[s + 1].Timestamp)
+				float weight = 0.0f;
+
+				if (h < boneCount)
 				{
-					bone.LocalTransform.Scale = nsVector3::Lerp(scaleChannels[s].Value, scaleChannels[s + 1].Value, (state.Timestamp - scaleChannels[s].Timestamp) / (scaleChannels[s + 1].Timestamp - scaleChannels[s].Timestamp));
-					break;
+					const int boneId = instanceData.HierarchyBoneIds[h];
+					weight = layer.EvaluatedWeight;
+
+					if (!layer.BoneMask.IsEmpty())
+					{
+						weight *= boneId < layer.BoneMask.GetCount() ? layer.BoneMask[boneId] : 0.0f;
+					}
 				}
+
+				weights[h] = weight;
 			}
+
+			boneWeights = weights.GetData();
 		}
 
+		if (bAdditive)
+		{
+			nsTransformHierarchy::AddPoses(poses, referencePoses, poseWeights, poseCount, boneWeights, localTransforms);
+		}
+		else
+		{
+			nsTransformHierarchy::BlendPoses(poses, poseWeights, poseCount, boneWeights, localTransforms);
+		}
+	}
+}
 
-		for (int j = 0; j < boneCount; ++j)
+
+void nsAnimationManager::UpdateInstancePose(int index, float deltaTime, nsAnimationPosePool& posePool)
+{
+	if (!(InstanceFlags[index] & Flag_Instance_UpdatePose))
+	{
+		return;
+	}
+
+	nsAnimationInstanceData& animInstanceData = InstanceDatas[index];
+	nsTransformSoA& localTransforms = animInstanceData.LocalTransforms;
+
+	nsAnimationPlayState& state = InstancePlayStates[index];
+	nsAnimationBlendState& blendState = InstanceBlendStates[index];
+
+	if (state.Clip != nsAnimationClipID::INVALID)
+	{
+		ns_AdvancePlayState(state, ClipDatas[state.Clip.Id], deltaTime);
+		SampleClip(animInstanceData, state.Clip, state.Timestamp, NS_ANIMATION_CURSOR_SLOT_CLIP, localTransforms);
+
+		if (blendState.From.Clip != nsAnimationClipID::INVALID)
 		{
-			nsAnimationSkeletonData::Bone& bone = animInstanceData.BoneTransforms[j];
-			const nsAnimationSkeletonData::Bone* parentBone = bone.ParentId == -1 ? nullptr : &animInstanceData.BoneTransforms[bone.ParentId];
+			blendState.BlendTime += deltaTime;
 
-			if (parentBone)
+			if (blendState.BlendTime >= blendState.BlendDuration)
 			{
-				NS_Validate(parentBone->bUpdated);
+				blendState.From.Clip = nsAnimationClipID::INVALID;
 			}
+			else
+			{
+				if (blendState.TransitionMode == nsEAnimationTransitionMode::SMOOTH)
+				{
+					ns_AdvancePlayState(blendState.From, ClipDatas[blendState.From.Clip.Id], deltaTime);
+				}
 
-			bone.PoseTransform = parentBone ? bone.LocalTransform.ToMatrix() * parentBone->PoseTransform : bone.LocalTransform.ToMatrix();
+				posePool.Reset();
+				nsTransformSoA& fromPose = posePool.Allocate();
+				SampleClip(animInstanceData, blendState.From.Clip, blendState.From.Timestamp, NS_ANIMATION_CURSOR_SLOT_BLEND_FROM, fromPose);
 
-			const int boneTransformId = animInstanceData.BoneTransformIndex + j;
-			InstanceBoneTransforms[boneTransformId] = bone.InverseBindPoseTransform * bone.PoseTransform;
-			bone.bUpdated = true;
+				const float alpha = blendState.BlendTime / blendState.BlendDuration;
+				const nsTransformSoA* poses[2] = { &fromPose, &localTransforms };
+				const float poseWeights[2] = { 1.0f - alpha, alpha };
+				nsTransformHierarchy::BlendPoses(poses, poseWeights, 2, nullptr, localTransforms);
+			}
 		}
 	}
+	else if (animInstanceData.Graph)
+	{
+		localTransforms = animInstanceData.BindLocalTransforms;
+	}
+	else
+	{
+		return;
+	}
+
+	if (animInstanceData.Graph)
+	{
+		EvaluateGraphLayers(animInstanceData, posePool);
+	}
+
+	nsTransformHierarchy::ComputeMatrices(localTransforms, animInstanceData.HierarchyParentIds.GetData(), animInstanceData.HierarchyInverseBindPoses.GetData(),
+		animInstanceData.HierarchyBoneIds.GetData(), animInstanceData.HierarchyModelMatrices.GetData(), InstanceBoneTransforms.GetData() + animInstanceData.BoneTransformIndex);
 }
 
 
@@ -152,7 +505,7 @@ nsAnimationSkeletonID nsAnimationManager::FindSkeleton(const nsName& name) const
 	{
 		if ((*it) == name)
 		{
-			return it.GetIndex();
+			return nsAnimationSkeletonID(it.GetIndex(), SkeletonFlags.GetGeneration(it.GetIndex()));
 		}
 	}
 
@@ -163,6 +516,7 @@ nsAnimationSkeletonID nsAnimationManager::FindSkeleton(const nsName& name) const
 nsAnimationSkeletonID nsAnimationManager::CreateSkeleton(nsName name)
 {
 	NS_Validate_IsMainThread();
+	WaitAnimationPoses();
 
 	if (FindSkeleton(name) != nsAnimationSkeletonID::INVALID)
 	{
@@ -180,8 +534,9 @@ nsAnimationSkeletonID nsAnimationManager::CreateSkeleton(nsName name)
 	nsAnimationSkeletonData& data = SkeletonDatas[dataId];
 	data.BoneNames.Clear();
 	data.BoneDatas.Clear();
+	data.CompressionError = NS_ENGINE_ANIMATION_COMPRESSION_ERROR;
 
-	return nameId;
+	return nsAnimationSkeletonID(nameId, SkeletonFlags.GetGeneration(nameId));
 }
 
 
@@ -191,7 +546,26 @@ void nsAnimationManager::DestroySkeleton(nsAnimationSkeletonID& skeleton)
 
 	if (IsSkeletonValid(skeleton))
 	{
-		NS_ValidateV(0, TEXT("Not implemented yet!"));
+		WaitAnimationPoses();
+		NS_LogDebug(AnimationLog, TEXT("Destroy skeleton [%s]"), *SkeletonNames[skeleton.Id].ToString());
+
+		// Instances keep their own copy of bone data and stay valid, only their skeleton handle is invalidated
+		const nsTArray<int>& instanceIds = InstanceFlags.GetIndices();
+
+		for (int i = 0; i < instanceIds.GetCount(); ++i)
+		{
+			nsAnimationInstanceData& instanceData = InstanceDatas[instanceIds[i]];
+
+			if (instanceData.Skeleton == skeleton)
+			{
+				instanceData.Skeleton = nsAnimationSkeletonID::INVALID;
+			}
+		}
+
+		const int id = skeleton.Id;
+		SkeletonNames.RemoveAt(id);
+		SkeletonFlags.RemoveAt(id);
+		SkeletonDatas.RemoveAt(id);
 	}
 
 	skeleton = nsAnimationSkeletonID::INVALID;
@@ -204,7 +578,7 @@ nsAnimationClipID nsAnimationManager::FindClip(const nsName& name) const
 	{
 		if ((*it) == name)
 		{
-			return it.GetIndex();
+			return nsAnimationClipID(it.GetIndex(), ClipFlags.GetGeneration(it.GetIndex()));
 		}
 	}
 
@@ -215,6 +589,7 @@ nsAnimationClipID nsAnimationManager::FindClip(const nsName& name) const
 nsAnimationClipID nsAnimationManager::CreateClip(nsName name)
 {
 	NS_Validate_IsMainThread();
+	WaitAnimationPoses();
 
 	if (FindClip(name) != nsAnimationClipID::INVALID)
 	{
@@ -234,8 +609,9 @@ nsAnimationClipID nsAnimationManager::CreateClip(nsName name)
 	data.FrameCount = 0;
 	data.Duration = 0.0f;
 	data.KeyFrames.Clear(true);
+	data.Compressed = nsAnimationCompressedClipData();
 
-	return nameId;
+	return nsAnimationClipID(nameId, ClipFlags.GetGeneration(nameId));
 }
 
 
@@ -272,7 +648,43 @@ void nsAnimationManager::DestroyClip(nsAnimationClipID& clip)
 
 	if (IsClipValid(clip))
 	{
-		NS_ValidateV(0, TEXT("Not implemented yet!"));
+		WaitAnimationPoses();
+		NS_LogDebug(AnimationLog, TEXT("Destroy clip [%s]"), *ClipNames[clip.Id].ToString());
+
+		// Instances stop playing destroyed clip. Graph samples that still reference it are skipped (see EvaluateGraphLayers)
+		const nsTArray<int>& instanceIds = InstanceFlags.GetIndices();
+
+		for (int i = 0; i < instanceIds.GetCount(); ++i)
+		{
+			const int instanceId = instanceIds[i];
+			nsAnimationPlayState& state = InstancePlayStates[instanceId];
+			nsAnimationBlendState& blendState = InstanceBlendStates[instanceId];
+
+			if (state.Clip == clip)
+			{
+				state.Clip = nsAnimationClipID::INVALID;
+				blendState.From.Clip = nsAnimationClipID::INVALID;
+			}
+			else if (blendState.From.Clip == clip)
+			{
+				blendState.From.Clip = nsAnimationClipID::INVALID;
+			}
+
+			nsTArray<nsAnimationAdditiveReference>& additiveReferences = InstanceDatas[instanceId].AdditiveReferences;
+
+			for (int r = additiveReferences.GetCount() - 1; r >= 0; --r)
+			{
+				if (additiveReferences[r].Clip == clip)
+				{
+					additiveReferences.RemoveAt(r);
+				}
+			}
+		}
+
+		const int id = clip.Id;
+		ClipNames.RemoveAt(id);
+		ClipFlags.RemoveAt(id);
+		ClipDatas.RemoveAt(id);
 	}
 
 	clip = nsAnimationClipID::INVALID;
@@ -285,7 +697,7 @@ nsAnimationInstanceID nsAnimationManager::FindInstance(const nsName& name) const
 	{
 		if ((*it) == name)
 		{
-			return it.GetIndex();
+			return nsAnimationInstanceID(it.GetIndex(), InstanceFlags.GetGeneration(it.GetIndex()));
 		}
 	}
 
@@ -296,6 +708,7 @@ nsAnimationInstanceID nsAnimationManager::FindInstance(const nsName& name) const
 nsAnimationInstanceID nsAnimationManager::CreateInstance(nsName name, nsAnimationSkeletonID skeleton)
 {
 	NS_Validate_IsMainThread();
+	WaitAnimationPoses();
 	NS_Assert(IsSkeletonValid(skeleton));
 
 	if (FindInstance(name) != nsAnimationInstanceID::INVALID)
@@ -307,7 +720,8 @@ nsAnimationInstanceID nsAnimationManager::CreateInstance(nsName name, nsAnimatio
 	const int flagId = InstanceFlags.Add();
 	const int dataId = InstanceDatas.Add();
 	const int stateId = InstancePlayStates.Add();
-	NS_Assert(nameId == flagId && flagId == dataId && dataId == stateId);
+	const int blendStateId = InstanceBlendStates.Add();
+	NS_Assert(nameId == flagId && flagId == dataId && dataId == stateId && stateId == blendStateId);
 
 	InstanceNames[nameId] = name;
 	InstanceFlags[flagId] = Flag_Allocated;
@@ -317,21 +731,67 @@ nsAnimationInstanceID nsAnimationManager::CreateInstance(nsName name, nsAnimatio
 
 	nsAnimationInstanceData& data = InstanceDatas[dataId];
 	data.BoneNames = skeletonData.BoneNames;
-	data.BoneTransforms = skeletonData.BoneDatas;
+	data.KeyFrameCursors.Clear();
+	data.KeyFrameCursors.Resize(boneCount * NS_ANIMATION_CURSOR_SLOT_GRAPH);
+	data.AdditiveReferences.Clear();
 	data.Skeleton = skeleton;
+	data.SkeletonName = SkeletonNames[skeleton.Id];
+	data.Graph = nullptr;
 	data.BoneTransformIndex = InstanceBoneTransforms.GetCount();
 
+	// Pose update walks bones in parent-first order, imported skeletons may store child bones before their parent
+	nsTArrayInline<int, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> boneParentIds;
+	boneParentIds.Resize(boneCount);
+
+	for (int j = 0; j < boneCount; ++j)
+	{
+		boneParentIds[j] = skeletonData.BoneDatas[j].ParentId;
+	}
+
+	data.HierarchyBoneIds.Resize(boneCount);
+	const bool bSorted = nsTransformHierarchy::SortParentFirst(boneParentIds.GetData(), boneCount, data.HierarchyBoneIds.GetData());
+	NS_ValidateV(bSorted, TEXT("Invalid bone hierarchy of skeleton [%s]!"), *SkeletonNames[skeleton.Id].ToString());
+
+	data.BoneHierarchyIds.Resize(boneCount);
+	data.HierarchyParentIds.Resize(boneCount);
+	data.HierarchyInverseBindPoses.Resize(boneCount);
+	data.HierarchyModelMatrices.Resize(boneCount);
+	data.LocalTransforms.Resize(boneCount);
+
+	for (int h = 0; h < boneCount; ++h)
+	{
+		data.BoneHierarchyIds[data.HierarchyBoneIds[h]] = h;
+	}
+
+	for (int h = 0; h < boneCount; ++h)
+	{
+		const nsAnimationSkeletonData::Bone& bone = skeletonData.BoneDatas[data.HierarchyBoneIds[h]];
+		data.HierarchyParentIds[h] = bone.ParentId == -1 ? -1 : data.BoneHierarchyIds[bone.ParentId];
+		data.HierarchyInverseBindPoses[h] = bone.InverseBindPoseTransform;
+		data.LocalTransforms.Set(h, bone.LocalTransform);
+	}
+
+	data.BindLocalTransforms = data.LocalTransforms;
+
 	nsAnimationPlayState& state = InstancePlayStates[stateId];
 	state.Clip = nsAnimationClipID::INVALID;
 	state.PlayRate = 0.0f;
 	state.Timestamp = 0.0f;
 	state.bLooping = false;
 
+	nsAnimationBlendState& blendState = InstanceBlendStates[blendStateId];
+	blendState.From.Clip = nsAnimationClipID::INVALID;
+	blendState.BlendTime = 0.0f;
+
 	InstanceBoneTransforms.ResizeConstructs(data.BoneTransformIndex + boneCount, nsMatrix4::IDENTITY);
 
+	// Start from bind pose
+	nsTransformHierarchy::ComputeMatrices(data.LocalTransforms, data.HierarchyParentIds.GetData(), data.HierarchyInverseBindPoses.GetData(),
+		data.HierarchyBoneIds.GetData(), data.HierarchyModelMatrices.GetData(), InstanceBoneTransforms.GetData() + data.BoneTransformIndex);
+
 	NS_LogDebug(AnimationLog, TEXT("Create animation instance [%s]"), *name.ToString());
 
-	return nameId;
+	return nsAnimationInstanceID(nameId, InstanceFlags.GetGeneration(nameId));
 }
 
 
@@ -351,6 +811,7 @@ void nsAnimationManager::DestroyInstance(nsAnimationInstanceID& instance)
 void nsAnimationManager::SetInstanceUpdatePose(nsAnimationInstanceID instance, bool bUpdatePose)
 {
 	NS_Assert(IsInstanceValid(instance));
+	WaitAnimationPoses();
 
 	if (bUpdatePose)
 	{
@@ -363,55 +824,95 @@ void nsAnimationManager::SetInstanceUpdatePose(nsAnimationInstanceID instance, b
 }
 
 
-void nsAnimationManager::PlayAnimation(nsAnimationInstanceID instance, nsAnimationClipID clip, float playRate, bool bLoop)
+bool nsAnimationManager::PlayAnimation(nsAnimationInstanceID instance, nsAnimationClipID clip, float playRate, bool bLoop)
 {
 	NS_Assert(IsInstanceValid(instance));
 	NS_Assert(IsClipValid(clip));
+	WaitAnimationPoses();
 
 	const nsAnimationInstanceData& instanceData = InstanceDatas[instance.Id];
-	const nsAnimationSkeletonID skeleton = instanceData.Skeleton;
-	NS_Assert(IsSkeletonValid(skeleton));
-	const nsName skeletonName = SkeletonNames[skeleton.Id];
 
-	const nsAnimationClipData& clipData = ClipDatas[clip.Id];
-
-	if (skeletonName != clipData.SkeletonName)
+	if (!IsClipCompatible(instanceData, clip))
 	{
-		NS_CONSOLE_Warning(AnimationLog, TEXT("Play animation [%s] with animation instance [%s]. Skeleton is not compatible! [AnimationInstanceSkeleton: %s, AnimationClipSkeleton: %s]"),
+		const nsAnimationClipData& clipData = ClipDatas[clip.Id];
+
+		NS_CONSOLE_Warning(AnimationLog, TEXT("Fail to play animation [%s] with animation instance [%s]. Skeleton is not compatible! [AnimationInstanceSkeleton: %s (%i bones), AnimationClipSkeleton: %s (%i bones)]"),
 			*ClipNames[clip.Id].ToString(),
 			*InstanceNames[instance.Id].ToString(),
-			*skeletonName.ToString(),
-			*clipData.SkeletonName.ToString()
+			*instanceData.SkeletonName.ToString(),
+			instanceData.BoneHierarchyIds.GetCount(),
+			*clipData.SkeletonName.ToString(),
+			clipData.Compressed.IsEmpty() ? clipData.KeyFrames.GetCount() : clipData.Compressed.Tracks.GetCount() / 3
 		);
+
+		return false;
 	}
 
 	nsAnimationPlayState& state = InstancePlayStates[instance.Id];
 	
 	if (state.Clip == clip && state.PlayRate == playRate)
 	{
-		return;
+		return true;
 	}
 
 	state.Clip = clip;
 	state.PlayRate = playRate;
 	state.Timestamp = 0.0f;
 	state.bLooping = bLoop;
+
+	InstanceBlendStates[instance.Id].From.Clip = nsAnimationClipID::INVALID;
+
+	return true;
 }
 
 
 void nsAnimationManager::StopAnimation(nsAnimationInstanceID instance)
 {
 	NS_Assert(IsInstanceValid(instance));
+	WaitAnimationPoses();
 
 	nsAnimationPlayState& state = InstancePlayStates[instance.Id];
 	state.Clip = nsAnimationClipID::INVALID;
+
+	InstanceBlendStates[instance.Id].From.Clip = nsAnimationClipID::INVALID;
 }
 
 
-void nsAnimationManager::BlendAnimation(nsAnimationInstanceID instance, nsEAnimationTransitionMode transitionMode, float blendFactor, nsAnimationClipID clip, float playRate, bool bLoop)
+void nsAnimationManager::BlendAnimation(nsAnimationInstanceID instance, nsEAnimationTransitionMode transitionMode, float blendDuration, nsAnimationClipID clip, float playRate, bool bLoop)
 {
 	NS_Assert(IsInstanceValid(instance));
+	WaitAnimationPoses();
+
+	const nsAnimationPlayState fromState = InstancePlayStates[instance.Id];
 
+	if (fromState.Clip == clip && fromState.PlayRate == playRate)
+	{
+		return;
+	}
+
+	if (!PlayAnimation(instance, clip, playRate, bLoop))
+	{
+		return;
+	}
+
+	// Interrupted transition restarts from clip that was played, its own source is dropped
+	if (blendDuration > 0.0f && IsClipValid(fromState.Clip))
+	{
+		nsAnimationBlendState& blendState = InstanceBlendStates[instance.Id];
+		blendState.From = fromState;
+		blendState.TransitionMode = transitionMode;
+		blendState.BlendDuration = blendDuration;
+		blendState.BlendTime = 0.0f;
+	}
+}
+
+
+void nsAnimationManager::SetInstanceGraph(nsAnimationInstanceID instance, nsAnimationGraph* graph)
+{
+	NS_Assert(IsInstanceValid(instance));
+	WaitAnimationPoses();
+
+	InstanceDatas[instance.Id].Graph = graph;
 }
 
 
@@ -426,6 +927,8 @@ void nsAnimationManager::BeginFrame(int frameIndex)
 
 void nsAnimationManager::UpdateRenderResources()
 {
+	WaitAnimationPoses();
+
 	Frame& frame = FrameDatas[FrameIndex];
 
 	const uint64 storageBufferSize = sizeof(nsMatrix4) * InstanceBoneTransforms.GetCount();
@@ -459,39 +962,33 @@ void nsAnimationManager::SetInstanceDebugDraw(nsAnimationInstanceID instance, bo
 
 void nsAnimationManager::DebugDraw(nsRenderer* renderer)
 {
+	WaitAnimationPoses();
+
 	nsTArray<nsMatrix4> cachedBoneWorldMatrices;
 
 	for (int i = 0; i < InstanceDebugDraws.GetCount(); ++i)
 	{
 		const int id = InstanceDebugDraws.GetKeyByIndex(i);
 		const nsMatrix4 rootWorldTransformMatrix = InstanceDebugDraws.GetValueByIndex(i).ToMatrixNoScale();
-		const nsTArrayInline<nsAnimationSkeletonData::Bone, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE>& instanceBones = InstanceDatas[id].BoneTransforms;
+		const nsAnimationInstanceData& instanceData = InstanceDatas[id];
+		const int boneCount = instanceData.HierarchyModelMatrices.GetCount();
 		cachedBoneWorldMatrices.Clear();
-		cachedBoneWorldMatrices.ResizeConstructs(instanceBones.GetCount(), nsMatrix4::IDENTITY);
+		cachedBoneWorldMatrices.ResizeConstructs(boneCount, nsMatrix4::IDENTITY);
 
-		for (int j = 0; j < instanceBones.GetCount(); ++j)
+		for (int h = 0; h < boneCount; ++h)
 		{
-			const nsAnimationSkeletonData::Bone& bone = instanceBones[j];
-
-			if (bone.ParentId == -1)
-			{
-				cachedBoneWorldMatrices[j] = bone.LocalTransform.ToMatrix() * rootWorldTransformMatrix;
-			}
-			else
-			{
-				cachedBoneWorldMatrices[j] = bone.LocalTransform.ToMatrix() * cachedBoneWorldMatrices[bone.ParentId];
-			}
+			cachedBoneWorldMatrices[h] = instanceData.HierarchyModelMatrices[h] * rootWorldTransformMatrix;
 		}
 
-		for (int j = 0; j < instanceBones.GetCount(); ++j)
+		for (int h = 0; h < boneCount; ++h)
 		{
-			const nsAnimationSkeletonData::Bone& bone = instanceBones[j];
-			const nsVector3 boneWorldPosition = cachedBoneWorldMatrices[j].GetPosition();
+			const int parentId = instanceData.HierarchyParentIds[h];
+			const nsVector3 boneWorldPosition = cachedBoneWorldMatrices[h].GetPosition();
 			renderer->DebugDrawMeshAABB(boneWorldPosition - 0.5f, boneWorldPosition + 0.5f, nsColor::GRAY, true);
 
-			if (bone.ParentId != -1)
+			if (parentId != -1)
 			{
-				const nsVector3 parentBoneWorldPosition = cachedBoneWorldMatrices[bone.ParentId].GetPosition();
+				const nsVector3 parentBoneWorldPosition = cachedBoneWorldMatrices[parentId].GetPosition();
 				renderer->DebugDrawLine(boneWorldPosition, parentBoneWorldPosition, nsColor::WHITE, 100, true);
 			}
 		}
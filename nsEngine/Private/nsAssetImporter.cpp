@@ -3,7 +3,158 @@
 #include "nsFileSystem.h"
 #include "nsConsole.h"
 #include "nsMesh.h"
-#include "nsTextureManager.h"
+#include "nsThreadPool.h"
+#include "nsCommandLines.h"
+
+
+
+// =============================================================================================================================================================== //
+// IMPORT JOB
+// =============================================================================================================================================================== //
+class nsAssetImportBatch;
+
+
+// Imports single asset. Execute() runs on worker thread, it only writes asset file (engine managers are not touched) and logs through nsLogger (console is not thread safe)
+class nsAssetImportJob
+{
+public:
+	nsName Name;
+	nsEAssetType Type;
+	bool bSucceeded;
+
+
+public:
+	nsAssetImportJob(nsName name, nsEAssetType type) noexcept
+		: Name(name)
+		, Type(type)
+		, bSucceeded(false)
+	{
+	}
+
+	virtual ~nsAssetImportJob() noexcept = default;
+
+	NS_NODISCARD virtual bool Execute(const nsAssetImportBatch& batch) noexcept = 0;
+
+};
+
+
+
+// Source data shared by import jobs (ex: parsed GLB file), released after all jobs in batch finished
+class nsAssetImportSource
+{
+public:
+	virtual ~nsAssetImportSource() noexcept = default;
+
+};
+
+
+
+class nsAssetImportBatch
+{
+public:
+	// Destination folder (game assets path + destination folder path)
+	nsString AssetPath;
+
+	nsTArray<nsAssetImportJob*> Jobs;
+	nsTArray<nsAssetImportSource*> Sources;
+
+
+public:
+	~nsAssetImportBatch() noexcept
+	{
+		for (int i = 0; i < Jobs.GetCount(); ++i)
+		{
+			ns_DestroyObject(Jobs[i]);
+		}
+
+		for (int i = 0; i < Sources.GetCount(); ++i)
+		{
+			ns_DestroyObject(Sources[i]);
+		}
+	}
+
+
+	NS_NODISCARD_INLINE nsString GetAssetFile(nsName name) const noexcept
+	{
+		return nsString::Format(TEXT("%s/%s%s"), *AssetPath, *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
+	}
+
+
+	// Jobs already run in parallel, texture compression only uses its own threads if it is the only job
+	NS_NODISCARD_INLINE int GetTextureCompressThreadCount() const noexcept
+	{
+		return Jobs.GetCount() > 1 ? 1 : 0;
+	}
+
+};
+
+
+
+bool nsAssetImporter::RunImportBatch(nsAssetImportBatch& batch) noexcept
+{
+	const int jobCount = batch.Jobs.GetCount();
+
+	if (jobCount == 0)
+	{
+		return true;
+	}
+
+	// Jobs with same name would write same asset file in parallel, only first one is run and the rest are rejected
+	nsTArray<nsAssetImportJob*> runJobs;
+	nsTMap<nsName, int> jobNameIndices;
+
+	for (int i = 0; i < jobCount; ++i)
+	{
+		nsAssetImportJob* job = batch.Jobs[i];
+		const int* firstIndex = jobNameIndices.GetValueByKey(job->Name);
+
+		if (firstIndex)
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Skip import asset [%s]. Another source in this import already produces asset with the same name!"), *job->Name.ToString());
+			job->bSucceeded = false;
+			continue;
+		}
+
+		jobNameIndices.Add(job->Name) = i;
+		runJobs.Add(job);
+	}
+
+	const int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+
+	nsParallelFor(0, runJobs.GetCount(), 1, [&batch, &runJobs](int index)
+	{
+		nsAssetImportJob* job = runJobs[index];
+		job->bSucceeded = job->Execute(batch);
+	});
+
+	const double elapsedMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	nsAssetManager& assetManager = nsAssetManager::Get();
+	int succeededCount = 0;
+
+	for (int i = 0; i < jobCount; ++i)
+	{
+		const nsAssetImportJob* job = batch.Jobs[i];
+
+		if (job->bSucceeded)
+		{
+			assetManager.RegisterImportedAsset(job->Name, batch.AssetPath, job->Type);
+			++succeededCount;
+		}
+	}
+
+	if (succeededCount == jobCount)
+	{
+		NS_CONSOLE_Log(AssetLog, TEXT("Imported %i assets to [%s] in %.3f ms (%i threads)"), jobCount, *batch.AssetPath, elapsedMs, nsThreadPool::GetThreadCount());
+	}
+	else
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Imported %i of %i assets to [%s] in %.3f ms (%i threads)"), succeededCount, jobCount, *batch.AssetPath, elapsedMs, nsThreadPool::GetThreadCount());
+	}
+
+	return succeededCount == jobCount;
+}
+
 
 
 
@@ -86,88 +237,186 @@ static NS_NODISCARD_INLINE CMP_FORMAT ns_ConvertTextureFormatToCMP(nsETextureFor
 }
 
 
-void nsAssetImporter::ImportAssetFromImageFile(const nsAssetImportOption_Image& option, const nsString& dstFolderPath) noexcept
+// [Thread safe] Load image file, generate mips and compress into <outData>
+static bool ns_ImportTextureDataFromImageFile(nsTextureData& outData, const nsString& sourceFile, nsETextureFormat format, bool bGenerateMipMaps, int compressThreadCount) noexcept
 {
-	if (!nsFileSystem::FileExists(option.SourceFile))
-	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture. Source file [%s] does not exists!"), *option.SourceFile);
-		return;
-	}
-
-	if (!nsFileSystem::FolderCreate(dstFolderPath))
-	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture from file [%s]. Fail to create destination folder [%s]"), *option.SourceFile, *dstFolderPath);
-		return;
-	}
-
-	const nsString fileName = nsFileSystem::FileGetName(option.SourceFile);
-	const nsString fileExt = nsFileSystem::FileGetExtension(option.SourceFile);
-
-	if (!(fileExt == TEXT(".bmp") || fileExt == TEXT(".png") || fileExt == TEXT(".tga") ))
-	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture from file [%s]. File format not supported!"), *option.SourceFile);
-		return;
-	}
-
 	CMP_MipSet srcMipSet = {};
 	char sourceFileCstr[256];
-	nsPlatform::String_ConvertToChar(sourceFileCstr, *option.SourceFile, option.SourceFile.GetLength());
+	nsPlatform::String_ConvertToChar(sourceFileCstr, *sourceFile, sourceFile.GetLength());
 
 	if (CMP_LoadTexture(sourceFileCstr, &srcMipSet) != CMP_OK)
 	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture from file [%s]. Compressonator: Load texture data failed!"), *option.SourceFile);
-		return;
+		NS_LogWarning(AssetLog, TEXT("Fail to import texture from file [%s]. Compressonator: Load texture data failed!"), *sourceFile);
+		return false;
 	}
 
-	if (srcMipSet.m_nMipLevels <= 1 && option.bGenerateMipMaps)
+	if (srcMipSet.m_nMipLevels <= 1 && bGenerateMipMaps)
 	{
 		const int mipMinSize = CMP_CalcMinMipSize(srcMipSet.dwHeight, srcMipSet.dwWidth, NS_ENGINE_TEXTURE_MAX_MIP);
 		CMP_GenerateMIPLevels(&srcMipSet, mipMinSize);
 	}
 
 	CMP_MipSet dstMipSet = {};
-	const bool bCompressed = !(option.Format == nsETextureFormat::UNCOMPRESSED_RGBA || option.Format == nsETextureFormat::UNCOMPRESSED_BGRA || option.Format == nsETextureFormat::UNCOMPRESSED_R);
+	const bool bCompressed = !(format == nsETextureFormat::UNCOMPRESSED_RGBA || format == nsETextureFormat::UNCOMPRESSED_BGRA || format == nsETextureFormat::UNCOMPRESSED_R);
 
 	if (bCompressed)
 	{
 		KernelOptions options = {};
-		options.format = ns_ConvertTextureFormatToCMP(option.Format);
+		options.format = ns_ConvertTextureFormatToCMP(format);
 		options.fquality = 0.1f;
-		options.threads = 0;
+		options.threads = compressThreadCount;
 
 		if (CMP_ProcessTexture(&srcMipSet, &dstMipSet, options, nullptr) != CMP_OK)
 		{
-			NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture from file [%s]. Compressonator: Fail to process texture compression!"), *option.SourceFile);
+			NS_LogWarning(AssetLog, TEXT("Fail to import texture from file [%s]. Compressonator: Fail to process texture compression!"), *sourceFile);
 			CMP_FreeMipSet(&srcMipSet);
 			CMP_FreeMipSet(&dstMipSet);
-			return;
+			return false;
 		}
 
 		NS_Assert(dstMipSet.m_nMipLevels >= 1);
 	}
 
 	const CMP_MipSet* useMipSet = bCompressed ? &dstMipSet : &srcMipSet;
+	const int mipCount = nsMath::Min(useMipSet->m_nMipLevels, NS_ENGINE_TEXTURE_MAX_MIP);
 
-	nsTextureManager& textureManager = nsTextureManager::Get();
-	const nsTextureID texture = textureManager.CreateTexture2D(*fileName, option.Format, useMipSet->m_nWidth, useMipSet->m_nHeight);
-
-	const CMP_MipLevelTable& mipLevelTable0 = useMipSet->m_pMipLevelTable[0];
-	textureManager.UpdateTextureMipData(texture, 0, mipLevelTable0->m_pbData, mipLevelTable0->m_dwLinearSize);
+	outData.Width = useMipSet->m_nWidth;
+	outData.Height = useMipSet->m_nHeight;
+	outData.Format = format;
+	outData.Mips.Resize(mipCount);
 
-	for (int m = 1; m < useMipSet->m_nMipLevels; ++m)
+	for (int m = 0; m < mipCount; ++m)
 	{
 		const CMP_MipLevelTable& mipLevelTable = useMipSet->m_pMipLevelTable[m];
-		const int mipIndex = textureManager.AddTextureMipLevel(texture, mipLevelTable->m_nWidth, mipLevelTable->m_nHeight);
-		NS_Assert(mipIndex == m);
-		textureManager.UpdateTextureMipData(texture, m, mipLevelTable->m_pbData, mipLevelTable->m_dwLinearSize);
+		nsTextureData::Mip& mip = outData.Mips[m];
+		mip.Width = mipLevelTable->m_nWidth;
+		mip.Height = mipLevelTable->m_nHeight;
+		mip.Pixels.Clear();
+		mip.Pixels.InsertAt(mipLevelTable->m_pbData, static_cast<int>(mipLevelTable->m_dwLinearSize));
 	}
 
 	CMP_FreeMipSet(&srcMipSet);
 	CMP_FreeMipSet(&dstMipSet);
 
-	NS_CONSOLE_Log(AssetLog, TEXT("Imported texture from source file: %s"), *option.SourceFile);
+	return true;
+}
+
+
+
+class nsAssetImportJob_Image : public nsAssetImportJob
+{
+public:
+	nsString SourceFile;
+	nsETextureFormat Format;
+	bool bGenerateMipMaps;
+
+
+public:
+	nsAssetImportJob_Image(nsName name, const nsString& sourceFile, nsETextureFormat format, bool bGenerateMipMaps) noexcept
+		: nsAssetImportJob(name, nsEAssetType::TEXTURE)
+		, SourceFile(sourceFile)
+		, Format(format)
+		, bGenerateMipMaps(bGenerateMipMaps)
+	{
+	}
+
+
+	virtual bool Execute(const nsAssetImportBatch& batch) noexcept override
+	{
+		nsTextureData data{};
+
+		if (!ns_ImportTextureDataFromImageFile(data, SourceFile, Format, bGenerateMipMaps, batch.GetTextureCompressThreadCount()))
+		{
+			return false;
+		}
+
+		const nsString assetFile = batch.GetAssetFile(Name);
+
+		if (!nsAssetManager::Get().WriteTextureAssetFile(assetFile, data, nsECompression::LZ4))
+		{
+			NS_LogWarning(AssetLog, TEXT("Fail to save texture [%s] to asset file [%s]"), *Name.ToString(), *assetFile);
+			return false;
+		}
+
+		NS_LogInfo(AssetLog, TEXT("Imported texture [%s] from source file [%s]"), *Name.ToString(), *SourceFile);
+
+		return true;
+	}
+
+};
 
-	nsAssetManager::Get().SaveTextureAsset(*fileName, texture, dstFolderPath, false);
+
+
+NS_NODISCARD static NS_INLINE bool ns_IsImageFileExtension(const nsString& fileExt)
+{
+	const nsString ext = fileExt.ToLower();
+	return ext == TEXT(".bmp") || ext == TEXT(".png") || ext == TEXT(".tga");
+}
+
+
+bool nsAssetImporter::AddImportJob_Image(nsAssetImportBatch& batch, const nsAssetImportOption_Image& option) noexcept
+{
+	if (!nsFileSystem::FileExists(option.SourceFile))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture. Source file [%s] does not exists!"), *option.SourceFile);
+		return false;
+	}
+
+	if (!ns_IsImageFileExtension(nsFileSystem::FileGetExtension(option.SourceFile)))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import texture from file [%s]. File format not supported!"), *option.SourceFile);
+		return false;
+	}
+
+	const nsString fileName = nsFileSystem::FileGetName(option.SourceFile);
+	batch.Jobs.Add(ns_CreateObject<nsAssetImportJob_Image>(*fileName, option.SourceFile, option.Format, option.bGenerateMipMaps));
+
+	return true;
+}
+
+
+static bool ns_InitImportBatch(nsAssetImportBatch& batch, const nsString& dstFolderPath)
+{
+	batch.AssetPath = nsString::Format(TEXT("%s/%s"), *nsAssetManager::Get().GetGameAssetsPath(), *dstFolderPath);
+
+	if (!nsFileSystem::FolderCreate(batch.AssetPath))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import assets. Fail to create destination folder [%s]"), *batch.AssetPath);
+		return false;
+	}
+
+	return true;
+}
+
+
+void nsAssetImporter::ImportAssetFromImageFile(const nsAssetImportOption_Image& option, const nsString& dstFolderPath) noexcept
+{
+	nsAssetImportBatch batch;
+
+	if (ns_InitImportBatch(batch, dstFolderPath) && AddImportJob_Image(batch, option))
+	{
+		RunImportBatch(batch);
+	}
+}
+
+
+bool nsAssetImporter::ImportAssetsFromImageFiles(const nsTArray<nsAssetImportOption_Image>& options, const nsString& dstFolderPath) noexcept
+{
+	nsAssetImportBatch batch;
+
+	if (!ns_InitImportBatch(batch, dstFolderPath))
+	{
+		return false;
+	}
+
+	bool bSucceeded = true;
+
+	for (int i = 0; i < options.GetCount(); ++i)
+	{
+		bSucceeded &= AddImportJob_Image(batch, options[i]);
+	}
+
+	return RunImportBatch(batch) && bSucceeded;
 }
 
 
@@ -182,25 +431,143 @@ void nsAssetImporter::ImportAssetFromImageFile(const nsAssetImportOption_Image&
 
 
 
-void nsAssetImporter::ImportAssetFromModelFile(const nsAssetImportOption_Model& option, const nsString& dstFolderPath) noexcept
+bool nsAssetImporter::AddImportJobs_Model(nsAssetImportBatch& batch, const nsAssetImportOption_Model& option) noexcept
 {
 	if (!nsFileSystem::FileExists(option.SourceFile))
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import model. Source file [%s] does not exists!"), *option.SourceFile);
-		return;
+		return false;
 	}
 
-	const nsString fileName = nsFileSystem::FileGetName(option.SourceFile);
-	const nsString fileExt = nsFileSystem::FileGetExtension(option.SourceFile);
+	const nsString fileExt = nsFileSystem::FileGetExtension(option.SourceFile).ToLower();
 
 	if (!(fileExt == TEXT(".glb") || fileExt == TEXT(".fbx")) )
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import model from file [%s]. File format not supported!"), *option.SourceFile);
-		return;
+		return false;
 	}
 
 	if (fileExt == TEXT(".glb") )
 	{
-		ImportAssetFromModelFile_GLB(option, dstFolderPath);
+		return AddImportJobs_GLB(batch, option);
+	}
+
+	NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import model from file [%s]. FBX import not implemented yet!"), *option.SourceFile);
+
+	return false;
+}
+
+
+void nsAssetImporter::ImportAssetFromModelFile(const nsAssetImportOption_Model& option, const nsString& dstFolderPath) noexcept
+{
+	nsAssetImportBatch batch;
+
+	if (ns_InitImportBatch(batch, dstFolderPath) && AddImportJobs_Model(batch, option))
+	{
+		RunImportBatch(batch);
 	}
 }
+
+
+
+
+// =============================================================================================================================================================== //
+// BATCH IMPORT
+// =============================================================================================================================================================== //
+bool nsAssetImporter::ImportAssetsFromFolder(const nsString& sourceFolderPath, const nsString& dstFolderPath, const nsAssetImportOption_Image& imageOption, const nsAssetImportOption_Model& modelOption) noexcept
+{
+	if (!nsFileSystem::FolderExists(sourceFolderPath))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to import assets. Source folder [%s] does not exists!"), *sourceFolderPath);
+		return false;
+	}
+
+	nsAssetImportBatch batch;
+
+	if (!ns_InitImportBatch(batch, dstFolderPath))
+	{
+		return false;
+	}
+
+	nsTArray<nsString> sourceFiles;
+	nsFileSystem::FileIterate(sourceFiles, sourceFolderPath, true);
+
+	bool bSucceeded = true;
+
+	// GLB files are parsed on calling thread while gathering jobs, everything else runs in RunImportBatch()
+	for (int i = 0; i < sourceFiles.GetCount(); ++i)
+	{
+		const nsString& sourceFile = sourceFiles[i];
+		const nsString fileExt = nsFileSystem::FileGetExtension(sourceFile).ToLower();
+
+		if (ns_IsImageFileExtension(fileExt))
+		{
+			nsAssetImportOption_Image option = imageOption;
+			option.SourceFile = sourceFile;
+			bSucceeded &= AddImportJob_Image(batch, option);
+		}
+		else if (fileExt == TEXT(".glb"))
+		{
+			nsAssetImportOption_Model option = modelOption;
+			option.SourceFile = sourceFile;
+			bSucceeded &= AddImportJobs_GLB(batch, option);
+		}
+	}
+
+	NS_CONSOLE_Log(AssetLog, TEXT("Import %i assets from [%s] (%i source files)"), batch.Jobs.GetCount(), *sourceFolderPath, sourceFiles.GetCount());
+
+	return RunImportBatch(batch) && bSucceeded;
+}
+
+
+bool nsAssetImporter::ImportAssetsFromCommandLines() noexcept
+{
+	const nsCommandLines& commandLines = nsCommandLines::Get();
+
+	if (!commandLines.HasCommand(TEXT("import")))
+	{
+		return false;
+	}
+
+	const nsString source = commandLines.GetValue(TEXT("import"));
+	const nsString dstFolderPath = commandLines.HasCommand(TEXT("importdst")) ? commandLines.GetValue(TEXT("importdst")) : nsString(TEXT("Imported"));
+
+	nsAssetImportOption_Image imageOption{};
+	imageOption.Format = nsETextureFormat::COMPRESSED_BC3_RGBA;
+	imageOption.bGenerateMipMaps = true;
+
+	nsAssetImportOption_Model modelOption{};
+	modelOption.MeshScaleMultiplier = commandLines.HasCommand(TEXT("importscale")) ? commandLines.GetValuesAsFloat(TEXT("importscale")) : 100.0f;
+	modelOption.AnimationCompressionError = commandLines.HasCommand(TEXT("importanimerror")) ? commandLines.GetValuesAsFloat(TEXT("importanimerror")) : 0.0f;
+	modelOption.bImportMesh = true;
+	modelOption.bImportSkeleton = true;
+	modelOption.bImportAnimation = true;
+	modelOption.bImportTexture = true;
+
+	if (nsFileSystem::FolderExists(source))
+	{
+		return ImportAssetsFromFolder(source, dstFolderPath, imageOption, modelOption);
+	}
+
+	nsAssetImportBatch batch;
+
+	if (!ns_InitImportBatch(batch, dstFolderPath))
+	{
+		return false;
+	}
+
+	bool bSucceeded = false;
+
+	if (ns_IsImageFileExtension(nsFileSystem::FileGetExtension(source)))
+	{
+		imageOption.SourceFile = source;
+		bSucceeded = AddImportJob_Image(batch, imageOption);
+	}
+	else
+	{
+		modelOption.SourceFile = source;
+		bSucceeded = AddImportJobs_Model(batch, modelOption);
+	}
+
+	return RunImportBatch(batch) && bSucceeded;
+}
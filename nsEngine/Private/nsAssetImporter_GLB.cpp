@@ -1,6 +1,7 @@
 #include "nsAssetImporter.h"
 #include "nsFileSystem.h"
 #include "nsAnimationManager.h"
+#include "nsAnimationCompression.h"
 #include "nsConsole.h"
 #include "ThirdParty/json.hpp"
 
@@ -24,641 +25,924 @@ struct nsGLB_Node
 {
 	nsName Name;
 	nsTransform Transform;
-	nsTArrayInline<int, 16> Children;
+	nsTArray<int> Children;
 };
 
 
 
-struct nsGLB_Mesh
+// Byte range inside BIN chunk
+struct nsGLB_BufferView
+{
+	int Offset;
+	int Length;
+
+	// 0 if elements are tightly packed
+	int Stride;
+};
+
+
+
+struct nsGLB_Accessor
+{
+	int BufferView;
+	int Offset;
+	int Count;
+	int ComponentType;
+
+	// Element size (bytes)
+	int ElementSize;
+};
+
+
+
+// Typed strided view into BIN chunk, no data is copied
+template<typename T>
+struct nsGLB_AccessorView
+{
+	const uint8* Data;
+	int Count;
+	int Stride;
+
+
+public:
+	nsGLB_AccessorView() noexcept
+		: Data(nullptr)
+		, Count(0)
+		, Stride(0)
+	{
+	}
+
+
+	NS_NODISCARD_INLINE bool IsValid() const noexcept
+	{
+		return Data != nullptr;
+	}
+
+
+	NS_NODISCARD_INLINE bool IsPacked() const noexcept
+	{
+		return Stride == static_cast<int>(sizeof(T));
+	}
+
+
+	// Copy element, BIN data is only aligned to component size
+	NS_NODISCARD_INLINE T operator[](int index) const noexcept
+	{
+		NS_Assert(index >= 0 && index < Count);
+		T value;
+		nsPlatform::Memory_Copy(&value, Data + static_cast<size_t>(index) * Stride, sizeof(T));
+		return value;
+	}
+
+};
+
+
+
+struct nsGLB_Joints16
+{
+	uint16 Indices[4];
+};
+
+
+
+// ================================================================================================================================================================ //
+// SKELETON
+// ================================================================================================================================================================ //
+struct nsGLB_Bone
 {
 	nsName Name;
-	nsTArray<nsVector3> VertexPositions;
-	nsTArray<nsVector3> VertexNormals;
-	nsTArray<nsVector4> VertexTangents;
-	nsTArray<nsVector2> VertexTexCoords_0;
-	nsTArray<nsVector2> VertexTexCoords_1;
-	nsTArray<nsVector4> VertexWeights;
-	nsTArray<uint32> VertexJoints;
-	nsTArray<uint32> VertexIndices;
+	nsMatrix4 InverseBindPoseTransform;
+	nsTransform LocalTransform;
+	int NodeId;
+	int ParentId;
+
+
+public:
+	nsGLB_Bone()
+	{
+		InverseBindPoseTransform = nsMatrix4::IDENTITY;
+		NodeId = -1;
+		ParentId = -1;
+	}
+
 };
 
+typedef nsTArrayInline<nsGLB_Bone, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> nsGLB_BoneHierarchy;
 
 
-struct nsGLB_Model
+
+struct nsGLB_Skeleton
 {
 	nsName Name;
-	nsTArrayInline<nsGLB_Mesh, NS_ENGINE_ASSET_MODEL_MAX_MESH> Meshes;
+	nsGLB_BoneHierarchy Bones;
 };
 
 
 
 
-template<typename T = void>
-static const T* ns_GLB_GetBufferData(int& outCount, int& outComponentType, const uint8* binData, const nlohmann::json& jsonData, int accessorIndex)
+// ================================================================================================================================================================ //
+// FILE
+// ================================================================================================================================================================ //
+// Parsed GLB file, read only while import jobs are running.
+// File is mapped, buffer views and accessors are indexed once so import jobs read vertex/animation data straight from BIN chunk
+class nsGLB_File : public nsAssetImportSource
 {
-	NS_Validate(binData);
+public:
+	nsAssetImportOption_Model Option;
+	nsFileMappedView MappedFile;
+	nlohmann::json JsonData;
+	const uint8* BinData;
+	int BinSize;
+	nsTArray<nsGLB_BufferView> BufferViews;
+	nsTArray<nsGLB_Accessor> Accessors;
+	nsTArray<nsGLB_Node> Nodes;
+	nsGLB_Skeleton Skeleton;
 
-	const nlohmann::json& jsonAccessorArray = jsonData["accessors"];
-	const int accessorCount = static_cast<int>(jsonAccessorArray.size());
-	NS_Validate(accessorIndex >= 0 && accessorIndex < accessorCount);
 
-	const nlohmann::json& jsonAccessor = jsonAccessorArray[accessorIndex];
-	outCount = jsonAccessor["count"];
-	outComponentType = jsonAccessor["componentType"];
-	const int bufferViewIndex = jsonAccessor["bufferView"];
+public:
+	nsGLB_File() noexcept
+		: BinData(nullptr)
+		, BinSize(0)
+	{
+	}
+
+};
 
-	const nlohmann::json& jsonBufferViewArray = jsonData["bufferViews"];
-	const int bufferViewCount = static_cast<int>(jsonBufferViewArray.size());
-	NS_Validate(bufferViewIndex >= 0 && bufferViewIndex < bufferViewCount);
 
-	const nlohmann::json& jsonBufferView = jsonBufferViewArray[bufferViewIndex];
-	const int bufferDataIndex = jsonBufferView["buffer"];
-	NS_Validate(bufferDataIndex == 0);
 
-	const int bufferOffset = jsonBufferView["byteOffset"];
-	const int bufferSizeBytes = jsonBufferView["byteLength"];
-	NS_Validate(bufferSizeBytes > 0);
+static int ns_GLB_GetComponentSize(int componentType)
+{
+	switch (componentType)
+	{
+		case GLB_COMPONENT_TYPE_INT8:
+		case GLB_COMPONENT_TYPE_UINT8:		return 1;
+		case GLB_COMPONENT_TYPE_INT16:
+		case GLB_COMPONENT_TYPE_UINT16:		return 2;
+		case GLB_COMPONENT_TYPE_UINT32:
+		case GLB_COMPONENT_TYPE_FLOAT:		return 4;
+		default: break;
+	}
 
-	return reinterpret_cast<const T*>(binData + bufferOffset);
+	return 0;
 }
 
 
+static int ns_GLB_GetComponentCount(const std::string& type)
+{
+	if (type == "SCALAR") return 1;
+	if (type == "VEC2") return 2;
+	if (type == "VEC3") return 3;
+	if (type == "VEC4") return 4;
+	if (type == "MAT2") return 4;
+	if (type == "MAT3") return 9;
+	if (type == "MAT4") return 16;
+
+	return 0;
+}
 
-template<typename T>
-static bool ns_GLB_GetVertexData(nsTArray<T>& outVertexData, const char* attributeName, const uint8* binData, const nlohmann::json& jsonData, const nlohmann::json& jsonVertexAttributes)
+
+// Index <bufferViews> and <accessors> once, validates every accessor range against BIN chunk
+static bool ns_GLB_IndexAccessors(nsGLB_File& file)
 {
-	NS_Validate(attributeName);
-	NS_Validate(binData);
+	const nlohmann::json& jsonBufferViewArray = file.JsonData["bufferViews"];
+	const int bufferViewCount = static_cast<int>(jsonBufferViewArray.size());
+	file.BufferViews.Resize(bufferViewCount);
 
-	if (!jsonVertexAttributes.contains(attributeName))
+	for (int i = 0; i < bufferViewCount; ++i)
+	{
+		const nlohmann::json& jsonBufferView = jsonBufferViewArray[i];
+		nsGLB_BufferView& bufferView = file.BufferViews[i];
+		bufferView.Offset = jsonBufferView.value("byteOffset", 0);
+		bufferView.Length = jsonBufferView.value("byteLength", 0);
+		bufferView.Stride = jsonBufferView.value("byteStride", 0);
+
+		if (jsonBufferView.value("buffer", 0) != 0 || bufferView.Offset < 0 || bufferView.Length < 0 || bufferView.Offset > file.BinSize - bufferView.Length)
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Buffer view [%i] is out of BIN chunk!"), *file.Option.SourceFile, i);
+			return false;
+		}
+	}
+
+	const nlohmann::json& jsonAccessorArray = file.JsonData["accessors"];
+	const int accessorCount = static_cast<int>(jsonAccessorArray.size());
+	file.Accessors.Resize(accessorCount);
+
+	for (int i = 0; i < accessorCount; ++i)
+	{
+		const nlohmann::json& jsonAccessor = jsonAccessorArray[i];
+		nsGLB_Accessor& accessor = file.Accessors[i];
+		accessor.BufferView = jsonAccessor.value("bufferView", -1);
+		accessor.Offset = jsonAccessor.value("byteOffset", 0);
+		accessor.Count = jsonAccessor.value("count", 0);
+		accessor.ComponentType = jsonAccessor.value("componentType", 0);
+		accessor.ElementSize = ns_GLB_GetComponentSize(accessor.ComponentType) * ns_GLB_GetComponentCount(jsonAccessor.value("type", std::string()));
+
+		// Sparse accessor or accessor without buffer view (all zeros) is not supported, only fails when it is used
+		if (accessor.BufferView < 0 || accessor.BufferView >= bufferViewCount || accessor.ElementSize == 0 || accessor.Count <= 0)
+		{
+			accessor.BufferView = -1;
+			continue;
+		}
+
+		const nsGLB_BufferView& bufferView = file.BufferViews[accessor.BufferView];
+		const int64 stride = bufferView.Stride > 0 ? bufferView.Stride : accessor.ElementSize;
+		const int64 lastByte = static_cast<int64>(accessor.Offset) + stride * (accessor.Count - 1) + accessor.ElementSize;
+
+		if (accessor.Offset < 0 || lastByte > bufferView.Length)
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Accessor [%i] is out of buffer view [%i]!"), *file.Option.SourceFile, i, accessor.BufferView);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+// [Thread safe] Get typed view of accessor. Returns false if accessor does not exist or element type does not match
+template<typename T>
+static bool ns_GLB_GetAccessorView(nsGLB_AccessorView<T>& outView, const nsGLB_File& file, int accessorIndex, int componentType)
+{
+	if (accessorIndex < 0 || accessorIndex >= file.Accessors.GetCount())
 	{
 		return false;
 	}
 
-	const int accessorIndex = jsonVertexAttributes[attributeName];
-	int vertexCount = 0;
-	int componentType = 0;
-	const T* vertexData = ns_GLB_GetBufferData<T>(vertexCount, componentType, binData, jsonData, accessorIndex);
-	NS_Validate(vertexData);
+	const nsGLB_Accessor& accessor = file.Accessors[accessorIndex];
+
+	if (accessor.BufferView == -1 || accessor.ComponentType != componentType || accessor.ElementSize != static_cast<int>(sizeof(T)))
+	{
+		return false;
+	}
 
-	outVertexData.InsertAt(vertexData, vertexCount);
+	const nsGLB_BufferView& bufferView = file.BufferViews[accessor.BufferView];
+	outView.Data = file.BinData + bufferView.Offset + accessor.Offset;
+	outView.Count = accessor.Count;
+	outView.Stride = bufferView.Stride > 0 ? bufferView.Stride : accessor.ElementSize;
 
 	return true;
 }
 
 
+NS_NODISCARD static NS_INLINE int ns_GLB_GetAttributeAccessor(const nlohmann::json& jsonVertexAttributes, const char* attributeName)
+{
+	return jsonVertexAttributes.value(attributeName, -1);
+}
+
+
+// Index value (ex: sampler, node) of json object. Returns -1 if key is missing or value is not an integer
+NS_NODISCARD static NS_INLINE int ns_GLB_GetIndex(const nlohmann::json& jsonObject, const char* key)
+{
+	const nlohmann::json::const_iterator it = jsonObject.find(key);
+	return (it != jsonObject.end() && it->is_number_integer()) ? it->get<int>() : -1;
+}
+
+
+// Name of json object, <fallbackPrefix><index> if name is missing or not a string
+NS_NODISCARD static std::string ns_GLB_GetName(const nlohmann::json& jsonObject, const char* fallbackPrefix, int index)
+{
+	const nlohmann::json::const_iterator it = jsonObject.find("name");
+	return (it != jsonObject.end() && it->is_string()) ? it->get<std::string>() : fallbackPrefix + std::to_string(index);
+}
+
+
 
 
 // ================================================================================================================================================================ //
 // MODEL/MESHES
 // ================================================================================================================================================================ //
-static void ns_GLB_ImportModels(const nsAssetImportOption_Model& option, const nsString& dstFolderPath, const uint8* binData, const nlohmann::json& jsonData)
+// [Thread safe] Convert mesh primitive straight from BIN chunk into final vertex streams
+static bool ns_GLB_ReadMeshVertexData(nsMeshVertexData& vertexData, const nsGLB_File& file, const nlohmann::json& jsonMesh, const nsName& meshName)
 {
-	if (!option.bImportMesh)
+	const nlohmann::json& jsonVertexAttributes = jsonMesh["attributes"];
+
+	nsGLB_AccessorView<nsVector3> positions;
+	nsGLB_AccessorView<nsVector3> normals;
+	nsGLB_AccessorView<nsVector4> tangents;
+	nsGLB_AccessorView<nsVector2> texCoords;
+
+	if (!ns_GLB_GetAccessorView(positions, file, ns_GLB_GetAttributeAccessor(jsonVertexAttributes, "POSITION"), GLB_COMPONENT_TYPE_FLOAT) ||
+		!ns_GLB_GetAccessorView(normals, file, ns_GLB_GetAttributeAccessor(jsonVertexAttributes, "NORMAL"), GLB_COMPONENT_TYPE_FLOAT) ||
+		!ns_GLB_GetAccessorView(tangents, file, ns_GLB_GetAttributeAccessor(jsonVertexAttributes, "TANGENT"), GLB_COMPONENT_TYPE_FLOAT) ||
+		!ns_GLB_GetAccessorView(texCoords, file, ns_GLB_GetAttributeAccessor(jsonVertexAttributes, "TEXCOORD_0"), GLB_COMPONENT_TYPE_FLOAT))
 	{
-		return;
+		NS_LogWarning(AssetImporterGLB, TEXT("Fail to import mesh [%s] from file [%s]. Vertex [POSITION, NORMAL, TANGENT, TEXCOORD_0] float data required!"), *meshName.ToString(), *file.Option.SourceFile);
+		return false;
 	}
 
-	if (!jsonData.contains("meshes"))
+	const int vertexCount = positions.Count;
+
+	if (normals.Count != vertexCount || tangents.Count != vertexCount || texCoords.Count != vertexCount)
 	{
-		NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import model from file [%s]. <meshes> not found in json data!"), *option.SourceFile);
-		return;
+		NS_LogWarning(AssetImporterGLB, TEXT("Fail to import mesh [%s] from file [%s]. Vertex attribute count mismatch!"), *meshName.ToString(), *file.Option.SourceFile);
+		return false;
 	}
 
-	const nlohmann::json& jsonAccessorArray = jsonData["accessors"];
-	const nlohmann::json& jsonBufferViewArray = jsonData["bufferViews"];
-	const nlohmann::json& jsonModelArray = jsonData["meshes"];
-	const int modelCount = static_cast<int>(jsonModelArray.size());
-	nsTArray<nsGLB_Model> glbModels(modelCount, nsGLB_Model());
+	// Vertex position
+	const float scale = file.Option.MeshScaleMultiplier;
+	vertexData.Positions.Resize(vertexCount);
+	nsVertexMeshPosition* dstPositions = vertexData.Positions.GetData();
 
-	for (int i = 0; i < modelCount; ++i)
+	if (positions.IsPacked() && scale == 1.0f)
 	{
-		const nlohmann::json& jsonModel = jsonModelArray[i];
-		
-		nsGLB_Model& glbModel = glbModels[i];
-		glbModel.Name = nsName::Format("mdl_%s", jsonModel["name"].get<std::string>().c_str());
-
-		if (!jsonModel.contains("primitives"))
+		nsPlatform::Memory_Copy(dstPositions, positions.Data, sizeof(nsVector3) * vertexCount);
+	}
+	else
+	{
+		for (int v = 0; v < vertexCount; ++v)
 		{
-			NS_CONSOLE_Warning(AssetImporterGLB, TEXT("Fail to import model [%s] from file [%s]. <primitives> data not found!"), *glbModel.Name.ToString(), *option.SourceFile);
-			continue;
+			dstPositions[v] = positions[v] * scale;
 		}
+	}
 
-		const nlohmann::json jsonMeshArray = jsonModel["primitives"];
-		const int meshCount = static_cast<int>(jsonMeshArray.size());
+	// Vertex normal, tangent, texCoord_0
+	vertexData.Attributes.Resize(vertexCount);
+	nsVertexMeshAttribute* dstAttributes = vertexData.Attributes.GetData();
 
-		for (int m = 0; m < meshCount; ++m)
+	for (int v = 0; v < vertexCount; ++v)
+	{
+		nsVertexMeshAttribute& attribute = dstAttributes[v];
+		attribute.Normal = normals[v];
+		attribute.Tangent = tangents[v].ToVector3();
+		attribute.TexCoord = texCoords[v];
+	}
+
+	// Vertex weights, joints
+	vertexData.Skins.Resize(vertexCount);
+	const int weightsAccessor = ns_GLB_GetAttributeAccessor(jsonVertexAttributes, "WEIGHTS_0");
+
+	if (weightsAccessor != -1)
+	{
+		const int jointsAccessor = ns_GLB_GetAttributeAccessor(jsonVertexAttributes, "JOINTS_0");
+
+		nsGLB_AccessorView<nsVector4> weights;
+		nsGLB_AccessorView<uint32> joints8;
+		nsGLB_AccessorView<nsGLB_Joints16> joints16;
+
+		if (!ns_GLB_GetAccessorView(weights, file, weightsAccessor, GLB_COMPONENT_TYPE_FLOAT) || weights.Count != vertexCount ||
+			!(ns_GLB_GetAccessorView(joints8, file, jointsAccessor, GLB_COMPONENT_TYPE_UINT8) || ns_GLB_GetAccessorView(joints16, file, jointsAccessor, GLB_COMPONENT_TYPE_UINT16)) ||
+			nsMath::Max(joints8.Count, joints16.Count) != vertexCount)
 		{
-			nsGLB_Mesh& mesh = glbModel.Meshes.Add();
-			mesh.Name = nsName::Format("%s_%i", *glbModel.Name, m);
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import mesh [%s] from file [%s]. Invalid vertex [WEIGHTS_0, JOINTS_0] data!"), *meshName.ToString(), *file.Option.SourceFile);
+			return false;
+		}
 
-			const nlohmann::json& jsonMesh = jsonMeshArray[m];
-			const nlohmann::json& jsonVertexAttributes = jsonMesh["attributes"];
+		nsVertexMeshSkin* dstSkins = vertexData.Skins.GetData();
 
-			// Vertex position
-			bool bSuccess = ns_GLB_GetVertexData(mesh.VertexPositions, "POSITION", binData, jsonData, jsonVertexAttributes);
-			NS_ValidateV(bSuccess, TEXT("Fail to get vertex [POSITION] data from model [%s] in GLB file [%s]"), *mesh.Name.ToString(), *option.SourceFile);
+		for (int v = 0; v < vertexCount; ++v)
+		{
+			nsVertexMeshSkin& skin = dstSkins[v];
+			skin.Weights = weights[v];
 
-			for (int vtx = 0; vtx < mesh.VertexPositions.GetCount(); ++vtx)
+			if (joints8.IsValid())
 			{
-				mesh.VertexPositions[vtx] *= option.MeshScaleMultiplier;
+				skin.Joints = joints8[v];
 			}
+			else
+			{
+				// Joint index is packed as uint8, skeleton never has more than 256 bones
+				const nsGLB_Joints16& joint = joints16[v];
+				skin.Joints = (joint.Indices[0] & 0xFF) | ((joint.Indices[1] & 0xFF) << 8) | ((joint.Indices[2] & 0xFF) << 16) | ((joint.Indices[3] & 0xFF) << 24);
+			}
+		}
+	}
 
-			// Vertex normal
-			bSuccess = ns_GLB_GetVertexData(mesh.VertexNormals, "NORMAL", binData, jsonData, jsonVertexAttributes);
-			NS_ValidateV(bSuccess, TEXT("Fail to get vertex [NORMAL] data from model [%s] in GLB file [%s]"), *mesh.Name.ToString(), *option.SourceFile);
-			NS_Validate(mesh.VertexNormals.GetCount() == mesh.VertexPositions.GetCount());
-
-			// Vertex tangent
-			bSuccess = ns_GLB_GetVertexData(mesh.VertexTangents, "TANGENT", binData, jsonData, jsonVertexAttributes);
-			NS_ValidateV(bSuccess, TEXT("Fail to get vertex [TANGENT] data from model [%s] in GLB file [%s]"), *mesh.Name.ToString(), *option.SourceFile);
-			NS_Validate(mesh.VertexTangents.GetCount() == mesh.VertexPositions.GetCount());
+	// Vertex indices
+	{
+		const int accessorIndex = jsonMesh.value("indices", -1);
+		nsGLB_AccessorView<uint32> indices32;
+		nsGLB_AccessorView<uint16> indices16;
+		nsGLB_AccessorView<uint8> indices8;
 
-			// Vertex texCoord_0
-			bSuccess = ns_GLB_GetVertexData(mesh.VertexTexCoords_0, "TEXCOORD_0", binData, jsonData, jsonVertexAttributes);
-			NS_ValidateV(bSuccess, TEXT("Fail to get vertex [TEXCOORD_0] data from model [%s] in GLB file [%s]"), *mesh.Name.ToString(), *option.SourceFile);
-			NS_Validate(mesh.VertexTexCoords_0.GetCount() == mesh.VertexPositions.GetCount());
+		if (ns_GLB_GetAccessorView(indices32, file, accessorIndex, GLB_COMPONENT_TYPE_UINT32))
+		{
+			vertexData.Indices.Resize(indices32.Count);
 
-			// Vertex weights
-			const bool bHasVertexWeights = ns_GLB_GetVertexData(mesh.VertexWeights, "WEIGHTS_0", binData, jsonData, jsonVertexAttributes);
-			if (bHasVertexWeights)
+			if (indices32.IsPacked())
 			{
-				NS_Validate(mesh.VertexWeights.GetCount() == mesh.VertexPositions.GetCount());
+				nsPlatform::Memory_Copy(vertexData.Indices.GetData(), indices32.Data, sizeof(uint32) * indices32.Count);
 			}
-
-			// Vertex joints
-			const bool bHasVertexJoints = ns_GLB_GetVertexData(mesh.VertexJoints, "JOINTS_0", binData, jsonData, jsonVertexAttributes);
-			if (bHasVertexJoints)
+			else
 			{
-				NS_Validate(mesh.VertexJoints.GetCount() == mesh.VertexPositions.GetCount());
+				for (int i = 0; i < indices32.Count; ++i)
+				{
+					vertexData.Indices[i] = indices32[i];
+				}
 			}
+		}
+		else if (ns_GLB_GetAccessorView(indices16, file, accessorIndex, GLB_COMPONENT_TYPE_UINT16))
+		{
+			vertexData.Indices.Resize(indices16.Count);
+			uint32* dstIndices = vertexData.Indices.GetData();
 
-			// Vertex indices
+			for (int i = 0; i < indices16.Count; ++i)
 			{
-				const int accessorIndex = jsonMesh["indices"];
-				int indexCount = 0;
-				int componentType = 0;
-				const void* indicesBufferData = ns_GLB_GetBufferData(indexCount, componentType, binData, jsonData, accessorIndex);
-				mesh.VertexIndices.Resize(indexCount);
-
-				// UINT16
-				if (componentType == GLB_COMPONENT_TYPE_UINT16)
-				{
-					const uint16* indices = reinterpret_cast<const uint16*>(indicesBufferData);
+				dstIndices[i] = indices16[i];
+			}
+		}
+		else if (ns_GLB_GetAccessorView(indices8, file, accessorIndex, GLB_COMPONENT_TYPE_UINT8))
+		{
+			vertexData.Indices.Resize(indices8.Count);
+			uint32* dstIndices = vertexData.Indices.GetData();
 
-					for (int idx = 0; idx < indexCount; ++idx)
-					{
-						mesh.VertexIndices[idx] = indices[idx];
-					}
-				}
-				// UINT32
-				else
-				{
-					NS_Validate(componentType == GLB_COMPONENT_TYPE_UINT32);
-					nsPlatform::Memory_Copy(mesh.VertexIndices.GetData(), indicesBufferData, sizeof(uint32) * indexCount);
-				}
+			for (int i = 0; i < indices8.Count; ++i)
+			{
+				dstIndices[i] = indices8[i];
 			}
 		}
+		else
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import mesh [%s] from file [%s]. Invalid vertex indices!"), *meshName.ToString(), *file.Option.SourceFile);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 
 
-		nsMeshManager& meshManager = nsMeshManager::Get();
-		nsAssetModelMeshes modelMeshes;
 
-		for (int i = 0; i < meshCount; ++i)
+// ================================================================================================================================================================ //
+// SKELETON/ANIMATION
+// ================================================================================================================================================================ //
+static int ns_GLB_FindBoneIdWithNodeIndex(const nsGLB_BoneHierarchy& bones, int nodeIndex)
+{
+	for (int i = 0; i < bones.GetCount(); ++i)
+	{
+		if (bones[i].NodeId == nodeIndex)
 		{
-			const nsGLB_Mesh& mesh = glbModel.Meshes[i];
-			const int vertexCount = mesh.VertexPositions.GetCount();
+			return i;
+		}
+	}
 
-			const nsMeshID newMesh = meshManager.CreateMesh(mesh.Name);
-			nsMeshVertexData& vertexData = meshManager.GetMeshVertexData(newMesh, 0);
-			vertexData.Positions = mesh.VertexPositions;
+	return -1;
+};
 
-			vertexData.Attributes.Resize(vertexCount);
-			vertexData.Skins.Resize(vertexCount);
 
-			const nsTArray<nsVector3>& vertexNormals = mesh.VertexNormals;
-			const nsTArray<nsVector4>& vertexTangents = mesh.VertexTangents;
-			const nsTArray<nsVector2>& vertexTexCoords = mesh.VertexTexCoords_0;
-			const nsTArray<nsVector4>& vertexWeights = mesh.VertexWeights;
-			const nsTArray<uint32>& vertexJoints = mesh.VertexJoints;
+static bool ns_GLB_ReadSkeleton(nsGLB_File& file)
+{
+	const nlohmann::json& jsonSkeletonArray = file.JsonData["skins"];
+	const int skeletonCount = static_cast<int>(jsonSkeletonArray.size());
+	const nsMatrix4 scaleMatrix = nsMatrix4::Scale(100.0f);
 
-			for (int v = 0; v < vertexCount; ++v)
-			{
-				nsVertexMeshAttribute& attribute = vertexData.Attributes[v];
-				attribute.Normal = vertexNormals[v];
-				attribute.Tangent = vertexTangents[v].ToVector3();
-				attribute.TexCoord = vertexTexCoords[v];
+	if (!jsonSkeletonArray.is_array() || skeletonCount != 1)
+	{
+		NS_LogWarning(AssetImporterGLB, TEXT("Fail to import skeleton from file [%s]. Only single skin is supported! [SkinCount: %i]"), *file.Option.SourceFile, skeletonCount);
+		return false;
+	}
 
-				if (vertexWeights.GetCount() > 0)
-				{
-					NS_Validate(vertexJoints.GetCount() == vertexWeights.GetCount());
-					nsVertexMeshSkin& skin = vertexData.Skins[v];
-					skin.Weights = vertexWeights[v];
-					skin.Joints = vertexJoints[v];
-				}
-			}
+	const nlohmann::json& jsonSkeleton = jsonSkeletonArray[0];
 
-			vertexData.Indices = mesh.VertexIndices;
+	nsGLB_Skeleton& glbSkeleton = file.Skeleton;
+	glbSkeleton.Name = nsName::Format("skl_%s", ns_GLB_GetName(jsonSkeleton, "Skin_", 0).c_str());
 
-			modelMeshes.Add(newMesh);
-		}
+	if (!jsonSkeleton.contains("joints") || !jsonSkeleton["joints"].is_array())
+	{
+		NS_LogWarning(AssetImporterGLB, TEXT("Fail to import skeleton from file [%s]. <joints> not found in skin!"), *file.Option.SourceFile);
+		return false;
+	}
 
-		nsAssetManager::Get().SaveModelAsset(glbModel.Name, modelMeshes, dstFolderPath, false);
+	const nlohmann::json& jsonBoneArray = jsonSkeleton["joints"];
+	const int boneCount = static_cast<int>(jsonBoneArray.size());
 
-		NS_CONSOLE_Log(AssetImporterGLB, TEXT("Imported model [%s] from source file [%s]"), *glbModel.Name.ToString(), *option.SourceFile);
+	nsGLB_AccessorView<nsMatrix4> inverseBindPoseMatrices;
+
+	if (boneCount > NS_ENGINE_ANIMATION_SKELETON_MAX_BONE || !ns_GLB_GetAccessorView(inverseBindPoseMatrices, file, jsonSkeleton.value("inverseBindMatrices", -1), GLB_COMPONENT_TYPE_FLOAT) || inverseBindPoseMatrices.Count != boneCount)
+	{
+		NS_LogWarning(AssetImporterGLB, TEXT("Fail to import skeleton from file [%s]. Invalid bone count or inverse bind matrices!"), *file.Option.SourceFile);
+		return false;
 	}
-}
 
+	glbSkeleton.Bones.Resize(boneCount);
 
+	for (int j = 0; j < boneCount; ++j)
+	{
+		const int nodeIndex = jsonBoneArray[j].is_number_integer() ? jsonBoneArray[j].get<int>() : -1;
 
+		if (nodeIndex < 0 || nodeIndex >= file.Nodes.GetCount())
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import skeleton from file [%s]. Invalid node index of joint [%i]!"), *file.Option.SourceFile, j);
+			return false;
+		}
 
-// ================================================================================================================================================================ //
-// SKELETON/ANIMATION
-// ================================================================================================================================================================ //
-struct nsGLB_Bone
-{
-	nsName Name;
-	nsMatrix4 InverseBindPoseTransform;
-	nsTransform LocalTransform;
-	int NodeId;
-	int ParentId;
+		const nsGLB_Node& node = file.Nodes[nodeIndex];
 
+		const nsMatrix4 invBindMatrix = inverseBindPoseMatrices[j];
+		nsGLB_Bone& glbBone = glbSkeleton.Bones[j];
+		glbBone.Name = node.Name;
+		glbBone.InverseBindPoseTransform = invBindMatrix * scaleMatrix;
+		glbBone.LocalTransform = node.Transform;
+		glbBone.LocalTransform.Position *= 100.0f;
+		glbBone.NodeId = nodeIndex;
+		glbBone.ParentId = -1;
+	}
 
-public:
-	nsGLB_Bone()
+
+	// Adjust bone hierarchy
+	for (int j = 0; j < boneCount; ++j)
 	{
-		InverseBindPoseTransform = nsMatrix4::IDENTITY;
-		NodeId = -1;
-		ParentId = -1;
-	}
+		const nsGLB_Node& node = file.Nodes[glbSkeleton.Bones[j].NodeId];
 
-};
+		for (int c = 0; c < node.Children.GetCount(); ++c)
+		{
+			const int childNodeIndex = node.Children[c];
 
-typedef nsTArrayInline<nsGLB_Bone, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> nsGLB_BoneHierarchy;
+			if (childNodeIndex < 0 || childNodeIndex >= file.Nodes.GetCount())
+			{
+				NS_LogWarning(AssetImporterGLB, TEXT("Fail to import skeleton from file [%s]. Invalid child node index [%i] of joint [%i]!"), *file.Option.SourceFile, childNodeIndex, j);
+				return false;
+			}
+
+			const int childBoneId = ns_GLB_FindBoneIdWithNodeIndex(glbSkeleton.Bones, childNodeIndex);
 
+			if (childBoneId == -1)
+			{
+				NS_LogWarning(AssetImporterGLB, TEXT("Fail to import skeleton from file [%s]. Child node [%i] of joint [%i] is not a joint!"), *file.Option.SourceFile, childNodeIndex, j);
+				return false;
+			}
+
+			glbSkeleton.Bones[childBoneId].ParentId = j;
+		}
+	}
 
+	return true;
+}
 
-struct nsGLB_Skeleton
+
+// [Thread safe] Append sampler output to channels, returns false if sampler data is invalid
+template<typename T>
+static bool ns_GLB_ReadAnimationChannels(nsTArray<nsAnimationKeyFrame::TChannel<T>>& outChannels, float& outDuration, const nsGLB_File& file, const nsGLB_AccessorView<float>& timestamps, int outputAccessorIndex)
 {
-	nsName Name;
-	nsGLB_BoneHierarchy Bones;
-};
+	nsGLB_AccessorView<T> values;
 
+	if (!ns_GLB_GetAccessorView(values, file, outputAccessorIndex, GLB_COMPONENT_TYPE_FLOAT) || values.Count != timestamps.Count)
+	{
+		return false;
+	}
 
+	const int firstIndex = outChannels.GetCount();
+	outChannels.Resize(firstIndex + values.Count);
+	nsAnimationKeyFrame::TChannel<T>* dstChannels = outChannels.GetData() + firstIndex;
 
-struct nsGLB_Animation
-{
-	template<typename T>
-	struct TChannel
+	for (int t = 0; t < values.Count; ++t)
 	{
-		T Value;
-		float Timestamp;
-	};
+		dstChannels[t].Value = values[t];
+		dstChannels[t].Timestamp = timestamps[t];
+		outDuration = nsMath::Max(outDuration, dstChannels[t].Timestamp);
+	}
+
+	return true;
+}
+
+
+static void ns_GLB_MakeSkeletonData(nsAnimationSkeletonData& outData, const nsGLB_File& file)
+{
+	const nsGLB_BoneHierarchy& glbBones = file.Skeleton.Bones;
+	const int boneCount = glbBones.GetCount();
 
-	struct KeyFrame
+	outData.BoneNames.Resize(boneCount);
+	outData.BoneDatas.Resize(boneCount);
+	outData.CompressionError = file.Option.AnimationCompressionError > 0.0f ? file.Option.AnimationCompressionError : NS_ENGINE_ANIMATION_COMPRESSION_ERROR;
+
+	for (int j = 0; j < boneCount; ++j)
 	{
-		nsTArray<TChannel<nsVector3>> Positions;
-		nsTArray<TChannel<nsQuaternion>> Rotations;
-		nsTArray<TChannel<nsVector3>> Scales;
-	};
+		const nsGLB_Bone& glbBone = glbBones[j];
+		outData.BoneNames[j] = glbBone.Name;
 
-	// Animation name
-	nsName Name;
+		nsAnimationSkeletonData::Bone& bone = outData.BoneDatas[j];
+		bone.InverseBindPoseTransform = glbBone.InverseBindPoseTransform;
+		bone.PoseTransform = nsMatrix4::IDENTITY;
+		bone.LocalTransform = glbBone.LocalTransform;
+		bone.ParentId = glbBone.ParentId;
+	}
+}
 
-	// Frame count
-	int FrameCount;
 
-	// Duration (seconds)
-	float Duration;
 
-	// Key frame for each bone
-	nsTArrayInline<KeyFrame, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> KeyFrames;
+
+// ================================================================================================================================================================ //
+// IMPORT JOBS
+// ================================================================================================================================================================ //
+class nsAssetImportJob_GLB_Model : public nsAssetImportJob
+{
+public:
+	const nsGLB_File& File;
+	int ModelIndex;
 
 
 public:
-	nsGLB_Animation()
+	nsAssetImportJob_GLB_Model(nsName name, const nsGLB_File& file, int modelIndex) noexcept
+		: nsAssetImportJob(name, nsEAssetType::MODEL)
+		, File(file)
+		, ModelIndex(modelIndex)
 	{
-		FrameCount = 0;
-		Duration = 0.0f;
 	}
 
-};
-
 
-static nsGLB_Bone* ns_GLB_FindBoneWithNodeIndex(nsGLB_BoneHierarchy& bones, int nodeIndex, int* outBoneId = nullptr)
-{
-	for (int i = 0; i < bones.GetCount(); ++i)
+	virtual bool Execute(const nsAssetImportBatch& batch) noexcept override
 	{
-		if (bones[i].NodeId == nodeIndex)
+		const nlohmann::json& jsonModel = File.JsonData["meshes"][ModelIndex];
+
+		if (!jsonModel.contains("primitives"))
 		{
-			if (outBoneId)
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import model [%s] from file [%s]. <primitives> data not found!"), *Name.ToString(), *File.Option.SourceFile);
+			return false;
+		}
+
+		const nlohmann::json& jsonMeshArray = jsonModel["primitives"];
+		const int meshCount = static_cast<int>(jsonMeshArray.size());
+
+		if (meshCount == 0 || meshCount > NS_ENGINE_ASSET_MODEL_MAX_MESH)
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import model [%s] from file [%s]. Invalid mesh count [%i]!"), *Name.ToString(), *File.Option.SourceFile, meshCount);
+			return false;
+		}
+
+		nsTArray<nsMeshLODGroup> lodGroups;
+		lodGroups.Reserve(meshCount);
+		const nsMeshLODGroup* lodGroupPtrs[NS_ENGINE_ASSET_MODEL_MAX_MESH];
+
+		for (int m = 0; m < meshCount; ++m)
+		{
+			nsMeshLODGroup& lodGroup = lodGroups.Add();
+
+			if (!ns_GLB_ReadMeshVertexData(lodGroup.Add(), File, jsonMeshArray[m], nsName::Format("%s_%i", *Name, m)))
 			{
-				*outBoneId = i;
+				return false;
 			}
+		}
 
-			return &bones[i];
+		for (int m = 0; m < meshCount; ++m)
+		{
+			lodGroupPtrs[m] = &lodGroups[m];
 		}
+
+		const nsString assetFile = batch.GetAssetFile(Name);
+
+		if (!nsAssetManager::Get().WriteModelAssetFile(assetFile, lodGroupPtrs, meshCount, nsECompression::LZ4))
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to save model asset [%s] to file [%s]"), *Name.ToString(), *assetFile);
+			return false;
+		}
+
+		NS_LogInfo(AssetImporterGLB, TEXT("Imported model [%s] from source file [%s]"), *Name.ToString(), *File.Option.SourceFile);
+
+		return true;
 	}
 
-	return nullptr;
 };
 
 
-static void ns_GLB_ImportAnimations(const nsAssetImportOption_Model& option, const nsString& dstFolderPath, const uint8* binData, const nlohmann::json& jsonData, nsGLB_Skeleton& glbSkeleton, const nsTArray<nsGLB_Node>& glbNodes)
+
+class nsAssetImportJob_GLB_Skeleton : public nsAssetImportJob
 {
-	if (!option.bImportAnimation)
+public:
+	const nsGLB_File& File;
+
+
+public:
+	nsAssetImportJob_GLB_Skeleton(const nsGLB_File& file) noexcept
+		: nsAssetImportJob(file.Skeleton.Name, nsEAssetType::SKELETON)
+		, File(file)
 	{
-		return;
 	}
 
-	if (!jsonData.contains("animations"))
+
+	virtual bool Execute(const nsAssetImportBatch& batch) noexcept override
 	{
-		NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import animation from file [%s]. <animations> not found in json data!"), *option.SourceFile);
-		return;
+		nsAnimationSkeletonData data;
+		ns_GLB_MakeSkeletonData(data, File);
+
+		const nsString assetFile = batch.GetAssetFile(Name);
+
+		if (!nsAssetManager::Get().WriteSkeletonAssetFile(assetFile, data))
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to save skeleton asset [%s] to file [%s]"), *Name.ToString(), *assetFile);
+			return false;
+		}
+
+		NS_LogInfo(AssetImporterGLB, TEXT("Imported skeleton [%s] from source file [%s]"), *Name.ToString(), *File.Option.SourceFile);
+
+		return true;
 	}
 
-	const nlohmann::json& jsonAnimationArray = jsonData["animations"];
-	const int animationCount = static_cast<int>(jsonAnimationArray.size());
+};
 
-	for (int i = 0; i < animationCount; ++i)
+
+
+class nsAssetImportJob_GLB_Animation : public nsAssetImportJob
+{
+public:
+	const nsGLB_File& File;
+	int AnimationIndex;
+
+
+public:
+	nsAssetImportJob_GLB_Animation(nsName name, const nsGLB_File& file, int animationIndex) noexcept
+		: nsAssetImportJob(name, nsEAssetType::ANIMATION)
+		, File(file)
+		, AnimationIndex(animationIndex)
 	{
-		const nlohmann::json& jsonAnimation = jsonAnimationArray[i];
+	}
 
-		nsGLB_Animation glbAnimation;
-		glbAnimation.Name = nsName::Format("anim_%s", jsonAnimation["name"].get<std::string>().c_str());
-		glbAnimation.KeyFrames.Resize(glbSkeleton.Bones.GetCount());
+
+	virtual bool Execute(const nsAssetImportBatch& batch) noexcept override
+	{
+		const nlohmann::json& jsonAnimation = File.JsonData["animations"][AnimationIndex];
+		const nsGLB_Skeleton& glbSkeleton = File.Skeleton;
+
+		nsAnimationClipData data;
+		data.SkeletonName = glbSkeleton.Name;
+		data.KeyFrames.Resize(glbSkeleton.Bones.GetCount());
+
+		if (!jsonAnimation.contains("channels") || !jsonAnimation["channels"].is_array() || !jsonAnimation.contains("samplers") || !jsonAnimation["samplers"].is_array())
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import animation [%s] from file [%s]. Invalid channels or samplers!"), *Name.ToString(), *File.Option.SourceFile);
+			return false;
+		}
 
 		const nlohmann::json& jsonChannelArray = jsonAnimation["channels"];
 		const int channelCount = static_cast<int>(jsonChannelArray.size());
-
 		const nlohmann::json& jsonSamplerArray = jsonAnimation["samplers"];
 		const int samplerCount = static_cast<int>(jsonSamplerArray.size());
 
-
 		for (int c = 0; c < channelCount; ++c)
 		{
 			const nlohmann::json& jsonChannel = jsonChannelArray[c];
-			const int samplerIndex = jsonChannel["sampler"];
-			const int nodeIndex = jsonChannel["target"]["node"];
-			const nsName pathType = jsonChannel["target"]["path"].get<std::string>().c_str();
+			const int samplerIndex = ns_GLB_GetIndex(jsonChannel, "sampler");
+			const nlohmann::json::const_iterator jsonTarget = jsonChannel.find("target");
+
+			if (samplerIndex < 0 || samplerIndex >= samplerCount || jsonTarget == jsonChannel.end())
+			{
+				NS_LogWarning(AssetImporterGLB, TEXT("Fail to import animation [%s] from file [%s]. Invalid channel [%i] sampler or target!"), *Name.ToString(), *File.Option.SourceFile, c);
+				return false;
+			}
+
+			const int nodeIndex = ns_GLB_GetIndex(*jsonTarget, "node");
+			const nlohmann::json::const_iterator jsonPath = jsonTarget->find("path");
 
-			int boneId = -1;
-			ns_GLB_FindBoneWithNodeIndex(glbSkeleton.Bones, nodeIndex, &boneId);
+			if (nodeIndex < 0 || nodeIndex >= File.Nodes.GetCount() || jsonPath == jsonTarget->end() || !jsonPath->is_string())
+			{
+				NS_LogWarning(AssetImporterGLB, TEXT("Fail to import animation [%s] from file [%s]. Invalid channel [%i] target node or path!"), *Name.ToString(), *File.Option.SourceFile, c);
+				return false;
+			}
+
+			const std::string& pathType = jsonPath->get_ref<const std::string&>();
+			const int boneId = ns_GLB_FindBoneIdWithNodeIndex(glbSkeleton.Bones, nodeIndex);
 
 			if (boneId == -1)
 			{
 				continue;
 			}
 
-			nsGLB_Animation::KeyFrame& keyFrame = glbAnimation.KeyFrames[boneId];
+			nsAnimationKeyFrame& keyFrame = data.KeyFrames[boneId];
 
 			const nlohmann::json& jsonSampler = jsonSamplerArray[samplerIndex];
-			const int inputAccessorIndex = jsonSampler["input"]; // timestamp
-			const int outputAccessorIndex = jsonSampler["output"]; // position/rotation/scale
+			const int inputAccessorIndex = ns_GLB_GetIndex(jsonSampler, "input"); // timestamp
+			const int outputAccessorIndex = ns_GLB_GetIndex(jsonSampler, "output"); // position/rotation/scale
+
+			nsGLB_AccessorView<float> timestamps;
 
-			int inputCount = 0;
-			int inputComponentType = 0;
-			const float* timeStamps = ns_GLB_GetBufferData<float>(inputCount, inputComponentType, binData, jsonData, inputAccessorIndex);
-			NS_Validate(inputComponentType == GLB_COMPONENT_TYPE_FLOAT);
-			glbAnimation.FrameCount = nsMath::Max(glbAnimation.FrameCount, inputCount);
+			if (!ns_GLB_GetAccessorView(timestamps, File, inputAccessorIndex, GLB_COMPONENT_TYPE_FLOAT))
+			{
+				NS_LogWarning(AssetImporterGLB, TEXT("Fail to import animation [%s] from file [%s]. Invalid sampler input!"), *Name.ToString(), *File.Option.SourceFile);
+				return false;
+			}
 
-			int outputCount = 0;
-			int outputComponentType = 0;
+			data.FrameCount = nsMath::Max(data.FrameCount, timestamps.Count);
+			bool bSucceeded = false;
 
 			if (pathType == "translation")
 			{
-				const nsVector3* positions = ns_GLB_GetBufferData<nsVector3>(outputCount, outputComponentType, binData, jsonData, outputAccessorIndex);
-				NS_Validate(inputCount == outputCount);
+				const int firstIndex = keyFrame.PositionChannels.GetCount();
+				bSucceeded = ns_GLB_ReadAnimationChannels(keyFrame.PositionChannels, data.Duration, File, timestamps, outputAccessorIndex);
 
-				for (int t = 0; t < inputCount; ++t)
+				for (int t = firstIndex; t < keyFrame.PositionChannels.GetCount(); ++t)
 				{
-					nsGLB_Animation::TChannel<nsVector3>& positionChannel = keyFrame.Positions.Add();
-					positionChannel.Value = positions[t] * 100.0f;
-					positionChannel.Timestamp = timeStamps[t];
-					glbAnimation.Duration = nsMath::Max(glbAnimation.Duration, positionChannel.Timestamp);
+					keyFrame.PositionChannels[t].Value *= 100.0f;
 				}
 			}
 			else if (pathType == "rotation")
 			{
-				const nsQuaternion* rotations = ns_GLB_GetBufferData<nsQuaternion>(outputCount, outputComponentType, binData, jsonData, outputAccessorIndex);
-				NS_Validate(inputCount == outputCount);
-
-				for (int t = 0; t < inputCount; ++t)
-				{
-					nsGLB_Animation::TChannel<nsQuaternion>& rotationChannel = keyFrame.Rotations.Add();
-					rotationChannel.Value = rotations[t];
-					rotationChannel.Timestamp = timeStamps[t];
-					glbAnimation.Duration = nsMath::Max(glbAnimation.Duration, rotationChannel.Timestamp);
-				}
+				bSucceeded = ns_GLB_ReadAnimationChannels(keyFrame.RotationChannels, data.Duration, File, timestamps, outputAccessorIndex);
 			}
 			else if (pathType == "scale")
 			{
-				const nsVector3* scales = ns_GLB_GetBufferData<nsVector3>(outputCount, outputComponentType, binData, jsonData, outputAccessorIndex);
-				NS_Validate(inputCount == outputCount);
-
-				for (int t = 0; t < inputCount; ++t)
-				{
-					nsGLB_Animation::TChannel<nsVector3>& scaleChannel = keyFrame.Scales.Add();
-					scaleChannel.Value = scales[t];
-					scaleChannel.Timestamp = timeStamps[t];
-					glbAnimation.Duration = nsMath::Max(glbAnimation.Duration, scaleChannel.Timestamp);
-				}
+				bSucceeded = ns_GLB_ReadAnimationChannels(keyFrame.ScaleChannels, data.Duration, File, timestamps, outputAccessorIndex);
 			}
 			else
 			{
-				NS_ValidateV(0, TEXT("Unknown path type [%s]!"), *pathType);
-			}
-		}
-
-
-		nsAnimationManager& animationManager = nsAnimationManager::Get();
-		const nsAnimationClipID clip = animationManager.CreateClip(glbAnimation.Name, glbSkeleton.Name);
-		nsAnimationClipData& data = animationManager.GetClipData(clip);
-		data.SkeletonName = glbSkeleton.Name;
-		data.FrameCount = glbAnimation.FrameCount;
-		data.Duration = glbAnimation.Duration;
-
-		const int keyFrameCount = glbAnimation.KeyFrames.GetCount();
-		data.KeyFrames.Resize(keyFrameCount);
-
-		for (int k = 0; k < keyFrameCount; ++k)
-		{
-			const nsGLB_Animation::KeyFrame& glbKeyFrame = glbAnimation.KeyFrames[k];
-			nsAnimationKeyFrame& keyFrame = data.KeyFrames[k];
-
-			// Copy position channels
-			const int pCount = glbKeyFrame.Positions.GetCount();
-			keyFrame.PositionChannels.Resize(pCount);
-
-			for (int p = 0; p < pCount; ++p)
-			{
-				const nsGLB_Animation::TChannel<nsVector3>& glbPositionChannel = glbKeyFrame.Positions[p];
-				nsAnimationKeyFrame::TChannel<nsVector3>& positionChannel = keyFrame.PositionChannels[p];
-				positionChannel.Value = glbPositionChannel.Value;
-				positionChannel.Timestamp = glbPositionChannel.Timestamp;
+				// Morph target weights
+				continue;
 			}
 
-
-			// Copy rotation channels
-			const int rCount = glbKeyFrame.Rotations.GetCount();
-			keyFrame.RotationChannels.Resize(rCount);
-
-			for (int r = 0; r < rCount; ++r)
+			if (!bSucceeded)
 			{
-				const nsGLB_Animation::TChannel<nsQuaternion>& glbRotationChannel = glbKeyFrame.Rotations[r];
-				nsAnimationKeyFrame::TChannel<nsQuaternion>& rotationChannel = keyFrame.RotationChannels[r];
-				rotationChannel.Value = glbRotationChannel.Value;
-				rotationChannel.Timestamp = glbRotationChannel.Timestamp;
+				NS_LogWarning(AssetImporterGLB, TEXT("Fail to import animation [%s] from file [%s]. Invalid channel [%i] data!"), *Name.ToString(), *File.Option.SourceFile, c);
+				return false;
 			}
+		}
 
+		nsAnimationSkeletonData skeletonData;
+		ns_GLB_MakeSkeletonData(skeletonData, File);
+		nsAnimationCompression::CompressClip(data, skeletonData);
 
-			// Copy scale channels
-			const int sCount = glbKeyFrame.Scales.GetCount();
-			keyFrame.ScaleChannels.Resize(sCount);
+		const nsString assetFile = batch.GetAssetFile(Name);
 
-			for (int s = 0; s < sCount; ++s)
-			{
-				const nsGLB_Animation::TChannel<nsVector3>& glbScaleChannel = glbKeyFrame.Scales[s];
-				nsAnimationKeyFrame::TChannel<nsVector3>& scaleChannel = keyFrame.ScaleChannels[s];
-				scaleChannel.Value = glbScaleChannel.Value;
-				scaleChannel.Timestamp = glbScaleChannel.Timestamp;
-			}
+		if (!nsAssetManager::Get().WriteAnimationAssetFile(assetFile, data, nsECompression::LZ4))
+		{
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to save animation asset [%s] to file [%s]"), *Name.ToString(), *assetFile);
+			return false;
 		}
 
-		nsAssetManager::Get().SaveAnimationAsset(glbAnimation.Name, clip, dstFolderPath, false);
-		NS_CONSOLE_Log(AssetImporterGLB, TEXT("Imported animation [%s] from source file [%s]"), *glbAnimation.Name.ToString(), *option.SourceFile);
-	}
-}
-
+		NS_LogInfo(AssetImporterGLB, TEXT("Imported animation [%s] from source file [%s]"), *Name.ToString(), *File.Option.SourceFile);
 
-static void ns_GLB_ImportSkeletonAndAnimations(const nsAssetImportOption_Model& option, const nsString& dstFolderPath, const uint8* binData, const nlohmann::json& jsonData, const nsTArray<nsGLB_Node>& glbNodes)
-{
-	if (!(option.bImportSkeleton || option.bImportAnimation))
-	{
-		return;
+		return true;
 	}
 
-	if (!jsonData.contains("skins"))
-	{
-		NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import skeleton or animation from file [%s]. <skins> not found in json data!"), *option.SourceFile);
-		return;
-	}
+};
 
-	const nlohmann::json& jsonAccessorArray = jsonData["accessors"];
-	const nlohmann::json& jsonBufferViewArray = jsonData["bufferViews"];
-	const nlohmann::json& jsonSkeletonArray = jsonData["skins"];
-	const int skeletonCount = static_cast<int>(jsonSkeletonArray.size());
-	const nsMatrix4 scaleMatrix = nsMatrix4::Scale(100.0f);
-	NS_Validate(skeletonCount == 1);
 
-	const nlohmann::json& jsonSkeleton = jsonSkeletonArray[0];
 
-	nsGLB_Skeleton glbSkeleton;
-	glbSkeleton.Name = nsName::Format("skl_%s", jsonSkeleton["name"].get<std::string>().c_str());
-	const nlohmann::json& jsonBoneArray = jsonSkeleton["joints"];
-	const int boneCount = static_cast<int>(jsonBoneArray.size());
-	glbSkeleton.Bones.Resize(boneCount);
+// Embedded image is written to temporary file inside destination folder, Compressonator only loads image from file
+class nsAssetImportJob_GLB_Texture : public nsAssetImportJob_Image
+{
+public:
+	const nsGLB_File& File;
+	int BufferViewIndex;
 
-	const int accessorIndex = jsonSkeleton["inverseBindMatrices"];
-	int matrixCount = 0;
-	int componentType = 0;
-	const nsMatrix4* inverseBindPoseMatrices = ns_GLB_GetBufferData<nsMatrix4>(matrixCount, componentType, binData, jsonData, accessorIndex);
-	NS_Validate(matrixCount == boneCount);
 
-	for (int j = 0; j < boneCount; ++j)
+public:
+	nsAssetImportJob_GLB_Texture(nsName name, const nsString& tempFile, const nsGLB_File& file, int bufferViewIndex) noexcept
+		: nsAssetImportJob_Image(name, tempFile, nsETextureFormat::COMPRESSED_BC3_RGBA, true)
+		, File(file)
+		, BufferViewIndex(bufferViewIndex)
 	{
-		const int nodeIndex = jsonBoneArray[j];
-		const nsGLB_Node& node = glbNodes[nodeIndex];
-
-		const nsMatrix4 invBindMatrix = inverseBindPoseMatrices[j];
-		nsGLB_Bone& glbBone = glbSkeleton.Bones[j];
-		glbBone.Name = node.Name;
-		glbBone.InverseBindPoseTransform = invBindMatrix * scaleMatrix;
-		glbBone.LocalTransform = node.Transform;
-		glbBone.LocalTransform.Position *= 100.0f;
-		glbBone.NodeId = nodeIndex;
-		glbBone.ParentId = -1;
 	}
 
 
-	// Adjust bone hierarchy
-	for (int j = 0; j < boneCount; ++j)
+	virtual bool Execute(const nsAssetImportBatch& batch) noexcept override
 	{
-		const int nodeIndex = jsonBoneArray[j];
-		const nsGLB_Node& node = glbNodes[nodeIndex];
+		const nsGLB_BufferView& bufferView = File.BufferViews[BufferViewIndex];
 
-		for (int c = 0; c < node.Children.GetCount(); ++c)
+		if (!nsFileSystem::FileWriteBinary(SourceFile, File.BinData + bufferView.Offset, bufferView.Length))
 		{
-			const int childNodeIndex = node.Children[c];
-			nsGLB_Bone* childBone = ns_GLB_FindBoneWithNodeIndex(glbSkeleton.Bones, childNodeIndex);
-			NS_Validate(childBone);
-			childBone->ParentId = j;
+			NS_LogWarning(AssetImporterGLB, TEXT("Fail to import texture [%s] from file [%s]. Fail to write image data!"), *Name.ToString(), *File.Option.SourceFile);
+			return false;
 		}
-	}
-
 
-	nsAnimationManager& animationManager = nsAnimationManager::Get();
-	const nsAnimationSkeletonID skeleton = animationManager.CreateSkeleton(glbSkeleton.Name);
-	nsAnimationSkeletonData& data = animationManager.GetSkeletonData(skeleton);
-	data.BoneNames.Resize(boneCount);
-	data.BoneDatas.Resize(boneCount);
+		const bool bSucceeded = nsAssetImportJob_Image::Execute(batch);
+		nsFileSystem::FileDelete(SourceFile);
 
-	for (int j = 0; j < boneCount; ++j)
-	{
-		const nsGLB_Bone& glbBone = glbSkeleton.Bones[j];
-		data.BoneNames[j] = glbBone.Name;
-
-		nsAnimationSkeletonData::Bone& bone = data.BoneDatas[j];
-		bone.InverseBindPoseTransform = glbBone.InverseBindPoseTransform;
-		bone.PoseTransform = nsMatrix4::IDENTITY;
-		bone.LocalTransform = glbBone.LocalTransform;
-		bone.ParentId = glbBone.ParentId;
+		return bSucceeded;
 	}
 
-	if (option.bImportSkeleton)
-	{
-		nsAssetManager::Get().SaveSkeletonAsset(glbSkeleton.Name, skeleton, dstFolderPath, false);
-		NS_CONSOLE_Log(AssetImporterGLB, TEXT("Imported skeleton [%s] from source file [%s]"), *glbSkeleton.Name.ToString(), *option.SourceFile);
-	}
-
-	if (option.bImportAnimation)
-	{
-		ns_GLB_ImportAnimations(option, dstFolderPath, binData, jsonData, glbSkeleton, glbNodes);
-	}
-}
+};
 
 
 
-void nsAssetImporter::ImportAssetFromModelFile_GLB(const nsAssetImportOption_Model& option, const nsString& dstFolderPath)
+bool nsAssetImporter::AddImportJobs_GLB(nsAssetImportBatch& batch, const nsAssetImportOption_Model& option)
 {
-	nsTArray<uint8> bytes;
+	nsGLB_File* glbFile = ns_CreateObject<nsGLB_File>();
+	glbFile->Option = option;
+	batch.Sources.Add(glbFile);
 
-	if (!nsFileSystem::FileReadBinary(option.SourceFile, bytes))
+	// File stays mapped until batch finished, json and BIN chunk are read in place
+	nsFileMappedView& mappedFile = glbFile->MappedFile;
+
+	if (!nsFileSystem::FileMap(option.SourceFile, mappedFile))
 	{
 		NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Fail to read data!"), *option.SourceFile);
-		return;
+		return false;
 	}
 
-	nsBinaryStreamReader reader(bytes);
+	nsBinaryStreamReader reader(mappedFile.Data, mappedFile.Size);
 
 	// Header
 	{
+		if (mappedFile.Size < 20)
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Invalid GLB file!"), *option.SourceFile);
+			return false;
+		}
+
 		uint32 magic = 0;
 		reader | magic;
 
 		if (magic != GLB_MAGIC)
 		{
 			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Invalid GLB file!"), *option.SourceFile);
-			return;
+			return false;
 		}
 
 		uint32 version = 0;
 		reader | version;
-		
+
 		if (version != 2)
 		{
 			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Asset importer for GLB only support GLB file version 2! [Source GLB File Version: %u]"), *option.SourceFile, version);
-			return;
+			return false;
 		}
 
 		uint32 length = 0;
@@ -667,21 +951,22 @@ void nsAssetImporter::ImportAssetFromModelFile_GLB(const nsAssetImportOption_Mod
 		if (length <= 12)
 		{
 			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Emtpy GLB data!"), *option.SourceFile);
-			return;
+			return false;
 		}
 	}
 
 
 	// Chunk-0 (JSON)
-	nlohmann::json jsonData;
+	nlohmann::json& jsonData = glbFile->JsonData;
+	uint32 jsonChunkLength = 0;
 	{
 		uint32 chunkLength = 0;
 		reader | chunkLength;
 
-		if (chunkLength == 0)
+		if (chunkLength == 0 || chunkLength > static_cast<uint32>(mappedFile.Size - 28))
 		{
-			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Empty chunk-0 (JSON) data size!"), *option.SourceFile);
-			return;
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Invalid chunk-0 (JSON) data size!"), *option.SourceFile);
+			return false;
 		}
 
 		uint32 chunkType = 0;
@@ -690,76 +975,85 @@ void nsAssetImporter::ImportAssetFromModelFile_GLB(const nsAssetImportOption_Mod
 		if (chunkType != GLB_CHUNK_TYPE_JSON)
 		{
 			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Invalid chunk-0 type!"), *option.SourceFile);
-			return;
+			return false;
 		}
 
-		nsTArray<char> jsonCharString;
-		jsonCharString.Resize(chunkLength + 1);
-		reader.SerializeData(jsonCharString.GetData(), chunkLength);
-
-		nsFileSystem::FileWriteText("debug_glb_import.json", jsonCharString.GetData());
+		// Parse in place from mapped file, no intermediate string copy
+		const char* jsonChars = reinterpret_cast<const char*>(reader.GetBufferData() + reader.GetCurrentOffset());
+		jsonData = nlohmann::json::parse(jsonChars, jsonChars + chunkLength, nullptr, false);
+		jsonChunkLength = chunkLength;
 
-		jsonData = nlohmann::json::parse(jsonCharString.GetData());
+		if (jsonData.is_discarded())
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Fail to parse chunk-0 (JSON) data!"), *option.SourceFile);
+			return false;
+		}
 	}
 
 
 	// Chunk-1 (BIN)
-	const uint8* binData = nullptr;
 	{
-		uint32 chunkLength = 0;
-		reader | chunkLength;
+		const int chunkOffset = 20 + static_cast<int>(jsonChunkLength);
+		nsBinaryStreamReader chunkReader(mappedFile.Data + chunkOffset, mappedFile.Size - chunkOffset);
 
-		if (chunkLength == 0)
-		{
-			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Empty chunk-1 (Binary) data size!"), *option.SourceFile);
-			return;
-		}
+		uint32 chunkLength = 0;
+		chunkReader | chunkLength;
 
 		uint32 chunkType = 0;
-		reader | chunkType;
+		chunkReader | chunkType;
 
 		if (chunkType != GLB_CHUNK_TYPE_BIN)
 		{
 			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Invalid chunk-1 type!"), *option.SourceFile);
-			return;
+			return false;
+		}
+
+		if (chunkLength == 0 || chunkLength > static_cast<uint32>(chunkReader.GetBufferSize() - chunkReader.GetCurrentOffset()))
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. Invalid chunk-1 (Binary) data size!"), *option.SourceFile);
+			return false;
 		}
 
-		binData = reader.GetBufferData() + reader.GetCurrentOffset();
-		NS_Validate(binData);
+		glbFile->BinData = chunkReader.GetBufferData() + chunkReader.GetCurrentOffset();
+		glbFile->BinSize = static_cast<int>(chunkLength);
 	}
 
 
 	if (!jsonData.contains("accessors"))
 	{
 		NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. <accessors> not found in json data!"), *option.SourceFile);
-		return;
+		return false;
 	}
 
 	if (!jsonData.contains("bufferViews"))
 	{
 		NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import asset from file [%s]. <bufferViews> not found in json data!"), *option.SourceFile);
-		return;
+		return false;
+	}
+
+	if (!ns_GLB_IndexAccessors(*glbFile))
+	{
+		return false;
 	}
 
 
 	// Validate nodes
-	nlohmann::json jsonNodeArray;
 	int nodeCount = 0;
 
 	if (jsonData.contains("nodes"))
 	{
-		jsonNodeArray = jsonData["nodes"];
-		nodeCount = static_cast<int>(jsonNodeArray.size());
+		nodeCount = static_cast<int>(jsonData["nodes"].size());
 	}
 
-	nsTArray<nsGLB_Node> glbNodes(nodeCount, nsGLB_Node());
+	nsTArray<nsGLB_Node>& glbNodes = glbFile->Nodes;
+	glbNodes.ResizeConstructs(nodeCount);
 
 	for (int i = 0; i < nodeCount; ++i)
 	{
-		const nlohmann::json& jsonNode = jsonNodeArray[i];
+		const nlohmann::json& jsonNode = jsonData["nodes"][i];
 
 		nsGLB_Node& node = glbNodes[i];
-		node.Name = jsonNode["name"].get<std::string>().c_str();
+		node.Name = ns_GLB_GetName(jsonNode, "Node_", i).c_str();
 
 		if (jsonNode.contains("translation"))
 		{
@@ -778,13 +1072,105 @@ void nsAssetImporter::ImportAssetFromModelFile_GLB(const nsAssetImportOption_Mod
 			const nlohmann::json& children = jsonNode["children"];
 			const int childrenCount = static_cast<int>(children.size());
 
+			// Invalid child index is kept as -1 and rejected by readers that follow hierarchy
 			for (int c = 0; c < childrenCount; ++c)
 			{
-				node.Children.Add(children[c]);
+				node.Children.Add(children[c].is_number_integer() ? children[c].get<int>() : -1);
 			}
 		}
 	}
 
-	ns_GLB_ImportModels(option, dstFolderPath, binData, jsonData);
-	ns_GLB_ImportSkeletonAndAnimations(option, dstFolderPath, binData, jsonData, glbNodes);
+	const int firstJobIndex = batch.Jobs.GetCount();
+	bool bSucceeded = true;
+
+	// Model (one job per model)
+	if (option.bImportMesh)
+	{
+		if (jsonData.contains("meshes"))
+		{
+			const nlohmann::json& jsonModelArray = jsonData["meshes"];
+			const int modelCount = static_cast<int>(jsonModelArray.size());
+
+			for (int i = 0; i < modelCount; ++i)
+			{
+				const nsName modelName = nsName::Format("mdl_%s", ns_GLB_GetName(jsonModelArray[i], "Mesh_", i).c_str());
+				batch.Jobs.Add(ns_CreateObject<nsAssetImportJob_GLB_Model>(modelName, *glbFile, i));
+			}
+		}
+		else
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import model from file [%s]. <meshes> not found in json data!"), *option.SourceFile);
+			bSucceeded = false;
+		}
+	}
+
+	// Skeleton and animation (one job per animation clip), skeleton is read here since every animation clip needs it
+	if (option.bImportSkeleton || option.bImportAnimation)
+	{
+		if (!jsonData.contains("skins"))
+		{
+			NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import skeleton or animation from file [%s]. <skins> not found in json data!"), *option.SourceFile);
+			bSucceeded = false;
+		}
+		else if (!ns_GLB_ReadSkeleton(*glbFile))
+		{
+			bSucceeded = false;
+		}
+		else
+		{
+			if (option.bImportSkeleton)
+			{
+				batch.Jobs.Add(ns_CreateObject<nsAssetImportJob_GLB_Skeleton>(*glbFile));
+			}
+
+			if (option.bImportAnimation)
+			{
+				if (jsonData.contains("animations"))
+				{
+					const nlohmann::json& jsonAnimationArray = jsonData["animations"];
+					const int animationCount = static_cast<int>(jsonAnimationArray.size());
+
+					for (int i = 0; i < animationCount; ++i)
+					{
+						const nsName animationName = nsName::Format("anim_%s", ns_GLB_GetName(jsonAnimationArray[i], "Animation_", i).c_str());
+						batch.Jobs.Add(ns_CreateObject<nsAssetImportJob_GLB_Animation>(animationName, *glbFile, i));
+					}
+				}
+				else
+				{
+					NS_CONSOLE_Error(AssetImporterGLB, TEXT("Fail to import animation from file [%s]. <animations> not found in json data!"), *option.SourceFile);
+					bSucceeded = false;
+				}
+			}
+		}
+	}
+
+	// Embedded texture (one job per image)
+	if (option.bImportTexture && jsonData.contains("images"))
+	{
+		const nlohmann::json& jsonImageArray = jsonData["images"];
+		const int imageCount = static_cast<int>(jsonImageArray.size());
+		const nsName fileName = *nsFileSystem::FileGetName(option.SourceFile);
+
+		for (int i = 0; i < imageCount; ++i)
+		{
+			const nlohmann::json& jsonImage = jsonImageArray[i];
+			const int bufferViewIndex = jsonImage.value("bufferView", -1);
+
+			if (bufferViewIndex < 0 || bufferViewIndex >= glbFile->BufferViews.GetCount() || jsonImage.value("mimeType", std::string()) != "image/png")
+			{
+				NS_CONSOLE_Warning(AssetImporterGLB, TEXT("Skip import texture [%i] from file [%s]. Only embedded png image is supported!"), i, *option.SourceFile);
+				continue;
+			}
+
+			const nsName textureName = (jsonImage.contains("name") && jsonImage["name"].is_string()) ? nsName::Format("tex_%s", jsonImage["name"].get<std::string>().c_str()) : nsName::Format("tex_%s_%i", *fileName, i);
+			// Job index keeps temp file unique per job, texture names of different sources may collide
+			const nsString tempFile = nsString::Format(TEXT("%s/_import_%i_%s.png"), *batch.AssetPath, batch.Jobs.GetCount(), *textureName.ToString());
+			batch.Jobs.Add(ns_CreateObject<nsAssetImportJob_GLB_Texture>(textureName, tempFile, *glbFile, bufferViewIndex));
+		}
+	}
+
+	NS_CONSOLE_Log(AssetImporterGLB, TEXT("Import %i assets from source file [%s]"), batch.Jobs.GetCount() - firstJobIndex, *option.SourceFile);
+
+	return bSucceeded;
 }
@@ -5,14 +5,339 @@
 #include "nsTextureManager.h"
 #include "nsMaterial.h"
 #include "nsAnimationManager.h"
+#include "nsThreadPool.h"
+#include "nsAlgorithm.h"
+#include "nsCommandLines.h"
+
+
+
+// Number of mips (smallest first) that are never dropped by texture streaming
+static int ns_GetTextureTailMipCount(const nsAssetTextureMip* mips, int mipCount)
+{
+	int tailMipCount = 1;
+
+	while (tailMipCount < mipCount && nsMath::Max(mips[tailMipCount].Width, mips[tailMipCount].Height) <= NS_ENGINE_TEXTURE_STREAMING_TAIL_SIZE)
+	{
+		++tailMipCount;
+	}
+
+	return tailMipCount;
+}
+
+
+struct nsAssetManager::AsyncLoadRequest : public nsAsyncLoadRequest
+{
+	nsEAssetType Type;
+	int AssetIndex;
+	nsName Name;
+	nsString File;
+	nsAssetManager::ArchiveData Archive;
+	nsFileMappedView FileView;
+
+	// Asset file data, points to mapped file or mounted archive
+	const uint8* Data;
+	int DataSize;
+
+	// Texture mip table (smallest first), empty if texture asset file is version 1 that is always fully loaded
+	nsAssetTextureHeader TextureHeader;
+	nsTArrayInline<nsAssetTextureMip, NS_ENGINE_TEXTURE_MAX_MIP> TextureMips;
+
+	// Range of mips in TextureMips to load. Stream request adds mips to loaded texture instead of loading the asset
+	int TextureMipFirst;
+	int TextureMipCount;
+	bool bTextureStream;
+
+	// Decoded data, moved into engine resource on finalize
+	nsTextureData TextureData;
+	nsTArray<nsMeshLODGroup> ModelLodGroups;
+	nsAnimationSkeletonData SkeletonData;
+	nsAnimationClipData ClipData;
+
+
+public:
+	AsyncLoadRequest() noexcept
+		: Type(nsEAssetType::NONE)
+		, AssetIndex(-1)
+		, Archive()
+		, Data(nullptr)
+		, DataSize(0)
+		, TextureHeader()
+		, TextureMipFirst(0)
+		, TextureMipCount(0)
+		, bTextureStream(false)
+		, TextureData()
+	{
+	}
+
+
+	// [IO thread] Map file and fault in all pages that will be decoded, so decode never waits for disk
+	virtual bool Read() noexcept override
+	{
+		if (Archive.Data)
+		{
+			Data = Archive.Data;
+			DataSize = Archive.Size;
+		}
+		else if (nsFileSystem::FileMap(File, FileView))
+		{
+			Data = FileView.Data;
+			DataSize = FileView.Size;
+		}
+		else
+		{
+			return false;
+		}
+
+		int touchBegin = 0;
+		int touchEnd = DataSize;
+
+		if (Type == nsEAssetType::TEXTURE && !ReadTextureMipTable(touchBegin, touchEnd))
+		{
+			return false;
+		}
+
+		uint8 touch = 0;
+
+		for (int i = touchBegin; i < touchEnd; i += 4096)
+		{
+			touch ^= *(static_cast<const volatile uint8*>(Data + i));
+		}
+
+		(void)touch;
+
+		return true;
+	}
+
+
+	// [IO thread] Read texture mip table and select mips to load (full chain, or requested range for stream request)
+	NS_NODISCARD bool ReadTextureMipTable(int& outTouchBegin, int& outTouchEnd) noexcept
+	{
+		const int headerSize = static_cast<int>(sizeof(nsAssetFileHeader));
+		const int tableOffset = headerSize + static_cast<int>(sizeof(nsAssetTextureHeader));
+
+		if (DataSize < headerSize)
+		{
+			return false;
+		}
+
+		nsBinaryStreamReader reader(Data, headerSize);
+		nsAssetFileHeader header{};
+		reader | header;
+
+		// Version 1 texture data is not streamable, all mips are loaded
+		if (header.Version < 2)
+		{
+			return !bTextureStream;
+		}
+
+		if (DataSize < tableOffset)
+		{
+			return false;
+		}
+
+		nsPlatform::Memory_Copy(&TextureHeader, Data + headerSize, sizeof(nsAssetTextureHeader));
+		const int mipCount = TextureHeader.MipCount;
+
+		if (mipCount <= 0 || mipCount > NS_ENGINE_TEXTURE_MAX_MIP || DataSize < tableOffset + mipCount * static_cast<int>(sizeof(nsAssetTextureMip)))
+		{
+			return false;
+		}
+
+		TextureMips.Resize(mipCount);
+		nsPlatform::Memory_Copy(TextureMips.GetData(), Data + tableOffset, sizeof(nsAssetTextureMip) * mipCount);
+
+		for (int m = 0; m < mipCount; ++m)
+		{
+			const nsAssetTextureMip& mip = TextureMips[m];
+
+			if (mip.Width <= 0 || mip.Height <= 0 || static_cast<uint64>(mip.DataOffset) + mip.DataSize > static_cast<uint64>(DataSize))
+			{
+				return false;
+			}
+		}
+
+		// Streaming is opt-in per texture (screen size requests), load starts with full chain and top mips are dropped later if needed
+		if (!bTextureStream)
+		{
+			TextureMipFirst = 0;
+			TextureMipCount = mipCount;
+		}
+		else if (TextureMipFirst < 0 || TextureMipCount <= 0 || TextureMipFirst + TextureMipCount > mipCount)
+		{
+			return false;
+		}
+
+		const nsAssetTextureMip& lastMip = TextureMips[TextureMipFirst + TextureMipCount - 1];
+		outTouchBegin = static_cast<int>(TextureMips[TextureMipFirst].DataOffset);
+		outTouchEnd = static_cast<int>(lastMip.DataOffset + lastMip.DataSize);
+
+		return true;
+	}
+
+
+	// [Worker thread] Deserialize file data, only touches data owned by this request
+	virtual bool Decode() noexcept override
+	{
+		nsBinaryStreamReader reader(Data, DataSize);
+
+		nsAssetFileHeader header{};
+		reader | header;
+
+		bool bValid = header.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE && header.Type == static_cast<int>(Type);
+
+		if (bValid && TextureMips.GetCount() > 0)
+		{
+			bValid = DecodeTextureMips(static_cast<nsECompression>(header.Compression));
+		}
+		else if (bValid && header.Compression != static_cast<int>(nsECompression::NONE))
+		{
+			// Payload blocks are decompressed in parallel on worker threads
+			nsTArray<uint8> payload;
+			const int headerSize = reader.GetCurrentOffset();
+			bValid = nsCompression::Decompress(Data + headerSize, DataSize - headerSize, payload);
+
+			if (bValid)
+			{
+				nsBinaryStreamReader payloadReader(std::move(payload));
+				Deserialize(payloadReader, header.Version);
+			}
+		}
+		else if (bValid)
+		{
+			Deserialize(reader, header.Version);
+		}
+
+		nsFileSystem::FileUnmap(FileView);
+		Data = nullptr;
+		DataSize = 0;
+
+		return bValid;
+	}
+
+
+private:
+	// Mips of texture data are ordered largest first
+	NS_NODISCARD bool DecodeTextureMips(nsECompression compression) noexcept
+	{
+		const nsAssetTextureMip& largestMip = TextureMips[TextureMipFirst + TextureMipCount - 1];
+		TextureData.Width = largestMip.Width;
+		TextureData.Height = largestMip.Height;
+		TextureData.Format = static_cast<nsETextureFormat>(TextureHeader.Format);
+		TextureData.Mips.Clear();
+
+		for (int m = TextureMipFirst + TextureMipCount - 1; m >= TextureMipFirst; --m)
+		{
+			const nsAssetTextureMip& mipEntry = TextureMips[m];
+			nsTextureData::Mip& mip = TextureData.Mips.Add();
+			mip.Width = mipEntry.Width;
+			mip.Height = mipEntry.Height;
+			mip.Pixels.Clear();
+
+			if (compression != nsECompression::NONE)
+			{
+				if (!nsCompression::Decompress(Data + mipEntry.DataOffset, static_cast<int>(mipEntry.DataSize), mip.Pixels))
+				{
+					return false;
+				}
+			}
+			else if (mipEntry.DataSize > 0)
+			{
+				mip.Pixels.InsertAt(Data + mipEntry.DataOffset, static_cast<int>(mipEntry.DataSize));
+			}
+
+			if (mip.Pixels.GetCount() != static_cast<int>(mipEntry.PixelSize))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	void Deserialize(nsStream& reader, int version) noexcept
+	{
+		switch (Type)
+		{
+			case nsEAssetType::TEXTURE:
+			{
+				reader | TextureData;
+				break;
+			}
+
+			case nsEAssetType::MODEL:
+			{
+				int meshCount = 0;
+				reader | meshCount;
+				ModelLodGroups.Resize(meshCount);
+
+				for (int i = 0; i < meshCount; ++i)
+				{
+					reader | ModelLodGroups[i];
+				}
+
+				break;
+			}
+
+			case nsEAssetType::SKELETON:
+			{
+				// Version 2 skeleton has no compression error
+				if (version < 3)
+				{
+					reader | SkeletonData.BoneNames;
+					reader | SkeletonData.BoneDatas;
+					SkeletonData.CompressionError = NS_ENGINE_ANIMATION_COMPRESSION_ERROR;
+				}
+				else
+				{
+					reader | SkeletonData;
+				}
+
+				break;
+			}
+
+			case nsEAssetType::ANIMATION:
+			{
+				// Version 2 clip has uncompressed key-frames only
+				if (version < 3)
+				{
+					reader | ClipData.SkeletonName;
+					reader | ClipData.FrameCount;
+					reader | ClipData.Duration;
+					reader | ClipData.KeyFrames;
+					ClipData.Compressed = nsAnimationCompressedClipData();
+				}
+				else
+				{
+					reader | ClipData;
+				}
+
+				break;
+			}
+
+			default:
+				NS_ValidateV(0, TEXT("Not implemented yet!"));
+				break;
+		}
+	}
+
+};
+
 
 
 
 nsAssetManager::nsAssetManager() noexcept
 	: bInitialized(false)
+	, AsyncLoadFinalizeBudgetMs(2.0f)
+	, ResidencyCpuBudget(static_cast<uint64>(NS_ENGINE_ASSET_RESIDENCY_CPU_BUDGET_MB) * 1024 * 1024)
+	, ResidencyGpuBudget(static_cast<uint64>(NS_ENGINE_ASSET_RESIDENCY_GPU_BUDGET_MB) * 1024 * 1024)
+	, ResidencyFrame(0)
+	, TextureStreamingBudget(static_cast<uint64>(NS_ENGINE_TEXTURE_STREAMING_BUDGET_MB) * 1024 * 1024)
+	, TextureStreamingBytes(0)
 {
 	EngineAssetsPath = "EngineAssets";
 	GameAssetsPath = "GameAssets";
+	nsPlatform::Memory_Zero(ResidencyTypeStats, sizeof(ResidencyTypeStats));
 }
 
 
@@ -65,40 +390,240 @@ void nsAssetManager::Initialize()
 	}
 
 
-	nsTArray<nsString> assetFiles;
-	assetFiles.Reserve(64);
-	nsFileSystem::FileIterate(assetFiles, GameAssetsPath, true, NS_ENGINE_ASSET_FILE_EXTENSION);
+	const nsString gameArchiveFile = GameAssetsPath + NS_ENGINE_ASSET_ARCHIVE_EXTENSION;
 
-	for (int i = 0; i < assetFiles.GetCount(); ++i)
+	if (nsCommandLines::Get().HasCommand(TEXT("assetcpubudget")))
+	{
+		ResidencyCpuBudget = static_cast<uint64>(nsCommandLines::Get().GetValueAsInt(TEXT("assetcpubudget"))) * 1024 * 1024;
+	}
+
+	if (nsCommandLines::Get().HasCommand(TEXT("assetgpubudget")))
+	{
+		ResidencyGpuBudget = static_cast<uint64>(nsCommandLines::Get().GetValueAsInt(TEXT("assetgpubudget"))) * 1024 * 1024;
+	}
+
+	if (nsCommandLines::Get().HasCommand(TEXT("texturestreamingbudget")))
+	{
+		TextureStreamingBudget = static_cast<uint64>(nsCommandLines::Get().GetValueAsInt(TEXT("texturestreamingbudget"))) * 1024 * 1024;
+	}
+
+	if (nsCommandLines::Get().HasCommand(TEXT("cookassets")))
+	{
+		CookAssetArchive(GameAssetsPath, gameArchiveFile);
+	}
+
+	// Cooked archive replaces loose game asset files
+	if (!nsFileSystem::FileExists(gameArchiveFile) || !MountAssetArchive(gameArchiveFile))
 	{
-		RegisterAsset(assetFiles[i]);
+		nsTArray<nsString> assetFiles;
+		assetFiles.Reserve(64);
+		nsFileSystem::FileIterate(assetFiles, GameAssetsPath, true, NS_ENGINE_ASSET_FILE_EXTENSION);
+		RegisterAssetFiles(assetFiles, GameAssetsPath + NS_ENGINE_ASSET_REGISTRY_EXTENSION);
 	}
 
+	AsyncLoadQueue.Initialize();
+
 	bInitialized = true;
 }
 
 
-void nsAssetManager::RegisterAsset(const nsString& assetFile)
+void nsAssetManager::Shutdown()
 {
-	nsAssetFileHeader header{};
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	AsyncLoadQueue.Shutdown();
+
+	for (int i = 0; i < AsyncLoadRequests.GetCount(); ++i)
+	{
+		AsyncLoadRequest* request = AsyncLoadRequests[i];
+		request->WaitDecode();
+		nsFileSystem::FileUnmap(request->FileView);
+		ns_DestroyObject(request);
+	}
+
+	AsyncLoadRequests.Clear();
+
+	for (int i = 0; i < MountedArchives.GetCount(); ++i)
+	{
+		ns_DestroyObject(MountedArchives[i]);
+	}
+
+	MountedArchives.Clear();
+
+	bInitialized = false;
+}
+
+
+// Registry index layout: signature, version, entry count, entries (nsAssetRegistryEntry serialization).
+// Index file can be truncated or corrupted (e.g. crash while writing older index), every read is checked against data size
+static bool ns_ReadAssetRegistryIndex(const uint8* data, int dataSize, nsTMap<nsString, nsAssetRegistryEntry>& outEntries)
+{
+	const int headerSize = static_cast<int>(sizeof(int) * 3);
+	const int minEntrySize = static_cast<int>(sizeof(int) + sizeof(uint64) + sizeof(int64) + sizeof(nsEAssetType));
+
+	if (dataSize < headerSize)
+	{
+		return false;
+	}
+
+	nsBinaryStreamReader reader(data, dataSize);
+	int signature = 0;
+	int version = 0;
+	int entryCount = 0;
+	reader | signature;
+	reader | version;
+	reader | entryCount;
+
+	if (signature != NS_ENGINE_ASSET_REGISTRY_SIGNATURE || version != NS_ENGINE_ASSET_REGISTRY_VERSION || entryCount < 0 || entryCount > (dataSize - headerSize) / minEntrySize)
+	{
+		return false;
+	}
+
+	outEntries.Reserve(entryCount);
+
+	for (int i = 0; i < entryCount; ++i)
+	{
+		if (dataSize - reader.GetCurrentOffset() < minEntrySize)
+		{
+			return false;
+		}
+
+		nsAssetRegistryEntry entry;
+		int fileLength = 0;
+		reader | fileLength;
+
+		if (fileLength <= 0 || fileLength > (dataSize - reader.GetCurrentOffset()) / static_cast<int>(sizeof(wchar_t)))
+		{
+			return false;
+		}
+
+		const int fileSize = fileLength * static_cast<int>(sizeof(wchar_t));
+
+		if (dataSize - reader.GetCurrentOffset() - fileSize < minEntrySize - static_cast<int>(sizeof(int)))
+		{
+			return false;
+		}
+
+		entry.File.Resize(fileLength);
+		reader.SerializeData(*entry.File, fileSize);
+		reader | entry.ModifiedTime;
+		reader | entry.Size;
+		reader | entry.Type;
+
+		if (entry.Type > nsEAssetType::ACTOR || outEntries.Exists(entry.File))
+		{
+			return false;
+		}
+
+		outEntries.Add(entry.File, std::move(entry));
+	}
+
+	return reader.GetCurrentOffset() == dataSize;
+}
+
+
+void nsAssetManager::RegisterAssetFiles(const nsTArray<nsString>& assetFiles, const nsString& registryFile)
+{
+	nsTMap<nsString, nsAssetRegistryEntry> cachedEntries;
+
+	// Load registry index, invalid index falls back to reading header of every asset file
+	{
+		nsFileMappedView registryView;
+
+		if (nsFileSystem::FileExists(registryFile) && nsFileSystem::FileMap(registryFile, registryView) && !ns_ReadAssetRegistryIndex(registryView.Data, registryView.Size, cachedEntries))
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Asset registry index [%s] is outdated or invalid, rebuild all entries"), *registryFile);
+			cachedEntries.Clear();
+		}
+	}
+
+
+	nsTArray<nsAssetRegistryEntry> entries;
+	entries.Reserve(assetFiles.GetCount());
+	int updatedCount = 0;
+
+	for (int i = 0; i < assetFiles.GetCount(); ++i)
+	{
+		const nsString& file = assetFiles[i];
+		nsFileAttributes attributes{};
+
+		if (!nsFileSystem::FileGetAttributes(file, attributes))
+		{
+			continue;
+		}
+
+		nsAssetRegistryEntry& entry = entries.Add();
+		entry.File = file;
+		entry.ModifiedTime = attributes.ModifiedTime;
+		entry.Size = attributes.Size;
 
-	if (!IsValidAssetFile(assetFile, header))
+		const nsAssetRegistryEntry* cachedEntry = cachedEntries.GetValueByKey(file);
+
+		if (cachedEntry && cachedEntry->ModifiedTime == attributes.ModifiedTime && cachedEntry->Size == attributes.Size)
+		{
+			entry.Type = cachedEntry->Type;
+		}
+		else
+		{
+			nsAssetFileHeader header{};
+			entry.Type = IsValidAssetFile(file, header) ? static_cast<nsEAssetType>(header.Type) : nsEAssetType::NONE;
+			updatedCount++;
+		}
+
+		if (entry.Type == nsEAssetType::NONE)
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Fail to register asset from file [%s]. Invalid asset file!"), *file);
+			continue;
+		}
+
+		RegisterAsset(*nsFileSystem::FileGetName(file), nsFileSystem::FileGetPath(file), entry.Type, ArchiveData{});
+	}
+
+	// Files that were added, modified or removed since last registry index
+	if (updatedCount == 0 && entries.GetCount() == cachedEntries.GetCount())
 	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to register asset from file [%s]. Invalid asset file!"), *assetFile);
 		return;
 	}
 
-	const nsName name = *nsFileSystem::FileGetName(assetFile);
-	const nsString path = nsFileSystem::FileGetPath(assetFile);
-	const nsEAssetType assetType = static_cast<nsEAssetType>(header.Type);
+	nsBinaryStreamWriter writer;
+	int signature = NS_ENGINE_ASSET_REGISTRY_SIGNATURE;
+	int version = NS_ENGINE_ASSET_REGISTRY_VERSION;
+	writer | signature;
+	writer | version;
+	writer | entries;
+
+	// Write to temporary file then replace index, so interrupted write never leaves partial index
+	const nsString tempRegistryFile = registryFile + TEXT(".tmp");
+
+	if (nsFileSystem::FileWriteBinary(tempRegistryFile, writer.GetBuffer()) && nsFileSystem::FileMove(tempRegistryFile, registryFile))
+	{
+		NS_CONSOLE_Log(AssetLog, TEXT("Update asset registry index [%s] (%i of %i entries changed)"), *registryFile, updatedCount, entries.GetCount());
+	}
+	else
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to write asset registry index [%s]!"), *registryFile);
+
+		if (nsFileSystem::FileExists(tempRegistryFile))
+		{
+			nsFileSystem::FileDelete(tempRegistryFile);
+		}
+	}
+}
+
 
-	switch (assetType)
+void nsAssetManager::RegisterAsset(nsName name, const nsString& path, nsEAssetType type, ArchiveData archiveData)
+{
+	switch (type)
 	{
 		case nsEAssetType::TEXTURE:
 		{
-			NS_AssertV(TextureAsset.Names.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Texture asset with name [%s] already registered!"), *name);
+			NS_AssertV(TextureAsset.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Texture asset with name [%s] already registered!"), *name);
 			NS_CONSOLE_Log(AssetLog, TEXT("Register texture asset [%s]"), *name.ToString());
-			TextureAsset.Add(name, path, AssetFlag_Unloaded, nsTextureID::INVALID);
+			TextureAsset.Add(name, path, AssetFlag_Unloaded, nsTextureID::INVALID, archiveData);
+			TextureStreamings.Resize(TextureAsset.Names.GetCount());
 
 			break;
 		}
@@ -111,27 +636,27 @@ void nsAssetManager::RegisterAsset(const nsString& assetFile)
 
 		case nsEAssetType::MODEL:
 		{
-			NS_AssertV(ModelAsset.Names.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Mesh asset with name [%s] already registered!"), *name.ToString());
+			NS_AssertV(ModelAsset.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Mesh asset with name [%s] already registered!"), *name.ToString());
 			NS_CONSOLE_Log(AssetLog, TEXT("Register mesh asset [%s]"), *name.ToString());
-			ModelAsset.Add(name, path, AssetFlag_Unloaded, nsAssetModelMeshes());
+			ModelAsset.Add(name, path, AssetFlag_Unloaded, nsAssetModelMeshes(), archiveData);
 
 			break;
 		}
 
 		case nsEAssetType::SKELETON:
 		{
-			NS_AssertV(SkeletonAsset.Names.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Skeleton asset with name [%s] already registered!"), *name.ToString());
+			NS_AssertV(SkeletonAsset.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Skeleton asset with name [%s] already registered!"), *name.ToString());
 			NS_CONSOLE_Log(AssetLog, TEXT("Register texture asset [%s]"), *name.ToString());
-			SkeletonAsset.Add(name, path, AssetFlag_Unloaded, nsAnimationSkeletonID::INVALID);
+			SkeletonAsset.Add(name, path, AssetFlag_Unloaded, nsAnimationSkeletonID::INVALID, archiveData);
 
 			break;
 		}
 
 		case nsEAssetType::ANIMATION:
 		{
-			NS_AssertV(AnimationAsset.Names.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Animation asset with name [%s] already registered!"), *name.ToString());
+			NS_AssertV(AnimationAsset.Find(name) == NS_ARRAY_INDEX_INVALID, TEXT("Animation asset with name [%s] already registered!"), *name.ToString());
 			NS_CONSOLE_Log(AssetLog, TEXT("Register animation asset [%s]"), *name.ToString());
-			AnimationAsset.Add(name, path, AssetFlag_Unloaded, nsAnimationClipID::INVALID);
+			AnimationAsset.Add(name, path, AssetFlag_Unloaded, nsAnimationClipID::INVALID, archiveData);
 
 			break;
 		}
@@ -143,39 +668,93 @@ void nsAssetManager::RegisterAsset(const nsString& assetFile)
 }
 
 
-bool nsAssetManager::IsValidAssetFile(const nsString& assetFile, nsAssetFileHeader& outHeader) const
+void nsAssetManager::RegisterImportedAsset(nsName name, const nsString& path, nsEAssetType type)
 {
-	if (assetFile.IsEmpty())
+	if (!bInitialized)
 	{
-		return false;
+		return;
 	}
 
-	const nsString ext = nsFileSystem::FileGetExtension(assetFile);
+	int index = NS_ARRAY_INDEX_INVALID;
 
-	if (ext != NS_ENGINE_ASSET_FILE_EXTENSION)
+	switch (type)
 	{
-		return false;
+		case nsEAssetType::TEXTURE: index = TextureAsset.Find(name); break;
+		case nsEAssetType::MODEL: index = ModelAsset.Find(name); break;
+		case nsEAssetType::SKELETON: index = SkeletonAsset.Find(name); break;
+		case nsEAssetType::ANIMATION: index = AnimationAsset.Find(name); break;
+		default: NS_ValidateV(0, TEXT("Not implemented yet!")); return;
 	}
 
-	nsFileStreamReader reader(assetFile);
-	reader | outHeader;
-
-	// TODO: Other validations
+	if (index != NS_ARRAY_INDEX_INVALID)
+	{
+		NS_CONSOLE_Log(AssetLog, TEXT("Reimported asset [%s], loaded data is kept until reloaded"), *name.ToString());
+		return;
+	}
 
-	return outHeader.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE;
+	RegisterAsset(name, path, type, ArchiveData{});
 }
 
 
-bool nsAssetManager::GetAssetInfoFromFile(const nsString& assetFile, nsAssetInfo& outAssetInfo) const
+bool nsAssetManager::WriteAssetFile(const nsString& assetFile, nsEAssetType type, const nsBinaryStreamWriter& payload, nsECompression compression) const
 {
-	bool bValid = false;
-	nsAssetFileHeader header{};
+	nsAssetFileHeader header;
+	header.Signature = NS_ENGINE_ASSET_FILE_SIGNATURE;
+	header.Version = NS_ENGINE_ASSET_FILE_VERSION;
+	header.Type = static_cast<int>(type);
+	header.Compression = static_cast<int>(compression);
 
-	if (IsValidAssetFile(assetFile, header))
+	nsBinaryStreamWriter headerWriter;
+	headerWriter | header;
+
+	nsTArray<uint8> fileData = headerWriter.GetBuffer();
+
+	if (compression == nsECompression::NONE)
 	{
-		outAssetInfo.Name = *nsFileSystem::FileGetName(assetFile);
-		outAssetInfo.Path = nsFileSystem::FileGetPath(assetFile);
-		outAssetInfo.Type = static_cast<nsEAssetType>(header.Type);
+		fileData.InsertAt(payload.GetBufferData(), payload.GetBufferSize());
+	}
+	else
+	{
+		nsCompression::Compress(payload.GetBufferData(), payload.GetBufferSize(), compression, fileData);
+	}
+
+	return nsFileSystem::FileWriteBinary(assetFile, fileData);
+}
+
+
+bool nsAssetManager::IsValidAssetFile(const nsString& assetFile, nsAssetFileHeader& outHeader) const
+{
+	if (assetFile.IsEmpty())
+	{
+		return false;
+	}
+
+	const nsString ext = nsFileSystem::FileGetExtension(assetFile);
+
+	if (ext != NS_ENGINE_ASSET_FILE_EXTENSION)
+	{
+		return false;
+	}
+
+	nsFileStreamReader reader(assetFile);
+	reader | outHeader;
+
+	// TODO: Other validations
+
+	return outHeader.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE;
+}
+
+
+bool nsAssetManager::GetAssetInfoFromFile(const nsString& assetFile, nsAssetInfo& outAssetInfo) const
+{
+	bool bValid = false;
+	nsAssetFileHeader header{};
+
+	if (IsValidAssetFile(assetFile, header))
+	{
+		outAssetInfo.Name = *nsFileSystem::FileGetName(assetFile);
+		outAssetInfo.Path = nsFileSystem::FileGetPath(assetFile);
+		outAssetInfo.Type = static_cast<nsEAssetType>(header.Type);
 		bValid = true;
 	}
 
@@ -202,34 +781,823 @@ void nsAssetManager::GetAssetInfosFromPath(const nsString& path, nsTArray<nsAsse
 	{
 		if (GetAssetInfoFromFile(assetFiles[i], assetInfo))
 		{
-			outAssetInfos.Add(assetInfo);
+			outAssetInfos.Add(assetInfo);
+		}
+	}
+}
+
+
+void nsAssetManager::Update()
+{
+	++ResidencyFrame;
+
+	UpdateAsyncLoadRequests();
+	UpdateTextureStreaming();
+	UpdateMaterialAssets();
+	UpdateResidency();
+}
+
+
+
+
+// ====================================================================================================================================================================== //
+// ARCHIVE
+// ====================================================================================================================================================================== //
+bool nsAssetManager::CookAssetArchive(const nsString& assetsPath, const nsString& archiveFile) const
+{
+	nsTArray<nsString> assetFiles;
+	assetFiles.Reserve(64);
+	nsFileSystem::FileIterate(assetFiles, assetsPath, true, NS_ENGINE_ASSET_FILE_EXTENSION);
+
+	nsTArray<nsAssetArchiveEntry> entries;
+	entries.Reserve(assetFiles.GetCount());
+
+	nsTArray<nsString> entryFiles;
+	entryFiles.Reserve(assetFiles.GetCount());
+
+	// Asset names are unique per asset type, value is mask of (1 << type)
+	nsTMap<nsName, uint32> entryNameTypes;
+	entryNameTypes.Reserve(assetFiles.GetCount());
+
+	for (int i = 0; i < assetFiles.GetCount(); ++i)
+	{
+		nsFileMappedView fileView;
+		nsAssetFileHeader header{};
+
+		if (nsFileSystem::FileMap(assetFiles[i], fileView) && fileView.Size >= static_cast<int>(sizeof(nsAssetFileHeader)))
+		{
+			nsBinaryStreamReader reader(fileView.Data, fileView.Size);
+			reader | header;
+		}
+
+		if (header.Signature != NS_ENGINE_ASSET_FILE_SIGNATURE || header.Type <= 0 || header.Type >= 32)
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Skip cook asset file [%s]. Invalid asset file!"), *assetFiles[i]);
+			continue;
+		}
+
+		const nsName name = *nsFileSystem::FileGetName(assetFiles[i]);
+		const uint32 typeMask = (1u << header.Type);
+		uint32* nameTypes = entryNameTypes.GetValueByKey(name);
+
+		if (nameTypes && (*nameTypes & typeMask))
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Skip cook asset file [%s]. Asset with name [%s] already exists!"), *assetFiles[i], *name.ToString());
+			continue;
+		}
+
+		if (nameTypes)
+		{
+			*nameTypes |= typeMask;
+		}
+		else
+		{
+			entryNameTypes.Add(name, typeMask);
+		}
+
+		nsAssetArchiveEntry& entry = entries.Add();
+		nsPlatform::Memory_Zero(&entry, sizeof(nsAssetArchiveEntry));
+		entry.Name = name;
+		entry.Type = static_cast<uint8>(header.Type);
+		entry.DataSize = static_cast<uint32>(fileView.Size);
+		entryFiles.Add(assetFiles[i]);
+	}
+
+
+	// Layout: header, table of contents, then aligned data
+	const int tocSize = entries.GetCount() * static_cast<int>(sizeof(nsAssetArchiveEntry));
+	uint64 archiveSize = sizeof(nsAssetArchiveHeader) + tocSize;
+
+	for (int i = 0; i < entries.GetCount(); ++i)
+	{
+		archiveSize = (archiveSize + NS_ENGINE_ASSET_ARCHIVE_DATA_ALIGNMENT - 1) & ~static_cast<uint64>(NS_ENGINE_ASSET_ARCHIVE_DATA_ALIGNMENT - 1);
+		entries[i].DataOffset = archiveSize;
+		archiveSize += entries[i].DataSize;
+	}
+
+	if (archiveSize >= INT32_MAX)
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to cook asset archive [%s]. Archive size exceeds 2 GiB!"), *archiveFile);
+		return false;
+	}
+
+	nsTArray<uint8> archiveData;
+	archiveData.Resize(static_cast<int>(archiveSize));
+
+	nsAssetArchiveHeader header;
+	header.Signature = NS_ENGINE_ASSET_ARCHIVE_SIGNATURE;
+	header.Version = NS_ENGINE_ASSET_ARCHIVE_VERSION;
+	header.EntryCount = entries.GetCount();
+	nsPlatform::Memory_Copy(archiveData.GetData(), &header, sizeof(nsAssetArchiveHeader));
+
+	if (tocSize > 0)
+	{
+		nsPlatform::Memory_Copy(archiveData.GetData() + sizeof(nsAssetArchiveHeader), entries.GetData(), tocSize);
+	}
+
+	for (int i = 0; i < entries.GetCount(); ++i)
+	{
+		nsFileMappedView fileView;
+
+		if (!nsFileSystem::FileMap(entryFiles[i], fileView) || fileView.Size != static_cast<int>(entries[i].DataSize))
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Fail to cook asset archive [%s]. Read asset file [%s] failed!"), *archiveFile, *entryFiles[i]);
+			return false;
+		}
+
+		nsPlatform::Memory_Copy(archiveData.GetData() + entries[i].DataOffset, fileView.Data, fileView.Size);
+	}
+
+	if (!nsFileSystem::FileWriteBinary(archiveFile, archiveData))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to cook asset archive. Write archive file [%s] failed!"), *archiveFile);
+		return false;
+	}
+
+	NS_CONSOLE_Log(AssetLog, TEXT("Cooked %i assets from [%s] to asset archive [%s]"), entries.GetCount(), *assetsPath, *archiveFile);
+
+	return true;
+}
+
+
+bool nsAssetManager::MountAssetArchive(const nsString& archiveFile)
+{
+	nsFileMappedView* archiveView = ns_CreateObject<nsFileMappedView>();
+
+	if (!nsFileSystem::FileMap(archiveFile, *archiveView))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to mount asset archive. Map archive file [%s] failed!"), *archiveFile);
+		ns_DestroyObject(archiveView);
+		return false;
+	}
+
+	const int headerSize = static_cast<int>(sizeof(nsAssetArchiveHeader));
+	const nsAssetArchiveHeader* header = reinterpret_cast<const nsAssetArchiveHeader*>(archiveView->Data);
+
+	bool bValid = archiveView->Size >= headerSize && header->Signature == NS_ENGINE_ASSET_ARCHIVE_SIGNATURE && header->Version == NS_ENGINE_ASSET_ARCHIVE_VERSION && header->EntryCount >= 0;
+	bValid = bValid && static_cast<int64>(header->EntryCount) * static_cast<int64>(sizeof(nsAssetArchiveEntry)) <= static_cast<int64>(archiveView->Size - headerSize);
+
+	if (!bValid)
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to mount asset archive [%s]. Invalid archive file!"), *archiveFile);
+		ns_DestroyObject(archiveView);
+		return false;
+	}
+
+	// Table of contents is used directly from mapped memory
+	const nsAssetArchiveEntry* entries = reinterpret_cast<const nsAssetArchiveEntry*>(archiveView->Data + headerSize);
+	const nsString archivePath = nsFileSystem::FileGetPath(archiveFile);
+
+	for (int i = 0; i < header->EntryCount; ++i)
+	{
+		const nsAssetArchiveEntry& entry = entries[i];
+
+		if (entry.DataOffset + entry.DataSize > static_cast<uint64>(archiveView->Size))
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Skip asset [%s] in archive [%s]. Data out of range!"), *entry.Name.ToString(), *archiveFile);
+			continue;
+		}
+
+		ArchiveData archiveData;
+		archiveData.Data = archiveView->Data + entry.DataOffset;
+		archiveData.Size = static_cast<int>(entry.DataSize);
+
+		RegisterAsset(entry.Name, archivePath, static_cast<nsEAssetType>(entry.Type), archiveData);
+	}
+
+	MountedArchives.Add(archiveView);
+	NS_CONSOLE_Log(AssetLog, TEXT("Mounted asset archive [%s] (%i assets)"), *archiveFile, header->EntryCount);
+
+	return true;
+}
+
+
+
+
+// ====================================================================================================================================================================== //
+// ASYNC LOAD
+// ====================================================================================================================================================================== //
+uint8& nsAssetManager::GetAssetFlags(nsEAssetType type, int index)
+{
+	switch (type)
+	{
+		case nsEAssetType::TEXTURE: return TextureAsset.Flags[index];
+		case nsEAssetType::MODEL: return ModelAsset.Flags[index];
+		case nsEAssetType::SKELETON: return SkeletonAsset.Flags[index];
+		case nsEAssetType::ANIMATION: return AnimationAsset.Flags[index];
+		default: break;
+	}
+
+	NS_ValidateV(0, TEXT("Not implemented yet!"));
+	return MaterialAsset.Flags[index];
+}
+
+
+nsAssetManager::AsyncLoadRequest* nsAssetManager::FindAsyncLoadRequest(nsEAssetType type, int index) const
+{
+	for (int i = 0; i < AsyncLoadRequests.GetCount(); ++i)
+	{
+		AsyncLoadRequest* request = AsyncLoadRequests[i];
+
+		if (request->Type == type && request->AssetIndex == index)
+		{
+			return request;
+		}
+	}
+
+	return nullptr;
+}
+
+
+nsAssetManager::AsyncLoadRequest* nsAssetManager::CreateAsyncLoadRequest(nsEAssetType type, int index)
+{
+	AsyncLoadRequest* request = ns_CreateObject<AsyncLoadRequest>();
+	request->Type = type;
+	request->AssetIndex = index;
+
+	switch (type)
+	{
+		case nsEAssetType::TEXTURE:
+			request->Name = TextureAsset.Names[index];
+			request->File = TextureAsset.Paths[index];
+			request->Archive = TextureAsset.ArchiveDatas[index];
+			break;
+
+		case nsEAssetType::MODEL:
+			request->Name = ModelAsset.Names[index];
+			request->File = ModelAsset.Paths[index];
+			request->Archive = ModelAsset.ArchiveDatas[index];
+			break;
+
+		case nsEAssetType::SKELETON:
+			request->Name = SkeletonAsset.Names[index];
+			request->File = SkeletonAsset.Paths[index];
+			request->Archive = SkeletonAsset.ArchiveDatas[index];
+			break;
+
+		case nsEAssetType::ANIMATION:
+			request->Name = AnimationAsset.Names[index];
+			request->File = AnimationAsset.Paths[index];
+			request->Archive = AnimationAsset.ArchiveDatas[index];
+			break;
+
+		default:
+			NS_ValidateV(0, TEXT("Not implemented yet!"));
+			break;
+	}
+
+	request->File = nsString::Format(TEXT("%s/%s%s"), *request->File, *request->Name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
+	AsyncLoadRequests.Add(request);
+
+	return request;
+}
+
+
+void nsAssetManager::RequestAsyncLoad(nsEAssetType type, int index, nsEAssetLoadPriority priority)
+{
+	AsyncLoadRequest* request = FindAsyncLoadRequest(type, index);
+
+	if (request == nullptr)
+	{
+		request = CreateAsyncLoadRequest(type, index);
+		AsyncLoadQueue.Submit(request, static_cast<int>(priority));
+	}
+	else if (static_cast<int>(priority) > request->Priority)
+	{
+		AsyncLoadQueue.SetPriority(request, static_cast<int>(priority));
+	}
+
+	// Clears pending unload, request in flight is reused
+	GetAssetFlags(type, index) = AssetFlag_Loading;
+}
+
+
+void nsAssetManager::FinalizeAsyncLoadRequest(AsyncLoadRequest* request)
+{
+	NS_Assert(request->GetState() == AsyncLoadState_Decoded);
+
+	const int index = request->AssetIndex;
+	const nsName& name = request->Name;
+
+	switch (request->Type)
+	{
+		case nsEAssetType::TEXTURE:
+		{
+			nsTextureManager& textureManager = nsTextureManager::Get();
+			TextureStreaming& streaming = TextureStreamings[index];
+
+			if (request->bTextureStream)
+			{
+				streaming.bStreaming = false;
+
+				// Mips dropped or texture unloaded while streaming
+				if (!Internal_IsTextureAssetLoaded(index) || streaming.ResidentMipCount != request->TextureMipFirst)
+				{
+					return;
+				}
+
+				nsTextureData& data = textureManager.GetTextureData(TextureAsset.Handles[index]);
+				nsTArrayInline<nsTextureData::Mip, NS_ENGINE_TEXTURE_MAX_MIP>& mips = request->TextureData.Mips;
+
+				for (int m = 0; m < data.Mips.GetCount(); ++m)
+				{
+					mips.Add(std::move(data.Mips[m]));
+				}
+
+				textureManager.UpdateTextureMips(TextureAsset.Handles[index], std::move(mips));
+				streaming.ResidentMipCount += request->TextureMipCount;
+				UpdateAssetMemorySize(nsEAssetType::TEXTURE, index);
+
+				NS_CONSOLE_Debug(AssetLog, TEXT("Streamed texture asset [%s] mips (%i/%i)"), *name.ToString(), streaming.ResidentMipCount, streaming.MipCount);
+				return;
+			}
+
+			TextureAsset.Handles[index] = textureManager.CreateTexture2D_Empty(name);
+			TextureAssetIndices.Add(TextureAsset.Handles[index], index);
+
+			nsTextureData& data = textureManager.GetTextureData(TextureAsset.Handles[index]);
+			data.Width = request->TextureData.Width;
+			data.Height = request->TextureData.Height;
+			data.Format = request->TextureData.Format;
+			data.Mips = std::move(request->TextureData.Mips);
+
+			nsPlatform::Memory_Zero(&streaming, sizeof(TextureStreaming));
+			streaming.MipCount = request->TextureMips.GetCount();
+			streaming.ResidentMipCount = request->TextureMipCount;
+			streaming.RequestedFrame = ResidencyFrame;
+
+			if (streaming.MipCount > 0)
+			{
+				nsPlatform::Memory_Copy(streaming.Mips, request->TextureMips.GetData(), sizeof(nsAssetTextureMip) * streaming.MipCount);
+				streaming.TailMipCount = ns_GetTextureTailMipCount(streaming.Mips, streaming.MipCount);
+			}
+
+			break;
+		}
+
+		case nsEAssetType::MODEL:
+		{
+			nsMeshManager& meshManager = nsMeshManager::Get();
+
+			for (int i = 0; i < request->ModelLodGroups.GetCount(); ++i)
+			{
+				const nsMeshID mesh = meshManager.CreateMesh(name);
+				meshManager.GetMeshLodGroup(mesh) = std::move(request->ModelLodGroups[i]);
+				ModelAsset.Handles[index].Add(mesh);
+			}
+
+			break;
+		}
+
+		case nsEAssetType::SKELETON:
+		{
+			nsAnimationManager& animationManager = nsAnimationManager::Get();
+			SkeletonAsset.Handles[index] = animationManager.CreateSkeleton(name);
+
+			nsAnimationSkeletonData& data = animationManager.GetSkeletonData(SkeletonAsset.Handles[index]);
+			data.BoneNames = std::move(request->SkeletonData.BoneNames);
+			data.BoneDatas = std::move(request->SkeletonData.BoneDatas);
+			data.CompressionError = request->SkeletonData.CompressionError;
+			break;
+		}
+
+		case nsEAssetType::ANIMATION:
+		{
+			nsAnimationManager& animationManager = nsAnimationManager::Get();
+			AnimationAsset.Handles[index] = animationManager.CreateClip(name);
+			animationManager.GetClipData(AnimationAsset.Handles[index]) = std::move(request->ClipData);
+			break;
+		}
+
+		default:
+			NS_ValidateV(0, TEXT("Not implemented yet!"));
+			break;
+	}
+
+	GetAssetFlags(request->Type, index) = AssetFlag_Loaded;
+	UpdateAssetMemorySize(request->Type, index);
+
+	NS_CONSOLE_Debug(AssetLog, TEXT("Loaded asset [%s]"), *name.ToString());
+}
+
+
+void nsAssetManager::DestroyAsyncLoadRequest(AsyncLoadRequest* request)
+{
+	NS_Assert(request->IsDecodeDone());
+
+	AsyncLoadRequests.Remove(request);
+	nsFileSystem::FileUnmap(request->FileView);
+	ns_DestroyObject(request);
+}
+
+
+bool nsAssetManager::LoadAssetImmediate(nsEAssetType type, int index)
+{
+	AsyncLoadRequest* request = FindAsyncLoadRequest(type, index);
+
+	if (request == nullptr)
+	{
+		request = CreateAsyncLoadRequest(type, index);
+		AsyncLoadQueue.Prepare(request, static_cast<int>(nsEAssetLoadPriority::HIGH));
+	}
+
+	AsyncLoadQueue.Wait(request);
+
+	const bool bDecoded = request->GetState() == AsyncLoadState_Decoded;
+
+	if (bDecoded)
+	{
+		FinalizeAsyncLoadRequest(request);
+	}
+	else
+	{
+		GetAssetFlags(type, index) = AssetFlag_Unloaded;
+	}
+
+	DestroyAsyncLoadRequest(request);
+
+	return bDecoded;
+}
+
+
+void nsAssetManager::UpdateAsyncLoadRequests()
+{
+	if (AsyncLoadRequests.GetCount() == 0)
+	{
+		return;
+	}
+
+	const nsThreadAffinityMasks decodeAffinity = nsThreadPool::GetThreadCount() > 1 ? nsEThreadAffinity::Thread_ExcludeMain : nsEThreadAffinity::Thread_ALL;
+	nsTArrayInline<AsyncLoadRequest*, 32> decodedRequests;
+
+	for (int i = AsyncLoadRequests.GetCount() - 1; i >= 0; --i)
+	{
+		AsyncLoadRequest* request = AsyncLoadRequests[i];
+		uint8& flags = GetAssetFlags(request->Type, request->AssetIndex);
+
+		// All shared assets released before finalized. Stream request only adds mips to loaded texture, it is destroyed when texture unloaded
+		if ((flags & AssetFlag_PendingUnload) && !request->bTextureStream)
+		{
+			if (AsyncLoadQueue.Cancel(request))
+			{
+				NS_CONSOLE_Debug(AssetLog, TEXT("Cancel async load asset [%s]"), *request->Name.ToString());
+				flags = AssetFlag_Unloaded;
+				DestroyAsyncLoadRequest(request);
+			}
+
+			continue;
+		}
+
+		const int state = request->GetState();
+
+		if (state == AsyncLoadState_ReadDone)
+		{
+			AsyncLoadQueue.SubmitDecode(request, decodeAffinity);
+		}
+		else if (state == AsyncLoadState_Decoded && request->IsDecodeDone())
+		{
+			decodedRequests.Add(request);
+		}
+		else if (state == AsyncLoadState_Failed && request->IsDecodeDone())
+		{
+			NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load asset [%s]. Read data from asset file [%s] failed!"), *request->Name.ToString(), *request->File);
+
+			if (request->bTextureStream)
+			{
+				// Keep resident mips, do not retry streaming
+				TextureStreaming& streaming = TextureStreamings[request->AssetIndex];
+				streaming.MipCount = streaming.ResidentMipCount;
+				streaming.bStreaming = false;
+			}
+			else
+			{
+				flags = AssetFlag_Unloaded;
+			}
+
+			DestroyAsyncLoadRequest(request);
+		}
+	}
+
+	if (decodedRequests.GetCount() == 0)
+	{
+		return;
+	}
+
+	// Creating engine resources (GPU upload) is main thread only, spread the cost over frames
+	nsAsyncLoadQueue::FinalizeRequests(decodedRequests.GetData(), decodedRequests.GetCount(), AsyncLoadFinalizeBudgetMs, [this](AsyncLoadRequest* request)
+	{
+		FinalizeAsyncLoadRequest(request);
+		DestroyAsyncLoadRequest(request);
+	});
+}
+
+
+void nsAssetManager::FlushAsyncLoads()
+{
+	while (AsyncLoadRequests.GetCount() > 0)
+	{
+		UpdateAsyncLoadRequests();
+
+		if (AsyncLoadRequests.GetCount() > 0)
+		{
+			nsPlatform::Thread_Sleep(1);
+		}
+	}
+}
+
+
+
+
+// ====================================================================================================================================================================== //
+// RESIDENCY
+// ====================================================================================================================================================================== //
+struct nsAssetResidencyCandidate
+{
+	nsEAssetType Type;
+	int Index;
+	uint64 ReleasedFrame;
+	nsAssetManager::MemorySize Size;
+};
+
+
+template<typename THandle>
+static void ns_AssetCollectResidency(const nsAssetManager::TAssetData<THandle>& assetData, nsEAssetType type, nsAssetManager::ResidencyStats& outStats, nsTArray<nsAssetResidencyCandidate>& outCandidates)
+{
+	nsPlatform::Memory_Zero(&outStats, sizeof(nsAssetManager::ResidencyStats));
+
+	for (int i = 0; i < assetData.Flags.GetCount(); ++i)
+	{
+		const uint8 flags = assetData.Flags[i];
+
+		if (!(flags & nsAssetManager::AssetFlag_Loaded))
+		{
+			continue;
+		}
+
+		const nsAssetManager::MemorySize& size = assetData.MemorySizes[i];
+		outStats.CpuBytes += size.CpuBytes;
+		outStats.GpuBytes += size.GpuBytes;
+		outStats.LoadedCount++;
+
+		// Async load in progress is cancelled by UpdateAsyncLoadRequests()
+		if ((flags & nsAssetManager::AssetFlag_PendingUnload) && !(flags & nsAssetManager::AssetFlag_Loading))
+		{
+			outStats.UnreferencedCount++;
+			outCandidates.Add(nsAssetResidencyCandidate{ type, i, assetData.ReleasedFrames[i], size });
+		}
+	}
+}
+
+
+static uint64 ns_AssetMeshMemorySize(const nsMeshLODGroup& lodGroup)
+{
+	uint64 bytes = 0;
+
+	for (int i = 0; i < lodGroup.GetCount(); ++i)
+	{
+		const nsMeshVertexData& vertexData = lodGroup[i];
+		bytes += static_cast<uint64>(vertexData.Positions.GetCount()) * sizeof(nsVertexMeshPosition);
+		bytes += static_cast<uint64>(vertexData.Attributes.GetCount()) * sizeof(nsVertexMeshAttribute);
+		bytes += static_cast<uint64>(vertexData.Skins.GetCount()) * sizeof(nsVertexMeshSkin);
+		bytes += static_cast<uint64>(vertexData.Indices.GetCount()) * sizeof(uint32);
+	}
+
+	return bytes;
+}
+
+
+void nsAssetManager::UpdateAssetMemorySize(nsEAssetType type, int index)
+{
+	MemorySize size{ 0, 0 };
+
+	switch (type)
+	{
+		case nsEAssetType::TEXTURE:
+		{
+			const nsTextureData& data = nsTextureManager::Get().GetTextureData(TextureAsset.Handles[index]);
+
+			for (int m = 0; m < data.Mips.GetCount(); ++m)
+			{
+				size.CpuBytes += static_cast<uint64>(data.Mips[m].Pixels.GetCount());
+			}
+
+			// Mip pixels stay in texture data after upload to GPU
+			size.GpuBytes = size.CpuBytes;
+			TextureAsset.MemorySizes[index] = size;
+			break;
+		}
+
+		case nsEAssetType::MODEL:
+		{
+			nsMeshManager& meshManager = nsMeshManager::Get();
+			const nsAssetModelMeshes& meshes = ModelAsset.Handles[index];
+
+			for (int m = 0; m < meshes.GetCount(); ++m)
+			{
+				size.CpuBytes += ns_AssetMeshMemorySize(meshManager.GetMeshLodGroup(meshes[m]));
+			}
+
+			// Vertex/index data stays in mesh LOD group after upload to GPU
+			size.GpuBytes = size.CpuBytes;
+			ModelAsset.MemorySizes[index] = size;
+			break;
+		}
+
+		case nsEAssetType::SKELETON:
+		{
+			const nsAnimationSkeletonData& data = nsAnimationManager::Get().GetSkeletonData(SkeletonAsset.Handles[index]);
+			size.CpuBytes = static_cast<uint64>(data.BoneNames.GetCount()) * sizeof(nsName) + static_cast<uint64>(data.BoneDatas.GetCount()) * sizeof(nsAnimationSkeletonData::Bone);
+			SkeletonAsset.MemorySizes[index] = size;
+			break;
+		}
+
+		case nsEAssetType::ANIMATION:
+		{
+			const nsAnimationClipData& data = nsAnimationManager::Get().GetClipData(AnimationAsset.Handles[index]);
+
+			for (int k = 0; k < data.KeyFrames.GetCount(); ++k)
+			{
+				const nsAnimationKeyFrame& keyFrame = data.KeyFrames[k];
+				size.CpuBytes += static_cast<uint64>(keyFrame.PositionChannels.GetCount()) * sizeof(nsAnimationKeyFrame::TChannel<nsVector3>);
+				size.CpuBytes += static_cast<uint64>(keyFrame.RotationChannels.GetCount()) * sizeof(nsAnimationKeyFrame::TChannel<nsQuaternion>);
+				size.CpuBytes += static_cast<uint64>(keyFrame.ScaleChannels.GetCount()) * sizeof(nsAnimationKeyFrame::TChannel<nsVector3>);
+			}
+
+			const nsAnimationCompressedClipData& compressed = data.Compressed;
+			size.CpuBytes += static_cast<uint64>(compressed.Tracks.GetCount()) * sizeof(nsAnimationCompressedTrack);
+			size.CpuBytes += static_cast<uint64>(compressed.KeyTimes.GetCount() + compressed.KeyValues.GetCount()) * sizeof(uint16);
+			size.CpuBytes += static_cast<uint64>(compressed.ConstantValues.GetCount()) * sizeof(nsVector4);
+
+			AnimationAsset.MemorySizes[index] = size;
+			break;
+		}
+
+		default:
+			NS_ValidateV(0, TEXT("Not implemented yet!"));
+			break;
+	}
+}
+
+
+void nsAssetManager::UnloadAsset(nsEAssetType type, int index)
+{
+	switch (type)
+	{
+		case nsEAssetType::TEXTURE: UnloadTextureAsset(index); break;
+		case nsEAssetType::MODEL: UnloadModelAsset(index); break;
+		case nsEAssetType::SKELETON: UnloadSkeletonAsset(index); break;
+		case nsEAssetType::ANIMATION: UnloadAnimationAsset(index); break;
+		default: NS_ValidateV(0, TEXT("Not implemented yet!")); break;
+	}
+}
+
+
+void nsAssetManager::UpdateResidency()
+{
+	nsTArray<nsAssetResidencyCandidate> candidates;
+	ns_AssetCollectResidency(TextureAsset, nsEAssetType::TEXTURE, ResidencyTypeStats[static_cast<int>(nsEAssetType::TEXTURE)], candidates);
+	ns_AssetCollectResidency(ModelAsset, nsEAssetType::MODEL, ResidencyTypeStats[static_cast<int>(nsEAssetType::MODEL)], candidates);
+	ns_AssetCollectResidency(SkeletonAsset, nsEAssetType::SKELETON, ResidencyTypeStats[static_cast<int>(nsEAssetType::SKELETON)], candidates);
+	ns_AssetCollectResidency(AnimationAsset, nsEAssetType::ANIMATION, ResidencyTypeStats[static_cast<int>(nsEAssetType::ANIMATION)], candidates);
+
+	uint64 cpuBytes = 0;
+	uint64 gpuBytes = 0;
+
+	for (int t = 0; t < RESIDENCY_TYPE_COUNT; ++t)
+	{
+		cpuBytes += ResidencyTypeStats[t].CpuBytes;
+		gpuBytes += ResidencyTypeStats[t].GpuBytes;
+	}
+
+	if (candidates.GetCount() == 0 || (cpuBytes <= ResidencyCpuBudget && gpuBytes <= ResidencyGpuBudget))
+	{
+		return;
+	}
+
+	// Evict below budget, so assets loaded right after eviction do not trigger eviction again every frame
+	const uint64 cpuTarget = static_cast<uint64>(static_cast<double>(ResidencyCpuBudget) * NS_ENGINE_ASSET_RESIDENCY_EVICT_TARGET_RATIO);
+	const uint64 gpuTarget = static_cast<uint64>(static_cast<double>(ResidencyGpuBudget) * NS_ENGINE_ASSET_RESIDENCY_EVICT_TARGET_RATIO);
+
+	nsAlgorithm::Sort(candidates.GetData(), candidates.GetCount(), [](const nsAssetResidencyCandidate& a, const nsAssetResidencyCandidate& b)
+	{
+		return a.ReleasedFrame < b.ReleasedFrame;
+	});
+
+	int evictedCount = 0;
+
+	for (int i = 0; i < candidates.GetCount(); ++i)
+	{
+		const bool bCpuOver = cpuBytes > cpuTarget;
+		const bool bGpuOver = gpuBytes > gpuTarget;
+
+		if (!bCpuOver && !bGpuOver)
+		{
+			break;
+		}
+
+		const nsAssetResidencyCandidate& candidate = candidates[i];
+
+		// Only evict assets that reduce the usage that is over target
+		if (!(bCpuOver && candidate.Size.CpuBytes > 0) && !(bGpuOver && candidate.Size.GpuBytes > 0))
+		{
+			continue;
+		}
+
+		UnloadAsset(candidate.Type, candidate.Index);
+		cpuBytes -= candidate.Size.CpuBytes;
+		gpuBytes -= candidate.Size.GpuBytes;
+
+		ResidencyStats& stats = ResidencyTypeStats[static_cast<int>(candidate.Type)];
+		stats.CpuBytes -= candidate.Size.CpuBytes;
+		stats.GpuBytes -= candidate.Size.GpuBytes;
+		stats.LoadedCount--;
+		stats.UnreferencedCount--;
+		++evictedCount;
+	}
+
+	// Runs every frame while over budget, only report frames that actually evicted something
+	if (evictedCount > 0)
+	{
+		NS_CONSOLE_Debug(AssetLog, TEXT("Evicted %i unreferenced assets (CPU: %llu KiB, GPU: %llu KiB)"), evictedCount, cpuBytes / 1024, gpuBytes / 1024);
+	}
+}
+
+
+
+
+// ====================================================================================================================================================================== //
+// TEXTURE
+// ====================================================================================================================================================================== //
+bool nsAssetManager::WriteTextureAssetFile(const nsString& assetFile, const nsTextureData& data, nsECompression compression, nsAssetTextureMip* outMipTable) const
+{
+	// Mips are compressed separately so each mip can be streamed on its own (see nsAssetTextureHeader)
+	const int mipCount = data.Mips.GetCount();
+	NS_Assert(mipCount > 0 && mipCount <= NS_ENGINE_TEXTURE_MAX_MIP);
+
+	nsAssetFileHeader header;
+	header.Signature = NS_ENGINE_ASSET_FILE_SIGNATURE;
+	header.Version = NS_ENGINE_ASSET_FILE_VERSION;
+	header.Type = static_cast<int>(nsEAssetType::TEXTURE);
+	header.Compression = static_cast<int>(compression);
+
+	nsBinaryStreamWriter headerWriter;
+	headerWriter | header;
+
+	nsTArray<uint8> fileData = headerWriter.GetBuffer();
+
+	nsAssetTextureHeader textureHeader;
+	textureHeader.Width = data.Width;
+	textureHeader.Height = data.Height;
+	textureHeader.Format = static_cast<int>(data.Format);
+	textureHeader.MipCount = mipCount;
+	fileData.InsertAt(reinterpret_cast<const uint8*>(&textureHeader), static_cast<int>(sizeof(nsAssetTextureHeader)));
+
+	nsAssetTextureMip mipTable[NS_ENGINE_TEXTURE_MAX_MIP];
+	const int tableOffset = fileData.GetCount();
+	fileData.Resize(tableOffset + mipCount * static_cast<int>(sizeof(nsAssetTextureMip)));
+
+	for (int i = 0; i < mipCount; ++i)
+	{
+		const nsTextureData::Mip& mip = data.Mips[mipCount - 1 - i];
+		const int pixelSize = mip.Pixels.GetCount();
+
+		nsAssetTextureMip& entry = mipTable[i];
+		entry.Width = mip.Width;
+		entry.Height = mip.Height;
+		entry.DataOffset = static_cast<uint32>(fileData.GetCount());
+		entry.PixelSize = static_cast<uint32>(pixelSize);
+		entry.Reserved = 0;
+
+		if (compression != nsECompression::NONE)
+		{
+			nsCompression::Compress(mip.Pixels.GetData(), pixelSize, compression, fileData);
+		}
+		else if (pixelSize > 0)
+		{
+			fileData.InsertAt(mip.Pixels.GetData(), pixelSize);
 		}
-	}
-}
 
+		entry.DataSize = static_cast<uint32>(fileData.GetCount()) - entry.DataOffset;
+	}
 
-void nsAssetManager::Update()
-{
-	UpdateTextureAssets();
-	UpdateMaterialAssets();
-	UpdateModelAssets();
-	UpdateSkeletonAssets();
-	UpdateAnimationAssets();
-}
+	nsPlatform::Memory_Copy(fileData.GetData() + tableOffset, mipTable, sizeof(nsAssetTextureMip) * mipCount);
 
+	if (outMipTable)
+	{
+		nsPlatform::Memory_Copy(outMipTable, mipTable, sizeof(nsAssetTextureMip) * mipCount);
+	}
 
+	return nsFileSystem::FileWriteBinary(assetFile, fileData);
+}
 
 
-// ====================================================================================================================================================================== //
-// TEXTURE
-// ====================================================================================================================================================================== //
-void nsAssetManager::SaveTextureAsset(nsName name, nsTextureID texture, const nsString& folderPath, bool bIsEngineAsset)
+void nsAssetManager::SaveTextureAsset(nsName name, nsTextureID texture, const nsString& folderPath, bool bIsEngineAsset, nsECompression compression)
 {
 	nsTextureManager& textureManager = nsTextureManager::Get();
 	const nsName assetName = textureManager.GetTextureName(texture);
 	const nsString assetPath = nsString::Format(TEXT("%s/%s"), bIsEngineAsset ? *EngineAssetsPath : *GameAssetsPath, *folderPath);
 
-	if (TextureAsset.Names.Find(assetName) != NS_ARRAY_INDEX_INVALID)
+	if (TextureAsset.Find(assetName) != NS_ARRAY_INDEX_INVALID)
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save texture asset. Texture asset with name [%s] already exists!"), *assetName);
 		return;
@@ -241,25 +1609,13 @@ void nsAssetManager::SaveTextureAsset(nsName name, nsTextureID texture, const ns
 		return;
 	}
 	
-	// Write data
-	nsBinaryStreamWriter writer;
-	{
-		nsAssetFileHeader header;
-		header.Signature = NS_ENGINE_ASSET_FILE_SIGNATURE;
-		header.Version = NS_ENGINE_ASSET_FILE_VERSION;
-		header.Type = static_cast<int>(nsEAssetType::TEXTURE);
-		header.Compression = 0;
-
-		writer | header;
-
-		nsTextureData& data = textureManager.GetTextureData(texture);
-		writer | data;
-	}
-	
+	const nsTextureData& data = textureManager.GetTextureData(texture);
+	const int mipCount = data.Mips.GetCount();
+	nsAssetTextureMip mipTable[NS_ENGINE_TEXTURE_MAX_MIP];
 
 	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *assetPath, *assetName.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
 
-	if (!nsFileSystem::FileWriteBinary(assetFile, writer.GetBuffer()))
+	if (!WriteTextureAssetFile(assetFile, data, compression, mipTable))
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save texture [%s] to asset file [%s]"), *assetName.ToString(), *assetFile);
 		return;
@@ -267,6 +1623,18 @@ void nsAssetManager::SaveTextureAsset(nsName name, nsTextureID texture, const ns
 
 	NS_CONSOLE_Log(AssetLog, TEXT("Texture [%s] saved to asset file [%s]"), *assetName.ToString(), *assetFile);
 	TextureAsset.Add(assetName, assetPath, AssetFlag_Loaded, texture);
+	TextureStreamings.Resize(TextureAsset.Names.GetCount());
+
+	const int index = TextureAsset.Names.GetCount() - 1;
+	UpdateAssetMemorySize(nsEAssetType::TEXTURE, index);
+
+	// All mips resident, top mips can be dropped and streamed again from saved file
+	TextureStreaming& streaming = TextureStreamings[index];
+	nsPlatform::Memory_Copy(streaming.Mips, mipTable, sizeof(nsAssetTextureMip) * mipCount);
+	streaming.MipCount = mipCount;
+	streaming.TailMipCount = ns_GetTextureTailMipCount(mipTable, mipCount);
+	streaming.ResidentMipCount = mipCount;
+	streaming.RequestedFrame = ResidencyFrame;
 }
 
 
@@ -277,7 +1645,7 @@ nsSharedTextureAsset nsAssetManager::LoadTextureAsset(const nsName& name)
 		return nsSharedTextureAsset();
 	}
 
-	const int index = TextureAsset.Names.Find(name);
+	const int index = TextureAsset.Find(name);
 
 	if (index == NS_ARRAY_INDEX_INVALID)
 	{
@@ -288,76 +1656,220 @@ nsSharedTextureAsset nsAssetManager::LoadTextureAsset(const nsName& name)
 	if (TextureAsset.Handles[index] != nsTextureID::INVALID)
 	{
 		TextureAsset.Flags[index] = AssetFlag_Loaded;
-		return nsSharedTextureAsset(index, name, TextureAsset.Handles[index]);
+		return nsSharedTextureAsset(index, name);
+	}
+
+	if (!LoadAssetImmediate(nsEAssetType::TEXTURE, index))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load texture asset [%s]!"), *name.ToString());
+		return nsSharedTextureAsset();
 	}
 
-	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *TextureAsset.Paths[index], *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
+	return nsSharedTextureAsset(index, name);
+}
 
-	nsTArray<uint8> bytes;
 
-	if (!nsFileSystem::FileReadBinary(assetFile, bytes))
+nsSharedTextureAsset nsAssetManager::LoadTextureAssetAsync(const nsName& name, nsEAssetLoadPriority priority)
+{
+	if (name.GetLength() == 0)
 	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load texture asset. Read data from asset file [%s] failed!"), *assetFile);
 		return nsSharedTextureAsset();
 	}
 
+	const int index = TextureAsset.Find(name);
 
-	// Read data
-	nsBinaryStreamReader reader(bytes);
+	if (index == NS_ARRAY_INDEX_INVALID)
 	{
-		nsAssetFileHeader header{};
-		reader | header;
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load texture asset. Texture asset with name [%s] not found!"), *name.ToString());
+		return nsSharedTextureAsset();
+	}
+
+	if (TextureAsset.Handles[index] != nsTextureID::INVALID)
+	{
+		TextureAsset.Flags[index] = AssetFlag_Loaded;
+	}
+	else
+	{
+		RequestAsyncLoad(nsEAssetType::TEXTURE, index, priority);
+	}
+
+	return nsSharedTextureAsset(index, name);
+}
 
-		NS_Validate(header.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE && header.Type == static_cast<int>(nsEAssetType::TEXTURE));
 
-		nsTextureManager& textureManager = nsTextureManager::Get();
-		TextureAsset.Handles[index] = textureManager.CreateTexture2D_Empty(name);
+void nsAssetManager::Internal_AddTextureAssetReference(int index)
+{
+	TextureAsset.AddReference(index);
+}
 
-		nsTextureData& data = textureManager.GetTextureData(TextureAsset.Handles[index]);
-		reader | data;
+
+void nsAssetManager::Internal_RemoveTextureAssetReference(int index)
+{
+	if (TextureAsset.RemoveReference(index, ResidencyFrame) == 0)
+	{
+		NS_CONSOLE_Debug(AssetLog, TEXT("Mark texture asset [%s] pending unload (RefCount = 0)"), *TextureAsset.Names[index].ToString());
 	}
-	
+}
+
+
+void nsAssetManager::UnloadTextureAsset(int index)
+{
+	NS_Assert(TextureAsset.RefCounts[index] == 0);
+	NS_Assert(TextureAsset.Handles[index].IsValid());
+
+	TextureStreaming& streaming = TextureStreamings[index];
 
-	TextureAsset.Flags[index] = AssetFlag_Loaded;
+	if (streaming.bStreaming)
+	{
+		AsyncLoadRequest* request = FindAsyncLoadRequest(nsEAssetType::TEXTURE, index);
+		NS_Assert(request && request->bTextureStream);
+
+		if (!AsyncLoadQueue.Cancel(request))
+		{
+			AsyncLoadQueue.Wait(request);
+		}
 
-	NS_CONSOLE_Debug(AssetLog, TEXT("Loaded texture asset [%s]"), *name.ToString());
+		DestroyAsyncLoadRequest(request);
+	}
+
+	nsPlatform::Memory_Zero(&streaming, sizeof(TextureStreaming));
 
-	return nsSharedTextureAsset(index, name, TextureAsset.Handles[index]);
+	TextureAsset.Flags[index] = AssetFlag_Unloaded;
+	TextureAsset.MemorySizes[index] = MemorySize{ 0, 0 };
+	NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded texture asset [%s]"), *TextureAsset.Names[index].ToString());
+	TextureAssetIndices.Remove(TextureAsset.Handles[index]);
+	nsTextureManager::Get().DestroyTexture(TextureAsset.Handles[index]);
+	TextureAsset.Handles[index] = nsTextureID::INVALID;
 }
 
 
-void nsAssetManager::Internal_AddTextureAssetReference(int index, nsTextureID texture)
+void nsAssetManager::RequestTextureMipStream(int index, int mipCount)
 {
-	TextureAsset.AddReference(index, texture);
+	TextureStreaming& streaming = TextureStreamings[index];
+	NS_Assert(!streaming.bStreaming);
+	NS_Assert(mipCount > streaming.ResidentMipCount && mipCount <= streaming.MipCount);
+
+	AsyncLoadRequest* request = CreateAsyncLoadRequest(nsEAssetType::TEXTURE, index);
+	request->TextureMipFirst = streaming.ResidentMipCount;
+	request->TextureMipCount = mipCount - streaming.ResidentMipCount;
+	request->bTextureStream = true;
+	streaming.bStreaming = true;
+
+	AsyncLoadQueue.Submit(request, static_cast<int>(nsEAssetLoadPriority::LOW));
 }
 
 
-void nsAssetManager::Internal_RemoveTextureAssetReference(int index, nsTextureID texture)
+void nsAssetManager::DropTextureMips(int index, int mipCount)
 {
-	if (TextureAsset.RemoveReference(index, texture) == 0)
+	TextureStreaming& streaming = TextureStreamings[index];
+	NS_Assert(!streaming.bStreaming);
+	NS_Assert(mipCount > 0 && mipCount < streaming.ResidentMipCount);
+
+	nsTextureManager& textureManager = nsTextureManager::Get();
+	nsTextureData& data = textureManager.GetTextureData(TextureAsset.Handles[index]);
+	NS_Assert(data.Mips.GetCount() == streaming.ResidentMipCount);
+
+	nsTArrayInline<nsTextureData::Mip, NS_ENGINE_TEXTURE_MAX_MIP> mips;
+
+	for (int m = streaming.ResidentMipCount - mipCount; m < data.Mips.GetCount(); ++m)
 	{
-		NS_CONSOLE_Debug(AssetLog, TEXT("Mark texture asset [%s] pending unload (RefCount = 0)"), *TextureAsset.Names[index].ToString());
+		mips.Add(std::move(data.Mips[m]));
 	}
+
+	textureManager.UpdateTextureMips(TextureAsset.Handles[index], std::move(mips));
+	streaming.ResidentMipCount = mipCount;
+	UpdateAssetMemorySize(nsEAssetType::TEXTURE, index);
 }
 
 
-void nsAssetManager::UpdateTextureAssets()
+struct nsAssetTextureDropCandidate
+{
+	int Index;
+	int KeepMipCount;
+	uint64 RequestedFrame;
+};
+
+
+void nsAssetManager::UpdateTextureStreaming()
 {
-	for (int i = 0; i < TextureAsset.Flags.GetCount(); ++i)
+	TextureStreamingBytes = 0;
+	nsTArray<nsAssetTextureDropCandidate> dropCandidates;
+
+	for (int i = 0; i < TextureStreamings.GetCount(); ++i)
 	{
-		uint8& flags = TextureAsset.Flags[i];
+		TextureStreaming& streaming = TextureStreamings[i];
+		const int requestedSize = streaming.RequestedSize;
+		streaming.RequestedSize = 0;
 
-		if (flags & AssetFlag_PendingUnload)
+		if (streaming.MipCount == 0 || !Internal_IsTextureAssetLoaded(i))
 		{
-			NS_Assert(TextureAsset.RefCounts[i] == 0);
-			NS_Assert(TextureAsset.Handles[i].IsValid());
-			
-			flags = AssetFlag_Unloaded;
-			TextureAsset.RefCounts[i] = 0;
-			NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded texture asset [%s]"), *TextureAsset.Names[i].ToString());
-			nsTextureManager::Get().DestroyTexture(TextureAsset.Handles[i]);
+			continue;
+		}
+
+		// Textures that never had screen size requested keep the full chain and are not counted against streaming budget
+		if (!streaming.bScreenSizeRequested)
+		{
+			NS_Assert(streaming.bStreaming || streaming.ResidentMipCount == streaming.MipCount);
+			continue;
+		}
+
+		for (int m = streaming.TailMipCount; m < streaming.ResidentMipCount; ++m)
+		{
+			TextureStreamingBytes += streaming.Mips[m].PixelSize;
+		}
+
+		// Smallest mip chain that covers requested size
+		int wantedMipCount = streaming.TailMipCount;
+
+		while (wantedMipCount < streaming.MipCount && nsMath::Max(streaming.Mips[wantedMipCount - 1].Width, streaming.Mips[wantedMipCount - 1].Height) < requestedSize)
+		{
+			++wantedMipCount;
+		}
+
+		if (streaming.bStreaming)
+		{
+			continue;
+		}
+
+		if (wantedMipCount > streaming.ResidentMipCount)
+		{
+			RequestTextureMipStream(i, wantedMipCount);
+		}
+		else if (wantedMipCount < streaming.ResidentMipCount)
+		{
+			dropCandidates.Add(nsAssetTextureDropCandidate{ i, wantedMipCount, streaming.RequestedFrame });
+		}
+	}
+
+	if (TextureStreamingBytes <= TextureStreamingBudget || dropCandidates.GetCount() == 0)
+	{
+		return;
+	}
+
+	const uint64 targetBytes = static_cast<uint64>(static_cast<double>(TextureStreamingBudget) * NS_ENGINE_ASSET_RESIDENCY_EVICT_TARGET_RATIO);
+
+	nsAlgorithm::Sort(dropCandidates.GetData(), dropCandidates.GetCount(), [](const nsAssetTextureDropCandidate& a, const nsAssetTextureDropCandidate& b)
+	{
+		return a.RequestedFrame < b.RequestedFrame;
+	});
+
+	int droppedCount = 0;
+
+	for (int i = 0; i < dropCandidates.GetCount() && TextureStreamingBytes > targetBytes; ++i)
+	{
+		const nsAssetTextureDropCandidate& candidate = dropCandidates[i];
+		const TextureStreaming& streaming = TextureStreamings[candidate.Index];
+
+		for (int m = candidate.KeepMipCount; m < streaming.ResidentMipCount; ++m)
+		{
+			TextureStreamingBytes -= streaming.Mips[m].PixelSize;
 		}
+
+		DropTextureMips(candidate.Index, candidate.KeepMipCount);
+		++droppedCount;
 	}
+
+	NS_CONSOLE_Log(AssetLog, TEXT("Dropped top mips of %i textures (Streamed mips: %llu KiB)"), droppedCount, TextureStreamingBytes / 1024);
 }
 
 
@@ -379,7 +1891,7 @@ nsSharedMaterialAsset nsAssetManager::LoadMaterialAsset(const nsName& name)
 		return nsSharedMaterialAsset();
 	}
 
-	const int index = MaterialAsset.Names.Find(name);
+	const int index = MaterialAsset.Find(name);
 
 	if (index == NS_ARRAY_INDEX_INVALID)
 	{
@@ -396,9 +1908,9 @@ nsSharedMaterialAsset nsAssetManager::LoadMaterialAsset(const nsName& name)
 
 	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *MaterialAsset.Paths[index], *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
 
-	nsTArray<uint8> bytes;
+	nsFileMappedView fileView;
 
-	if (!nsFileSystem::FileReadBinary(assetFile, bytes))
+	if (!nsFileSystem::FileMap(assetFile, fileView))
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load material asset. Read data from asset file [%s] failed!"), *assetFile);
 		return nsSharedMaterialAsset();
@@ -406,7 +1918,7 @@ nsSharedMaterialAsset nsAssetManager::LoadMaterialAsset(const nsName& name)
 
 
 	// Read data
-	nsBinaryStreamReader reader(bytes);
+	nsBinaryStreamReader reader(fileView.Data, fileView.Size);
 	{
 		nsAssetFileHeader header{};
 		reader | header;
@@ -429,13 +1941,13 @@ nsSharedMaterialAsset nsAssetManager::LoadMaterialAsset(const nsName& name)
 
 void nsAssetManager::Internal_AddMaterialAssetReference(int index, nsMaterialID material)
 {
-	MaterialAsset.AddReference(index, material);
+	MaterialAsset.AddReference(index);
 }
 
 
 void nsAssetManager::Internal_RemoveMaterialAssetReference(int index, nsMaterialID material)
 {
-	if (MaterialAsset.RemoveReference(index, material) == 0)
+	if (MaterialAsset.RemoveReference(index, ResidencyFrame) == 0)
 	{
 		NS_CONSOLE_Debug(AssetLog, TEXT("Mark material asset [%s] pending unload (RefCount = 0)"), *MaterialAsset.Names[index].ToString());
 	}
@@ -467,11 +1979,25 @@ void nsAssetManager::UpdateMaterialAssets()
 // ====================================================================================================================================================================== //
 // MODEL
 // ====================================================================================================================================================================== //
-void nsAssetManager::SaveModelAsset(nsName name, const nsAssetModelMeshes& meshes, const nsString& folderPath, bool bIsEngineAsset)
+bool nsAssetManager::WriteModelAssetFile(const nsString& assetFile, const nsMeshLODGroup* const* lodGroups, int meshCount, nsECompression compression) const
+{
+	nsBinaryStreamWriter writer;
+	writer | meshCount;
+
+	for (int i = 0; i < meshCount; ++i)
+	{
+		writer | const_cast<nsMeshLODGroup&>(*lodGroups[i]);
+	}
+
+	return WriteAssetFile(assetFile, nsEAssetType::MODEL, writer, compression);
+}
+
+
+void nsAssetManager::SaveModelAsset(nsName name, const nsAssetModelMeshes& meshes, const nsString& folderPath, bool bIsEngineAsset, nsECompression compression)
 {
 	const nsString assetPath = nsString::Format(TEXT("%s/%s"), bIsEngineAsset ? *EngineAssetsPath : *GameAssetsPath, *folderPath);
 
-	if (ModelAsset.Names.Find(name) != NS_ARRAY_INDEX_INVALID)
+	if (ModelAsset.Find(name) != NS_ARRAY_INDEX_INVALID)
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save model asset. Model asset with name [%s] already exists!"), *name.ToString());
 		return;
@@ -484,33 +2010,17 @@ void nsAssetManager::SaveModelAsset(nsName name, const nsAssetModelMeshes& meshe
 	}
 
 
-	// Write data
-	nsBinaryStreamWriter writer;
-	{
-		nsAssetFileHeader header;
-		header.Signature = NS_ENGINE_ASSET_FILE_SIGNATURE;
-		header.Version = NS_ENGINE_ASSET_FILE_VERSION;
-		header.Type = static_cast<int>(nsEAssetType::MODEL);
-		header.Compression = 0;
-
-		writer | header;
-
-		int meshCount = meshes.GetCount();
-		writer | meshCount;
-
-		nsMeshManager& meshManager = nsMeshManager::Get();
+	nsMeshManager& meshManager = nsMeshManager::Get();
+	const nsMeshLODGroup* lodGroups[NS_ENGINE_ASSET_MODEL_MAX_MESH];
 
-		for (int i = 0; i < meshCount; ++i)
-		{
-			nsMeshLODGroup& lodGroup = meshManager.GetMeshLodGroup(meshes[i]);
-			writer | lodGroup;
-		}
+	for (int i = 0; i < meshes.GetCount(); ++i)
+	{
+		lodGroups[i] = &meshManager.GetMeshLodGroup(meshes[i]);
 	}
-	
 
 	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *assetPath, *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
 
-	if (!nsFileSystem::FileWriteBinary(assetFile, writer.GetBuffer()))
+	if (!WriteModelAssetFile(assetFile, lodGroups, meshes.GetCount(), compression))
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save model asset [%s] to file [%s]"), *name.ToString(), *assetFile);
 		return;
@@ -518,6 +2028,7 @@ void nsAssetManager::SaveModelAsset(nsName name, const nsAssetModelMeshes& meshe
 
 	NS_CONSOLE_Log(AssetLog, TEXT("Model asset [%s] saved to file [%s]"), *name.ToString(), *assetFile);
 	ModelAsset.Add(name, assetPath, AssetFlag_Loaded, meshes);
+	UpdateAssetMemorySize(nsEAssetType::MODEL, ModelAsset.Names.GetCount() - 1);
 }
 
 
@@ -528,7 +2039,7 @@ nsSharedModelAsset nsAssetManager::LoadModelAsset(const nsName& name)
 		return nsSharedModelAsset();
 	}
 
-	const int index = ModelAsset.Names.Find(name);
+	const int index = ModelAsset.Find(name);
 
 	if (index == NS_ARRAY_INDEX_INVALID)
 	{
@@ -539,49 +2050,44 @@ nsSharedModelAsset nsAssetManager::LoadModelAsset(const nsName& name)
 	if (ModelAsset.Handles[index].GetCount() > 0)
 	{
 		ModelAsset.Flags[index] = AssetFlag_Loaded;
-		return nsSharedModelAsset(index, name, ModelAsset.Handles[index]);
+		return nsSharedModelAsset(index, name);
 	}
 
-	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *ModelAsset.Paths[index], *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
-
-	nsTArray<uint8> bytes;
-
-	if (!nsFileSystem::FileReadBinary(assetFile, bytes))
+	if (!LoadAssetImmediate(nsEAssetType::MODEL, index))
 	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load model asset. Read data from asset file [%s] failed!"), *assetFile);
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load model asset [%s]!"), *name.ToString());
 		return nsSharedModelAsset();
 	}
 
+	return nsSharedModelAsset(index, name);
+}
 
-	// Read data
-	nsBinaryStreamReader reader(bytes);
-	{
-		nsAssetFileHeader header{};
-		reader | header;
-
-		NS_Validate(header.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE && header.Type == static_cast<int>(nsEAssetType::MODEL));
-
-		int meshCount = 0;
-		reader | meshCount;
-
-		nsMeshManager& meshManager = nsMeshManager::Get();
-
-		for (int i = 0; i < meshCount; ++i)
-		{
-			const nsMeshID mesh = meshManager.CreateMesh(name);
-			nsMeshLODGroup& lodGroup = meshManager.GetMeshLodGroup(mesh);
-			reader | lodGroup;
 
-			ModelAsset.Handles[index].Add(mesh);
-		}
+nsSharedModelAsset nsAssetManager::LoadModelAssetAsync(const nsName& name, nsEAssetLoadPriority priority)
+{
+	if (name.GetLength() == 0)
+	{
+		return nsSharedModelAsset();
 	}
 
+	const int index = ModelAsset.Find(name);
 
-	ModelAsset.Flags[index] = AssetFlag_Loaded;
+	if (index == NS_ARRAY_INDEX_INVALID)
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load model asset. Model asset with name [%s] not found!"), *name.ToString());
+		return nsSharedModelAsset();
+	}
 
-	NS_CONSOLE_Debug(AssetLog, TEXT("Loaded model asset [%s]"), *name.ToString());
+	if (ModelAsset.Handles[index].GetCount() > 0)
+	{
+		ModelAsset.Flags[index] = AssetFlag_Loaded;
+	}
+	else
+	{
+		RequestAsyncLoad(nsEAssetType::MODEL, index, priority);
+	}
 
-	return nsSharedModelAsset(index, name, ModelAsset.Handles[index]);
+	return nsSharedModelAsset(index, name);
 }
 
 
@@ -600,35 +2106,29 @@ void nsAssetManager::Internal_RemoveModelAssetReference(int index)
 	{
 		ModelAsset.RefCounts[index] = 0;
 		ModelAsset.Flags[index] |= AssetFlag_PendingUnload;
+		ModelAsset.ReleasedFrames[index] = ResidencyFrame;
 		NS_CONSOLE_Debug(AssetLog, TEXT("Mark model asset [%s] pending unload (RefCount = 0)"), *ModelAsset.Names[index].ToString());
 	}
 }
 
 
-void nsAssetManager::UpdateModelAssets()
+void nsAssetManager::UnloadModelAsset(int index)
 {
-	for (int i = 0; i < ModelAsset.Flags.GetCount(); ++i)
-	{
-		uint8& flags = ModelAsset.Flags[i];
-
-		if (flags & AssetFlag_PendingUnload)
-		{
-			NS_Assert(ModelAsset.RefCounts[i] == 0);
-			NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded model asset [%s]"), *ModelAsset.Names[i].ToString());
-			flags = AssetFlag_Unloaded;
-			ModelAsset.RefCounts[i] = 0;
+	NS_Assert(ModelAsset.RefCounts[index] == 0);
 
-			const int meshCount = ModelAsset.Handles[i].GetCount();
-			NS_Assert(meshCount > 0);
+	const int meshCount = ModelAsset.Handles[index].GetCount();
+	NS_Assert(meshCount > 0);
 
-			for (int m = 0; m < meshCount; ++m)
-			{
-				nsMeshManager::Get().DestroyMesh(ModelAsset.Handles[i][m]);
-			}
+	ModelAsset.Flags[index] = AssetFlag_Unloaded;
+	ModelAsset.MemorySizes[index] = MemorySize{ 0, 0 };
+	NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded model asset [%s]"), *ModelAsset.Names[index].ToString());
 
-			ModelAsset.Handles[i].Clear();
-		}
+	for (int m = 0; m < meshCount; ++m)
+	{
+		nsMeshManager::Get().DestroyMesh(ModelAsset.Handles[index][m]);
 	}
+
+	ModelAsset.Handles[index].Clear();
 }
 
 
@@ -637,13 +2137,22 @@ void nsAssetManager::UpdateModelAssets()
 // ====================================================================================================================================================================== //
 // SKELETON
 // ====================================================================================================================================================================== //
+bool nsAssetManager::WriteSkeletonAssetFile(const nsString& assetFile, const nsAnimationSkeletonData& data) const
+{
+	nsBinaryStreamWriter writer;
+	writer | const_cast<nsAnimationSkeletonData&>(data);
+
+	return WriteAssetFile(assetFile, nsEAssetType::SKELETON, writer, nsECompression::NONE);
+}
+
+
 void nsAssetManager::SaveSkeletonAsset(nsName name, nsAnimationSkeletonID skeleton, const nsString& folderPath, bool bIsEngineAsset)
 {
 	nsAnimationManager& animationManager = nsAnimationManager::Get();
 	const nsName assetName = animationManager.GetSkeletonName(skeleton);
 	const nsString assetPath = nsString::Format(TEXT("%s/%s"), bIsEngineAsset ? *EngineAssetsPath : *GameAssetsPath, *folderPath);
 
-	if (SkeletonAsset.Names.Find(assetName) != NS_ARRAY_INDEX_INVALID)
+	if (SkeletonAsset.Find(assetName) != NS_ARRAY_INDEX_INVALID)
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save skeleton asset. Skeleton asset with name [%s] already exists!"), *assetName.ToString());
 		return;
@@ -656,25 +2165,9 @@ void nsAssetManager::SaveSkeletonAsset(nsName name, nsAnimationSkeletonID skelet
 	}
 
 
-	// Write data
-	nsBinaryStreamWriter writer;
-	{
-		nsAssetFileHeader header;
-		header.Signature = NS_ENGINE_ASSET_FILE_SIGNATURE;
-		header.Version = NS_ENGINE_ASSET_FILE_VERSION;
-		header.Type = static_cast<int>(nsEAssetType::SKELETON);
-		header.Compression = 0;
-
-		writer | header;
-
-		nsAnimationSkeletonData& data = animationManager.GetSkeletonData(skeleton);
-		writer | data;
-	}
-
-
 	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *assetPath, *assetName.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
 
-	if (!nsFileSystem::FileWriteBinary(assetFile, writer.GetBuffer()))
+	if (!WriteSkeletonAssetFile(assetFile, animationManager.GetSkeletonData(skeleton)))
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save skeleton [%s] to asset file [%s]"), *assetName.ToString(), *assetFile);
 		return;
@@ -682,6 +2175,7 @@ void nsAssetManager::SaveSkeletonAsset(nsName name, nsAnimationSkeletonID skelet
 
 	NS_CONSOLE_Log(AssetLog, TEXT("Skeleton [%s] saved to asset file [%s]"), *assetName.ToString(), *assetFile);
 	SkeletonAsset.Add(assetName, assetPath, AssetFlag_Loaded, skeleton);
+	UpdateAssetMemorySize(nsEAssetType::SKELETON, SkeletonAsset.Names.GetCount() - 1);
 }
 
 
@@ -692,7 +2186,7 @@ nsSharedSkeletonAsset nsAssetManager::LoadSkeletonAsset(const nsName& name)
 		return nsSharedSkeletonAsset();
 	}
 
-	const int index = SkeletonAsset.Names.Find(name);
+	const int index = SkeletonAsset.Find(name);
 
 	if (index == NS_ARRAY_INDEX_INVALID)
 	{
@@ -703,77 +2197,72 @@ nsSharedSkeletonAsset nsAssetManager::LoadSkeletonAsset(const nsName& name)
 	if (SkeletonAsset.Handles[index] != nsAnimationSkeletonID::INVALID)
 	{
 		SkeletonAsset.Flags[index] = AssetFlag_Loaded;
-		return nsSharedSkeletonAsset(index, name, SkeletonAsset.Handles[index]);
+		return nsSharedSkeletonAsset(index, name);
 	}
 
+	if (!LoadAssetImmediate(nsEAssetType::SKELETON, index))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load skeleton asset [%s]!"), *name.ToString());
+		return nsSharedSkeletonAsset();
+	}
 
-	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *SkeletonAsset.Paths[index], *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
+	return nsSharedSkeletonAsset(index, name);
+}
 
-	nsTArray<uint8> bytes;
 
-	if (!nsFileSystem::FileReadBinary(assetFile, bytes))
+nsSharedSkeletonAsset nsAssetManager::LoadSkeletonAssetAsync(const nsName& name, nsEAssetLoadPriority priority)
+{
+	if (name.GetLength() == 0)
 	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load skeleton asset. Read data from asset file [%s] failed!"), *assetFile);
 		return nsSharedSkeletonAsset();
 	}
 
+	const int index = SkeletonAsset.Find(name);
 
-	// Read data
-	nsBinaryStreamReader reader(bytes);
+	if (index == NS_ARRAY_INDEX_INVALID)
 	{
-		nsAssetFileHeader header{};
-		reader | header;
-
-		NS_Validate(header.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE && header.Type == static_cast<int>(nsEAssetType::SKELETON));
-
-		nsAnimationManager& animationManager = nsAnimationManager::Get();
-		SkeletonAsset.Handles[index] = animationManager.CreateSkeleton(name);
-
-		nsAnimationSkeletonData& data = animationManager.GetSkeletonData(SkeletonAsset.Handles[index]);
-		reader | data;
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load skeleton asset. Skeleton asset with name [%s] not found!"), *name.ToString());
+		return nsSharedSkeletonAsset();
 	}
 
+	if (SkeletonAsset.Handles[index] != nsAnimationSkeletonID::INVALID)
+	{
+		SkeletonAsset.Flags[index] = AssetFlag_Loaded;
+	}
+	else
+	{
+		RequestAsyncLoad(nsEAssetType::SKELETON, index, priority);
+	}
 
-	SkeletonAsset.Flags[index] = AssetFlag_Loaded;
-
-	NS_CONSOLE_Debug(AssetLog, TEXT("Loaded skeleton asset [%s]"), *name.ToString());
-
-	return nsSharedSkeletonAsset(index, name, SkeletonAsset.Handles[index]);
+	return nsSharedSkeletonAsset(index, name);
 }
 
 
-void nsAssetManager::Internal_AddSkeletonAssetReference(int index, nsAnimationSkeletonID skeleton)
+void nsAssetManager::Internal_AddSkeletonAssetReference(int index)
 {
-	SkeletonAsset.AddReference(index, skeleton);
+	SkeletonAsset.AddReference(index);
 }
 
 
-void nsAssetManager::Internal_RemoveSkeletonAssetReference(int index, nsAnimationSkeletonID skeleton)
+void nsAssetManager::Internal_RemoveSkeletonAssetReference(int index)
 {
-	if (SkeletonAsset.RemoveReference(index, skeleton) == 0)
+	if (SkeletonAsset.RemoveReference(index, ResidencyFrame) == 0)
 	{
 		NS_CONSOLE_Debug(AssetLog, TEXT("Mark skeleton asset [%s] pending unload (RefCount = 0)"), *SkeletonAsset.Names[index].ToString());
 	}
 }
 
 
-void nsAssetManager::UpdateSkeletonAssets()
+void nsAssetManager::UnloadSkeletonAsset(int index)
 {
-	for (int i = 0; i < SkeletonAsset.Flags.GetCount(); ++i)
-	{
-		uint8& flags = SkeletonAsset.Flags[i];
-
-		if (flags & AssetFlag_PendingUnload)
-		{
-			NS_Assert(SkeletonAsset.RefCounts[i] == 0);
-			NS_Assert(SkeletonAsset.Handles[i].IsValid());
-
-			flags = AssetFlag_Unloaded;
-			SkeletonAsset.RefCounts[i] = 0;
-			NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded skeleton asset [%s]"), *SkeletonAsset.Names[i].ToString());
-			nsAnimationManager::Get().DestroySkeleton(SkeletonAsset.Handles[i]);
-		}
-	}
+	NS_Assert(SkeletonAsset.RefCounts[index] == 0);
+	NS_Assert(SkeletonAsset.Handles[index].IsValid());
+
+	SkeletonAsset.Flags[index] = AssetFlag_Unloaded;
+	SkeletonAsset.MemorySizes[index] = MemorySize{ 0, 0 };
+	NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded skeleton asset [%s]"), *SkeletonAsset.Names[index].ToString());
+	nsAnimationManager::Get().DestroySkeleton(SkeletonAsset.Handles[index]);
+	SkeletonAsset.Handles[index] = nsAnimationSkeletonID::INVALID;
 }
 
 
@@ -782,13 +2271,22 @@ void nsAssetManager::UpdateSkeletonAssets()
 // ====================================================================================================================================================================== //
 // ANIMATION
 // ====================================================================================================================================================================== //
-void nsAssetManager::SaveAnimationAsset(nsName name, nsAnimationClipID clip, const nsString& folderPath, bool bIsEngineAsset)
+bool nsAssetManager::WriteAnimationAssetFile(const nsString& assetFile, const nsAnimationClipData& data, nsECompression compression) const
+{
+	nsBinaryStreamWriter writer;
+	writer | const_cast<nsAnimationClipData&>(data);
+
+	return WriteAssetFile(assetFile, nsEAssetType::ANIMATION, writer, compression);
+}
+
+
+void nsAssetManager::SaveAnimationAsset(nsName name, nsAnimationClipID clip, const nsString& folderPath, bool bIsEngineAsset, nsECompression compression)
 {
 	nsAnimationManager& animationManager = nsAnimationManager::Get();
 	const nsName assetName = animationManager.GetClipName(clip);
 	const nsString assetPath = nsString::Format(TEXT("%s/%s"), bIsEngineAsset ? *EngineAssetsPath : *GameAssetsPath, *folderPath);
 
-	if (AnimationAsset.Names.Find(assetName) != NS_ARRAY_INDEX_INVALID)
+	if (AnimationAsset.Find(assetName) != NS_ARRAY_INDEX_INVALID)
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save animation asset. Animation asset with name [%s] already exists!"), *assetName.ToString());
 		return;
@@ -801,25 +2299,9 @@ void nsAssetManager::SaveAnimationAsset(nsName name, nsAnimationClipID clip, con
 	}
 
 
-	// Write data
-	nsBinaryStreamWriter writer;
-	{
-		nsAssetFileHeader header;
-		header.Signature = NS_ENGINE_ASSET_FILE_SIGNATURE;
-		header.Version = NS_ENGINE_ASSET_FILE_VERSION;
-		header.Type = static_cast<int>(nsEAssetType::ANIMATION);
-		header.Compression = 0;
-
-		writer | header;
-
-		nsAnimationClipData& data = animationManager.GetClipData(clip);
-		writer | data;
-	}
-
-
 	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *assetPath, *assetName.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
 
-	if (!nsFileSystem::FileWriteBinary(assetFile, writer.GetBuffer()))
+	if (!WriteAnimationAssetFile(assetFile, animationManager.GetClipData(clip), compression))
 	{
 		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to save animation [%s] to asset file [%s]"), *assetName.ToString(), *assetFile);
 		return;
@@ -827,6 +2309,7 @@ void nsAssetManager::SaveAnimationAsset(nsName name, nsAnimationClipID clip, con
 
 	NS_CONSOLE_Log(AssetLog, TEXT("Animation [%s] saved to asset file [%s]"), *assetName.ToString(), *assetFile);
 	AnimationAsset.Add(assetName, assetPath, AssetFlag_Loaded, clip);
+	UpdateAssetMemorySize(nsEAssetType::ANIMATION, AnimationAsset.Names.GetCount() - 1);
 }
 
 
@@ -837,7 +2320,7 @@ nsSharedAnimationAsset nsAssetManager::LoadAnimationAsset(const nsName& name)
 		return nsSharedAnimationAsset();
 	}
 
-	const int index = AnimationAsset.Names.Find(name);
+	const int index = AnimationAsset.Find(name);
 
 	if (index == NS_ARRAY_INDEX_INVALID)
 	{
@@ -848,75 +2331,70 @@ nsSharedAnimationAsset nsAssetManager::LoadAnimationAsset(const nsName& name)
 	if (AnimationAsset.Handles[index] != nsAnimationClipID::INVALID)
 	{
 		AnimationAsset.Flags[index] = AssetFlag_Loaded;
-		return nsSharedAnimationAsset(index, name, AnimationAsset.Handles[index]);
+		return nsSharedAnimationAsset(index, name);
 	}
 
+	if (!LoadAssetImmediate(nsEAssetType::ANIMATION, index))
+	{
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load animation asset [%s]!"), *name.ToString());
+		return nsSharedAnimationAsset();
+	}
 
-	const nsString assetFile = nsString::Format(TEXT("%s/%s%s"), *AnimationAsset.Paths[index], *name.ToString(), NS_ENGINE_ASSET_FILE_EXTENSION);
+	return nsSharedAnimationAsset(index, name);
+}
 
-	nsTArray<uint8> bytes;
 
-	if (!nsFileSystem::FileReadBinary(assetFile, bytes))
+nsSharedAnimationAsset nsAssetManager::LoadAnimationAssetAsync(const nsName& name, nsEAssetLoadPriority priority)
+{
+	if (name.GetLength() == 0)
 	{
-		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load animation asset. Read data from asset file [%s] failed!"), *assetFile);
 		return nsSharedAnimationAsset();
 	}
 
+	const int index = AnimationAsset.Find(name);
 
-	// Read data
-	nsBinaryStreamReader reader(bytes);
+	if (index == NS_ARRAY_INDEX_INVALID)
 	{
-		nsAssetFileHeader header{};
-		reader | header;
-
-		NS_Validate(header.Signature == NS_ENGINE_ASSET_FILE_SIGNATURE && header.Type == static_cast<int>(nsEAssetType::ANIMATION));
-
-		nsAnimationManager& animationManager = nsAnimationManager::Get();
-		AnimationAsset.Handles[index] = animationManager.CreateClip(name);
-
-		nsAnimationClipData& data = animationManager.GetClipData(AnimationAsset.Handles[index]);
-		reader | data;
+		NS_CONSOLE_Warning(AssetLog, TEXT("Fail to load animation asset. Animation asset with name [%s] not found!"), *name.ToString());
+		return nsSharedAnimationAsset();
 	}
 
+	if (AnimationAsset.Handles[index] != nsAnimationClipID::INVALID)
+	{
+		AnimationAsset.Flags[index] = AssetFlag_Loaded;
+	}
+	else
+	{
+		RequestAsyncLoad(nsEAssetType::ANIMATION, index, priority);
+	}
 
-	AnimationAsset.Flags[index] = AssetFlag_Loaded;
-
-	NS_CONSOLE_Debug(AssetLog, TEXT("Loaded animation asset [%s]"), *name.ToString());
-
-	return nsSharedAnimationAsset(index, name, AnimationAsset.Handles[index]);
+	return nsSharedAnimationAsset(index, name);
 }
 
 
-void nsAssetManager::Internal_AddAnimationAssetReference(int index, nsAnimationClipID clip)
+void nsAssetManager::Internal_AddAnimationAssetReference(int index)
 {
-	AnimationAsset.AddReference(index, clip);
+	AnimationAsset.AddReference(index);
 }
 
 
-void nsAssetManager::Internal_RemoveAnimationAssetReference(int index, nsAnimationClipID clip)
+void nsAssetManager::Internal_RemoveAnimationAssetReference(int index)
 {
-	if (AnimationAsset.RemoveReference(index, clip) == 0)
+	if (AnimationAsset.RemoveReference(index, ResidencyFrame) == 0)
 	{
 		NS_CONSOLE_Debug(AssetLog, TEXT("Mark animation asset [%s] pending unload (RefCount = 0)"), *AnimationAsset.Names[index].ToString());
 	}
 }
 
 
-void nsAssetManager::UpdateAnimationAssets()
+void nsAssetManager::UnloadAnimationAsset(int index)
 {
-	for (int i = 0; i < AnimationAsset.Flags.GetCount(); ++i)
-	{
-		uint8& flags = AnimationAsset.Flags[i];
-
-		if (flags & AssetFlag_PendingUnload)
-		{
-			NS_Assert(AnimationAsset.RefCounts[i] == 0);
-			NS_Assert(AnimationAsset.Handles[i].IsValid());
-
-			flags = AssetFlag_Unloaded;
-			AnimationAsset.RefCounts[i] = 0;
-			NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded animation asset [%s]"), *AnimationAsset.Names[i].ToString());
-			nsAnimationManager::Get().DestroyClip(AnimationAsset.Handles[i]);
-		}
-	}
+	NS_Assert(AnimationAsset.RefCounts[index] == 0);
+	NS_Assert(AnimationAsset.Handles[index].IsValid());
+
+	AnimationAsset.Flags[index] = AssetFlag_Unloaded;
+	AnimationAsset.MemorySizes[index] = MemorySize{ 0, 0 };
+	NS_CONSOLE_Debug(AssetLog, TEXT("Unloaded animation asset [%s]"), *AnimationAsset.Names[index].ToString());
+	nsAnimationManager::Get().DestroyClip(AnimationAsset.Handles[index]);
+	AnimationAsset.Handles[index] = nsAnimationClipID::INVALID;
 }
@@ -13,7 +13,6 @@ nsLogCategory AssetLog(TEXT("nsAssetLog"), nsELogVerbosity::LV_DEBUG);
 nsSharedTextureAsset::nsSharedTextureAsset() noexcept
 	: AssetId(-1)
 	, Name("")
-	, Texture(nsTextureID::INVALID)
 {
 }
 
@@ -21,7 +20,6 @@ nsSharedTextureAsset::nsSharedTextureAsset() noexcept
 nsSharedTextureAsset::nsSharedTextureAsset(const nsSharedTextureAsset& other) noexcept
 	: AssetId(-1)
 	, Name("")
-	, Texture(nsTextureID::INVALID)
 {
 	Copy(other);
 }
@@ -30,11 +28,9 @@ nsSharedTextureAsset::nsSharedTextureAsset(const nsSharedTextureAsset& other) no
 nsSharedTextureAsset::nsSharedTextureAsset(nsSharedTextureAsset&& other) noexcept
 	: AssetId(other.AssetId)
 	, Name(other.Name)
-	, Texture(other.Texture)
 {
 	other.AssetId = -1;
 	other.Name = "";
-	other.Texture = nsTextureID::INVALID;
 }
 
 
@@ -44,15 +40,13 @@ nsSharedTextureAsset::~nsSharedTextureAsset() noexcept
 }
 
 
-nsSharedTextureAsset::nsSharedTextureAsset(int assetId, nsName name, nsTextureID texture) noexcept
+nsSharedTextureAsset::nsSharedTextureAsset(int assetId, nsName name) noexcept
 	: AssetId(assetId)
 	, Name(name)
-	, Texture(texture)
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Texture.IsValid());
-		nsAssetManager::Get().Internal_AddTextureAssetReference(AssetId, Texture);
+		nsAssetManager::Get().Internal_AddTextureAssetReference(AssetId);
 	}
 }
 
@@ -63,12 +57,10 @@ void nsSharedTextureAsset::Copy(const nsSharedTextureAsset& other) noexcept
 
 	AssetId = other.AssetId;
 	Name = other.Name;
-	Texture = other.Texture;
 
 	if (AssetId != -1)
 	{
-		NS_Assert(Texture.IsValid());
-		nsAssetManager::Get().Internal_AddTextureAssetReference(AssetId, Texture);
+		nsAssetManager::Get().Internal_AddTextureAssetReference(AssetId);
 	}
 }
 
@@ -77,13 +69,38 @@ void nsSharedTextureAsset::Release() noexcept
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Texture.IsValid());
-		nsAssetManager::Get().Internal_RemoveTextureAssetReference(AssetId, Texture);
+		nsAssetManager::Get().Internal_RemoveTextureAssetReference(AssetId);
 	}
 
 	AssetId = -1;
 	Name = "";
-	Texture = nsTextureID::INVALID;
+}
+
+
+bool nsSharedTextureAsset::IsValid() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsTextureAssetLoaded(AssetId);
+}
+
+
+bool nsSharedTextureAsset::IsLoading() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsTextureAssetLoading(AssetId);
+}
+
+
+nsTextureID nsSharedTextureAsset::GetTexture() const noexcept
+{
+	return AssetId != -1 ? nsAssetManager::Get().Internal_GetTextureAssetHandle(AssetId) : nsTextureID::INVALID;
+}
+
+
+void nsSharedTextureAsset::RequestScreenSize(int screenSize) const noexcept
+{
+	if (AssetId != -1)
+	{
+		nsAssetManager::Get().Internal_RequestTextureAssetScreenSize(AssetId, screenSize);
+	}
 }
 
 
@@ -177,16 +194,13 @@ void nsSharedMaterialAsset::Release() noexcept
 nsSharedModelAsset::nsSharedModelAsset() noexcept
 	: AssetId(-1)
 	, Name("")
-	, Meshes()
 {
-
 }
 
 
 nsSharedModelAsset::nsSharedModelAsset(const nsSharedModelAsset& other) noexcept
 	: AssetId(-1)
 	, Name("")
-	, Meshes()
 {
 	Copy(other);
 }
@@ -195,11 +209,9 @@ nsSharedModelAsset::nsSharedModelAsset(const nsSharedModelAsset& other) noexcept
 nsSharedModelAsset::nsSharedModelAsset(nsSharedModelAsset&& other) noexcept
 	: AssetId(other.AssetId)
 	, Name(other.Name)
-	, Meshes(other.Meshes)
 {
 	other.AssetId = -1;
 	other.Name = "";
-	other.Meshes.Clear();
 }
 
 
@@ -209,14 +221,12 @@ nsSharedModelAsset::~nsSharedModelAsset() noexcept
 }
 
 
-nsSharedModelAsset::nsSharedModelAsset(int assetId, nsName name, nsAssetModelMeshes meshes) noexcept
+nsSharedModelAsset::nsSharedModelAsset(int assetId, nsName name) noexcept
 	: AssetId(assetId)
 	, Name(name)
-	, Meshes(meshes)
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Meshes.GetCount() > 0);
 		nsAssetManager::Get().Internal_AddModelAssetReference(AssetId);
 	}
 }
@@ -228,11 +238,9 @@ void nsSharedModelAsset::Copy(const nsSharedModelAsset& other) noexcept
 
 	AssetId = other.AssetId;
 	Name = other.Name;
-	Meshes = other.Meshes;
 
 	if (AssetId != -1)
 	{
-		NS_Assert(Meshes.GetCount() > 0);
 		nsAssetManager::Get().Internal_AddModelAssetReference(AssetId);
 	}
 }
@@ -242,13 +250,30 @@ void nsSharedModelAsset::Release() noexcept
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Meshes.GetCount() > 0);
 		nsAssetManager::Get().Internal_RemoveModelAssetReference(AssetId);
 	}
 
 	AssetId = -1;
 	Name = "";
-	Meshes.Clear();
+}
+
+
+bool nsSharedModelAsset::IsValid() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsModelAssetLoaded(AssetId);
+}
+
+
+bool nsSharedModelAsset::IsLoading() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsModelAssetLoading(AssetId);
+}
+
+
+const nsAssetModelMeshes& nsSharedModelAsset::GetMeshes() const noexcept
+{
+	static const nsAssetModelMeshes EMPTY_MESHES;
+	return AssetId != -1 ? nsAssetManager::Get().Internal_GetModelAssetHandle(AssetId) : EMPTY_MESHES;
 }
 
 
@@ -260,7 +285,6 @@ void nsSharedModelAsset::Release() noexcept
 nsSharedSkeletonAsset::nsSharedSkeletonAsset() noexcept
 	: AssetId(-1)
 	, Name("")
-	, Skeleton(nsAnimationSkeletonID::INVALID)
 {
 }
 
@@ -268,7 +292,6 @@ nsSharedSkeletonAsset::nsSharedSkeletonAsset() noexcept
 nsSharedSkeletonAsset::nsSharedSkeletonAsset(const nsSharedSkeletonAsset& other) noexcept
 	: AssetId(-1)
 	, Name("")
-	, Skeleton(nsAnimationSkeletonID::INVALID)
 {
 	Copy(other);
 }
@@ -277,11 +300,9 @@ nsSharedSkeletonAsset::nsSharedSkeletonAsset(const nsSharedSkeletonAsset& other)
 nsSharedSkeletonAsset::nsSharedSkeletonAsset(nsSharedSkeletonAsset&& other) noexcept
 	: AssetId(other.AssetId)
 	, Name(other.Name)
-	, Skeleton(other.Skeleton)
 {
 	other.AssetId = -1;
 	other.Name = "";
-	other.Skeleton = nsAnimationSkeletonID::INVALID;
 }
 
 
@@ -291,15 +312,13 @@ nsSharedSkeletonAsset::~nsSharedSkeletonAsset() noexcept
 }
 
 
-nsSharedSkeletonAsset::nsSharedSkeletonAsset(int assetId, nsName name, nsAnimationSkeletonID skeleton) noexcept
+nsSharedSkeletonAsset::nsSharedSkeletonAsset(int assetId, nsName name) noexcept
 	: AssetId(assetId)
 	, Name(name)
-	, Skeleton(skeleton)
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Skeleton.IsValid());
-		nsAssetManager::Get().Internal_AddSkeletonAssetReference(AssetId, Skeleton);
+		nsAssetManager::Get().Internal_AddSkeletonAssetReference(AssetId);
 	}
 }
 
@@ -310,12 +329,10 @@ void nsSharedSkeletonAsset::Copy(const nsSharedSkeletonAsset& other) noexcept
 
 	AssetId = other.AssetId;
 	Name = other.Name;
-	Skeleton = other.Skeleton;
 
 	if (AssetId != -1)
 	{
-		NS_Assert(Skeleton.IsValid());
-		nsAssetManager::Get().Internal_AddSkeletonAssetReference(AssetId, Skeleton);
+		nsAssetManager::Get().Internal_AddSkeletonAssetReference(AssetId);
 	}
 }
 
@@ -324,16 +341,31 @@ void nsSharedSkeletonAsset::Release() noexcept
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Skeleton.IsValid());
-		nsAssetManager::Get().Internal_RemoveSkeletonAssetReference(AssetId, Skeleton);
+		nsAssetManager::Get().Internal_RemoveSkeletonAssetReference(AssetId);
 	}
 
 	AssetId = -1;
 	Name = "";
-	Skeleton = nsAnimationSkeletonID::INVALID;
 }
 
 
+bool nsSharedSkeletonAsset::IsValid() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsSkeletonAssetLoaded(AssetId);
+}
+
+
+bool nsSharedSkeletonAsset::IsLoading() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsSkeletonAssetLoading(AssetId);
+}
+
+
+nsAnimationSkeletonID nsSharedSkeletonAsset::GetSkeleton() const noexcept
+{
+	return AssetId != -1 ? nsAssetManager::Get().Internal_GetSkeletonAssetHandle(AssetId) : nsAnimationSkeletonID::INVALID;
+}
+
 
 
 
@@ -343,16 +375,13 @@ void nsSharedSkeletonAsset::Release() noexcept
 nsSharedAnimationAsset::nsSharedAnimationAsset() noexcept
 	: AssetId(-1)
 	, Name("")
-	, Clip(nsAnimationClipID::INVALID)
 {
-
 }
 
 
 nsSharedAnimationAsset::nsSharedAnimationAsset(const nsSharedAnimationAsset& other) noexcept
 	: AssetId(-1)
 	, Name("")
-	, Clip(nsAnimationClipID::INVALID)
 {
 	Copy(other);
 }
@@ -361,12 +390,9 @@ nsSharedAnimationAsset::nsSharedAnimationAsset(const nsSharedAnimationAsset& oth
 nsSharedAnimationAsset::nsSharedAnimationAsset(nsSharedAnimationAsset&& other) noexcept
 	: AssetId(other.AssetId)
 	, Name(other.Name)
-	, Clip(other.Clip)
 {
 	other.AssetId = -1;
 	other.Name = "";
-	other.Clip = nsAnimationClipID::INVALID;
-
 }
 
 
@@ -376,17 +402,14 @@ nsSharedAnimationAsset::~nsSharedAnimationAsset() noexcept
 }
 
 
-nsSharedAnimationAsset::nsSharedAnimationAsset(int assetId, nsName name, nsAnimationClipID clip) noexcept
+nsSharedAnimationAsset::nsSharedAnimationAsset(int assetId, nsName name) noexcept
 	: AssetId(assetId)
 	, Name(name)
-	, Clip(clip)
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Clip.IsValid());
-		nsAssetManager::Get().Internal_AddAnimationAssetReference(AssetId, Clip);
+		nsAssetManager::Get().Internal_AddAnimationAssetReference(AssetId);
 	}
-
 }
 
 
@@ -396,12 +419,10 @@ void nsSharedAnimationAsset::Copy(const nsSharedAnimationAsset& other) noexcept
 
 	AssetId = other.AssetId;
 	Name = other.Name;
-	Clip = other.Clip;
 
 	if (AssetId != -1)
 	{
-		NS_Assert(Clip.IsValid());
-		nsAssetManager::Get().Internal_AddAnimationAssetReference(AssetId, Clip);
+		nsAssetManager::Get().Internal_AddAnimationAssetReference(AssetId);
 	}
 }
 
@@ -410,11 +431,27 @@ void nsSharedAnimationAsset::Release() noexcept
 {
 	if (AssetId != -1)
 	{
-		NS_Assert(Clip.IsValid());
-		nsAssetManager::Get().Internal_RemoveAnimationAssetReference(AssetId, Clip);
+		nsAssetManager::Get().Internal_RemoveAnimationAssetReference(AssetId);
 	}
 
 	AssetId = -1;
 	Name = "";
-	Clip = nsAnimationClipID::INVALID;
+}
+
+
+bool nsSharedAnimationAsset::IsValid() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsAnimationAssetLoaded(AssetId);
+}
+
+
+bool nsSharedAnimationAsset::IsLoading() const noexcept
+{
+	return AssetId != -1 && nsAssetManager::Get().Internal_IsAnimationAssetLoading(AssetId);
+}
+
+
+nsAnimationClipID nsSharedAnimationAsset::GetClip() const noexcept
+{
+	return AssetId != -1 ? nsAssetManager::Get().Internal_GetAnimationAssetHandle(AssetId) : nsAnimationClipID::INVALID;
 }
@@ -17,6 +17,45 @@ nsMemory g_EngineDefaultMemory("engine_default", NS_MEMORY_SIZE_MiB(1), 16);
 
 
 
+static nsMemoryLinear FrameMemories[NS_ENGINE_FRAME_BUFFERING];
+static int FrameMemoryIndex = 0;
+static uint64 FrameMemoryFrameNumber = 0;
+
+
+void nsFrameMemory::Initialize() noexcept
+{
+	for (int i = 0; i < NS_ENGINE_FRAME_BUFFERING; ++i)
+	{
+		FrameMemories[i].Initialize(nsName::Format("frame_memory_%i", i), NS_MEMORY_SIZE_MiB(1));
+	}
+}
+
+
+void nsFrameMemory::BeginFrame() noexcept
+{
+	NS_Validate_IsMainThread();
+
+	FrameMemoryIndex = (FrameMemoryIndex + 1) % NS_ENGINE_FRAME_BUFFERING;
+	FrameMemories[FrameMemoryIndex].Clear(false);
+	FrameMemoryFrameNumber++;
+}
+
+
+nsMemoryLinear& nsFrameMemory::Get() noexcept
+{
+	NS_Assert(nsThreadPool::IsMainThread());
+
+	return FrameMemories[FrameMemoryIndex];
+}
+
+
+uint64 nsFrameMemory::GetFrameNumber() noexcept
+{
+	return FrameMemoryFrameNumber;
+}
+
+
+
 nsEngine::nsEngine() noexcept
 	: GameModuleName("")
 	, GameModuleHandle(nullptr)
@@ -37,6 +76,8 @@ void nsEngine::Initialize()
 {
 	NS_LogInfo(EngineLog, TEXT("Initialize engine"));
 
+	nsFrameMemory::Initialize();
+
 	nsConsoleManager::Get().Initialize();
 	nsPhysicsManager::Get().Initialize();
 	nsRenderManager::Get().Initialize();
@@ -216,6 +257,7 @@ void nsEngine::MainLoop()
 	}
 
 	CalculateAverageFPS();
+	nsFrameMemory::BeginFrame();
 
 
 #if NS_ENGINE_GAME_MODULE_HOTRELOAD
@@ -317,6 +359,8 @@ void nsEngine::Shutdown()
 	{
 		Game->Shutdown();
 	}
+
+	nsAssetManager::Get().Shutdown();
 }
 
 
@@ -29,6 +29,7 @@ struct nsFontData
 static nsTArrayFreeList<stbtt_fontinfo> FontInfos;
 static nsTArrayFreeList<nsFontData> FontDatas;
 static nsTArrayFreeList<nsTextureID> FontTextures;
+static nsFontID DefaultFont;
 static bool bFontManagerInitialized;
 
 
@@ -44,7 +45,7 @@ void nsFontManager::Initialize(const nsString& defaultFontTTFFile, float default
 	FontDatas.Reserve(16);
 	FontTextures.Reserve(16);
 
-	nsFontID defaultFont = CreateFontTTF(defaultFontTTFFile, defaultFontSize);
+	DefaultFont = CreateFontTTF(defaultFontTTFFile, defaultFontSize);
 
 	bFontManagerInitialized = true;
 }
@@ -112,13 +113,13 @@ nsFontID nsFontManager::CreateFontTTF(const nsString& ttfFile, float fontSize)
 		nsTextureManager::Get().UpdateTextureMipData(FontTextures[texId], 0, pixels.GetData(), PIXEL_SIZE);
 	}
 
-	return nsFontID(infoId);
+	return nsFontID(infoId, FontDatas.GetGeneration(infoId));
 }
 
 
 bool nsFontManager::IsFontValid(nsFontID font) noexcept
 {
-	return font.IsValid() && FontDatas.IsValid(font.Id);
+	return font.IsValid() && FontDatas.IsValid(font.Id, font.Generation);
 }
 
 
@@ -237,7 +238,7 @@ float nsFontManager::CalculateCaretPositionX(nsFontID font, const nsString& text
 }
 
 
-int nsFontManager::GenerateVertices(nsFontID font, nsPointFloat& position, const wchar_t* text, int length, const nsColor& color, nsTArray<nsVertexGUI>& outVertices, nsTArray<uint32>& outIndices)
+int nsFontManager::GenerateVertices(nsFontID font, nsPointFloat& position, const wchar_t* text, int length, const nsColor& color, nsTFrameArray<nsVertexGUI>& outVertices, nsTFrameArray<uint32>& outIndices)
 {
 	if (text == nullptr || length <= 0)
 	{
@@ -246,9 +247,6 @@ int nsFontManager::GenerateVertices(nsFontID font, nsPointFloat& position, const
 
 	NS_Assert(IsFontValid(font));
 
-	outVertices.Reserve(outVertices.GetCount() + (length * 4));
-	outIndices.Reserve(outIndices.GetCount() + (length * 6));
-
 	const nsFontData& data = FontDatas[font.Id];
 	const nsPointInt textureDimension = nsTextureManager::Get().GetTextureDimension(FontTextures[font.Id]);
 	position.Y += data.Ascent;
@@ -318,7 +316,8 @@ nsTextureID nsFontManager::GetFontTexture(nsFontID font)
 }
 
 
+// INVALID until Initialize created default font
 nsFontID nsFontManager::GetDefaultFont() noexcept
 {
-	return nsFontID(0);
+	return DefaultFont;
 }
@@ -32,10 +32,7 @@ nsGUIContext::nsGUIContext() noexcept
 	LastHoveredRegionId = -1;
 	CurrentActiveWindowRegionId = -1;
 	CurrentControlInputFocus = nullptr;
-
-	DrawVertices.Reserve(1024);
-	DrawIndices.Reserve(2048);
-	DrawDatas.Reserve(32);
+	DrawFrameNumber = 0;
 
 	for (int i = 0; i < NS_ENGINE_FRAME_BUFFERING; ++i)
 	{
@@ -780,9 +777,13 @@ void nsGUIContext::BeginRender(const nsPointFloat& windowDimension, const nsGUIR
 	RegionStacks.Clear();
 	CurrentRegionId = -1;
 	CurrentControlId = -1;
-	DrawVertices.Clear();
-	DrawIndices.Clear();
-	DrawDatas.Clear();
+	DrawFrameNumber = nsFrameMemory::GetFrameNumber();
+	DrawVertices.Clear(true);
+	DrawVertices.Reserve(1024);
+	DrawIndices.Clear(true);
+	DrawIndices.Reserve(2048);
+	DrawDatas.Clear(true);
+	DrawDatas.Reserve(32);
 	DrawBindMaterials.Clear();
 	DrawCallData.Clear();
 
@@ -820,6 +821,16 @@ void nsGUIContext::UpdateResourcesAndBuildDrawCalls(int frameIndex) noexcept
 {
 	FrameIndex = frameIndex;
 
+	if (DrawFrameNumber != nsFrameMemory::GetFrameNumber())
+	{
+		// BeginRender() was not called on this frame (ex: minimized), draw data may point to recycled frame memory
+		DrawFrameNumber = nsFrameMemory::GetFrameNumber();
+		DrawVertices.Clear(true);
+		DrawIndices.Clear(true);
+		DrawDatas.Clear(true);
+		DrawCallData.Clear();
+	}
+
 	const uint64 vertexBufferSize = sizeof(nsVertexGUI) * DrawVertices.GetCount();
 	const uint64 indexBufferSize = sizeof(uint32) * DrawIndices.GetCount();
 
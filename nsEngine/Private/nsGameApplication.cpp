@@ -195,20 +195,26 @@ void nsGameApplication::LoadTestLevel_Boxes()
 {
 	nsAssetManager& assetManager = nsAssetManager::Get();
 
+	// Level models are read and decoded in parallel, flushed before actors are created since navmesh build needs the mesh data
+	nsSharedModelAsset floorModelAsset = assetManager.LoadModelAssetAsync(NS_ENGINE_ASSET_MODEL_DEFAULT_FLOOR_NAME, nsEAssetLoadPriority::HIGH);
+	nsSharedModelAsset wallModelAsset = assetManager.LoadModelAssetAsync(NS_ENGINE_ASSET_MODEL_DEFAULT_WALL_NAME, nsEAssetLoadPriority::HIGH);
+	nsSharedModelAsset platformModelAsset = assetManager.LoadModelAssetAsync(NS_ENGINE_ASSET_MODEL_DEFAULT_PLATFORM_NAME, nsEAssetLoadPriority::HIGH);
+	nsSharedModelAsset boxModelAsset = assetManager.LoadModelAssetAsync(NS_ENGINE_ASSET_MODEL_DEFAULT_BOX_NAME, nsEAssetLoadPriority::HIGH);
+	assetManager.FlushAsyncLoads();
+
 	{
 		nsActor* floorActor = MainWorld->CreateActor("floor_actor", true, nsVector3(0.0f, -8.0f, 0.0f));
 		nsBoxCollisionComponent* boxCollisionComp = floorActor->AddComponent<nsBoxCollisionComponent>("box_collision");
 		boxCollisionComp->HalfExtents = nsVector3(1600.0f, 8.0f, 1600.0f);
 
 		nsMeshComponent* meshComp = floorActor->AddComponent<nsMeshComponent>("mesh");
-		meshComp->SetMesh(assetManager.LoadModelAsset(NS_ENGINE_ASSET_MODEL_DEFAULT_FLOOR_NAME));
+		meshComp->SetMesh(floorModelAsset);
 
 		floorActor->SetRootComponent(boxCollisionComp);
 		MainWorld->AddActorToLevel(floorActor);
 	}
 
 
-	nsSharedModelAsset wallModelAsset = assetManager.LoadModelAsset(NS_ENGINE_ASSET_MODEL_DEFAULT_WALL_NAME);
 	{
 		nsActor* wall0 = MainWorld->CreateActor("wall_0", true, nsVector3(-500.0f, 138.0f, 100.0f));
 		nsBoxCollisionComponent* boxCollisionComp = wall0->AddComponent<nsBoxCollisionComponent>("box_collision");
@@ -237,7 +243,6 @@ void nsGameApplication::LoadTestLevel_Boxes()
 		MainWorld->AddActorToLevel(wall2);
 	}
 
-	nsSharedModelAsset platformModelAsset = assetManager.LoadModelAsset(NS_ENGINE_ASSET_MODEL_DEFAULT_PLATFORM_NAME);
 	{
 		nsActor* slide0 = MainWorld->CreateActor("slide_0", true, nsVector3(-617.0f, 128.0f, -485.0f), nsQuaternion::FromRotation(0.0f, 0.0f, -30.0f));
 		nsBoxCollisionComponent* boxCollisionComp = slide0->AddComponent<nsBoxCollisionComponent>("box_collision");
@@ -258,8 +263,6 @@ void nsGameApplication::LoadTestLevel_Boxes()
 	}
 
 
-	nsSharedModelAsset boxModelAsset = assetManager.LoadModelAsset(NS_ENGINE_ASSET_MODEL_DEFAULT_BOX_NAME);
-
 	nsActor* boxCenter = MainWorld->CreateActor("box_center", true, nsVector3());
 	{
 		nsMeshComponent* meshComp = boxCenter->AddComponent<nsMeshComponent>("mesh");
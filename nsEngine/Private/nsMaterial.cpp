@@ -414,7 +414,7 @@ nsMaterialID nsMaterialManager::FindMaterial(const nsName& name) const noexcept
 	{
 		if ((*it) == name)
 		{
-			return nsMaterialID(it.GetIndex());
+			return nsMaterialID(it.GetIndex(), MaterialFlags.GetGeneration(it.GetIndex()));
 		}
 	}
 
@@ -430,7 +430,9 @@ nsMaterialID nsMaterialManager::CreateMaterial_Empty(nsName name) noexcept
 		return nsMaterialID::INVALID;
 	}
 
-	return Internal_CreateMaterial(name);
+	const int id = Internal_CreateMaterial(name);
+
+	return nsMaterialID(id, MaterialFlags.GetGeneration(id));
 }
 
 
@@ -542,7 +544,7 @@ nsMaterialID nsMaterialManager::CreateMaterial(nsName name, nsMaterialPipelineSt
 
 	NS_LogInfo(MaterialLog, TEXT("Create material default [%s]"), *name.ToString());
 
-	return nsMaterialID(id);
+	return nsMaterialID(id, MaterialFlags.GetGeneration(id));
 }
 
 
@@ -558,7 +560,7 @@ nsMaterialID nsMaterialManager::CreateMaterialInstance(nsName name, nsMaterialID
 
 	NS_LogInfo(MaterialLog, TEXT("Create material instance [%s]"), *name.ToString());
 
-	return nsMaterialID(id);
+	return nsMaterialID(id, MaterialFlags.GetGeneration(id));
 }
 
 
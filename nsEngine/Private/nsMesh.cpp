@@ -89,7 +89,7 @@ nsMeshID nsMeshManager::FindMesh(const nsName& name) const noexcept
 	{
 		if ((*it) == name)
 		{
-			return nsMeshID(it.GetIndex());
+			return nsMeshID(it.GetIndex(), MeshFlags.GetGeneration(it.GetIndex()));
 		}
 	}
 
@@ -105,7 +105,7 @@ nsMeshID nsMeshManager::CreateMesh(nsName name) noexcept
 	}
 
 	const int nameId = MeshNames.Add(name);
-	const int flagId = MeshFlags.Add(MeshFlag_Dirty);
+	const int flagId = MeshFlags.Add(MeshFlag_Dirty | MeshFlag_BoundDirty);
 	const int lodGroupId = MeshLodGroups.Add();
 	const int drawDataId = MeshDrawDatas.Add();
 	const int boundId = MeshBounds.Add();
@@ -117,7 +117,7 @@ nsMeshID nsMeshManager::CreateMesh(nsName name) noexcept
 	MeshDrawDatas[drawDataId] = nsMeshDrawData();
 	MeshBounds[boundId] = nsMeshBound();
 
-	return nsMeshID(nameId);
+	return nsMeshID(nameId, MeshFlags.GetGeneration(nameId));
 }
 
 
@@ -174,7 +174,7 @@ void nsMeshManager::UpdateMeshVertexData(nsMeshID mesh, int lodIndex, const nsVe
 		data.Indices.InsertAt(indices, indexCount, 0);
 	}
 
-	MeshFlags[mesh.Id] |= MeshFlag_Dirty;
+	MeshFlags[mesh.Id] |= (MeshFlag_Dirty | MeshFlag_BoundDirty);
 }
 
 
@@ -204,7 +204,7 @@ void nsMeshManager::BeginFrame(int frameIndex) noexcept
 	FrameIndex = frameIndex;
 
 	Frame& frame = FrameDatas[FrameIndex];
-	frame.MeshBindingInfos.Clear();
+	frame.MeshBindingInfos.Clear(true);
 	frame.MeshToDestroys.Clear();
 }
 
@@ -231,6 +231,12 @@ void nsMeshManager::BindMeshes(const nsMeshBindingInfo* bindingInfos, int count)
 			flags |= MeshFlag_PendingLoad;
 		}
 
+		if ((flags & MeshFlag_BoundDirty) && MeshLodGroups[info.Mesh.Id][0].Positions.GetCount() > 0)
+		{
+			RecomputeMeshBound(info.Mesh);
+			flags &= ~MeshFlag_BoundDirty;
+		}
+
 		frame.MeshBindingInfos.Add(info);
 	}
 }
@@ -245,8 +251,10 @@ void nsMeshManager::UpdateRenderResources() noexcept
 		return;
 	}
 
-	// Sort meshes, skinned meshes are priority
-	nsAlgorithm::Sort(frame.MeshBindingInfos.GetData(), frame.MeshBindingInfos.GetCount(), [](const nsMeshBindingInfo& a, const nsMeshBindingInfo& b) { return a.bIsSkinned > b.bIsSkinned; });
+	// Sort meshes, skinned meshes are priority. Radix sort is stable, bind order is kept within each group
+	nsTFrameArray<nsMeshBindingInfo> sortScratch;
+	sortScratch.Resize(frame.MeshBindingInfos.GetCount());
+	nsAlgorithm::SortRadix(frame.MeshBindingInfos.GetData(), frame.MeshBindingInfos.GetCount(), sortScratch.GetData(), [](const nsMeshBindingInfo& info) { return info.bIsSkinned ? 0u : 1u; });
 
 
 	uint64 vertexPositionBufferSize = 0;
@@ -469,6 +469,8 @@ void nsNavigationManager::BuildNavMesh(nsWorld* world)
 	
 	NavMeshBuildTask.DetourNavMesh = DetourNavMesh;
 	NavMeshBuildTask.DetourNavMeshQuery = DetourNavMeshQuery;
+
+	// Build is synchronous, crowd and agents are bound to the navmesh right after
 	NavMeshBuildTask.Execute();
 
 	const bool bSuccess = DetourCrowd->init(NS_ENGINE_NAVIGATION_MAX_AGENT, 40.0f, DetourNavMesh);
@@ -507,7 +509,7 @@ nsNavigationAgentID nsNavigationManager::CreateAgent(nsNavigationAgentComponent*
 	const nsVector3 initialPosition = component->GetWorldPosition();
 	state.AgentIndex = DetourCrowd->addAgent((const float*)&initialPosition, &dtParams);
 
-	return stateId;
+	return nsNavigationAgentID(stateId, AgentStates.GetGeneration(stateId));
 }
 
 
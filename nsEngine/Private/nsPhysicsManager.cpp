@@ -355,19 +355,27 @@ void nsPhysicsManager::SceneSyncTransforms(physx::PxScene* scene)
 
 	PxU32 numActiveActors = 0;
 	PxActor** activeActors = scene->getActiveActors(numActiveActors);
+	const int actorCount = static_cast<int>(numActiveActors);
 
-	for (PxU32 i = 0; i < numActiveActors; ++i)
-	{
-		NS_Assert(activeActors[i]->is<PxRigidActor>());
-
-		PxRigidActor* rigidActor = static_cast<PxRigidActor*>(activeActors[i]);
+	SyncTransforms.Resize(actorCount);
 
-		nsCollisionComponent* collisionComponent = static_cast<nsCollisionComponent*>(rigidActor->userData);
-		const PxTransform globalPose = rigidActor->getGlobalPose();
+	// Only physics poses are read in parallel, scene is not simulating
+	nsParallelFor(0, actorCount, 64, [this, activeActors](int index)
+	{
+		NS_Assert(activeActors[index]->is<PxRigidActor>());
 
-		nsTransform newTransform;
+		const PxTransform globalPose = static_cast<const PxRigidActor*>(activeActors[index])->getGlobalPose();
+		nsTransform& newTransform = SyncTransforms[index];
 		newTransform.Position = NS_FromPxVec3(globalPose.p);
 		newTransform.Rotation = NS_FromPxQuat(globalPose.q);
+	});
+
+	// Transform updates propagate to children and render context, applied serially
+	for (int i = 0; i < actorCount; ++i)
+	{
+		nsCollisionComponent* collisionComponent = static_cast<nsCollisionComponent*>(static_cast<PxRigidActor*>(activeActors[i])->userData);
+
+		nsTransform& newTransform = SyncTransforms[i];
 		newTransform.Scale = collisionComponent->GetWorldScale();
 
 		collisionComponent->Internal_SyncWithPhysicsTransform(newTransform);
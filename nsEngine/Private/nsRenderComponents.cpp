@@ -42,6 +42,7 @@ nsMeshComponent::nsMeshComponent()
 	Materials.Add();
 	RenderMeshId = nsRenderMeshID::INVALID;
 	bGenerateNavMesh = true;
+	bTextureStreaming = true;
 }
 
 
@@ -115,11 +116,11 @@ void nsMeshComponent::RegisterMesh()
 
 	if (RenderMeshId == nsRenderMeshID::INVALID)
 	{
-		RenderMeshId = renderContext.AddRenderMesh(meshes[0], Materials[0], GetWorldTransform().ToMatrix(), nsAnimationInstanceID::INVALID);
+		RenderMeshId = renderContext.AddRenderMesh(meshes[0], Materials[0], GetWorldTransform().ToMatrix(), nsAnimationInstanceID::INVALID, bTextureStreaming);
 	}
 	else
 	{
-		renderContext.UpdateRenderMesh(RenderMeshId, meshes[0], Materials[0], GetWorldTransform().ToMatrix(), nsAnimationInstanceID::INVALID);
+		renderContext.UpdateRenderMesh(RenderMeshId, meshes[0], Materials[0], GetWorldTransform().ToMatrix(), nsAnimationInstanceID::INVALID, bTextureStreaming);
 	}
 }
 
@@ -181,6 +182,7 @@ NS_CLASS_END(nsSkeletalMeshComponent)
 
 nsSkeletalMeshComponent::nsSkeletalMeshComponent()
 {
+	AnimationGraph = nullptr;
 	bGenerateNavMesh = false;
 	bDebugDrawSkeleton = false;
 }
@@ -235,11 +237,11 @@ void nsSkeletalMeshComponent::RegisterMesh()
 
 	if (RenderMeshId == nsRenderMeshID::INVALID)
 	{
-		RenderMeshId = renderContext.AddRenderMesh(meshes[0], Materials[0], GetWorldTransform().ToMatrix(), AnimationInstance);
+		RenderMeshId = renderContext.AddRenderMesh(meshes[0], Materials[0], GetWorldTransform().ToMatrix(), AnimationInstance, bTextureStreaming);
 	}
 	else
 	{
-		renderContext.UpdateRenderMesh(RenderMeshId, meshes[0], Materials[0], GetWorldTransform().ToMatrix(), AnimationInstance);
+		renderContext.UpdateRenderMesh(RenderMeshId, meshes[0], Materials[0], GetWorldTransform().ToMatrix(), AnimationInstance, bTextureStreaming);
 	}
 
 
@@ -279,6 +281,7 @@ void nsSkeletalMeshComponent::SetSkeleton(nsSharedSkeletonAsset newSkeleton)
 	if (SkeletonAsset.IsValid())
 	{
 		AnimationInstance = animationManager.CreateInstance("anim_instance", SkeletonAsset.GetSkeleton());
+		animationManager.SetInstanceGraph(AnimationInstance, AnimationGraph);
 	}
 }
 
@@ -303,3 +306,25 @@ void nsSkeletalMeshComponent::StopAnimation()
 
 	nsAnimationManager::Get().StopAnimation(AnimationInstance);
 }
+
+
+void nsSkeletalMeshComponent::BlendAnimation(nsSharedAnimationAsset animation, float blendDuration, float playRate, bool bLoop, nsEAnimationTransitionMode transitionMode)
+{
+	if (!SkeletonAsset.IsValid() || !animation.IsValid())
+	{
+		return;
+	}
+
+	nsAnimationManager::Get().BlendAnimation(AnimationInstance, transitionMode, blendDuration, animation.GetClip(), playRate, bLoop);
+}
+
+
+void nsSkeletalMeshComponent::SetAnimationGraph(nsAnimationGraph* graph)
+{
+	AnimationGraph = graph;
+
+	if (AnimationInstance.IsValid())
+	{
+		nsAnimationManager::Get().SetInstanceGraph(AnimationInstance, AnimationGraph);
+	}
+}
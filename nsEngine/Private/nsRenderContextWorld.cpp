@@ -2,6 +2,7 @@
 #include "nsGeometryFactory.h"
 #include "nsMaterial.h"
 #include "nsAnimationManager.h"
+#include "nsAssetManager.h"
 #include "API_VK/nsVulkanFunctions.h"
 
 
@@ -27,10 +28,6 @@ nsRenderContextWorld::nsRenderContextWorld() noexcept
 
 	PrimitiveBatchLineVertices.Reserve(1024);
 	PrimitiveBatchLineIndices.Reserve(2048);
-
-	DrawBindMaterials.Reserve(64);
-	DrawBindMeshes.Reserve(64);
-	DrawCallMeshes.Reserve(64);
 }
 
 
@@ -110,6 +107,17 @@ void nsRenderContextWorld::AddPrimitiveLine_CircleAroundAxis(const nsVector3& ce
 }
 
 
+void nsRenderContextWorld::BeginFrame(int frameIndex) noexcept
+{
+	FrameIndex = frameIndex;
+
+	// Previous frame data lives in frame memory, release before the slot gets recycled
+	DrawBindMaterials.Clear(true);
+	DrawBindMeshes.Clear(true);
+	DrawCallMeshes.Clear(true);
+}
+
+
 void nsRenderContextWorld::UpdateResourcesAndBuildDrawCalls(int frameIndex) noexcept
 {
 	FrameIndex = frameIndex;
@@ -306,3 +314,43 @@ void nsRenderContextWorld::UpdateResourcesAndBuildDrawCalls(int frameIndex) noex
 	PrimitiveBatchLineVertices.Clear();
 	PrimitiveBatchLineIndices.Clear();
 }
+
+
+void nsRenderContextWorld::RequestTextureScreenSizes(const nsMatrix4& projection, const nsVector3& viewPosition, int renderTargetHeight) noexcept
+{
+	nsMeshManager& meshManager = nsMeshManager::Get();
+	nsMaterialManager& materialManager = nsMaterialManager::Get();
+	nsAssetManager& assetManager = nsAssetManager::Get();
+
+	// Orthographic projection has no perspective divide (M[3][3] == 1)
+	const bool bIsOrthographic = projection[3][3] == 1.0f;
+
+	for (auto it = RenderMeshes.CreateConstIterator(); it; ++it)
+	{
+		if (!it->bTextureStreaming)
+		{
+			continue;
+		}
+
+		const nsVector3 scale = it->WorldTransform.GetScale();
+		const float radius = meshManager.GetMeshBound(it->Mesh).SphereRadius * nsMath::Max(scale.X, nsMath::Max(scale.Y, scale.Z));
+		const float distance = (it->WorldTransform.GetPosition() - viewPosition).GetMagnitude();
+		int screenSize = renderTargetHeight;
+
+		if (bIsOrthographic)
+		{
+			screenSize = static_cast<int>(radius * projection[1][1] * static_cast<float>(renderTargetHeight));
+		}
+		else if (distance > radius)
+		{
+			screenSize = static_cast<int>(radius * projection[1][1] * static_cast<float>(renderTargetHeight) / distance);
+		}
+
+		const nsTMap<nsName, nsTextureID>& textures = materialManager.GetMaterialParameterTextures(it->Material);
+
+		for (int i = 0; i < textures.GetCount(); ++i)
+		{
+			assetManager.RequestTextureScreenSize(textures.GetValueByIndex(i), screenSize);
+		}
+	}
+}
@@ -49,6 +49,11 @@ void nsRenderManager::Render(float deltaTime) noexcept
 	nsMeshManager::Get().BeginFrame(FrameIndex);
 	nsAnimationManager::Get().BeginFrame(FrameIndex);
 
+	for (int i = 0; i < WorldRenderContexts.GetCount(); ++i)
+	{
+		WorldRenderContexts.GetValueByIndex(i).BeginFrame(FrameIndex);
+	}
+
 	for (int i = 0; i < RegisteredRenderers.GetCount(); ++i)
 	{
 		RegisteredRenderers[i]->BeginRender(FrameIndex, deltaTime);
@@ -120,6 +120,7 @@ void nsRenderer::BeginRender(int frameIndex, float deltaTime) noexcept
 		if (RenderContextWorld)
 		{
 			RenderContextWorld->UpdateResourcesAndBuildDrawCalls(FrameIndex);
+			RenderContextWorld->RequestTextureScreenSizes(Viewport.GetProjectionMatrix(), Viewport.GetViewTransform().Position, RenderTargetDimension.Y);
 		}
 
 
@@ -226,7 +227,7 @@ void nsRenderer::RenderPassForward_Mesh(VkCommandBuffer commandBuffer)
 
 	nsMaterialID boundMaterial = nsMaterialID::INVALID;
 	const nsVulkanShaderPipeline* boundShaderPipeline = nullptr;
-	const nsTArray<nsRenderDrawCallPerMaterial>& drawCallMaterials = RenderContextWorld->GetDrawCallMeshes();
+	const nsTFrameArray<nsRenderDrawCallPerMaterial>& drawCallMaterials = RenderContextWorld->GetDrawCallMeshes();
 
 	for (int i = 0; i < drawCallMaterials.GetCount(); ++i)
 	{
@@ -246,7 +247,7 @@ void nsRenderer::RenderPassForward_Mesh(VkCommandBuffer commandBuffer)
 			}
 		}
 
-		const nsTArray<nsRenderDrawCallPerMesh>& drawCallMeshes = perMaterial.Meshes;
+		const nsTFrameArray<nsRenderDrawCallPerMesh>& drawCallMeshes = perMaterial.Meshes;
 
 		for (int j = 0; j < drawCallMeshes.GetCount(); ++j)
 		{
@@ -345,11 +346,11 @@ void nsRenderer::RenderPassForward_Wireframe(VkCommandBuffer commandBuffer)
 	const nsMaterialResource& materialResource = materialManager.GetMaterialResource(defaultWireframeMaterial);
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, materialResource.ShaderPipeline->GetVkPipeline());
 
-	const nsTArray<nsRenderDrawCallPerMaterial>& drawCallMaterials = RenderContextWorld->GetDrawCallMeshes();
+	const nsTFrameArray<nsRenderDrawCallPerMaterial>& drawCallMaterials = RenderContextWorld->GetDrawCallMeshes();
 
 	for (int i = 0; i < drawCallMaterials.GetCount(); ++i)
 	{
-		const nsTArray<nsRenderDrawCallPerMesh>& drawCallMeshes = drawCallMaterials[i].Meshes;
+		const nsTFrameArray<nsRenderDrawCallPerMesh>& drawCallMeshes = drawCallMaterials[i].Meshes;
 
 		for (int j = 0; j < drawCallMeshes.GetCount(); ++j)
 		{
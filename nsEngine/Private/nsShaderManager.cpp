@@ -187,31 +187,15 @@ void nsShaderManager::CompileShaders(bool bWaitUntilFinished) noexcept
 
 	if (submitCount > 0)
 	{
-		nsThreadPool::SubmitTasks(reinterpret_cast<nsIThreadTask**>(submitTasks.GetData()), submitCount, bWaitUntilFinished ? nsEThreadAffinity::Thread_ALL : nsEThreadAffinity::Thread_ExcludeMain);
+		// Background compiles stay off main thread, otherwise any WaitForCounter on main thread (e.g. animation poses) could pick up a whole compile
+		const nsThreadAffinityMasks affinityMasks = bWaitUntilFinished ? nsEThreadAffinity::Thread_ALL : nsEThreadAffinity::Thread_ExcludeMain;
+		nsThreadPool::SubmitTasks(reinterpret_cast<nsIThreadTask**>(submitTasks.GetData()), submitCount, affinityMasks, &CompileTaskCounter);
 	}
 
 	if (bWaitUntilFinished)
 	{
-		while (true)
-		{
-			bool bAllTasksFinished = true;
-
-			for (int i = 0; i < ShaderCompileTasks.GetCount(); ++i)
-			{
-				nsShaderCompileTask& task = ShaderCompileTasks[i];
-
-				if (task.bCompiling && !task.IsDone())
-				{
-					bAllTasksFinished = false;
-					break;
-				}
-			}
-
-			if (bAllTasksFinished)
-			{
-				break;
-			}
-		}
+		// Main thread executes compile tasks while waiting
+		nsThreadPool::WaitForCounter(CompileTaskCounter);
 	}
 
 	for (int i = 0; i < ShaderCompileTasks.GetCount(); ++i)
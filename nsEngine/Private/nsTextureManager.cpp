@@ -97,7 +97,7 @@ nsTextureID nsTextureManager::AllocateTexture(nsName name) noexcept
 	NS_Assert(resource.TextureView == nullptr);
 	NS_Assert(resource.SubresourceViews.IsEmpty());
 
-	return nsTextureID(nameId);
+	return nsTextureID(nameId, TextureFlags.GetGeneration(nameId));
 }
 
 
@@ -114,9 +114,33 @@ void nsTextureManager::DeallocateTexture(nsTextureID texture) noexcept
 	TextureNames.RemoveAt(id);
 	TextureFlags.RemoveAt(id);
 	TextureDatas.RemoveAt(id);
+	DestroyTextureResource(TextureResources[id]);
+	TextureResources.RemoveAt(id);
+}
+
 
+void nsTextureManager::CreateTexture2DResource(int id) noexcept
+{
 	nsTextureResource& resource = TextureResources[id];
+	NS_Assert(resource.Texture == nullptr);
+
+	const nsTextureData& data = TextureDatas[id];
+	const nsName name = TextureNames[id];
+	const int mipCount = data.Mips.GetCount();
+
+	resource.Texture = nsVulkan::CreateTexture2D(ns_ToVkFormat(data.Format), static_cast<uint32>(data.Width), static_cast<uint32>(data.Height), static_cast<uint32>(mipCount), *name);
+	resource.TextureView = nsVulkan::CreateTextureView(resource.Texture, 0, static_cast<uint32>(mipCount), nsName::Format("%s_view", *name));
+	resource.SubresourceViews.Resize(mipCount);
+
+	for (int m = 0; m < mipCount; ++m)
+	{
+		resource.SubresourceViews[m] = nsVulkan::CreateTextureView(resource.Texture, m, 1, nsName::Format("%s_view_%i", *name, m));
+	}
+}
 
+
+void nsTextureManager::DestroyTextureResource(nsTextureResource& resource) noexcept
+{
 	for (int i = 0; i < resource.SubresourceViews.GetCount(); ++i)
 	{
 		nsVulkan::DestroyTextureView(resource.SubresourceViews[i]);
@@ -125,8 +149,6 @@ void nsTextureManager::DeallocateTexture(nsTextureID texture) noexcept
 	resource.SubresourceViews.Clear();
 	nsVulkan::DestroyTextureView(resource.TextureView);
 	nsVulkan::DestroyTexture(resource.Texture);
-
-	TextureResources.RemoveAt(id);
 }
 
 
@@ -144,7 +166,7 @@ nsTextureID nsTextureManager::FindTexture(const nsName& name) const noexcept
 				continue;
 			}
 
-			return id;
+			return nsTextureID(id, TextureFlags.GetGeneration(id));
 		}
 	}
 
@@ -307,6 +329,42 @@ void nsTextureManager::UpdateTextureMipData(nsTextureID texture, int mipIndex, c
 }
 
 
+void nsTextureManager::UpdateTextureMips(nsTextureID texture, nsTArrayInline<nsTextureData::Mip, NS_ENGINE_TEXTURE_MAX_MIP>&& mips) noexcept
+{
+	NS_Assert(IsTextureValid(texture));
+	NS_Assert(mips.GetCount() > 0);
+
+	const int id = texture.Id;
+	nsTextureData& data = TextureDatas[id];
+	NS_AssertV(!data.bIsRenderTarget && !data.bIsDepth && !data.bIsStencil, TEXT("Cannot update mips of render target/depth-stencil!"));
+
+	data.Width = mips[0].Width;
+	data.Height = mips[0].Height;
+	data.Mips = std::move(mips);
+
+	uint32& flags = TextureFlags[id];
+	flags |= TextureFlag_Dirty;
+
+	nsTextureResource& resource = TextureResources[id];
+
+	if (resource.Texture == nullptr)
+	{
+		return;
+	}
+
+	FrameDatas[FrameIndex].ResourceToDestroys.Add(resource);
+	resource.Texture = nullptr;
+	resource.TextureView = nullptr;
+	resource.SubresourceViews.Clear();
+
+	// Texture may already be bound in current frame, descriptor must point to valid view before upload
+	CreateTexture2DResource(id);
+	flags |= TextureFlag_PendingLoad;
+
+	NS_LogDebug(TextureLog, TEXT("Update texture [%s] mips (%ix%i, %i mips)"), *TextureNames[id].ToString(), data.Width, data.Height, data.Mips.GetCount());
+}
+
+
 nsTextureID nsTextureManager::GetDefaultTexture2D_White() noexcept
 {
 	static nsTextureID _white;
@@ -372,6 +430,13 @@ void nsTextureManager::BeginFrame(int frameIndex) noexcept
 	}
 
 	frame.TextureToDestroys.Clear();
+
+	for (int i = 0; i < frame.ResourceToDestroys.GetCount(); ++i)
+	{
+		DestroyTextureResource(frame.ResourceToDestroys[i]);
+	}
+
+	frame.ResourceToDestroys.Clear();
 }
 
 
@@ -397,22 +462,11 @@ void nsTextureManager::BindTextures(const nsTextureID* textures, int count) noex
 			flags |= TextureFlag_PendingLoad;
 
 			nsTextureResource& resource = TextureResources[id];
-			const nsTextureData& data = TextureDatas[id];
 
 			// For texture 2D we only create resource when needed (binding)
 			if (resource.Texture == nullptr)
 			{
-				const nsName name = TextureNames[id];
-				resource.Texture = nsVulkan::CreateTexture2D(ns_ToVkFormat(data.Format), static_cast<uint32>(data.Width), static_cast<uint32>(data.Height), static_cast<uint32>(data.Mips.GetCount()), *name);
-				resource.TextureView = nsVulkan::CreateTextureView(resource.Texture, 0, static_cast<uint32>(data.Mips.GetCount()), nsName::Format("%s_view", *name));
-
-				const int mipCount = data.Mips.GetCount();
-				resource.SubresourceViews.Resize(mipCount);
-
-				for (int m = 0; m < mipCount; ++m)
-				{
-					resource.SubresourceViews[m] = nsVulkan::CreateTextureView(resource.Texture, m, 1, nsName::Format("%s_view_%i", *name, m));
-				}
+				CreateTexture2DResource(id);
 			}
 			// For render target/depth-stencil, resource must already created
 			else
@@ -36,7 +36,7 @@ class NS_ENGINE_API nsActor : public nsObject
 	NS_DECLARE_OBJECT(nsActor)
 
 private:
-	static nsMemory ComponentMemory;
+	static nsMemoryPool ComponentMemory;
 
 
 protected:
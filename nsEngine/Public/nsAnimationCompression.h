@@ -0,0 +1,102 @@
+#pragma once
+
+#include "nsAnimationTypes.h"
+#include "nsAlgorithm.h"
+#include "nsQuantization.h"
+
+
+
+namespace nsAnimationCompression
+{
+	// Compress KeyFrames of <clip> into clip.Compressed, KeyFrames are cleared.
+	// Constant tracks are stored as single value and keys that can be interpolated from their neighbors are removed,
+	// both within skeleton.CompressionError. Error is measured per bone in local space, rotation/scale error at distance to farthest child bone.
+	// Remaining rotation keys are quantized to smallest three (48 bits), position/scale keys to 16 bits per component in track range.
+	// Key removal is measured against quantized keys, so the error bound includes quantization error.
+	extern NS_ENGINE_API void CompressClip(nsAnimationClipData& clip, const nsAnimationSkeletonData& skeleton) noexcept;
+
+
+	// Convert timestamp (seconds) to quantized key time of compressed clip
+	NS_NODISCARD_INLINE float GetKeyTime(const nsAnimationClipData& clip, float timestamp) noexcept
+	{
+		return clip.Duration > 0.0f ? timestamp * (65535.0f / clip.Duration) : 0.0f;
+	}
+
+
+	NS_NODISCARD_INLINE nsVector3 DecodeVector(const nsAnimationCompressedTrack& track, const uint16* values) noexcept
+	{
+		return nsVector3(
+			nsQuantization::DecodeRange16(values[0], track.RangeMin[0], track.RangeExtent[0]),
+			nsQuantization::DecodeRange16(values[1], track.RangeMin[1], track.RangeExtent[1]),
+			nsQuantization::DecodeRange16(values[2], track.RangeMin[2], track.RangeExtent[2])
+		);
+	}
+
+
+	NS_NODISCARD_INLINE nsQuaternion DecodeRotation(const uint16* values) noexcept
+	{
+		return nsQuantization::DecodeQuaternion48(values);
+	}
+
+
+	// Find key interval of animated track at <keyTime>, returns interpolation alpha. <cursor> is key-frame cursor of this track
+	NS_NODISCARD_INLINE float FindKeyInterval(const nsAnimationCompressedClipData& data, const nsAnimationCompressedTrack& track, float keyTime, int& cursor, int& outKey) noexcept
+	{
+		const uint16* keyTimes = data.KeyTimes.GetData() + track.FirstKey;
+		const int index = nsAlgorithm::FindInterval(keyTimes, track.KeyCount, keyTime, cursor, [](uint16 time) { return static_cast<float>(time); });
+		const float timeA = static_cast<float>(keyTimes[index]);
+		outKey = track.FirstKey + index;
+
+		// Key times are strictly increasing
+		return nsMath::Clamp((keyTime - timeA) / (static_cast<float>(keyTimes[index + 1]) - timeA), 0.0f, 1.0f);
+	}
+
+
+	// Sample position/scale track, <outValue> is not modified if track has no keys
+	NS_INLINE void SampleVector(const nsAnimationCompressedClipData& data, int trackIndex, float keyTime, int& cursor, nsVector3& outValue) noexcept
+	{
+		const nsAnimationCompressedTrack& track = data.Tracks[trackIndex];
+
+		if (track.KeyCount == 0)
+		{
+			return;
+		}
+
+		if (track.KeyCount == 1)
+		{
+			const nsVector4& value = data.ConstantValues[track.FirstKey];
+			outValue = nsVector3(value.X, value.Y, value.Z);
+			return;
+		}
+
+		int key = 0;
+		const float alpha = FindKeyInterval(data, track, keyTime, cursor, key);
+		const uint16* values = data.KeyValues.GetData() + key * 3;
+		outValue = nsVector3::Lerp(DecodeVector(track, values), DecodeVector(track, values + 3), alpha);
+	}
+
+
+	// Sample rotation track, <outValue> is not modified if track has no keys
+	NS_INLINE void SampleRotation(const nsAnimationCompressedClipData& data, int trackIndex, float keyTime, int& cursor, nsQuaternion& outValue) noexcept
+	{
+		const nsAnimationCompressedTrack& track = data.Tracks[trackIndex];
+
+		if (track.KeyCount == 0)
+		{
+			return;
+		}
+
+		if (track.KeyCount == 1)
+		{
+			const nsVector4& value = data.ConstantValues[track.FirstKey];
+			outValue = nsQuaternion(value.X, value.Y, value.Z, value.W);
+			return;
+		}
+
+		int key = 0;
+		const float alpha = FindKeyInterval(data, track, keyTime, cursor, key);
+		const uint16* values = data.KeyValues.GetData() + key * 3;
+		outValue = nsQuaternion::Slerp(DecodeRotation(values), DecodeRotation(values + 3), alpha);
+	}
+
+};
@@ -4,6 +4,63 @@
 
 
 
+enum class nsEAnimationLayerBlendMode : uint8
+{
+	// Layer pose replaces pose of previous layers, lerped by layer weight and bone mask
+	OVERRIDE = 0,
+
+	// Layer pose delta from first frame of its clips is added on top of previous layers
+	ADDITIVE
+};
+
+
+
+// Clip placed in blend space of animation layer
+struct nsAnimationBlendSample
+{
+	nsAnimationClipID Clip;
+
+	// Position in blend space, Y is ignored by 1D blend space
+	nsVector2 Position;
+
+	// Evaluated by nsAnimationGraph::TickUpdate, samples with zero weight are not sampled
+	float Weight;
+	float Timestamp;
+};
+
+
+
+struct nsAnimationLayer
+{
+	nsName Name;
+	nsEAnimationLayerBlendMode BlendMode;
+
+	// Layer weight, multiplied by float parameter WeightParameter if set
+	float Weight;
+	nsName WeightParameter;
+
+	// Float parameters of blend space axes. No ParameterX = plays first sample only, no ParameterY = 1D blend space
+	nsName ParameterX;
+	nsName ParameterY;
+
+	float PlayRate;
+	bool bLooping;
+
+	nsTArrayInline<nsAnimationBlendSample, NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE> Samples;
+
+	// Weight of each bone (skeleton bone order), empty = all bones have weight 1
+	nsTArray<float> BoneMask;
+
+	// Normalized play time, samples with different duration are synchronized to it
+	float Phase;
+
+	// Weight * WeightParameter, evaluated by nsAnimationGraph::TickUpdate
+	float EvaluatedWeight;
+};
+
+
+
+// Parameter driven animation layers evaluated on top of clip played by animation instance (nsAnimationManager::SetInstanceGraph). Graph can be shared by multiple instances, it is ticked once per pose update
 class NS_ENGINE_API nsAnimationGraph
 {
 private:
@@ -12,9 +69,49 @@ private:
 	nsTMap<nsName, float> ParameterFloats;
 	nsTMap<nsName, nsVector3> ParameterVectors;
 
-	
+	nsTArray<nsAnimationLayer> Layers;
+
+	// Pose update the graph was last ticked on
+	uint64 LastUpdateIndex;
+
+
 public:
 	nsAnimationGraph();
-	void TickUpdate(float deltaTime);
+
+	// [Main thread only] Advance layer phases and evaluate blend weights from parameters. Called by nsAnimationManager before instance pose is evaluated,
+	// does nothing if graph was already ticked on <updateIndex> by another instance
+	void TickUpdate(float deltaTime, uint64 updateIndex);
+
+	void SetParameterBool(const nsName& name, bool value);
+	void SetParameterInt(const nsName& name, int value);
+	void SetParameterFloat(const nsName& name, float value);
+	void SetParameterVector(const nsName& name, const nsVector3& value);
+
+	NS_NODISCARD bool GetParameterBool(const nsName& name) const;
+	NS_NODISCARD int GetParameterInt(const nsName& name) const;
+	NS_NODISCARD float GetParameterFloat(const nsName& name) const;
+	NS_NODISCARD nsVector3 GetParameterVector(const nsName& name) const;
+
+
+	// Layers modify pose of previous layers, returns index of new layer
+	int AddLayer(const nsName& name, nsEAnimationLayerBlendMode blendMode = nsEAnimationLayerBlendMode::OVERRIDE, float weight = 1.0f);
+	NS_NODISCARD int FindLayer(const nsName& name) const;
+
+	void AddLayerSample(int layer, nsAnimationClipID clip, const nsVector2& position = nsVector2::ZERO);
+	void SetLayerBlendParameters(int layer, const nsName& parameterX, const nsName& parameterY = nsName::NONE);
+	void SetLayerWeight(int layer, float weight, const nsName& weightParameter = nsName::NONE);
+	void SetLayerPlayRate(int layer, float playRate, bool bLoop);
+
+	// Set weight of each bone (skeleton bone order), empty mask affects all bones
+	void SetLayerBoneMask(int layer, const nsTArray<float>& boneMask);
+
+	// Mask layer to bone <rootBoneName> and its descendants
+	void SetLayerBoneMask(int layer, nsAnimationSkeletonID skeleton, const nsName& rootBoneName);
+
+
+	NS_NODISCARD_INLINE const nsTArray<nsAnimationLayer>& GetLayers() const
+	{
+		return Layers;
+	}
 
 };
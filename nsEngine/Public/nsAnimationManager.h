@@ -5,6 +5,37 @@
 
 
 
+// Evaluates poses of animation instances in range [InstanceBegin, InstanceEnd)
+class nsAnimationPoseUpdateTask : public nsIThreadTask
+{
+private:
+	nsAtomic bDone;
+
+public:
+	int InstanceBegin;
+	int InstanceEnd;
+	float DeltaTime;
+
+	// Scratch poses of instances evaluated by this task
+	nsAnimationPosePool PosePool;
+
+
+public:
+	nsAnimationPoseUpdateTask() noexcept;
+	virtual void Reset() noexcept override;
+	virtual void Execute() noexcept override;
+	virtual bool IsIdle() const noexcept override;
+	virtual bool IsRunning() const noexcept override;
+	virtual bool IsDone() const noexcept override;
+
+#ifdef _DEBUG
+	virtual nsString GetDebugName() const noexcept override;
+#endif // _DEBUG
+
+};
+
+
+
 class NS_ENGINE_API nsAnimationManager
 {
 	NS_DECLARE_SINGLETON(nsAnimationManager)
@@ -21,6 +52,9 @@ private:
 	Frame FrameDatas[NS_ENGINE_FRAME_BUFFERING];
 	int FrameIndex;
 
+	// Incremented by each UpdateAnimationPoses, graphs shared by multiple instances are ticked once per update
+	uint64 UpdateIndex;
+
 
 	enum Flag
 	{
@@ -48,15 +82,50 @@ private:
 	nsTArrayFreeList<uint32> InstanceFlags;
 	nsTArrayFreeList<nsAnimationInstanceData> InstanceDatas;
 	nsTArrayFreeList<nsAnimationPlayState> InstancePlayStates;
+	nsTArrayFreeList<nsAnimationBlendState> InstanceBlendStates;
 
 
 	nsTArray<nsMatrix4> InstanceBoneTransforms;
 
 
+	// Each instance only writes its own bone transforms, instances are evaluated in batches on thread pool
+	nsTArray<nsAnimationPoseUpdateTask> PoseUpdateTasks;
+	nsThreadTaskCounter PoseUpdateTaskCounter;
+
+	// Scratch poses of instances evaluated on main thread
+	nsAnimationPosePool PosePool;
+
+
+private:
+	// [Main thread only] Tick instance animation graph and prepare its cursors and additive references before pose update tasks read them
+	void UpdateInstanceGraph(int index, float deltaTime);
+
+	void UpdateInstancePose(int index, float deltaTime, nsAnimationPosePool& posePool);
+
+	// Sample <clip> into <outPose> (hierarchy order), bones without key-frames are in bind pose. Each cursor slot keeps key-frame cursors of one sampled clip
+	void SampleClip(nsAnimationInstanceData& instanceData, nsAnimationClipID clip, float timestamp, int cursorSlot, nsTransformSoA& outPose);
+
+	// Clip was created for skeleton of instance and has key-frames (or compressed tracks) for every bone. Incompatible clips are never sampled
+	NS_NODISCARD bool IsClipCompatible(const nsAnimationInstanceData& instanceData, nsAnimationClipID clip) const;
+
+	void EvaluateGraphLayers(nsAnimationInstanceData& instanceData, nsAnimationPosePool& posePool);
+
+
 public:
 	void Initialize();
+
+	// [Main thread only] Submit pose update tasks for all instances and return without waiting
 	void UpdateAnimationPoses(float deltaTime);
 
+	// [Main thread only] Wait until pose update tasks finished. Main thread executes queued tasks while waiting
+	NS_INLINE void WaitAnimationPoses()
+	{
+		if (!PoseUpdateTaskCounter.IsDone())
+		{
+			nsThreadPool::WaitForCounter(PoseUpdateTaskCounter);
+		}
+	}
+
 
 	NS_NODISCARD nsAnimationSkeletonID FindSkeleton(const nsName& name) const;
 	NS_NODISCARD nsAnimationSkeletonID CreateSkeleton(nsName name);
@@ -64,12 +133,13 @@ public:
 
 	NS_NODISCARD_INLINE bool IsSkeletonValid(nsAnimationSkeletonID skeleton) const
 	{
-		return skeleton.IsValid() && SkeletonFlags.IsValid(skeleton.Id) && !(SkeletonFlags[skeleton.Id] & Flag_PendingDestroy);
+		return skeleton.IsValid() && SkeletonFlags.IsValid(skeleton.Id, skeleton.Generation) && !(SkeletonFlags[skeleton.Id] & Flag_PendingDestroy);
 	}
 
 	NS_NODISCARD_INLINE nsAnimationSkeletonData& GetSkeletonData(nsAnimationSkeletonID skeleton)
 	{
 		NS_Assert(IsSkeletonValid(skeleton));
+		WaitAnimationPoses();
 		return SkeletonDatas[skeleton.Id];
 	}
 
@@ -95,12 +165,13 @@ public:
 
 	NS_NODISCARD_INLINE bool IsClipValid(nsAnimationClipID clip) const
 	{
-		return clip.IsValid() && ClipFlags.IsValid(clip.Id) && !(ClipFlags[clip.Id] & Flag_PendingDestroy);
+		return clip.IsValid() && ClipFlags.IsValid(clip.Id, clip.Generation) && !(ClipFlags[clip.Id] & Flag_PendingDestroy);
 	}
 
 	NS_NODISCARD_INLINE nsAnimationClipData& GetClipData(nsAnimationClipID clip)
 	{
 		NS_Assert(IsClipValid(clip));
+		WaitAnimationPoses();
 		return ClipDatas[clip.Id];
 	}
 
@@ -121,14 +192,22 @@ public:
 	NS_NODISCARD nsAnimationInstanceID CreateInstance(nsName name, nsAnimationSkeletonID skeleton);
 	void DestroyInstance(nsAnimationInstanceID& instance);
 	void SetInstanceUpdatePose(nsAnimationInstanceID instance, bool bUpdatePose);
-	void PlayAnimation(nsAnimationInstanceID instance, nsAnimationClipID clip, float playRate, bool bLoop);
+
+	// Returns false if <clip> is not compatible with skeleton of instance, played clip is unchanged
+	bool PlayAnimation(nsAnimationInstanceID instance, nsAnimationClipID clip, float playRate, bool bLoop);
+
 	void StopAnimation(nsAnimationInstanceID instance);
-	void BlendAnimation(nsAnimationInstanceID instance, nsEAnimationTransitionMode transitionMode, float blendFactor, nsAnimationClipID clip, float playRate, bool bLoop);
+
+	// Play <clip> and cross-fade from currently played clip over <blendDuration> seconds. FROZEN transition holds previous clip at its current time while fading out
+	void BlendAnimation(nsAnimationInstanceID instance, nsEAnimationTransitionMode transitionMode, float blendDuration, nsAnimationClipID clip, float playRate, bool bLoop);
+
+	// Evaluate layers of <graph> on top of played clip, graph must outlive instance or be unset (nullptr). Graph can be shared by multiple instances
+	void SetInstanceGraph(nsAnimationInstanceID instance, nsAnimationGraph* graph);
 
 
 	NS_NODISCARD_INLINE bool IsInstanceValid(nsAnimationInstanceID instance) const
 	{
-		return instance.IsValid() && InstanceFlags.IsValid(instance.Id) && !(InstanceFlags[instance.Id] & Flag_PendingDestroy);
+		return instance.IsValid() && InstanceFlags.IsValid(instance.Id, instance.Generation) && !(InstanceFlags[instance.Id] & Flag_PendingDestroy);
 	}
 
 	NS_NODISCARD_INLINE int GetInstanceBoneTransformIndex(nsAnimationInstanceID instance) const
@@ -158,4 +237,7 @@ public:
 
 #endif // NS_ENGINE_DEBUG_DRAW
 
+
+	friend class nsAnimationPoseUpdateTask;
+
 };
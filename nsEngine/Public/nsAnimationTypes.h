@@ -1,6 +1,7 @@
 #pragma once
 
 #include "nsEngineTypes.h"
+#include "nsTransformHierarchy.h"
 
 
 NS_ENGINE_DECLARE_HANDLE(nsAnimationSkeletonID, nsAnimationManager)
@@ -17,7 +18,6 @@ struct nsAnimationSkeletonData
 		nsMatrix4 PoseTransform;
 		nsTransform LocalTransform;
 		int ParentId;
-		bool bUpdated;
 
 
 		friend NS_INLINE void operator|(nsStream& stream, Bone& bone)
@@ -33,11 +33,22 @@ struct nsAnimationSkeletonData
 	nsTArrayInline<nsName, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> BoneNames;
 	nsTArrayInline<Bone, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> BoneDatas;
 
+	// Maximum error (cm) allowed when compressing animation clips of this skeleton
+	float CompressionError;
+
+
+public:
+	nsAnimationSkeletonData()
+		: CompressionError(NS_ENGINE_ANIMATION_COMPRESSION_ERROR)
+	{
+	}
+
 
 	friend NS_INLINE void operator|(nsStream& stream, nsAnimationSkeletonData& animationSkeletonData)
 	{
 		stream | animationSkeletonData.BoneNames;
 		stream | animationSkeletonData.BoneDatas;
+		stream | animationSkeletonData.CompressionError;
 	}
 
 };
@@ -69,6 +80,57 @@ struct nsAnimationKeyFrame
 
 
 
+// Compressed key-frames of single bone channel (position, rotation or scale)
+struct nsAnimationCompressedTrack
+{
+	// Index of first key in KeyTimes (KeyValues index is FirstKey * 3), or index of value in ConstantValues if KeyCount is 1
+	int FirstKey;
+
+	// 0 = no keys (bone keeps local transform), 1 = constant
+	int KeyCount;
+
+	// Position/scale key value = RangeMin + RangeExtent * (quantized / 65535)
+	float RangeMin[3];
+	float RangeExtent[3];
+};
+
+
+
+// Runtime layout of compressed clip, keys of each track are contiguous
+struct nsAnimationCompressedClipData
+{
+	// 3 tracks per bone (position, rotation, scale)
+	nsTArray<nsAnimationCompressedTrack> Tracks;
+
+	// Key timestamp quantized to [0, 65535] over clip duration
+	nsTArray<uint16> KeyTimes;
+
+	// 3 values per key. Position/scale are range reduced, rotation is smallest three (15 bits per component, largest component index in top bits)
+	nsTArray<uint16> KeyValues;
+
+	// Full precision value of constant tracks (position/scale use XYZ)
+	nsTArray<nsVector4> ConstantValues;
+
+
+public:
+	NS_NODISCARD_INLINE bool IsEmpty() const
+	{
+		return Tracks.GetCount() == 0;
+	}
+
+
+	friend NS_INLINE void operator|(nsStream& stream, nsAnimationCompressedClipData& compressedClipData)
+	{
+		stream | compressedClipData.Tracks;
+		stream | compressedClipData.KeyTimes;
+		stream | compressedClipData.KeyValues;
+		stream | compressedClipData.ConstantValues;
+	}
+
+};
+
+
+
 struct nsAnimationClipData
 {
 	// Compatible skeleton
@@ -80,9 +142,12 @@ struct nsAnimationClipData
 	// Duration (seconds)
 	float Duration;
 
-	// Key-frames for each bone
+	// Key-frames for each bone, empty after clip is compressed
 	nsTArray<nsAnimationKeyFrame> KeyFrames;
 
+	// Compressed key-frames, sampled instead of KeyFrames if not empty
+	nsAnimationCompressedClipData Compressed;
+
 
 public:
 	nsAnimationClipData()
@@ -99,23 +164,76 @@ public:
 		stream | animationSequenceData.FrameCount;
 		stream | animationSequenceData.Duration;
 		stream | animationSequenceData.KeyFrames;
+		stream | animationSequenceData.Compressed;
 	}
 
 };
 
 
 
+// Key-frame interval of each channel found by previous sample, next sample searches forward from it
+struct nsAnimationKeyFrameCursor
+{
+	int Position;
+	int Rotation;
+	int Scale;
+};
+
+
+
+struct nsAnimationAdditiveReference
+{
+	nsAnimationClipID Clip;
+	nsTransformSoA Pose;
+};
+
+
+
+class nsAnimationGraph;
+
+
+
 struct nsAnimationInstanceData
 {
 	// Skeleton bone names
 	nsTArrayInline<nsName, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> BoneNames;
 
-	// Skeleton bone transforms
-	nsTArrayInline<nsAnimationSkeletonData::Bone, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> BoneTransforms;
+	// Bone local transforms in hierarchy order (parent before child)
+	nsTransformSoA LocalTransforms;
+
+	// Bone index of each hierarchy transform
+	nsTArrayInline<int, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> HierarchyBoneIds;
+
+	// Hierarchy index of each bone
+	nsTArrayInline<int, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> BoneHierarchyIds;
+
+	// Parent hierarchy index of each hierarchy transform, -1 for root
+	nsTArrayInline<int, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> HierarchyParentIds;
+
+	// Inverse bind pose of each hierarchy transform
+	nsTArrayInline<nsMatrix4, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> HierarchyInverseBindPoses;
 
-	// Skeleton which this instanced from
+	// Model space matrix of each hierarchy transform
+	nsTArrayInline<nsMatrix4, NS_ENGINE_ANIMATION_SKELETON_MAX_BONE> HierarchyModelMatrices;
+
+	// Bone bind pose local transforms in hierarchy order, sampled poses start from it
+	nsTransformSoA BindLocalTransforms;
+
+	// Key-frame cursors for each bone of each sampled clip slot (bone count per slot)
+	nsTArray<nsAnimationKeyFrameCursor> KeyFrameCursors;
+
+	// Pose of additive clips at first frame, delta of additive layer is relative to it
+	nsTArray<nsAnimationAdditiveReference> AdditiveReferences;
+
+	// Skeleton which this instanced from, invalid after skeleton is destroyed
 	nsAnimationSkeletonID Skeleton;
 
+	// Name of skeleton which this instanced from, kept after skeleton is destroyed
+	nsName SkeletonName;
+
+	// Animation graph layered on top of played clip
+	nsAnimationGraph* Graph;
+
 	// Bone transform index
 	int BoneTransformIndex;
 
@@ -124,6 +242,7 @@ public:
 	nsAnimationInstanceData()
 	{
 		Skeleton = nsAnimationSkeletonID::INVALID;
+		Graph = nullptr;
 		BoneTransformIndex = -1;
 	}
 
@@ -160,18 +279,26 @@ public:
 
 
 
+// Cross-fade from previous play state to current play state
 struct nsAnimationBlendState
 {
-	nsAnimationClipID Clip;
+	// Play state being blended out, Clip is INVALID if there is no transition
+	nsAnimationPlayState From;
+
 	nsEAnimationTransitionMode TransitionMode;
-	float BlendFactor;
+
+	// Transition duration (seconds)
+	float BlendDuration;
+
+	// Elapsed transition time (seconds)
+	float BlendTime;
 
 
 public:
 	nsAnimationBlendState()
-		: Clip(nsAnimationClipID::INVALID)
-		, TransitionMode(nsEAnimationTransitionMode::SMOOTH)
-		, BlendFactor(0.2f)
+		: TransitionMode(nsEAnimationTransitionMode::SMOOTH)
+		, BlendDuration(0.2f)
+		, BlendTime(0.0f)
 	{
 	}
 
@@ -179,4 +306,35 @@ public:
 
 
 
-class nsAnimationGraph;
+// Scratch poses used while evaluating instance pose. Each pose update task owns one, so buffers are reused every frame without allocation
+class nsAnimationPosePool
+{
+private:
+	nsTransformSoA Poses[NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE];
+	int PoseCount;
+
+public:
+	// Per bone weights (hierarchy order) of layer being evaluated
+	nsTArray<float> BoneWeights;
+
+
+public:
+	nsAnimationPosePool()
+		: PoseCount(0)
+	{
+	}
+
+
+	NS_INLINE void Reset()
+	{
+		PoseCount = 0;
+	}
+
+
+	NS_NODISCARD_INLINE nsTransformSoA& Allocate()
+	{
+		NS_Assert(PoseCount < NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE);
+		return Poses[PoseCount++];
+	}
+
+};
@@ -17,6 +17,10 @@ struct nsAssetImportOption_Model
 {
 	nsString SourceFile;
 	float MeshScaleMultiplier;
+
+	// Maximum error (cm) of compressed animation clips, stored in imported skeleton. Default is used if <= 0
+	float AnimationCompressionError;
+
 	bool bImportMesh;
 	bool bImportSkeleton;
 	bool bImportAnimation;
@@ -25,6 +29,10 @@ struct nsAssetImportOption_Model
 
 
 
+class nsAssetImportBatch;
+
+
+
 class NS_ENGINE_API nsAssetImporter
 {
 	NS_DECLARE_SINGLETON(nsAssetImporter)
@@ -35,13 +43,30 @@ private:
 public:
 	void Initialize() noexcept;
 
-	void ImportAssetFromImageFile(const nsAssetImportOption_Image& option, const nsString& dstFolderPath) noexcept;
-
 
 private:
-	void ImportAssetFromModelFile_GLB(const nsAssetImportOption_Model& option, const nsString& dstFolderPath);
+	bool AddImportJob_Image(nsAssetImportBatch& batch, const nsAssetImportOption_Image& option) noexcept;
+	bool AddImportJobs_GLB(nsAssetImportBatch& batch, const nsAssetImportOption_Model& option);
+	bool AddImportJobs_Model(nsAssetImportBatch& batch, const nsAssetImportOption_Model& option) noexcept;
+
+	// Execute all jobs in batch on worker threads, then register imported assets. Returns false if any job failed
+	bool RunImportBatch(nsAssetImportBatch& batch) noexcept;
 
 public:
+	void ImportAssetFromImageFile(const nsAssetImportOption_Image& option, const nsString& dstFolderPath) noexcept;
+
+	// Import all images in parallel (one job per image)
+	bool ImportAssetsFromImageFiles(const nsTArray<nsAssetImportOption_Image>& options, const nsString& dstFolderPath) noexcept;
+
+	// Meshes, skeleton, animation clips and embedded textures are imported in parallel (one job per asset)
 	void ImportAssetFromModelFile(const nsAssetImportOption_Model& option, const nsString& dstFolderPath) noexcept;
 
+	// Import all image (.bmp, .png, .tga) and model (.glb) files in folder (and subfolders) as one batch.
+	// SourceFile in <imageOption> and <modelOption> is ignored, other options are used for every file
+	bool ImportAssetsFromFolder(const nsString& sourceFolderPath, const nsString& dstFolderPath, const nsAssetImportOption_Image& imageOption, const nsAssetImportOption_Model& modelOption) noexcept;
+
+	// Headless bulk import, does not need engine to be initialized (only platform, logger and thread pool).
+	// -import=<source file or folder> [-importdst=<folder in game assets>] [-importscale=<mesh scale multiplier>] [-importanimerror=<animation compression error>]
+	bool ImportAssetsFromCommandLines() noexcept;
+
 };
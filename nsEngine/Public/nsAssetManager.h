@@ -1,6 +1,9 @@
 #pragma once
 
 #include "nsAssetTypes.h"
+#include "nsFileSystem.h"
+#include "nsAsyncLoad.h"
+#include "nsMesh.h"
 
 
 
@@ -16,9 +19,31 @@ private:
 
 public:
 	void Initialize();
+	void Shutdown();
+
+
+	// Asset data inside mounted archive, Data is null if asset is loaded from its own asset file
+	struct ArchiveData
+	{
+		const uint8* Data;
+		int Size;
+	};
+
+	// CPU and GPU memory used by loaded asset
+	struct MemorySize
+	{
+		uint64 CpuBytes;
+		uint64 GpuBytes;
+	};
 
 private:
-	void RegisterAsset(const nsString& assetFile);
+	void RegisterAsset(nsName name, const nsString& path, nsEAssetType type, ArchiveData archiveData);
+
+	// Register asset files, asset type is taken from registry index if file not modified. Registry index is updated if any file changed
+	void RegisterAssetFiles(const nsTArray<nsString>& assetFiles, const nsString& registryFile);
+
+	// Write asset file header followed by <payload>. Payload is block compressed if <compression> is not NONE
+	NS_NODISCARD bool WriteAssetFile(const nsString& assetFile, nsEAssetType type, const nsBinaryStreamWriter& payload, nsECompression compression) const;
 
 public:
 	bool IsValidAssetFile(const nsString& assetFile, nsAssetFileHeader& outHeader) const;
@@ -26,6 +51,16 @@ public:
 	void GetAssetInfosFromPath(const nsString& path, nsTArray<nsAssetInfo>& outAssetInfos) const;
 	void Update();
 
+	// [Thread safe] Write asset file from data without creating engine resource or registering the asset. Used by Save<Type>Asset() and asset importer jobs
+	NS_NODISCARD bool WriteTextureAssetFile(const nsString& assetFile, const nsTextureData& data, nsECompression compression, nsAssetTextureMip* outMipTable = nullptr) const;
+	NS_NODISCARD bool WriteModelAssetFile(const nsString& assetFile, const nsMeshLODGroup* const* lodGroups, int meshCount, nsECompression compression) const;
+	NS_NODISCARD bool WriteSkeletonAssetFile(const nsString& assetFile, const nsAnimationSkeletonData& data) const;
+	NS_NODISCARD bool WriteAnimationAssetFile(const nsString& assetFile, const nsAnimationClipData& data, nsECompression compression) const;
+
+	// Register asset file written by Write<Type>AssetFile(), ignored if asset manager is not initialized (headless import).
+	// Asset that is already registered keeps its current data until it is unloaded and loaded again
+	void RegisterImportedAsset(nsName name, const nsString& path, nsEAssetType type);
+
 
 	NS_NODISCARD_INLINE const nsString& GetEngineAssetsPath() const
 	{
@@ -58,6 +93,14 @@ public:
 		nsTArray<uint8> Flags;
 		nsTArray<int> RefCounts;
 		nsTArray<THandle> Handles;
+		nsTArray<ArchiveData> ArchiveDatas;
+		nsTArray<MemorySize> MemorySizes;
+
+		// Residency frame when reference count dropped to zero, unreferenced assets are evicted in LRU order
+		nsTArray<uint64> ReleasedFrames;
+
+		// Name to index of asset
+		nsTMap<nsName, int> NameIndices;
 
 	public:
 		TAssetData()
@@ -67,61 +110,292 @@ public:
 			Flags.Reserve(64);
 			RefCounts.Reserve(64);
 			Handles.Reserve(64);
+			ArchiveDatas.Reserve(64);
+			MemorySizes.Reserve(64);
+			ReleasedFrames.Reserve(64);
+			NameIndices.Reserve(64);
 		}
 
 
-		NS_INLINE void Add(nsName name, nsString path, uint8 flags, THandle handle)
+		NS_INLINE void Add(nsName name, nsString path, uint8 flags, THandle handle, ArchiveData archiveData = {})
 		{
+			NameIndices.Add(name, Names.GetCount());
 			Names.Add(name);
 			Paths.Add(path);
 			Flags.Add(flags);
 			RefCounts.Add(0);
 			Handles.Add(handle);
+			ArchiveDatas.Add(archiveData);
+			MemorySizes.Add(MemorySize{ 0, 0 });
+			ReleasedFrames.Add(0);
+		}
+
+
+		NS_NODISCARD_INLINE int Find(const nsName& name) const
+		{
+			const int* index = NameIndices.GetValueByKey(name);
+			return index ? *index : NS_ARRAY_INDEX_INVALID;
 		}
 
 
-		NS_INLINE int AddReference(int index, THandle handle)
+		NS_INLINE int AddReference(int index)
 		{
 			NS_Assert(index >= 0 && index < Handles.GetCount());
-			NS_Assert(handle == Handles[index]);
 
 			return ++RefCounts[index];
 		}
 
 
-		NS_INLINE int RemoveReference(int index, THandle handle)
+		NS_INLINE int RemoveReference(int index, uint64 frame)
 		{
 			NS_Assert(index >= 0 && index < Handles.GetCount());
-			NS_Assert(handle == Handles[index]);
 
 			if (--RefCounts[index] <= 0)
 			{
 				RefCounts[index] = 0;
 				Flags[index] |= AssetFlag_PendingUnload;
+				ReleasedFrames[index] = frame;
 			}
 
 			return RefCounts[index];
 		}
 
+
+		NS_NODISCARD_INLINE bool IsLoaded(int index) const
+		{
+			NS_Assert(index >= 0 && index < Flags.GetCount());
+			return (Flags[index] & AssetFlag_Loaded) != 0;
+		}
+
+
+		NS_NODISCARD_INLINE bool IsLoading(int index) const
+		{
+			NS_Assert(index >= 0 && index < Flags.GetCount());
+			return (Flags[index] & AssetFlag_Loading) != 0;
+		}
+
 	};
 
 
 
+// ================================================================================================ //
+// ARCHIVE
+// ================================================================================================ //
+private:
+	nsTArray<nsFileMappedView*> MountedArchives;
+
+public:
+	// Pack all asset files in <assetsPath> (include subfolders) into single archive file
+	bool CookAssetArchive(const nsString& assetsPath, const nsString& archiveFile) const;
+
+	// Map archive file and register all assets from its table of contents. Archive stays mapped until Shutdown()
+	bool MountAssetArchive(const nsString& archiveFile);
+
+
+
+// ================================================================================================ //
+// ASYNC LOAD
+// ================================================================================================ //
+// Load<Type>AssetAsync returns shared asset in loading state. File is read on IO thread, decoded on worker threads,
+// then finalized (engine resource created) on main thread in Update(). Releasing all shared assets before finalized cancels the load.
+private:
+	// Defined in nsAssetManager.cpp
+	struct AsyncLoadRequest;
+
+	nsAsyncLoadQueue AsyncLoadQueue;
+
+	// [Main thread] All requests that are not finalized yet
+	nsTArray<AsyncLoadRequest*> AsyncLoadRequests;
+	float AsyncLoadFinalizeBudgetMs;
+
+
+public:
+	// Max time spent finalizing async loaded assets per Update(). At least one asset is finalized per update
+	NS_INLINE void SetAsyncLoadFinalizeBudget(float milliseconds)
+	{
+		AsyncLoadFinalizeBudgetMs = milliseconds;
+	}
+
+
+	NS_NODISCARD_INLINE int GetAsyncLoadPendingCount() const
+	{
+		return AsyncLoadRequests.GetCount();
+	}
+
+
+	// [Main thread only] Block until all pending async loads are read, decoded on worker threads and finalized
+	void FlushAsyncLoads();
+
+private:
+	uint8& GetAssetFlags(nsEAssetType type, int index);
+	AsyncLoadRequest* FindAsyncLoadRequest(nsEAssetType type, int index) const;
+	AsyncLoadRequest* CreateAsyncLoadRequest(nsEAssetType type, int index);
+	void RequestAsyncLoad(nsEAssetType type, int index, nsEAssetLoadPriority priority);
+	void FinalizeAsyncLoadRequest(AsyncLoadRequest* request);
+	void DestroyAsyncLoadRequest(AsyncLoadRequest* request);
+
+	// Read and decode asset on main thread (reuses async request in flight), then finalize. Returns false if failed
+	bool LoadAssetImmediate(nsEAssetType type, int index);
+
+	void UpdateAsyncLoadRequests();
+
+
+
+// ================================================================================================ //
+// RESIDENCY
+// ================================================================================================ //
+// Assets stay loaded after all shared assets are released (marked pending unload), so loading them again is free.
+// Once CPU or GPU memory of loaded assets exceeds budget, Update() unloads least recently released assets
+// until usage drops below budget * NS_ENGINE_ASSET_RESIDENCY_EVICT_TARGET_RATIO.
+public:
+	struct ResidencyStats
+	{
+		uint64 CpuBytes;
+		uint64 GpuBytes;
+		int LoadedCount;
+		int UnreferencedCount;
+	};
+
+private:
+	static constexpr int RESIDENCY_TYPE_COUNT = static_cast<int>(nsEAssetType::ACTOR) + 1;
+
+	uint64 ResidencyCpuBudget;
+	uint64 ResidencyGpuBudget;
+	uint64 ResidencyFrame;
+	ResidencyStats ResidencyTypeStats[RESIDENCY_TYPE_COUNT];
+
+
+public:
+	// Budget in bytes of memory used by loaded assets, unreferenced assets are only unloaded while usage exceeds budget
+	NS_INLINE void SetResidencyBudget(uint64 cpuBytes, uint64 gpuBytes)
+	{
+		ResidencyCpuBudget = cpuBytes;
+		ResidencyGpuBudget = gpuBytes;
+	}
+
+
+	// Memory usage of loaded assets per asset type, updated in Update()
+	NS_NODISCARD_INLINE const ResidencyStats& GetResidencyStats(nsEAssetType type) const
+	{
+		return ResidencyTypeStats[static_cast<int>(type)];
+	}
+
+private:
+	// Compute memory size of loaded asset from engine resource
+	void UpdateAssetMemorySize(nsEAssetType type, int index);
+
+	void UnloadAsset(nsEAssetType type, int index);
+	void UpdateResidency();
+
+
+
 // ================================================================================================ //
 // TEXTURE
 // ================================================================================================ //
+// Texture asset is loaded with full mip chain. Streaming is opt-in, once nsSharedTextureAsset::RequestScreenSize() (or RequestTextureScreenSize()) is called for a texture,
+// mips above tail (see NS_ENGINE_TEXTURE_STREAMING_TAIL_SIZE) larger than requested size may be dropped and are streamed back by async load requests.
+// Once streamed mips exceed budget, Update() drops top mips of least recently requested textures until usage drops below budget * NS_ENGINE_ASSET_RESIDENCY_EVICT_TARGET_RATIO.
+// World renderers request screen size of material textures for visible meshes every frame (see nsRenderContextWorld::RequestTextureScreenSizes).
 private:
 	TAssetData<nsTextureID> TextureAsset;
 
+	struct TextureStreaming
+	{
+		// Mip table of texture asset file (smallest first). MipCount is 0 if texture asset is not streamable
+		nsAssetTextureMip Mips[NS_ENGINE_TEXTURE_MAX_MIP];
+		int MipCount;
+		int TailMipCount;
+
+		// Number of mips loaded into texture, counted from the smallest
+		int ResidentMipCount;
+
+		// Largest screen size requested since last update
+		int RequestedSize;
+		uint64 RequestedFrame;
+		bool bStreaming;
+
+		// Screen size was requested at least once since texture is loaded, texture is managed by streaming
+		bool bScreenSizeRequested;
+	};
+
+	// Streaming state per texture asset, same index as TextureAsset
+	nsTArray<TextureStreaming> TextureStreamings;
+
+	// Texture asset index by loaded texture handle, used by screen size requests from render path
+	nsTMap<nsTextureID, int> TextureAssetIndices;
+	uint64 TextureStreamingBudget;
+	uint64 TextureStreamingBytes;
+
 
 public:
-	void SaveTextureAsset(nsName name, nsTextureID texture, const nsString& folderPath, bool bIsEngineAsset);
+	void SaveTextureAsset(nsName name, nsTextureID texture, const nsString& folderPath, bool bIsEngineAsset, nsECompression compression = nsECompression::LZ4);
 	nsSharedTextureAsset LoadTextureAsset(const nsName& name);
-	void Internal_AddTextureAssetReference(int index, nsTextureID texture);
-	void Internal_RemoveTextureAssetReference(int index, nsTextureID texture);
+
+	nsSharedTextureAsset LoadTextureAssetAsync(const nsName& name, nsEAssetLoadPriority priority = nsEAssetLoadPriority::NORMAL);
+	void Internal_AddTextureAssetReference(int index);
+	void Internal_RemoveTextureAssetReference(int index);
+
+
+	NS_NODISCARD_INLINE bool Internal_IsTextureAssetLoaded(int index) const
+	{
+		return TextureAsset.IsLoaded(index) && TextureAsset.Handles[index].IsValid();
+	}
+
+
+	NS_NODISCARD_INLINE bool Internal_IsTextureAssetLoading(int index) const
+	{
+		return TextureAsset.IsLoading(index);
+	}
+
+
+	NS_NODISCARD_INLINE nsTextureID Internal_GetTextureAssetHandle(int index) const
+	{
+		return TextureAsset.Handles[index];
+	}
+
+
+	NS_INLINE void Internal_RequestTextureAssetScreenSize(int index, int screenSize)
+	{
+		TextureStreaming& streaming = TextureStreamings[index];
+		streaming.RequestedSize = nsMath::Max(streaming.RequestedSize, screenSize);
+		streaming.RequestedFrame = ResidencyFrame;
+		streaming.bScreenSizeRequested = true;
+	}
+
+
+	// Request screen size of texture in pixels for this frame. Ignored if texture is not loaded from texture asset
+	NS_INLINE void RequestTextureScreenSize(nsTextureID texture, int screenSize)
+	{
+		const int* index = TextureAssetIndices.GetValueByKey(texture);
+
+		if (index)
+		{
+			Internal_RequestTextureAssetScreenSize(*index, screenSize);
+		}
+	}
+
+
+	// Budget in bytes of streamed texture mips (mips above tail)
+	NS_INLINE void SetTextureStreamingBudget(uint64 bytes)
+	{
+		TextureStreamingBudget = bytes;
+	}
+
+
+	// Memory usage of streamed texture mips, updated in Update()
+	NS_NODISCARD_INLINE uint64 GetTextureStreamingBytes() const
+	{
+		return TextureStreamingBytes;
+	}
 
 private:
-	void UpdateTextureAssets();
+	void UnloadTextureAsset(int index);
+	void RequestTextureMipStream(int index, int mipCount);
+
+	// Keep <mipCount> smallest mips of texture, larger mips are removed
+	void DropTextureMips(int index, int mipCount);
+
+	void UpdateTextureStreaming();
 
 
 
@@ -151,13 +425,33 @@ private:
 
 
 public:
-	void SaveModelAsset(nsName name, const nsAssetModelMeshes& meshes, const nsString& folderPath, bool bIsEngineAsset);
+	void SaveModelAsset(nsName name, const nsAssetModelMeshes& meshes, const nsString& folderPath, bool bIsEngineAsset, nsECompression compression = nsECompression::LZ4);
 	nsSharedModelAsset LoadModelAsset(const nsName& name);
+
+	nsSharedModelAsset LoadModelAssetAsync(const nsName& name, nsEAssetLoadPriority priority = nsEAssetLoadPriority::NORMAL);
 	void Internal_AddModelAssetReference(int index);
 	void Internal_RemoveModelAssetReference(int index);
 
+
+	NS_NODISCARD_INLINE bool Internal_IsModelAssetLoaded(int index) const
+	{
+		return ModelAsset.IsLoaded(index) && ModelAsset.Handles[index].GetCount() > 0;
+	}
+
+
+	NS_NODISCARD_INLINE bool Internal_IsModelAssetLoading(int index) const
+	{
+		return ModelAsset.IsLoading(index);
+	}
+
+
+	NS_NODISCARD_INLINE const nsAssetModelMeshes& Internal_GetModelAssetHandle(int index) const
+	{
+		return ModelAsset.Handles[index];
+	}
+
 private:
-	void UpdateModelAssets();
+	void UnloadModelAsset(int index);
 
 
 
@@ -171,11 +465,31 @@ private:
 public:
 	void SaveSkeletonAsset(nsName name, nsAnimationSkeletonID skeleton, const nsString& folderPath, bool bIsEngineAsset);
 	nsSharedSkeletonAsset LoadSkeletonAsset(const nsName& name);
-	void Internal_AddSkeletonAssetReference(int index, nsAnimationSkeletonID skeleton);
-	void Internal_RemoveSkeletonAssetReference(int index, nsAnimationSkeletonID skeleton);
+
+	nsSharedSkeletonAsset LoadSkeletonAssetAsync(const nsName& name, nsEAssetLoadPriority priority = nsEAssetLoadPriority::NORMAL);
+	void Internal_AddSkeletonAssetReference(int index);
+	void Internal_RemoveSkeletonAssetReference(int index);
+
+
+	NS_NODISCARD_INLINE bool Internal_IsSkeletonAssetLoaded(int index) const
+	{
+		return SkeletonAsset.IsLoaded(index) && SkeletonAsset.Handles[index].IsValid();
+	}
+
+
+	NS_NODISCARD_INLINE bool Internal_IsSkeletonAssetLoading(int index) const
+	{
+		return SkeletonAsset.IsLoading(index);
+	}
+
+
+	NS_NODISCARD_INLINE nsAnimationSkeletonID Internal_GetSkeletonAssetHandle(int index) const
+	{
+		return SkeletonAsset.Handles[index];
+	}
 
 private:
-	void UpdateSkeletonAssets();
+	void UnloadSkeletonAsset(int index);
 
 
 
@@ -187,12 +501,32 @@ private:
 
 
 public:
-	void SaveAnimationAsset(nsName name, nsAnimationClipID clip, const nsString& folderPath, bool bIsEngineAsset);
+	void SaveAnimationAsset(nsName name, nsAnimationClipID clip, const nsString& folderPath, bool bIsEngineAsset, nsECompression compression = nsECompression::LZ4);
 	nsSharedAnimationAsset LoadAnimationAsset(const nsName& name);
-	void Internal_AddAnimationAssetReference(int index, nsAnimationClipID clip);
-	void Internal_RemoveAnimationAssetReference(int index, nsAnimationClipID clip);
+
+	nsSharedAnimationAsset LoadAnimationAssetAsync(const nsName& name, nsEAssetLoadPriority priority = nsEAssetLoadPriority::NORMAL);
+	void Internal_AddAnimationAssetReference(int index);
+	void Internal_RemoveAnimationAssetReference(int index);
+
+
+	NS_NODISCARD_INLINE bool Internal_IsAnimationAssetLoaded(int index) const
+	{
+		return AnimationAsset.IsLoaded(index) && AnimationAsset.Handles[index].IsValid();
+	}
+
+
+	NS_NODISCARD_INLINE bool Internal_IsAnimationAssetLoading(int index) const
+	{
+		return AnimationAsset.IsLoading(index);
+	}
+
+
+	NS_NODISCARD_INLINE nsAnimationClipID Internal_GetAnimationAssetHandle(int index) const
+	{
+		return AnimationAsset.Handles[index];
+	}
 
 private:
-	void UpdateAnimationAssets();
+	void UnloadAnimationAsset(int index);
 
 };
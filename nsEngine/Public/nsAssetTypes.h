@@ -2,6 +2,7 @@
 
 #include "nsAnimationTypes.h"
 #include "nsTextureTypes.h"
+#include "nsCompression.h"
 
 
 
@@ -25,11 +26,22 @@ enum class nsEAssetType : uint8
 
 
 
+enum class nsEAssetLoadPriority : uint8
+{
+	LOW = 0,
+	NORMAL,
+	HIGH,
+};
+
+
+
 struct nsAssetFileHeader
 {
 	int Signature;
 	int Version;
 	int Type;
+
+	// nsECompression of data that follows the header (see nsCompression::Compress)
 	int Compression;
 
 
@@ -55,6 +67,107 @@ public:
 
 
 
+struct nsAssetArchiveHeader
+{
+	int Signature;
+	int Version;
+	int EntryCount;
+	int Reserved;
+
+
+public:
+	nsAssetArchiveHeader() noexcept
+		: Signature(0)
+		, Version(0)
+		, EntryCount(0)
+		, Reserved(0)
+	{
+	}
+
+};
+
+
+
+// Table of contents entry in asset archive. Entry data is the content of the asset file (header included) stored as is,
+// asset file payload is already compressed (nsAssetFileHeader::Compression) and texture mips must stay addressable for streaming.
+// Archive layout: [nsAssetArchiveHeader][nsAssetArchiveEntry * EntryCount][data aligned to NS_ENGINE_ASSET_ARCHIVE_DATA_ALIGNMENT ...]
+struct nsAssetArchiveEntry
+{
+	nsName Name;
+	uint64 DataOffset;
+	uint32 DataSize;
+	uint8 Type;
+	uint8 Reserved[19];
+};
+
+static_assert(sizeof(nsAssetArchiveHeader) == 16, "Asset archive header size must be 16 bytes!");
+static_assert(sizeof(nsAssetArchiveEntry) == 64, "Asset archive entry size must be 64 bytes!");
+
+
+
+// Texture asset data (asset file version 2). Mips are stored smallest first, so tail mips are loaded with single contiguous read and
+// larger mips are streamed later. Mip data is compressed per mip (nsCompression::Compress) with compression from asset file header.
+// Layout: [nsAssetFileHeader][nsAssetTextureHeader][nsAssetTextureMip * MipCount][mip data ...]
+struct nsAssetTextureHeader
+{
+	int Width;
+	int Height;
+	int Format;
+	int MipCount;
+};
+
+
+struct nsAssetTextureMip
+{
+	int Width;
+	int Height;
+
+	// Offset from start of asset file
+	uint32 DataOffset;
+	uint32 DataSize;
+
+	// Size of mip pixels after decompression
+	uint32 PixelSize;
+	uint32 Reserved;
+};
+
+static_assert(sizeof(nsAssetTextureHeader) == 16, "Asset texture header size must be 16 bytes!");
+static_assert(sizeof(nsAssetTextureMip) == 24, "Asset texture mip size must be 24 bytes!");
+
+
+
+// Asset file info cached in asset registry index. Asset file header is read again only if modified time or size changed
+struct nsAssetRegistryEntry
+{
+	nsString File;
+	uint64 ModifiedTime;
+	int64 Size;
+
+	// NONE if not a valid asset file
+	nsEAssetType Type;
+
+
+public:
+	nsAssetRegistryEntry() noexcept
+		: ModifiedTime(0)
+		, Size(0)
+		, Type(nsEAssetType::NONE)
+	{
+	}
+
+
+	friend NS_INLINE void operator|(nsStream& stream, nsAssetRegistryEntry& entry) noexcept
+	{
+		stream | entry.File;
+		stream | entry.ModifiedTime;
+		stream | entry.Size;
+		stream | entry.Type;
+	}
+
+};
+
+
+
 struct nsAssetInfo
 {
 	nsName Name;
@@ -84,7 +197,6 @@ class NS_ENGINE_API nsSharedTextureAsset
 private:
 	int AssetId;
 	nsName Name;
-	nsTextureID Texture;
 
 
 public:
@@ -94,28 +206,28 @@ public:
 	~nsSharedTextureAsset() noexcept;
 
 private:
-	nsSharedTextureAsset(int assetId, nsName name, nsTextureID texture) noexcept;
+	nsSharedTextureAsset(int assetId, nsName name) noexcept;
 	void Copy(const nsSharedTextureAsset& other) noexcept;
 
 public:
 	void Release() noexcept;
 
+	// Asset is loaded and ready to use
+	NS_NODISCARD bool IsValid() const noexcept;
 
-	NS_NODISCARD_INLINE bool IsValid() const noexcept
-	{
-		return AssetId != -1 && Texture.IsValid();
-	}
+	// Asset is requested by async load and not finalized yet
+	NS_NODISCARD bool IsLoading() const noexcept;
 
+	NS_NODISCARD nsTextureID GetTexture() const noexcept;
 
-	NS_NODISCARD_INLINE nsName GetName() const noexcept
-	{
-		return Name;
-	}
+	// Request mips for mip streaming, <screenSize> is the largest size in pixels the texture is drawn on screen this frame.
+	// Loaded texture only contains tail mips until requested, unrequested top mips are dropped when streaming budget is exceeded
+	void RequestScreenSize(int screenSize) const noexcept;
 
 
-	NS_NODISCARD_INLINE nsTextureID GetTexture() const noexcept
+	NS_NODISCARD_INLINE nsName GetName() const noexcept
 	{
-		return Texture;
+		return Name;
 	}
 
 
@@ -137,10 +249,8 @@ public:
 			Release();
 			AssetId = rhs.AssetId;
 			Name = rhs.Name;
-			Texture = rhs.Texture;
 			rhs.AssetId = -1;
 			rhs.Name = "";
-			rhs.Texture = nsTextureID::INVALID;
 		}
 
 		return *this;
@@ -246,7 +356,6 @@ class NS_ENGINE_API nsSharedModelAsset
 private:
 	int AssetId;
 	nsName Name;
-	nsAssetModelMeshes Meshes;
 
 
 public:
@@ -256,17 +365,19 @@ public:
 	~nsSharedModelAsset() noexcept;
 
 private:
-	nsSharedModelAsset(int assetId, nsName name, nsAssetModelMeshes meshes) noexcept;
+	nsSharedModelAsset(int assetId, nsName name) noexcept;
 	void Copy(const nsSharedModelAsset& other) noexcept;
 
 public:
 	void Release() noexcept;
 
+	// Asset is loaded and ready to use
+	NS_NODISCARD bool IsValid() const noexcept;
 
-	NS_NODISCARD_INLINE bool IsValid() const noexcept
-	{
-		return AssetId != -1 && Meshes.GetCount() > 0;
-	}
+	// Asset is requested by async load and not finalized yet
+	NS_NODISCARD bool IsLoading() const noexcept;
+
+	NS_NODISCARD const nsAssetModelMeshes& GetMeshes() const noexcept;
 
 
 	NS_NODISCARD_INLINE nsName GetName() const noexcept
@@ -275,12 +386,6 @@ public:
 	}
 
 
-	NS_NODISCARD_INLINE const nsAssetModelMeshes& GetMeshes() const noexcept
-	{
-		return Meshes;
-	}
-
-
 	NS_INLINE nsSharedModelAsset& operator=(const nsSharedModelAsset& rhs) noexcept
 	{
 		if (this != &rhs)
@@ -299,10 +404,8 @@ public:
 			Release();
 			AssetId = rhs.AssetId;
 			Name = rhs.Name;
-			Meshes = rhs.Meshes;
 			rhs.AssetId = -1;
 			rhs.Name = "";
-			rhs.Meshes.Clear();
 		}
 
 		return *this;
@@ -332,7 +435,6 @@ class NS_ENGINE_API nsSharedSkeletonAsset
 private:
 	int AssetId;
 	nsName Name;
-	nsAnimationSkeletonID Skeleton;
 
 
 public:
@@ -342,17 +444,19 @@ public:
 	~nsSharedSkeletonAsset() noexcept;
 
 private:
-	nsSharedSkeletonAsset(int assetId, nsName name, nsAnimationSkeletonID skeleton) noexcept;
+	nsSharedSkeletonAsset(int assetId, nsName name) noexcept;
 	void Copy(const nsSharedSkeletonAsset& other) noexcept;
 
 public:
 	void Release() noexcept;
 
+	// Asset is loaded and ready to use
+	NS_NODISCARD bool IsValid() const noexcept;
 
-	NS_NODISCARD_INLINE bool IsValid() const noexcept
-	{
-		return AssetId != -1 && Skeleton.IsValid();
-	}
+	// Asset is requested by async load and not finalized yet
+	NS_NODISCARD bool IsLoading() const noexcept;
+
+	NS_NODISCARD nsAnimationSkeletonID GetSkeleton() const noexcept;
 
 
 	NS_NODISCARD_INLINE nsName GetName() const noexcept
@@ -361,12 +465,6 @@ public:
 	}
 
 
-	NS_NODISCARD_INLINE nsAnimationSkeletonID GetSkeleton() const noexcept
-	{
-		return Skeleton;
-	}
-
-
 	NS_INLINE nsSharedSkeletonAsset& operator=(const nsSharedSkeletonAsset& rhs) noexcept
 	{
 		if (this != &rhs)
@@ -385,10 +483,8 @@ public:
 			Release();
 			AssetId = rhs.AssetId;
 			Name = rhs.Name;
-			Skeleton = rhs.Skeleton;
 			rhs.AssetId = -1;
 			rhs.Name = "";
-			rhs.Skeleton = nsAnimationSkeletonID::INVALID;
 		}
 
 		return *this;
@@ -397,7 +493,7 @@ public:
 
 	NS_INLINE bool operator==(const nsSharedSkeletonAsset& rhs) const noexcept
 	{
-		return AssetId == rhs.AssetId && Skeleton == rhs.Skeleton;
+		return AssetId == rhs.AssetId;
 	}
 
 
@@ -419,7 +515,6 @@ class NS_ENGINE_API nsSharedAnimationAsset
 private:
 	int AssetId;
 	nsName Name;
-	nsAnimationClipID Clip;
 
 
 public:
@@ -429,17 +524,19 @@ public:
 	~nsSharedAnimationAsset() noexcept;
 
 private:
-	nsSharedAnimationAsset(int assetId, nsName name, nsAnimationClipID clip) noexcept;
+	nsSharedAnimationAsset(int assetId, nsName name) noexcept;
 	void Copy(const nsSharedAnimationAsset& other) noexcept;
 
 public:
 	void Release() noexcept;
 
+	// Asset is loaded and ready to use
+	NS_NODISCARD bool IsValid() const noexcept;
 
-	NS_NODISCARD_INLINE bool IsValid() const noexcept
-	{
-		return AssetId != -1 && Clip.IsValid();
-	}
+	// Asset is requested by async load and not finalized yet
+	NS_NODISCARD bool IsLoading() const noexcept;
+
+	NS_NODISCARD nsAnimationClipID GetClip() const noexcept;
 
 
 	NS_NODISCARD_INLINE nsName GetName() const noexcept
@@ -448,12 +545,6 @@ public:
 	}
 
 
-	NS_NODISCARD_INLINE nsAnimationClipID GetClip() const noexcept
-	{
-		return Clip;
-	}
-
-
 	NS_INLINE nsSharedAnimationAsset& operator=(const nsSharedAnimationAsset& rhs) noexcept
 	{
 		if (this != &rhs)
@@ -472,10 +563,8 @@ public:
 			Release();
 			AssetId = rhs.AssetId;
 			Name = rhs.Name;
-			Clip = rhs.Clip;
 			rhs.AssetId = -1;
 			rhs.Name = "";
-			rhs.Clip = nsAnimationClipID::INVALID;
 		}
 
 		return *this;
@@ -484,7 +573,7 @@ public:
 
 	NS_INLINE bool operator==(const nsSharedAnimationAsset& rhs) const noexcept
 	{
-		return AssetId == rhs.AssetId && Clip == rhs.Clip;
+		return AssetId == rhs.AssetId;
 	}
 
 
@@ -40,6 +40,12 @@
 // Default texture name (black)
 #define NS_ENGINE_TEXTURE_DEFAULT_BLACK_NAME						"tex_default_black"
 
+// Texture asset mips with width and height up to this size are always loaded with the texture, larger mips are streamed on request
+#define NS_ENGINE_TEXTURE_STREAMING_TAIL_SIZE						(64)
+
+// Default budget (MiB) of streamed texture mips (mips above tail), override with command line -texturestreamingbudget=<MiB>
+#define NS_ENGINE_TEXTURE_STREAMING_BUDGET_MB						(512)
+
 // Maximum material uniform buffer size in bytes
 #define NS_ENGINE_MATERIAL_UNIFORM_SIZE								(256)
 
@@ -58,18 +64,55 @@
 // Maximum bones per skeleton
 #define NS_ENGINE_ANIMATION_SKELETON_MAX_BONE						(64)
 
+// Default maximum error of compressed animation clip (cm), used when skeleton does not specify one
+#define NS_ENGINE_ANIMATION_COMPRESSION_ERROR						(0.01f)
+
+// Maximum clips sampled by single animation layer (blend space samples)
+#define NS_ENGINE_ANIMATION_LAYER_MAX_SAMPLE						(8)
+
 // Maximum navigation agent
 #define NS_ENGINE_NAVIGATION_MAX_AGENT								(64)
 
 // Asset file signature (magic number) 
 #define NS_ENGINE_ASSET_FILE_SIGNATURE								(0x0000734E) // Ns
 
-// Asset file version
-#define NS_ENGINE_ASSET_FILE_VERSION								(1)
+// Asset file version. Version 2 stores texture mips smallest first with mip table (streamable).
+// Version 3 stores skeleton compression error and compressed animation clip tracks
+#define NS_ENGINE_ASSET_FILE_VERSION								(3)
 
 // Asset file extension
 #define NS_ENGINE_ASSET_FILE_EXTENSION								TEXT(".nsbin")
 
+// Asset archive signature (magic number)
+#define NS_ENGINE_ASSET_ARCHIVE_SIGNATURE							(0x6B61734E) // Nsak
+
+// Asset archive version
+#define NS_ENGINE_ASSET_ARCHIVE_VERSION								(1)
+
+// Asset archive extension
+#define NS_ENGINE_ASSET_ARCHIVE_EXTENSION							TEXT(".nspak")
+
+// Alignment of asset data in archive
+#define NS_ENGINE_ASSET_ARCHIVE_DATA_ALIGNMENT						(64)
+
+// Asset registry index signature (magic number)
+#define NS_ENGINE_ASSET_REGISTRY_SIGNATURE							(0x6752734E) // NsRg
+
+// Asset registry index version
+#define NS_ENGINE_ASSET_REGISTRY_VERSION							(1)
+
+// Asset registry index extension
+#define NS_ENGINE_ASSET_REGISTRY_EXTENSION							TEXT(".nsreg")
+
+// Default budget (MiB) of CPU memory used by loaded assets, override with command line -assetcpubudget=<MiB>
+#define NS_ENGINE_ASSET_RESIDENCY_CPU_BUDGET_MB						(1024)
+
+// Default budget (MiB) of GPU memory used by loaded assets, override with command line -assetgpubudget=<MiB>
+#define NS_ENGINE_ASSET_RESIDENCY_GPU_BUDGET_MB						(1024)
+
+// Unreferenced assets are evicted once usage exceeds budget, until usage drops below budget * ratio
+#define NS_ENGINE_ASSET_RESIDENCY_EVICT_TARGET_RATIO				(0.85f)
+
 // Maximum texture count in material asset
 #define NS_ENGINE_ASSET_MATERIAL_MAX_TEXTURE						(8)
 
@@ -122,25 +165,27 @@ constexpr const wchar_t* ns_VendorName(int vendorId)
 
 
 
-#define NS_ENGINE_DECLARE_HANDLE(type, managerClass)										\
-class type																					\
-{																							\
-private:																					\
-	int Id;																					\
-public:																						\
-	static NS_ENGINE_API type INVALID;														\
-private:																					\
-	type(int id) noexcept : Id(id) {}														\
-public:																						\
-	type() noexcept : Id(-1) {}																\
-	NS_NODISCARD_INLINE bool IsValid() const noexcept { return Id != -1; }					\
-	NS_NODISCARD_INLINE int GetId() const noexcept { return Id; }							\
-	NS_NODISCARD_INLINE uint64 GetHash() const noexcept { return static_cast<uint64>(Id); } \
-	NS_INLINE bool operator==(const type& rhs) const noexcept { return Id == rhs.Id; }		\
-	NS_INLINE bool operator!=(const type& rhs) const noexcept { return Id != rhs.Id; }		\
-	NS_INLINE bool operator<(const type& rhs) const noexcept { return Id < rhs.Id; }		\
-	NS_INLINE bool operator>(const type& rhs) const noexcept { return Id > rhs.Id; }		\
-	friend class managerClass;																\
+#define NS_ENGINE_DECLARE_HANDLE(type, managerClass)																					\
+class type																																\
+{																																		\
+private:																																\
+	int Id;																																\
+	uint32 Generation;																													\
+public:																																	\
+	static NS_ENGINE_API type INVALID;																									\
+private:																																\
+	type(int id, uint32 generation) noexcept : Id(id), Generation(generation) {}														\
+public:																																	\
+	type() noexcept : Id(-1), Generation(0) {}																							\
+	NS_NODISCARD_INLINE bool IsValid() const noexcept { return Id != -1; }																\
+	NS_NODISCARD_INLINE int GetId() const noexcept { return Id; }																		\
+	NS_NODISCARD_INLINE uint32 GetGeneration() const noexcept { return Generation; }													\
+	NS_NODISCARD_INLINE uint64 GetHash() const noexcept { return (static_cast<uint64>(Generation) << 32) | static_cast<uint32>(Id); }	\
+	NS_INLINE bool operator==(const type& rhs) const noexcept { return Id == rhs.Id && Generation == rhs.Generation; }					\
+	NS_INLINE bool operator!=(const type& rhs) const noexcept { return !(*this == rhs); }												\
+	NS_INLINE bool operator<(const type& rhs) const noexcept { return Id < rhs.Id; }													\
+	NS_INLINE bool operator>(const type& rhs) const noexcept { return Id > rhs.Id; }													\
+	friend class managerClass;																											\
 };
 
 #define NS_ENGINE_DEFINE_HANDLE(type) type type::INVALID
@@ -280,3 +325,44 @@ NS_NODISCARD_INLINE void ns_DestroyObjectByClass(nsObject* obj) noexcept
 	const nsClass* objClass = obj->GetClass();
 	objClass->DestroyInstance(g_EngineDefaultMemory, obj);
 }
+
+
+
+// Per-frame transient memory, one linear allocator for each NS_ENGINE_FRAME_BUFFERING slot.
+// A slot is cleared when engine begins a new frame, so allocations remain valid for NS_ENGINE_FRAME_BUFFERING frames.
+namespace nsFrameMemory
+{
+	extern NS_ENGINE_API void Initialize() noexcept;
+
+	// [Main thread only] Move to next slot and release all of its allocations
+	extern NS_ENGINE_API void BeginFrame() noexcept;
+
+	// [Main thread only] Get allocator of current frame
+	NS_NODISCARD extern NS_ENGINE_API nsMemoryLinear& Get() noexcept;
+
+	// Number of frames started since Initialize()
+	NS_NODISCARD extern NS_ENGINE_API uint64 GetFrameNumber() noexcept;
+
+};
+
+
+// nsTArray allocator for per-frame transient data.
+// Array must be released with Clear(true) on a new frame before it is reused, its memory is recycled after NS_ENGINE_FRAME_BUFFERING frames.
+class nsTArrayFrameAllocator
+{
+public:
+	NS_NODISCARD_INLINE static void* Reallocate(void* data, int oldSize, int newSize, int alignment) noexcept
+	{
+		return nsFrameMemory::Get().Reallocate(data, oldSize, newSize, alignment);
+	}
+
+
+	NS_INLINE static void Free(void* data, int size) noexcept
+	{
+	}
+
+};
+
+
+template<typename T>
+using nsTFrameArray = nsTArray<T, nsTArrayFrameAllocator>;
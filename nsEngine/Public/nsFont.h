@@ -16,7 +16,7 @@ public:
 	NS_NODISCARD static NS_ENGINE_API nsRectFloat CalculateRect(nsFontID font, const nsPointFloat& position, const wchar_t* text, int length);
 	NS_NODISCARD static NS_ENGINE_API nsRectFloat CalculateSelectedRect(nsFontID font, const nsPointFloat& position, const wchar_t* text, int length, int selectedIndex, int selectedCount) noexcept;
 	NS_NODISCARD static NS_ENGINE_API float CalculateCaretPositionX(nsFontID font, const nsString& text, int caretCharIndex);
-	static NS_ENGINE_API int GenerateVertices(nsFontID font, nsPointFloat& position, const wchar_t* text, int length, const nsColor& color, nsTArray<nsVertexGUI>& outVertices, nsTArray<uint32>& outIndices);
+	static NS_ENGINE_API int GenerateVertices(nsFontID font, nsPointFloat& position, const wchar_t* text, int length, const nsColor& color, nsTFrameArray<nsVertexGUI>& outVertices, nsTFrameArray<uint32>& outIndices);
 	NS_NODISCARD static NS_ENGINE_API float GetFontSize(nsFontID font);
 	NS_NODISCARD static NS_ENGINE_API nsTextureID GetFontTexture(nsFontID font);
 	NS_NODISCARD static NS_ENGINE_API nsFontID GetDefaultFont() noexcept;
@@ -390,9 +390,11 @@ private:
 		uint8 bIsText;
 	};
 
-	nsTArray<nsVertexGUI> DrawVertices;
-	nsTArray<uint32> DrawIndices;
-	nsTArray<DrawData> DrawDatas;
+	// Draw data is allocated from frame memory and only valid on the frame BeginRender() was called
+	uint64 DrawFrameNumber;
+	nsTFrameArray<nsVertexGUI> DrawVertices;
+	nsTFrameArray<uint32> DrawIndices;
+	nsTFrameArray<DrawData> DrawDatas;
 	nsTArrayInline<nsMaterialID, 32> DrawBindMaterials;
 
 	nsTArray<nsGUIDrawCallPerRegion> DrawCallData;
@@ -210,7 +210,7 @@ public:
 			return false;
 		}
 
-		if (!MaterialFlags.IsValid(material.Id))
+		if (!MaterialFlags.IsValid(material.Id, material.Generation))
 		{
 			return false;
 		}
@@ -247,6 +247,13 @@ public:
 	}
 
 
+	NS_NODISCARD_INLINE const nsTMap<nsName, nsTextureID>& GetMaterialParameterTextures(nsMaterialID material) const noexcept
+	{
+		NS_Assert(IsMaterialValid(material));
+		return MaterialParameterTables[material.Id].Textures;
+	}
+
+
 	NS_NODISCARD_INLINE VkDescriptorSet GetMaterialDescriptorSet(nsMaterialID material) const noexcept
 	{
 		NS_Assert(IsMaterialValid(material));
@@ -95,7 +95,7 @@ private:
 		nsVulkanBuffer* VertexSkinBuffer;
 		nsVulkanBuffer* IndexBuffer;
 		nsVulkanBuffer* StagingBuffer;
-		nsTArray<nsMeshBindingInfo> MeshBindingInfos;
+		nsTFrameArray<nsMeshBindingInfo> MeshBindingInfos;
 		nsTArray<nsMeshID> MeshToDestroys;
 	};
 
@@ -112,6 +112,7 @@ private:
 		MeshFlag_Loaded				= (1 << 2),
 		MeshFlag_AlwaysLoaded		= (1 << 3),
 		MeshFlag_PendingDestroy		= (1 << 4),
+		MeshFlag_BoundDirty			= (1 << 5),
 	};
 
 	nsTArrayFreeList<nsName> MeshNames;
@@ -171,7 +172,7 @@ public:
 
 	NS_NODISCARD_INLINE bool IsMeshValid(nsMeshID mesh) const noexcept
 	{
-		return mesh.IsValid() && MeshFlags.IsValid(mesh.Id);
+		return mesh.IsValid() && MeshFlags.IsValid(mesh.Id, mesh.Generation);
 	}
 
 
@@ -230,6 +231,15 @@ public:
 	}
 
 
+	// Bound of LOD 0, recomputed when mesh is bound after vertex data changed
+	NS_NODISCARD_INLINE const nsMeshBound& GetMeshBound(nsMeshID mesh) const noexcept
+	{
+		NS_Assert(IsMeshValid(mesh));
+
+		return MeshBounds[mesh.Id];
+	}
+
+
 	NS_NODISCARD_INLINE const nsMeshDrawData& GetMeshDrawData(nsMeshID mesh) const noexcept
 	{
 		NS_Assert(IsMeshValid(mesh));
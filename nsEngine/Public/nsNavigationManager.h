@@ -39,7 +39,7 @@ public:
 
 	NS_NODISCARD_INLINE bool IsAgentValid(nsNavigationAgentID agent) const
 	{
-		return agent.IsValid() && AgentStates.IsValid(agent.Id);
+		return agent.IsValid() && AgentStates.IsValid(agent.Id, agent.Generation);
 	}
 
 
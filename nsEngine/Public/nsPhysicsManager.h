@@ -21,6 +21,9 @@ private:
 	nsTArray<nsName> SceneNames;
 	nsTArray<physx::PxScene*> SceneObjects;
 
+	// Active actor poses gathered in parallel by SceneSyncTransforms
+	nsTArray<nsTransform> SyncTransforms;
+
 
 public:
 	bool bGlobalSimulate;
@@ -51,6 +51,9 @@ protected:
 public:
 	bool bGenerateNavMesh;
 
+	// Request screen size of material textures so texture asset mips can be streamed, applied on next mesh register (transform/mesh/material change)
+	bool bTextureStreaming;
+
 
 public:
 	nsMeshComponent();
@@ -89,6 +92,7 @@ class NS_ENGINE_API nsSkeletalMeshComponent : public nsMeshComponent
 private:
 	nsSharedSkeletonAsset SkeletonAsset;
 	nsAnimationInstanceID AnimationInstance;
+	nsAnimationGraph* AnimationGraph;
 
 public:
 	bool bDebugDrawSkeleton;
@@ -109,6 +113,12 @@ public:
 	void PlayAnimation(nsSharedAnimationAsset animation, float playRate, bool bLoop);
 	void StopAnimation();
 
+	// Cross-fade from currently played animation to <animation> over <blendDuration> seconds
+	void BlendAnimation(nsSharedAnimationAsset animation, float blendDuration, float playRate, bool bLoop, nsEAnimationTransitionMode transitionMode = nsEAnimationTransitionMode::SMOOTH);
+
+	// Animation graph layered on top of played animation, kept when skeleton changes
+	void SetAnimationGraph(nsAnimationGraph* graph);
+
 
 	NS_NODISCARD_INLINE nsSharedSkeletonAsset GetSkeleton() const
 	{
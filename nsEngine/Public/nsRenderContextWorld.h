@@ -30,6 +30,9 @@ struct nsRenderMeshData
 	nsMaterialID Material;
 	nsMeshID Mesh;
 	nsAnimationInstanceID AnimationInstance;
+
+	// Request screen size of material textures for texture streaming
+	bool bTextureStreaming;
 };
 
 
@@ -43,7 +46,7 @@ struct nsRenderDrawCallPerInstance
 struct nsRenderDrawCallPerMesh
 {
 	nsMeshID Mesh;
-	nsTArray<nsRenderDrawCallPerInstance> Instances;
+	nsTFrameArray<nsRenderDrawCallPerInstance> Instances;
 
 
 public:
@@ -64,7 +67,7 @@ public:
 struct nsRenderDrawCallPerMaterial
 {
 	nsMaterialID Material;
-	nsTArray<nsRenderDrawCallPerMesh> Meshes;
+	nsTFrameArray<nsRenderDrawCallPerMesh> Meshes;
 
 
 public:
@@ -138,10 +141,11 @@ private:
 	nsTArray<nsVertexPrimitive> PrimitiveBatchMeshVertices;
 	nsTArray<uint32> PrimitiveBatchMeshIndices;
 
-	nsTArray<nsMaterialID> DrawBindMaterials;
-	nsTArray<nsMeshBindingInfo> DrawBindMeshes;
+	// Draw call data is rebuilt every frame from frame memory
+	nsTFrameArray<nsMaterialID> DrawBindMaterials;
+	nsTFrameArray<nsMeshBindingInfo> DrawBindMeshes;
 	//nsTArray<nsAnimationInstanceID> DrawBindAnimationInstances;
-	nsTArray<nsRenderDrawCallPerMaterial> DrawCallMeshes;
+	nsTFrameArray<nsRenderDrawCallPerMaterial> DrawCallMeshes;
 	nsRenderDrawCallPrimitiveBatch DrawCallPrimitiveBatchMesh;
 	nsRenderDrawCallPrimitiveBatch DrawCallPrimitiveBatchLine;
 
@@ -155,16 +159,20 @@ public:
 	void AddPrimitiveLine(const nsVector3& start, const nsVector3& end, const nsColor& color) noexcept;
 	void AddPrimitiveLine_Circle(const nsVector3& center, float radius, float halfArcRadian, nsEAxisType arcAxis, const nsColor& color) noexcept;
 	void AddPrimitiveLine_CircleAroundAxis(const nsVector3& center, const nsVector3& axis, float radius, float halfArcRadian, const nsColor& color) noexcept;
+	void BeginFrame(int frameIndex) noexcept;
 	void UpdateResourcesAndBuildDrawCalls(int frameIndex) noexcept;
 
+	// Request screen size (projected bound diameter in pixels) of material textures of render meshes from camera view
+	void RequestTextureScreenSizes(const nsMatrix4& projection, const nsVector3& viewPosition, int renderTargetHeight) noexcept;
+
 
 	NS_NODISCARD_INLINE bool IsRenderMeshValid(nsRenderMeshID renderMesh) const noexcept
 	{
-		return renderMesh.IsValid() && RenderMeshes.IsValid(renderMesh.Id);
+		return renderMesh.IsValid() && RenderMeshes.IsValid(renderMesh.Id, renderMesh.Generation);
 	}
 
 
-	NS_NODISCARD_INLINE nsRenderMeshID AddRenderMesh(nsMeshID mesh, nsMaterialID material, const nsMatrix4& transform, nsAnimationInstanceID animationInstance) noexcept
+	NS_NODISCARD_INLINE nsRenderMeshID AddRenderMesh(nsMeshID mesh, nsMaterialID material, const nsMatrix4& transform, nsAnimationInstanceID animationInstance, bool bTextureStreaming) noexcept
 	{
 		NS_Assert(mesh != nsMeshID::INVALID);
 		NS_Assert(material != nsMaterialID::INVALID);
@@ -174,11 +182,14 @@ public:
 		value.Material = material;
 		value.Mesh = mesh;
 		value.AnimationInstance = animationInstance;
+		value.bTextureStreaming = bTextureStreaming;
+
+		const int id = RenderMeshes.Add(value);
 
-		return RenderMeshes.Add(value);
+		return nsRenderMeshID(id, RenderMeshes.GetGeneration(id));
 	}
 
-	NS_INLINE void UpdateRenderMesh(nsRenderMeshID id, nsMeshID newMesh, nsMaterialID newMaterial, const nsMatrix4& newTransform, nsAnimationInstanceID animationInstance) noexcept
+	NS_INLINE void UpdateRenderMesh(nsRenderMeshID id, nsMeshID newMesh, nsMaterialID newMaterial, const nsMatrix4& newTransform, nsAnimationInstanceID animationInstance, bool bTextureStreaming) noexcept
 	{
 		NS_Assert(IsRenderMeshValid(id));
 		NS_Assert(newMesh != nsMeshID::INVALID);
@@ -189,6 +200,7 @@ public:
 		value.Material = newMaterial;
 		value.Mesh = newMesh;
 		value.AnimationInstance = animationInstance;
+		value.bTextureStreaming = bTextureStreaming;
 	}
 
 	NS_INLINE void RemoveRenderMesh(nsRenderMeshID& id) noexcept
@@ -222,7 +234,7 @@ public:
 
 
 	// Get draw call data (meshes)
-	NS_NODISCARD_INLINE const nsTArray<nsRenderDrawCallPerMaterial>& GetDrawCallMeshes() const noexcept
+	NS_NODISCARD_INLINE const nsTFrameArray<nsRenderDrawCallPerMaterial>& GetDrawCallMeshes() const noexcept
 	{
 		return DrawCallMeshes;
 	}
@@ -55,6 +55,7 @@ private:
 	nsTArray<uint32> ShaderFlags;
 	nsTArray<nsShaderCompileTask> ShaderCompileTasks;
 	nsTArray<nsVulkanShader*> ShaderResources;
+	nsThreadTaskCounter CompileTaskCounter;
 
 
 public:
@@ -16,6 +16,9 @@ private:
 		VkDescriptorSet TextureDescriptorSet;
 		nsTArray<nsTextureID> TextureToBinds;
 		nsTArray<nsTextureID> TextureToDestroys;
+
+		// GPU resources replaced by UpdateTextureMips(), may still be used by frame in flight
+		nsTArray<nsTextureResource> ResourceToDestroys;
 	};
 
 	Frame FrameDatas[NS_ENGINE_FRAME_BUFFERING];
@@ -46,6 +49,8 @@ public:
 private:
 	nsTextureID AllocateTexture(nsName name) noexcept;
 	void DeallocateTexture(nsTextureID texture) noexcept;
+	void CreateTexture2DResource(int id) noexcept;
+	void DestroyTextureResource(nsTextureResource& resource) noexcept;
 
 public:
 	// Find valid texture (not marked as pending destroy) by name
@@ -67,6 +72,10 @@ public:
 	// Update texture mip data. Only valid for texture2D
 	void UpdateTextureMipData(nsTextureID texture, int mipIndex, const uint8* pixelData, int pixelDataSize) noexcept;
 
+	// Replace all mips of texture 2D (mip 0 is the largest, texture size is taken from mip 0). Used by mip streaming to add/drop top mips.
+	// GPU resource is recreated with new mip count, previous resource is destroyed once frame in flight is done
+	void UpdateTextureMips(nsTextureID texture, nsTArrayInline<nsTextureData::Mip, NS_ENGINE_TEXTURE_MAX_MIP>&& mips) noexcept;
+
 	// Get default texture 2D white (32x32)
 	NS_NODISCARD nsTextureID GetDefaultTexture2D_White() noexcept;
 
@@ -83,7 +92,7 @@ public:
 
 	NS_NODISCARD_INLINE bool IsTextureValid(nsTextureID texture) const noexcept
 	{
-		return texture.IsValid() && TextureFlags.IsValid(texture.Id);
+		return texture.IsValid() && TextureFlags.IsValid(texture.Id, texture.Generation);
 	}
 
 
@@ -7,6 +7,12 @@
 NS_ENGINE_DECLARE_HANDLE(nsTextureID, nsTextureManager)
 
 
+NS_NODISCARD_INLINE uint64 ns_GetHash(nsTextureID texture) noexcept
+{
+	return texture.GetHash();
+}
+
+
 
 enum class nsETextureFormat : uint8
 {
@@ -19,7 +19,7 @@ private:
 	physx::PxScene* PhysicsScene;
 	nsTArray<nsLevel*> Levels;
 
-	nsMemory ActorMemory;
+	nsMemoryPool ActorMemory;
 	nsTArray<nsActor*> ActorList;
 	nsTArray<nsActor*> StartStopPlayActors;
 	nsTArray<nsActor*> PrePhysicsTickUpdateActors;
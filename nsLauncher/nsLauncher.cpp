@@ -3,6 +3,7 @@
 #include "nsThreadPool.h"
 #include "nsCommandLines.h"
 #include "nsEngine.h"
+#include "nsAssetImporter.h"
 
 
 
@@ -29,6 +30,19 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR pCmdLine
 	nsThreadPool::Initialize();
 
 
+	// Headless asset import, ex: -import=SourceAssets/Characters -importdst=Characters
+	if (nsCommandLines::Get().HasCommand(TEXT("import")))
+	{
+		const bool bSucceeded = nsAssetImporter::Get().ImportAssetsFromCommandLines();
+
+		nsThreadPool::Shutdown();
+
+		nsPlatform::Shutdown();
+
+		return bSucceeded ? 0 : 1;
+	}
+
+
 	// TODO: Init online platform (Steam, etc.)
 
 
@@ -0,0 +1,383 @@
+#include "nsUnitTest.h"
+#include "nsAlgorithm.h"
+
+
+
+static uint32 TestAlgorithm_Random(uint32& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return seed >> 8;
+}
+
+
+static void TestAlgorithm_Fill(nsTArray<int>& values, int count, int pattern)
+{
+	uint32 seed = 12345;
+	values.Resize(count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		switch (pattern)
+		{
+			case 0: values[i] = static_cast<int>(TestAlgorithm_Random(seed) % 100000); break;
+			case 1: values[i] = i; break;
+			case 2: values[i] = count - i; break;
+			case 3: values[i] = 7; break;
+			default: values[i] = static_cast<int>(TestAlgorithm_Random(seed) % 4); break;
+		}
+	}
+}
+
+
+static void TestAlgorithm_Sort()
+{
+	const int COUNTS[8] = { 0, 1, 2, 3, 16, 17, 100, 5000 };
+	nsTArray<int> values;
+
+	for (int c = 0; c < 8; ++c)
+	{
+		for (int pattern = 0; pattern < 5; ++pattern)
+		{
+			TestAlgorithm_Fill(values, COUNTS[c], pattern);
+
+			int sum = 0;
+
+			for (int i = 0; i < values.GetCount(); ++i)
+			{
+				sum += values[i];
+			}
+
+			nsAlgorithm::Sort(values.GetData(), values.GetCount(), [](int a, int b) { return a < b; });
+
+			for (int i = 1; i < values.GetCount(); ++i)
+			{
+				NS_Validate(values[i - 1] <= values[i]);
+				sum -= values[i];
+			}
+
+			NS_Validate(values.GetCount() == 0 || sum == values[0]);
+		}
+	}
+
+	// Two elements must be ordered
+	int pair[2] = { 2, 1 };
+	nsAlgorithm::Sort(pair, 2, [](int a, int b) { return a < b; });
+	NS_Validate(pair[0] == 1 && pair[1] == 2);
+
+	// Non-trivial element type, descending
+	nsTArray<nsTestObject> objects(200);
+
+	for (int i = 0; i < objects.GetCount(); ++i)
+	{
+		objects[i].I = (i * 37) % 200;
+		objects[i].S = nsString::FromInt(objects[i].I);
+	}
+
+	nsAlgorithm::Sort(objects.GetData(), objects.GetCount(), [](const nsTestObject& a, const nsTestObject& b) { return a.I > b.I; });
+
+	for (int i = 0; i < objects.GetCount(); ++i)
+	{
+		NS_Validate(objects[i].I == 199 - i && objects[i].S == nsString::FromInt(199 - i));
+	}
+}
+
+
+static void TestAlgorithm_SortRadix()
+{
+	struct Item
+	{
+		uint64 Key;
+		int Order;
+	};
+
+	const int COUNT = 10000;
+
+	nsTArray<Item> items(COUNT);
+	nsTArray<Item> scratch(COUNT);
+	uint32 seed = 12345;
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		// Few distinct keys spread over high bits to exercise stability and pass skipping
+		items[i].Key = static_cast<uint64>(TestAlgorithm_Random(seed) % 50) << 40;
+		items[i].Order = i;
+	}
+
+	nsAlgorithm::SortRadix(items.GetData(), COUNT, scratch.GetData(), [](const Item& item) { return item.Key; });
+
+	for (int i = 1; i < COUNT; ++i)
+	{
+		NS_Validate(items[i - 1].Key < items[i].Key || (items[i - 1].Key == items[i].Key && items[i - 1].Order < items[i].Order));
+	}
+
+	nsTArray<uint32> values(COUNT);
+	nsTArray<uint32> valueScratch(COUNT);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		values[i] = TestAlgorithm_Random(seed) ^ (TestAlgorithm_Random(seed) << 24);
+	}
+
+	nsAlgorithm::SortRadix(values.GetData(), COUNT, valueScratch.GetData(), [](uint32 value) { return value; });
+
+	for (int i = 1; i < COUNT; ++i)
+	{
+		NS_Validate(values[i - 1] <= values[i]);
+	}
+}
+
+
+// Reference interval search, linear scan from first key
+static int TestAlgorithm_FindIntervalLinear(const float* keys, int count, float value)
+{
+	for (int i = 0; i < count - 2; ++i)
+	{
+		if (value < keys[i + 1])
+		{
+			return i;
+		}
+	}
+
+	return count - 2;
+}
+
+
+static void TestAlgorithm_FindInterval()
+{
+	const int values[6] = { 1, 3, 3, 3, 8, 10 };
+	NS_Validate(nsAlgorithm::UpperBound(values, 6, 0, [](int v) { return v; }) == 0);
+	NS_Validate(nsAlgorithm::UpperBound(values, 6, 3, [](int v) { return v; }) == 4);
+	NS_Validate(nsAlgorithm::UpperBound(values, 6, 9, [](int v) { return v; }) == 5);
+	NS_Validate(nsAlgorithm::UpperBound(values, 6, 10, [](int v) { return v; }) == 6);
+	NS_Validate(nsAlgorithm::UpperBound(values, 0, 10, [](int v) { return v; }) == 0);
+
+	// Uneven key spacing
+	const int COUNT = 500;
+	nsTArray<float> keys(COUNT);
+	uint32 seed = 4321;
+	float time = 0.0f;
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		keys[i] = time;
+		time += 0.01f + static_cast<float>(TestAlgorithm_Random(seed) % 100) * 0.001f;
+	}
+
+	const float duration = keys[COUNT - 1];
+	auto getKey = [](float key) { return key; };
+
+	// Forward playback with small steps, loops, random seeks, out of range values
+	int cursor = 0;
+	float value = 0.0f;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const uint32 r = TestAlgorithm_Random(seed) % 100;
+
+		if (r < 90)
+		{
+			value += static_cast<float>(r) * 0.0005f;
+
+			if (value > duration)
+			{
+				value -= duration;
+			}
+		}
+		else if (r < 98)
+		{
+			value = static_cast<float>(TestAlgorithm_Random(seed) % 10000) * duration / 10000.0f;
+		}
+		else
+		{
+			value = (r == 98) ? -1.0f : duration + 1.0f;
+		}
+
+		const int index = nsAlgorithm::FindInterval(keys.GetData(), COUNT, value, cursor, getKey);
+		NS_Validate(index == TestAlgorithm_FindIntervalLinear(keys.GetData(), COUNT, value));
+		NS_Validate(cursor == index);
+	}
+
+	// Invalid cursor falls back to binary search
+	cursor = COUNT + 10;
+	NS_Validate(nsAlgorithm::FindInterval(keys.GetData(), COUNT, keys[100], cursor, getKey) == 100 && cursor == 100);
+	cursor = -1;
+	NS_Validate(nsAlgorithm::FindInterval(keys.GetData(), COUNT, duration, cursor, getKey) == COUNT - 2);
+
+	const float twoKeys[2] = { 0.0f, 1.0f };
+	cursor = 0;
+	NS_Validate(nsAlgorithm::FindInterval(twoKeys, 2, 5.0f, cursor, getKey) == 0);
+}
+
+
+void nsUnitTest::TestAlgorithm()
+{
+	TestAlgorithm_Sort();
+	TestAlgorithm_SortRadix();
+	TestAlgorithm_FindInterval();
+}
+
+
+
+// Previous nsAlgorithm::Sort (recursive Lomuto quicksort, last element pivot), kept as benchmark reference
+static void BenchmarkAlgorithm_QuickSort(uint32* data, int left, int right)
+{
+	if (left >= right)
+	{
+		return;
+	}
+
+	const uint32 pivot = data[right];
+	int i = left;
+
+	for (int j = left; j < right; ++j)
+	{
+		if (data[j] < pivot)
+		{
+			nsAlgorithm::Swap(data[i], data[j]);
+			++i;
+		}
+	}
+
+	nsAlgorithm::Swap(data[i], data[right]);
+	BenchmarkAlgorithm_QuickSort(data, left, i - 1);
+	BenchmarkAlgorithm_QuickSort(data, i + 1, right);
+}
+
+
+void nsUnitTest::BenchmarkAlgorithm()
+{
+	const double msPerCounter = 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] nsAlgorithm sort uint32"));
+
+	// Sorted input is kept small, previous quicksort is O(n^2) with recursion depth n
+	const int COUNTS[2] = { 1000000, 5000 };
+	const wchar_t* NAMES[2] = { TEXT("Random"), TEXT("Sorted") };
+
+	for (int b = 0; b < 2; ++b)
+	{
+		const int count = COUNTS[b];
+		nsTArray<uint32> source(count);
+		nsTArray<uint32> values(count);
+		nsTArray<uint32> scratch(count);
+		uint32 seed = 12345;
+
+		for (int i = 0; i < count; ++i)
+		{
+			source[i] = (b == 0) ? TestAlgorithm_Random(seed) : static_cast<uint32>(i);
+		}
+
+		values = source;
+		int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+		BenchmarkAlgorithm_QuickSort(values.GetData(), 0, count - 1);
+		const double quickMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		values = source;
+		startCounter = nsPlatform::PerformanceQuery_Counter();
+		nsAlgorithm::Sort(values.GetData(), count, [](uint32 a, uint32 c) { return a < c; });
+		const double introMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		values = source;
+		startCounter = nsPlatform::PerformanceQuery_Counter();
+		nsAlgorithm::SortRadix(values.GetData(), count, scratch.GetData(), [](uint32 value) { return value; });
+		const double radixMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		for (int i = 1; i < count; ++i)
+		{
+			NS_Validate(values[i - 1] <= values[i]);
+		}
+
+		nsPlatform::ConsoleOutputFormat(0, TEXT("%s (%i): QuickSort: %.3f ms, IntroSort: %.3f ms, RadixSort: %.3f ms"), NAMES[b], count, quickMs, introMs, radixMs);
+	}
+
+	// Animation sampling, 60 second clip with 80 bones, 3 channels per bone, 30 keys per second, sampled at 60 fps
+	struct KeyFrame
+	{
+		float Value[3];
+		float Timestamp;
+	};
+
+	const int BONE_COUNT = 80;
+	const int CHANNEL_COUNT = BONE_COUNT * 3;
+	const int KEY_COUNT = 60 * 30 + 1;
+	const int SAMPLE_COUNT = 60 * 60;
+	const float DURATION = 60.0f;
+
+	nsTArray<KeyFrame> keys(CHANNEL_COUNT * KEY_COUNT);
+	uint32 seed = 777;
+
+	for (int c = 0; c < CHANNEL_COUNT; ++c)
+	{
+		for (int k = 0; k < KEY_COUNT; ++k)
+		{
+			KeyFrame& key = keys[c * KEY_COUNT + k];
+			key.Value[0] = static_cast<float>(TestAlgorithm_Random(seed) % 1000);
+			key.Value[1] = static_cast<float>(k);
+			key.Value[2] = static_cast<float>(c);
+			key.Timestamp = static_cast<float>(k) * DURATION / static_cast<float>(KEY_COUNT - 1);
+		}
+	}
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] Animation key sampling (%i channels, %i keys, %i samples)"), CHANNEL_COUNT, KEY_COUNT, SAMPLE_COUNT);
+
+	auto getTimestamp = [](const KeyFrame& key) { return key.Timestamp; };
+	nsTArray<int> cursors(CHANNEL_COUNT);
+	double results[3];
+	double sampleMs[3];
+
+	for (int method = 0; method < 3; ++method)
+	{
+		double result = 0.0;
+		cursors.Resize(CHANNEL_COUNT);
+
+		const int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+
+		for (int s = 0; s < SAMPLE_COUNT; ++s)
+		{
+			const float time = static_cast<float>(s) / 60.0f;
+
+			for (int c = 0; c < CHANNEL_COUNT; ++c)
+			{
+				const KeyFrame* channel = keys.GetData() + c * KEY_COUNT;
+				int index = 0;
+
+				if (method == 0)
+				{
+					// Previous sampling, linear scan from first key
+					for (int k = 0; k < KEY_COUNT - 1; ++k)
+					{
+						if (time >= channel[k].Timestamp && time <= channel[k + 1].Timestamp)
+						{
+							index = k;
+							break;
+						}
+					}
+				}
+				else if (method == 1)
+				{
+					int noCursor = -1;
+					index = nsAlgorithm::FindInterval(channel, KEY_COUNT, time, noCursor, getTimestamp);
+				}
+				else
+				{
+					index = nsAlgorithm::FindInterval(channel, KEY_COUNT, time, cursors[c], getTimestamp);
+				}
+
+				const float alpha = (time - channel[index].Timestamp) / (channel[index + 1].Timestamp - channel[index].Timestamp);
+				for (int v = 0; v < 3; ++v)
+				{
+					result += static_cast<double>(channel[index].Value[v] + (channel[index + 1].Value[v] - channel[index].Value[v]) * alpha);
+				}
+			}
+		}
+
+		sampleMs[method] = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+		results[method] = result;
+	}
+
+	// Linear scan picks previous interval when time is exactly on a key, result only differs by rounding
+	const double difference = results[0] - results[1];
+	NS_Validate((difference < 0.0 ? -difference : difference) < results[0] * 1e-6 && results[1] == results[2]);
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("Linear: %.3f ms, Binary: %.3f ms, Cursor: %.3f ms, Speedup: %.1fx"), sampleMs[0], sampleMs[1], sampleMs[2], sampleMs[0] / sampleMs[2]);
+}
@@ -129,6 +129,207 @@ static void TestArray_Remove()
 }
 
 
+// Tracks live instances and detects bitwise relocation (Self must always point to this)
+struct nsTestTrackedObject
+{
+	static int LiveCount;
+
+	const nsTestTrackedObject* Self;
+	int Value;
+
+
+public:
+	nsTestTrackedObject(int value = 0) noexcept
+		: Self(this)
+		, Value(value)
+	{
+		LiveCount++;
+	}
+
+
+	nsTestTrackedObject(const nsTestTrackedObject& other) noexcept
+		: Self(this)
+		, Value(other.Value)
+	{
+		NS_Validate(other.Self == &other);
+		LiveCount++;
+	}
+
+
+	nsTestTrackedObject(nsTestTrackedObject&& other) noexcept
+		: Self(this)
+		, Value(other.Value)
+	{
+		NS_Validate(other.Self == &other);
+		other.Value = -1;
+		LiveCount++;
+	}
+
+
+	~nsTestTrackedObject() noexcept
+	{
+		NS_Validate(Self == this);
+		LiveCount--;
+	}
+
+
+	NS_INLINE nsTestTrackedObject& operator=(const nsTestTrackedObject& rhs) noexcept
+	{
+		NS_Validate(Self == this && rhs.Self == &rhs);
+		Value = rhs.Value;
+		return *this;
+	}
+
+};
+
+int nsTestTrackedObject::LiveCount = 0;
+
+
+template<typename TArray>
+static void TestArray_ValidateTracked(const TArray& arr, const std::initializer_list<int>& values)
+{
+	NS_Validate(arr.GetCount() == static_cast<int>(values.size()));
+
+	int i = 0;
+
+	for (const int value : values)
+	{
+		NS_Validate(arr[i].Self == &arr[i] && arr[i].Value == value);
+		++i;
+	}
+}
+
+
+static void TestArray_NonTrivial()
+{
+	{
+		nsTArray<nsTestTrackedObject> arr;
+
+		for (int i = 0; i < 5; ++i)
+		{
+			arr.Add(i);
+		}
+
+		TestArray_ValidateTracked(arr, { 0, 1, 2, 3, 4 });
+		NS_Validate(nsTestTrackedObject::LiveCount == 5);
+
+		const nsTestTrackedObject insert(9);
+		arr.InsertAt(insert, 1);
+		TestArray_ValidateTracked(arr, { 0, 9, 1, 2, 3, 4 });
+
+		arr.RemoveAt(2);
+		TestArray_ValidateTracked(arr, { 0, 9, 2, 3, 4 });
+
+		arr.RemoveAt(0, false);
+		TestArray_ValidateTracked(arr, { 4, 9, 2, 3 });
+
+		arr.RemoveAtRange(1, 2);
+		TestArray_ValidateTracked(arr, { 4, 3 });
+
+		nsTArray<nsTestTrackedObject> copy = arr;
+		nsTArray<nsTestTrackedObject> moved = std::move(copy);
+		TestArray_ValidateTracked(moved, { 4, 3 });
+		NS_Validate(copy.GetCount() == 0);
+
+		copy = moved;
+		TestArray_ValidateTracked(copy, { 4, 3 });
+		NS_Validate(nsTestTrackedObject::LiveCount == 7);
+	}
+
+	NS_Validate(nsTestTrackedObject::LiveCount == 0);
+
+	// Small-buffer
+	{
+		nsTArray<nsTestTrackedObject, nsTArrayDefaultAllocator, 4> arr;
+		NS_Validate(arr.GetCapacity() == 4);
+
+		arr.Add(0);
+		arr.Add(1);
+		const nsTestTrackedObject* inlineData = arr.GetData();
+
+		// Move of inline array must move elements
+		nsTArray<nsTestTrackedObject, nsTArrayDefaultAllocator, 4> moved = std::move(arr);
+		TestArray_ValidateTracked(moved, { 0, 1 });
+		NS_Validate(arr.GetCount() == 0 && arr.GetData() == inlineData);
+
+		for (int i = 2; i < 10; ++i)
+		{
+			moved.Add(i);
+		}
+
+		TestArray_ValidateTracked(moved, { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+		NS_Validate(moved.GetCapacity() >= 10);
+
+		moved.Clear(true);
+		NS_Validate(moved.GetCapacity() == 4);
+		NS_Validate(nsTestTrackedObject::LiveCount == 0);
+
+		nsTArray<int, nsTArrayDefaultAllocator, 8> ints = { 1, 2, 3 };
+		nsTArray<int, nsTArrayDefaultAllocator, 8> intsCopy = ints;
+		NS_Validate(intsCopy.GetCount() == 3 && intsCopy[2] == 3 && intsCopy.GetData() != ints.GetData());
+	}
+
+	NS_Validate(nsTestTrackedObject::LiveCount == 0);
+}
+
+
+static void TestArray_FreeList()
+{
+	nsTArrayFreeList<nsString> list;
+	const int a = list.Add(TEXT("a"));
+	const int b = list.Add(TEXT("b"));
+	const int c = list.Add(TEXT("c"));
+	const uint32 generationB = list.GetGeneration(b);
+
+	NS_Validate(list.GetCount() == 3);
+	NS_Validate(list.IsValid(b, generationB));
+
+	list.RemoveAt(b);
+	NS_Validate(list.GetCount() == 2);
+	NS_Validate(!list.IsValid(b));
+	NS_Validate(!list.IsValid(b, generationB));
+
+	// Removed slot is reused with new generation, stale generation must stay invalid
+	const int d = list.Add(TEXT("d"));
+	NS_Validate(d == b);
+	NS_Validate(list.IsValid(d, list.GetGeneration(d)));
+	NS_Validate(!list.IsValid(d, generationB));
+	NS_Validate(list[d] == TEXT("d"));
+
+	list.RemoveAt(a);
+
+	// Iteration visits only valid slots
+	int visitCount = 0;
+
+	for (auto it = list.CreateConstIterator(); it; ++it)
+	{
+		NS_Validate(it.GetIndex() == c || it.GetIndex() == d);
+		NS_Validate(*it == (it.GetIndex() == c ? TEXT("c") : TEXT("d")));
+		visitCount++;
+	}
+
+	NS_Validate(visitCount == 2);
+	NS_Validate(list.GetIndices().GetCount() == 2);
+
+	// Copy keeps removed slots and generations
+	const nsTArrayFreeList<nsString> copy = list;
+	NS_Validate(copy.GetCount() == 2);
+	NS_Validate(!copy.IsValid(a));
+	NS_Validate(copy.IsValid(d, list.GetGeneration(d)) && copy[d] == TEXT("d"));
+
+	// Growth with removed slots must keep elements and free slots intact
+	list.Reserve(64);
+	NS_Validate(list[c] == TEXT("c") && list[d] == TEXT("d"));
+	NS_Validate(list.Add(TEXT("e")) == a);
+	NS_Validate(list.GetCount() == 3);
+
+	list.Clear();
+	NS_Validate(list.IsEmpty());
+	NS_Validate(!list.IsValid(c));
+	NS_Validate(!list.CreateConstIterator());
+}
+
+
 void nsUnitTest::TestArray()
 {
 	// Allocate big bytes
@@ -198,4 +399,8 @@ void nsUnitTest::TestArray()
 	TestArray_Insert();
 
 	TestArray_Remove();
+
+	TestArray_NonTrivial();
+
+	TestArray_FreeList();
 }
@@ -0,0 +1,394 @@
+#include "nsUnitTest.h"
+#include "nsAsyncLoad.h"
+
+
+
+// Fake file in memory. Read/decode can be held at gate to observe intermediate states, and can be set to fail
+class TestAsyncLoad_FakeFileRequest : public nsAsyncLoadRequest
+{
+public:
+	static nsTArray<int> ReadOrder;
+
+	int Id;
+	nsTArray<uint8> File;
+	nsTArray<uint8> ReadData;
+	int DecodedSum;
+	bool bFailRead;
+	bool bFailDecode;
+	nsAtomic ReadGate;
+	nsAtomic DecodeGate;
+	nsAtomic bDecodeStarted;
+
+
+public:
+	TestAsyncLoad_FakeFileRequest(int id) noexcept
+		: Id(id)
+		, DecodedSum(0)
+		, bFailRead(false)
+		, bFailDecode(false)
+	{
+		ReadGate.Set(1);
+		DecodeGate.Set(1);
+
+		for (int i = 0; i < 64; ++i)
+		{
+			File.Add(static_cast<uint8>(id + i));
+		}
+	}
+
+
+	virtual bool Read() noexcept override
+	{
+		while (ReadGate.Get() == 0)
+		{
+			nsPlatform::Thread_Sleep(1);
+		}
+
+		ReadOrder.Add(Id);
+
+		if (bFailRead)
+		{
+			return false;
+		}
+
+		ReadData = File;
+
+		return true;
+	}
+
+
+	virtual bool Decode() noexcept override
+	{
+		bDecodeStarted.Set(1);
+
+		while (DecodeGate.Get() == 0)
+		{
+			nsPlatform::Thread_Sleep(1);
+		}
+
+		if (bFailDecode || ReadData.GetCount() != File.GetCount())
+		{
+			return false;
+		}
+
+		DecodedSum = 0;
+
+		for (int i = 0; i < ReadData.GetCount(); ++i)
+		{
+			DecodedSum += ReadData[i];
+		}
+
+		return true;
+	}
+
+
+	NS_NODISCARD int GetExpectedSum() const noexcept
+	{
+		int sum = 0;
+
+		for (int i = 0; i < File.GetCount(); ++i)
+		{
+			sum += File[i];
+		}
+
+		return sum;
+	}
+
+};
+
+nsTArray<int> TestAsyncLoad_FakeFileRequest::ReadOrder;
+
+
+// Spin until request leaves <state>, fails test if it takes too long
+static void TestAsyncLoad_WaitWhileState(const nsAsyncLoadRequest& request, int state)
+{
+	int elapsedMs = 0;
+
+	while (request.GetState() == state)
+	{
+		nsPlatform::Thread_Sleep(1);
+		NS_Validate(++elapsedMs < 10000);
+	}
+}
+
+
+static void TestAsyncLoad_WaitDecode(const nsAsyncLoadRequest& request)
+{
+	int elapsedMs = 0;
+
+	while (!request.IsDecodeDone())
+	{
+		nsPlatform::Thread_Sleep(1);
+		NS_Validate(++elapsedMs < 10000);
+	}
+}
+
+
+static nsThreadAffinityMasks TestAsyncLoad_GetDecodeAffinity()
+{
+	return nsThreadPool::GetThreadCount() > 1 ? nsEThreadAffinity::Thread_ExcludeMain : nsEThreadAffinity::Thread_ALL;
+}
+
+
+static void TestAsyncLoad_States()
+{
+	nsAsyncLoadQueue loadQueue;
+	loadQueue.Initialize();
+
+	TestAsyncLoad_FakeFileRequest request(7);
+	request.ReadGate.Set(0);
+	NS_Validate(request.GetState() == AsyncLoadState_Queued);
+
+	// Decode is not submitted before read is done
+	NS_Validate(!loadQueue.SubmitDecode(&request, TestAsyncLoad_GetDecodeAffinity()));
+
+	loadQueue.Submit(&request, 0);
+	TestAsyncLoad_WaitWhileState(request, AsyncLoadState_Queued);
+	NS_Validate(request.GetState() == AsyncLoadState_Reading);
+
+	request.ReadGate.Set(1);
+	TestAsyncLoad_WaitWhileState(request, AsyncLoadState_Reading);
+	NS_Validate(request.GetState() == AsyncLoadState_ReadDone);
+
+	// Single worker thread executes decode only when main thread waits, gate is only used with worker threads
+	const bool bHoldDecode = nsThreadPool::GetThreadCount() > 1;
+	request.DecodeGate.Set(bHoldDecode ? 0 : 1);
+
+	NS_Validate(loadQueue.SubmitDecode(&request, TestAsyncLoad_GetDecodeAffinity()));
+
+	if (bHoldDecode)
+	{
+		NS_Validate(request.GetState() == AsyncLoadState_Decoding);
+		NS_Validate(!request.IsDecodeDone());
+		request.DecodeGate.Set(1);
+	}
+
+	request.WaitDecode();
+	NS_Validate(request.GetState() == AsyncLoadState_Decoded);
+	NS_Validate(request.DecodedSum == request.GetExpectedSum());
+
+	loadQueue.Shutdown();
+}
+
+
+static void TestAsyncLoad_Priority()
+{
+	nsAsyncLoadQueue loadQueue;
+	loadQueue.Initialize();
+
+	// First request holds IO thread, others are queued behind it
+	TestAsyncLoad_FakeFileRequest blocker(0);
+	blocker.ReadGate.Set(0);
+	loadQueue.Submit(&blocker, 0);
+	TestAsyncLoad_WaitWhileState(blocker, AsyncLoadState_Queued);
+
+	TestAsyncLoad_FakeFileRequest low(1);
+	TestAsyncLoad_FakeFileRequest normalFirst(2);
+	TestAsyncLoad_FakeFileRequest high(3);
+	TestAsyncLoad_FakeFileRequest normalSecond(4);
+	TestAsyncLoad_FakeFileRequest raised(5);
+	loadQueue.Submit(&low, 0);
+	loadQueue.Submit(&normalFirst, 1);
+	loadQueue.Submit(&high, 2);
+	loadQueue.Submit(&normalSecond, 1);
+	loadQueue.Submit(&raised, 0);
+	loadQueue.SetPriority(&raised, 2);
+
+	TestAsyncLoad_FakeFileRequest::ReadOrder.Clear();
+	blocker.ReadGate.Set(1);
+	TestAsyncLoad_WaitWhileState(low, AsyncLoadState_Queued);
+	TestAsyncLoad_WaitWhileState(low, AsyncLoadState_Reading);
+
+	// Highest priority first, same priority in submit order
+	const int expectedOrder[6] = { 0, 3, 5, 2, 4, 1 };
+	nsTArray<int>& readOrder = TestAsyncLoad_FakeFileRequest::ReadOrder;
+	NS_Validate(readOrder.GetCount() == 6);
+
+	for (int i = 0; i < 6; ++i)
+	{
+		NS_Validate(readOrder[i] == expectedOrder[i]);
+	}
+
+	loadQueue.Shutdown();
+}
+
+
+static void TestAsyncLoad_Cancel()
+{
+	nsAsyncLoadQueue loadQueue;
+	loadQueue.Initialize();
+
+	TestAsyncLoad_FakeFileRequest reading(0);
+	reading.ReadGate.Set(0);
+	loadQueue.Submit(&reading, 0);
+	TestAsyncLoad_WaitWhileState(reading, AsyncLoadState_Queued);
+
+	// Cancel while queued removes request before read
+	TestAsyncLoad_FakeFileRequest queued(1);
+	loadQueue.Submit(&queued, 2);
+	NS_Validate(loadQueue.Cancel(&queued));
+	NS_Validate(queued.GetState() == AsyncLoadState_Queued);
+
+	// Cancel while reading can not destroy request until IO thread is done with it
+	NS_Validate(!loadQueue.Cancel(&reading));
+	NS_Validate(reading.GetState() == AsyncLoadState_Reading);
+
+	TestAsyncLoad_FakeFileRequest::ReadOrder.Clear();
+	reading.ReadGate.Set(1);
+	TestAsyncLoad_WaitWhileState(reading, AsyncLoadState_Reading);
+	NS_Validate(reading.GetState() == AsyncLoadState_ReadDone);
+	NS_Validate(loadQueue.Cancel(&reading));
+
+	// Cancelled queued request is never read
+	nsPlatform::Thread_Sleep(5);
+	NS_Validate(queued.GetState() == AsyncLoadState_Queued);
+	NS_Validate(TestAsyncLoad_FakeFileRequest::ReadOrder.GetCount() == 1);
+	NS_Validate(TestAsyncLoad_FakeFileRequest::ReadOrder[0] == 0);
+
+	// Cancel while decoding can not destroy request until worker thread is done with it
+	if (nsThreadPool::GetThreadCount() > 1)
+	{
+		TestAsyncLoad_FakeFileRequest decoding(2);
+		decoding.DecodeGate.Set(0);
+		loadQueue.Submit(&decoding, 0);
+		TestAsyncLoad_WaitWhileState(decoding, AsyncLoadState_Queued);
+		TestAsyncLoad_WaitWhileState(decoding, AsyncLoadState_Reading);
+		NS_Validate(loadQueue.SubmitDecode(&decoding, nsEThreadAffinity::Thread_ExcludeMain));
+
+		while (decoding.bDecodeStarted.Get() == 0)
+		{
+			nsPlatform::Thread_Sleep(1);
+		}
+
+		NS_Validate(!loadQueue.Cancel(&decoding));
+		decoding.DecodeGate.Set(1);
+		TestAsyncLoad_WaitDecode(decoding);
+		NS_Validate(loadQueue.Cancel(&decoding));
+	}
+
+	loadQueue.Shutdown();
+}
+
+
+static void TestAsyncLoad_Failure()
+{
+	nsAsyncLoadQueue loadQueue;
+	loadQueue.Initialize();
+
+	// Read failure skips decode
+	TestAsyncLoad_FakeFileRequest failRead(0);
+	failRead.bFailRead = true;
+	loadQueue.Submit(&failRead, 0);
+	TestAsyncLoad_WaitWhileState(failRead, AsyncLoadState_Queued);
+	TestAsyncLoad_WaitWhileState(failRead, AsyncLoadState_Reading);
+	NS_Validate(failRead.GetState() == AsyncLoadState_Failed);
+	NS_Validate(!loadQueue.SubmitDecode(&failRead, TestAsyncLoad_GetDecodeAffinity()));
+	NS_Validate(failRead.bDecodeStarted.Get() == 0);
+	NS_Validate(loadQueue.Cancel(&failRead));
+
+	TestAsyncLoad_FakeFileRequest failDecode(1);
+	failDecode.bFailDecode = true;
+	loadQueue.Submit(&failDecode, 0);
+	TestAsyncLoad_WaitWhileState(failDecode, AsyncLoadState_Queued);
+	TestAsyncLoad_WaitWhileState(failDecode, AsyncLoadState_Reading);
+	NS_Validate(loadQueue.SubmitDecode(&failDecode, TestAsyncLoad_GetDecodeAffinity()));
+	failDecode.WaitDecode();
+	NS_Validate(failDecode.GetState() == AsyncLoadState_Failed);
+
+	loadQueue.Shutdown();
+}
+
+
+static void TestAsyncLoad_Wait()
+{
+	nsAsyncLoadQueue loadQueue;
+
+	// Without IO thread, request is read and decoded on calling thread
+	TestAsyncLoad_FakeFileRequest immediate(0);
+	loadQueue.Prepare(&immediate, 2);
+	loadQueue.Wait(&immediate);
+	NS_Validate(immediate.GetState() == AsyncLoadState_Decoded);
+	NS_Validate(immediate.DecodedSum == immediate.GetExpectedSum());
+
+	TestAsyncLoad_FakeFileRequest immediateFail(1);
+	immediateFail.bFailRead = true;
+	loadQueue.Prepare(&immediateFail, 2);
+	loadQueue.Wait(&immediateFail);
+	NS_Validate(immediateFail.GetState() == AsyncLoadState_Failed);
+	NS_Validate(immediateFail.bDecodeStarted.Get() == 0);
+
+	// Queued request is taken from IO queue, request being read is waited
+	loadQueue.Initialize();
+
+	TestAsyncLoad_FakeFileRequest reading(2);
+	reading.ReadGate.Set(0);
+	loadQueue.Submit(&reading, 0);
+	TestAsyncLoad_WaitWhileState(reading, AsyncLoadState_Queued);
+
+	TestAsyncLoad_FakeFileRequest queued(3);
+	loadQueue.Submit(&queued, 0);
+	loadQueue.Wait(&queued);
+	NS_Validate(queued.GetState() == AsyncLoadState_Decoded);
+	NS_Validate(queued.DecodedSum == queued.GetExpectedSum());
+
+	reading.ReadGate.Set(1);
+	loadQueue.Wait(&reading);
+	NS_Validate(reading.GetState() == AsyncLoadState_Decoded);
+	NS_Validate(reading.DecodedSum == reading.GetExpectedSum());
+
+	loadQueue.Shutdown();
+}
+
+
+static void TestAsyncLoad_FinalizeBudget()
+{
+	nsAsyncLoadQueue loadQueue;
+	TestAsyncLoad_FakeFileRequest request0(0);
+	TestAsyncLoad_FakeFileRequest request1(1);
+	TestAsyncLoad_FakeFileRequest request2(2);
+	TestAsyncLoad_FakeFileRequest request3(3);
+	TestAsyncLoad_FakeFileRequest* decoded[4] = { &request0, &request1, &request2, &request3 };
+	const int priorities[4] = { 0, 2, 1, 2 };
+
+	for (int i = 0; i < 4; ++i)
+	{
+		loadQueue.Prepare(decoded[i], priorities[i]);
+	}
+
+	// Budget is exceeded by first finalize, still one request is finalized per call
+	nsTArray<int> finalized;
+	const int slowCount = nsAsyncLoadQueue::FinalizeRequests(decoded, 4, 1.0f, [&finalized](TestAsyncLoad_FakeFileRequest* request)
+	{
+		finalized.Add(request->Id);
+		nsPlatform::Thread_Sleep(3);
+	});
+
+	NS_Validate(slowCount == 1);
+	NS_Validate(finalized.GetCount() == 1);
+	NS_Validate(finalized[0] == 1);
+
+	finalized.Clear();
+	const int fastCount = nsAsyncLoadQueue::FinalizeRequests(decoded, 4, 1000.0f, [&finalized](TestAsyncLoad_FakeFileRequest* request)
+	{
+		finalized.Add(request->Id);
+	});
+
+	const int expectedOrder[4] = { 1, 3, 2, 0 };
+	NS_Validate(fastCount == 4);
+
+	for (int i = 0; i < 4; ++i)
+	{
+		NS_Validate(finalized[i] == expectedOrder[i]);
+	}
+}
+
+
+void nsUnitTest::TestAsyncLoad()
+{
+	TestAsyncLoad_States();
+	TestAsyncLoad_Priority();
+	TestAsyncLoad_Cancel();
+	TestAsyncLoad_Failure();
+	TestAsyncLoad_Wait();
+	TestAsyncLoad_FinalizeBudget();
+}
@@ -0,0 +1,189 @@
+#include "nsUnitTest.h"
+#include "nsCompression.h"
+#include "nsThreadPool.h"
+
+
+
+static uint32 TestCompression_Random(uint32& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return seed >> 8;
+}
+
+
+static void TestCompression_Fill(nsTArray<uint8>& data, int size, int pattern)
+{
+	uint32 seed = 12345;
+	data.Resize(size);
+
+	for (int i = 0; i < size; ++i)
+	{
+		switch (pattern)
+		{
+			case 0: data[i] = static_cast<uint8>(TestCompression_Random(seed)); break;
+			case 1: data[i] = 0; break;
+			case 2: data[i] = static_cast<uint8>("ns_engine_asset_"[i % 16]); break;
+			default: data[i] = static_cast<uint8>(((i / 4) % 97) * ((i & 3) + 1) + (TestCompression_Random(seed) % 3)); break;
+		}
+	}
+}
+
+
+static void TestCompression_RoundTrip()
+{
+	const int SIZES[7] = { 0, 1, 13, 1000, NS_COMPRESSION_BLOCK_SIZE, NS_COMPRESSION_BLOCK_SIZE + 1, NS_COMPRESSION_BLOCK_SIZE * 3 + 17 };
+	const nsECompression COMPRESSIONS[2] = { nsECompression::LZ4, nsECompression::LZ4_HIGH };
+
+	nsTArray<uint8> data;
+	nsTArray<uint8> compressed;
+	nsTArray<uint8> decompressed;
+
+	for (int s = 0; s < 7; ++s)
+	{
+		for (int pattern = 0; pattern < 4; ++pattern)
+		{
+			TestCompression_Fill(data, SIZES[s], pattern);
+
+			for (int c = 0; c < 2; ++c)
+			{
+				compressed.Clear();
+				nsCompression::Compress(data.GetData(), data.GetCount(), COMPRESSIONS[c], compressed);
+
+				const int blockCount = (data.GetCount() + NS_COMPRESSION_BLOCK_SIZE - 1) / NS_COMPRESSION_BLOCK_SIZE;
+				NS_Validate(compressed.GetCount() <= 8 + blockCount * 4 + data.GetCount());
+
+				// Repeated data must compress well
+				if (pattern == 1 || pattern == 2)
+				{
+					NS_Validate(data.GetCount() < 1000 || compressed.GetCount() < data.GetCount() / 4);
+				}
+
+				NS_Validate(nsCompression::Decompress(compressed.GetData(), compressed.GetCount(), decompressed));
+				NS_Validate(decompressed.GetCount() == data.GetCount());
+
+				for (int i = 0; i < data.GetCount(); ++i)
+				{
+					NS_Validate(decompressed[i] == data[i]);
+				}
+			}
+		}
+	}
+
+	// Compress appends to existing data
+	TestCompression_Fill(data, 5000, 3);
+	compressed.Clear();
+	compressed.Add(0xAB);
+	nsCompression::Compress(data.GetData(), data.GetCount(), nsECompression::LZ4, compressed);
+	NS_Validate(compressed[0] == 0xAB);
+	NS_Validate(nsCompression::Decompress(compressed.GetData() + 1, compressed.GetCount() - 1, decompressed));
+	NS_Validate(decompressed.GetCount() == data.GetCount() && decompressed[4999] == data[4999]);
+}
+
+
+static void TestCompression_Corrupted()
+{
+	nsTArray<uint8> data;
+	nsTArray<uint8> compressed;
+	nsTArray<uint8> decompressed;
+
+	TestCompression_Fill(data, NS_COMPRESSION_BLOCK_SIZE * 2 + 100, 3);
+	nsCompression::Compress(data.GetData(), data.GetCount(), nsECompression::LZ4, compressed);
+
+	NS_Validate(!nsCompression::Decompress(compressed.GetData(), 4, decompressed));
+	NS_Validate(!nsCompression::Decompress(compressed.GetData(), compressed.GetCount() - 1, decompressed));
+
+	// Uncompressed size does not match block count
+	nsTArray<uint8> corrupted = compressed;
+	corrupted[2] ^= 0x40;
+	NS_Validate(!nsCompression::Decompress(corrupted.GetData(), corrupted.GetCount(), decompressed));
+
+	// Random garbage must be rejected without reading/writing out of bounds
+	uint32 seed = 777;
+	nsTArray<uint8> block(NS_COMPRESSION_BLOCK_SIZE);
+
+	for (int i = 0; i < 200; ++i)
+	{
+		corrupted = compressed;
+		const int offset = 8 + 3 * 4 + static_cast<int>(TestCompression_Random(seed) % (corrupted.GetCount() - 20));
+		corrupted[offset] = static_cast<uint8>(TestCompression_Random(seed));
+		const bool bDecompressed = nsCompression::Decompress(corrupted.GetData(), corrupted.GetCount(), decompressed);
+		NS_Validate(!bDecompressed || decompressed.GetCount() == data.GetCount());
+
+		uint8 garbage[64];
+
+		for (int g = 0; g < 64; ++g)
+		{
+			garbage[g] = static_cast<uint8>(TestCompression_Random(seed));
+		}
+
+		NS_Validate(!nsCompression::DecompressBlock(garbage, 64, block.GetData(), 1000));
+	}
+}
+
+
+void nsUnitTest::TestCompression()
+{
+	TestCompression_RoundTrip();
+	TestCompression_Corrupted();
+}
+
+
+
+void nsUnitTest::BenchmarkCompression()
+{
+	// Vertex stream like data, 16 MiB
+	const int DATA_SIZE = NS_MEMORY_SIZE_MiB(16);
+	const int BLOCK_COUNT = DATA_SIZE / NS_COMPRESSION_BLOCK_SIZE;
+	const double msPerCounter = 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	nsTArray<uint8> data;
+	TestCompression_Fill(data, DATA_SIZE, 3);
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] nsCompression (%i bytes, %i blocks, %i threads)"), DATA_SIZE, BLOCK_COUNT, nsThreadPool::GetThreadCount());
+
+	const nsECompression COMPRESSIONS[2] = { nsECompression::LZ4, nsECompression::LZ4_HIGH };
+	const wchar_t* NAMES[2] = { TEXT("LZ4"), TEXT("LZ4_HIGH") };
+
+	for (int c = 0; c < 2; ++c)
+	{
+		nsTArray<uint8> compressed;
+		int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+		nsCompression::Compress(data.GetData(), DATA_SIZE, COMPRESSIONS[c], compressed);
+		const double compressMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		// Serial reference, decompress each block on calling thread
+		nsTArray<uint8> blockDatas(BLOCK_COUNT * nsCompression::GetCompressBound(NS_COMPRESSION_BLOCK_SIZE));
+		nsTArray<int> blockSizes(BLOCK_COUNT);
+
+		for (int b = 0; b < BLOCK_COUNT; ++b)
+		{
+			blockSizes[b] = nsCompression::CompressBlock(data.GetData() + b * NS_COMPRESSION_BLOCK_SIZE, NS_COMPRESSION_BLOCK_SIZE, blockDatas.GetData() + b * nsCompression::GetCompressBound(NS_COMPRESSION_BLOCK_SIZE), nsCompression::GetCompressBound(NS_COMPRESSION_BLOCK_SIZE), COMPRESSIONS[c]);
+			NS_Validate(blockSizes[b] > 0);
+		}
+
+		nsTArray<uint8> serial(DATA_SIZE);
+		startCounter = nsPlatform::PerformanceQuery_Counter();
+
+		for (int b = 0; b < BLOCK_COUNT; ++b)
+		{
+			NS_Validate(nsCompression::DecompressBlock(blockDatas.GetData() + b * nsCompression::GetCompressBound(NS_COMPRESSION_BLOCK_SIZE), blockSizes[b], serial.GetData() + b * NS_COMPRESSION_BLOCK_SIZE, NS_COMPRESSION_BLOCK_SIZE));
+		}
+
+		const double serialMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		nsTArray<uint8> parallel;
+		startCounter = nsPlatform::PerformanceQuery_Counter();
+		NS_Validate(nsCompression::Decompress(compressed.GetData(), compressed.GetCount(), parallel));
+		const double parallelMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		NS_Validate(parallel.GetCount() == DATA_SIZE);
+
+		for (int i = 0; i < DATA_SIZE; ++i)
+		{
+			NS_Validate(parallel[i] == data[i] && serial[i] == data[i]);
+		}
+
+		nsPlatform::ConsoleOutputFormat(0, TEXT("%s: Ratio: %.2f, Compress: %.3f ms, Decompress serial: %.3f ms, Decompress parallel: %.3f ms, Speedup: %.1fx"),
+			NAMES[c], static_cast<double>(DATA_SIZE) / static_cast<double>(compressed.GetCount()), compressMs, serialMs, parallelMs, serialMs / parallelMs);
+	}
+}
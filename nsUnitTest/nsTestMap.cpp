@@ -0,0 +1,241 @@
+#include "nsUnitTest.h"
+#include "nsMath.h"
+
+
+
+// Every key hashes to the same value, lookup must fall back to key equality
+struct nsTestCollisionKey
+{
+	int Value;
+
+
+	NS_INLINE bool operator==(const nsTestCollisionKey& rhs) const noexcept
+	{
+		return Value == rhs.Value;
+	}
+
+};
+
+
+NS_NODISCARD_INLINE uint64 ns_GetHash(const nsTestCollisionKey&) noexcept
+{
+	return 42;
+}
+
+
+
+static void TestMap_AddRemove()
+{
+	nsTMap<nsString, int> map;
+	map.Add(TEXT("zero"), 0);
+	map.Add(TEXT("one"), 1);
+	map[TEXT("two")] = 2;
+
+	NS_Validate(map.GetCount() == 3);
+	NS_Validate(map.Exists(TEXT("one")));
+	NS_Validate(!map.Exists(TEXT("three")));
+	NS_Validate(*map.GetValueByKey(TEXT("two")) == 2);
+	NS_Validate(map.GetValueByKey(TEXT("three")) == nullptr);
+
+	// Add existing key overwrites value
+	map.Add(TEXT("one"), 11);
+	NS_Validate(map.GetCount() == 3);
+	NS_Validate(map[TEXT("one")] == 11);
+
+	// Unordered remove moves last element into removed index
+	map.Remove(TEXT("zero"));
+	NS_Validate(map.GetCount() == 2);
+	NS_Validate(!map.Exists(TEXT("zero")));
+	NS_Validate(map.GetKeyByIndex(0) == TEXT("two") && map.GetValueByIndex(0) == 2);
+	NS_Validate(*map.GetValueByKey(TEXT("one")) == 11);
+	NS_Validate(*map.GetValueByKey(TEXT("two")) == 2);
+
+	map.Clear();
+	NS_Validate(map.GetCount() == 0);
+	NS_Validate(!map.Exists(TEXT("one")));
+
+	map.Add(TEXT("one"), 1);
+	NS_Validate(map[TEXT("one")] == 1);
+}
+
+
+static void TestMap_Collision()
+{
+	nsTMap<nsTestCollisionKey, int> map;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		map.Add({ i }, i * 10);
+	}
+
+	NS_Validate(map.GetCount() == 100);
+
+	for (int i = 0; i < 100; i += 2)
+	{
+		map.Remove({ i }, true);
+	}
+
+	NS_Validate(map.GetCount() == 50);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		const int* value = map.GetValueByKey({ i });
+		NS_Validate((i % 2) == 0 ? value == nullptr : *value == i * 10);
+	}
+
+	// Ordered remove keeps insertion order
+	for (int i = 0; i < map.GetCount(); ++i)
+	{
+		NS_Validate(map.GetKeyByIndex(i).Value == i * 2 + 1);
+	}
+}
+
+
+static void TestMap_Random()
+{
+	const int KEY_RANGE = 4096;
+
+	nsTMap<int, int> map;
+	nsTArray<int> reference(KEY_RANGE);
+	uint32 seed = 12345;
+
+	for (int i = 0; i < 100000; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		const int key = static_cast<int>((seed >> 8) % KEY_RANGE);
+
+		if ((seed >> 28) < 10)
+		{
+			map.Add(key, i + 1);
+			reference[key] = i + 1;
+		}
+		else
+		{
+			map.Remove(key, (seed & 1) != 0);
+			reference[key] = 0;
+		}
+	}
+
+	int count = 0;
+
+	for (int key = 0; key < KEY_RANGE; ++key)
+	{
+		const int* value = map.GetValueByKey(key);
+
+		if (reference[key] == 0)
+		{
+			NS_Validate(value == nullptr);
+		}
+		else
+		{
+			NS_Validate(value && *value == reference[key]);
+			count++;
+		}
+	}
+
+	NS_Validate(map.GetCount() == count);
+
+	for (int i = 0; i < map.GetCount(); ++i)
+	{
+		NS_Validate(reference[map.GetKeyByIndex(i)] == map.GetValueByIndex(i));
+	}
+}
+
+
+void nsUnitTest::TestMap()
+{
+	TestMap_AddRemove();
+	TestMap_Collision();
+	TestMap_Random();
+}
+
+
+
+// Previous nsTMap lookup (linear scan over hashes), kept as benchmark reference
+class nsTestLinearMap
+{
+private:
+	nsTArray<uint64> Hashes;
+	nsTArray<int> Values;
+
+public:
+	NS_INLINE void Add(int key, int value) noexcept
+	{
+		Hashes.Add(ns_GetHash(key));
+		Values.Add(value);
+	}
+
+
+	NS_NODISCARD_INLINE const int* GetValueByKey(int key) const noexcept
+	{
+		const uint64 hash = ns_GetHash(key);
+
+		for (int i = 0; i < Hashes.GetCount(); ++i)
+		{
+			if (Hashes[i] == hash)
+			{
+				return &Values[i];
+			}
+		}
+
+		return nullptr;
+	}
+
+};
+
+
+void nsUnitTest::BenchmarkMap()
+{
+	const int ENTRY_COUNTS[3] = { 10, 1000, 100000 };
+	const int LOOKUP_COUNT = 100000;
+
+	const double msPerCounter = 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] nsTMap<int, int> lookup"));
+
+	for (int e = 0; e < 3; ++e)
+	{
+		const int entryCount = ENTRY_COUNTS[e];
+		const int linearLookupCount = nsMath::Min(LOOKUP_COUNT, 100000000 / entryCount);
+
+		nsTestLinearMap linearMap;
+		nsTMap<int, int> hashMap;
+
+		int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+
+		for (int i = 0; i < entryCount; ++i)
+		{
+			hashMap.Add(i * 7919 + 13, i);
+		}
+
+		const double insertMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+		for (int i = 0; i < entryCount; ++i)
+		{
+			linearMap.Add(i * 7919 + 13, i);
+		}
+
+		int64 sum = 0;
+		startCounter = nsPlatform::PerformanceQuery_Counter();
+
+		for (int i = 0; i < linearLookupCount; ++i)
+		{
+			sum += *linearMap.GetValueByKey(static_cast<int>((static_cast<int64>(i) * 7907) % entryCount) * 7919 + 13);
+		}
+
+		const double linearNs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter * 1000000.0 / linearLookupCount;
+
+		startCounter = nsPlatform::PerformanceQuery_Counter();
+
+		for (int i = 0; i < LOOKUP_COUNT; ++i)
+		{
+			sum += *hashMap.GetValueByKey(static_cast<int>((static_cast<int64>(i) * 7907) % entryCount) * 7919 + 13);
+		}
+
+		const double hashNs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter * 1000000.0 / LOOKUP_COUNT;
+
+		NS_Validate(sum > 0);
+
+		nsPlatform::ConsoleOutputFormat(0, TEXT("Entries: %i, Insert: %.3f ms, Linear: %.1f ns, Hash: %.1f ns, Speedup: %.1fx"), entryCount, insertMs, linearNs, hashNs, linearNs / hashNs);
+	}
+}
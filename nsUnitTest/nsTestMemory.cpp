@@ -0,0 +1,230 @@
+#include "nsUnitTest.h"
+#include "nsMemory.h"
+#include "nsThreadPool.h"
+
+
+
+static void TestMemory_Pool()
+{
+	nsMemoryPool pool("test_pool", NS_MEMORY_SIZE_KiB(256));
+	NS_Validate(pool.GetAllocatedSize() == 0);
+
+	// Small blocks are reused after deallocate
+	void* a = pool.Allocate(24);
+	void* b = pool.Allocate(24);
+	NS_Validate(a && b && a != b);
+	NS_Validate((reinterpret_cast<uint64>(a) & 15) == 0);
+	NS_Validate(pool.GetAllocatedSize() == 64);
+
+	pool.Deallocate(b);
+	void* c = pool.Allocate(32);
+	NS_Validate(c == b);
+
+	// Large and over-aligned allocation
+	void* large = pool.Allocate(NS_MEMORY_SIZE_KiB(64));
+	void* aligned = pool.AllocateAligned(100, 256);
+	NS_Validate((reinterpret_cast<uint64>(aligned) & 255) == 0);
+	nsPlatform::Memory_Set(large, 1, NS_MEMORY_SIZE_KiB(64));
+	NS_Validate(pool.GetAllocatedSize() == 64 + NS_MEMORY_SIZE_KiB(64) + 100);
+
+	pool.Deallocate(large);
+	pool.Deallocate(aligned);
+	pool.Deallocate(a);
+	pool.Deallocate(c);
+	NS_Validate(pool.GetAllocatedSize() == 0);
+
+	// Exhaust pages, must fallback to heap
+	nsTArray<void*> blocks;
+
+	for (int i = 0; i < 128; ++i)
+	{
+		blocks.Add(pool.Allocate(4000));
+	}
+
+	for (int i = 0; i < blocks.GetCount(); ++i)
+	{
+		pool.Deallocate(blocks[i]);
+	}
+
+	pool.Defragment();
+	NS_Validate(pool.GetAllocatedSize() == 0);
+}
+
+
+static void TestMemory_PoolMultiThread()
+{
+	const int COUNT = 20000;
+
+	nsMemoryPool pool("test_pool_mt", NS_MEMORY_SIZE_MiB(4));
+	nsTArray<int*> blocks(COUNT);
+
+	nsParallelFor(0, COUNT, 64, [&pool, &blocks](int index)
+	{
+		const int count = 1 + (index * 7) % 300;
+		int* data = static_cast<int*>(pool.Allocate(count * static_cast<int>(sizeof(int))));
+
+		for (int i = 0; i < count; ++i)
+		{
+			data[i] = index;
+		}
+
+		blocks[index] = data;
+	});
+
+	// Deallocate from different thread than allocation
+	nsParallelFor(0, COUNT, 64, [&pool, &blocks](int index)
+	{
+		const int blockIndex = COUNT - 1 - index;
+		const int count = 1 + (blockIndex * 7) % 300;
+		int* data = blocks[blockIndex];
+
+		for (int i = 0; i < count; ++i)
+		{
+			NS_Validate(data[i] == blockIndex);
+		}
+
+		pool.Deallocate(data);
+	});
+
+	NS_Validate(pool.GetAllocatedSize() == 0);
+}
+
+
+static nsMemoryLinear* TestLinearMemory = nullptr;
+
+
+class nsTestLinearArrayAllocator
+{
+public:
+	NS_NODISCARD_INLINE static void* Reallocate(void* data, int oldSize, int newSize, int alignment) noexcept
+	{
+		return TestLinearMemory->Reallocate(data, oldSize, newSize, alignment);
+	}
+
+
+	NS_INLINE static void Free(void* /*data*/, int /*size*/) noexcept
+	{
+	}
+
+};
+
+
+static void TestMemory_Linear()
+{
+	nsMemoryLinear linear("test_linear", NS_MEMORY_SIZE_KiB(1));
+
+	void* a = linear.Allocate(10);
+	void* b = linear.AllocateAligned(100, 64);
+	NS_Validate((reinterpret_cast<uint64>(a) & 15) == 0);
+	NS_Validate((reinterpret_cast<uint64>(b) & 63) == 0);
+	NS_Validate(linear.GetAllocatedSize() == 110);
+
+	// Last allocation grows in place and can be given back
+	NS_Validate(linear.Reallocate(b, 100, 200, 64) == b);
+	NS_Validate(linear.GetAllocatedSize() == 210);
+	linear.Deallocate(b);
+	NS_Validate(linear.GetAllocatedSize() == 10);
+	NS_Validate(linear.Allocate(16) == b);
+
+	// Overflow goes to heap, buffer grows on clear
+	void* overflow = linear.Allocate(NS_MEMORY_SIZE_KiB(4));
+	NS_Validate(linear.IsOwned(overflow));
+	nsPlatform::Memory_Set(overflow, 1, NS_MEMORY_SIZE_KiB(4));
+
+	linear.Clear(false);
+	NS_Validate(linear.GetAllocatedSize() == 0);
+	NS_Validate(linear.GetTotalSize() >= NS_MEMORY_SIZE_KiB(4));
+
+	// nsTArray with custom allocator, steady-state must not grow the buffer
+	TestLinearMemory = &linear;
+	int totalSize = 0;
+
+	for (int frame = 0; frame < 4; ++frame)
+	{
+		nsTArray<int, nsTestLinearArrayAllocator> values;
+		nsTArray<nsTArray<int, nsTestLinearArrayAllocator>, nsTestLinearArrayAllocator> nested;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			values.Add(i);
+			nested.Add().Add(i);
+		}
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			NS_Validate(values[i] == i && nested[i][0] == i);
+		}
+
+		nested.Clear(true);
+		values.Clear(true);
+		linear.Clear(false);
+
+		if (frame == 1)
+		{
+			totalSize = linear.GetTotalSize();
+		}
+		else if (frame > 1)
+		{
+			NS_Validate(linear.GetTotalSize() == totalSize);
+		}
+	}
+
+	TestLinearMemory = nullptr;
+}
+
+
+void nsUnitTest::TestMemory()
+{
+	TestMemory_Pool();
+	TestMemory_PoolMultiThread();
+	TestMemory_Linear();
+}
+
+
+
+static double BenchmarkMemory_Churn(nsMemory& memory)
+{
+	const int LIVE_COUNT = 2000;
+	const int OPERATION_COUNT = 50000;
+
+	nsTArray<void*> blocks(LIVE_COUNT);
+	uint32 seed = 12345;
+
+	for (int i = 0; i < LIVE_COUNT; ++i)
+	{
+		blocks[i] = memory.Allocate(16 + (i % 64) * 8);
+	}
+
+	const int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+
+	for (int i = 0; i < OPERATION_COUNT; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		const int index = static_cast<int>((seed >> 8) % LIVE_COUNT);
+
+		memory.Deallocate(blocks[index]);
+		blocks[index] = memory.Allocate(16 + ((seed >> 16) % 64) * 8);
+	}
+
+	const double ms = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	for (int i = 0; i < LIVE_COUNT; ++i)
+	{
+		memory.Deallocate(blocks[i]);
+	}
+
+	return ms;
+}
+
+
+void nsUnitTest::BenchmarkMemory()
+{
+	nsMemory firstFit("benchmark_first_fit", NS_MEMORY_SIZE_MiB(8));
+	nsMemoryPool pool("benchmark_pool", NS_MEMORY_SIZE_MiB(8));
+
+	const double firstFitMs = BenchmarkMemory_Churn(firstFit);
+	const double poolMs = BenchmarkMemory_Churn(pool);
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] Memory churn (2000 live blocks, 50000 deallocate/allocate)"));
+	nsPlatform::ConsoleOutputFormat(0, TEXT("nsMemory: %.3f ms, nsMemoryPool: %.3f ms, Speedup: %.1fx"), firstFitMs, poolMs, firstFitMs / poolMs);
+}
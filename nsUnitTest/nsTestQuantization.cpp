@@ -0,0 +1,112 @@
+#include "nsUnitTest.h"
+#include "nsQuantization.h"
+
+
+
+static float TestQuantization_Random(uint32& seed, float minValue, float maxValue)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return minValue + (maxValue - minValue) * (static_cast<float>(seed >> 8) / 16777215.0f);
+}
+
+
+static void TestQuantization_Range()
+{
+	uint32 seed = 12345;
+	const float ranges[3][2] = { { -250.0f, 250.0f }, { 0.5f, 1.5f }, { 3.0f, 3.0001f } };
+
+	for (int r = 0; r < 3; ++r)
+	{
+		// Same as track range, extent from min/max of keys
+		const float rangeMin = ranges[r][0];
+		const float rangeMax = ranges[r][1];
+		const float rangeExtent = rangeMax - rangeMin;
+		const float maxError = rangeExtent / 65535.0f * 0.5f + rangeExtent * 1e-6f + nsMath::Abs(rangeMin) * 1e-6f;
+
+		NS_Validate(nsQuantization::EncodeRange16(rangeMin, rangeMin, rangeExtent) == 0);
+		NS_Validate(nsQuantization::EncodeRange16(rangeMax, rangeMin, rangeExtent) == 65535);
+		NS_Validate(nsQuantization::DecodeRange16(0, rangeMin, rangeExtent) == rangeMin);
+
+		// Out of range values are clamped
+		NS_Validate(nsQuantization::EncodeRange16(rangeMin - rangeExtent, rangeMin, rangeExtent) == 0);
+		NS_Validate(nsQuantization::EncodeRange16(rangeMax + rangeExtent, rangeMin, rangeExtent) == 65535);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			const float value = TestQuantization_Random(seed, rangeMin, rangeMax);
+			const float decoded = nsQuantization::DecodeRange16(nsQuantization::EncodeRange16(value, rangeMin, rangeExtent), rangeMin, rangeExtent);
+			NS_Validate(nsMath::Abs(decoded - value) <= maxError);
+		}
+	}
+
+	// Zero range (constant component) decodes to range min exactly
+	NS_Validate(nsQuantization::EncodeRange16(42.0f, 42.0f, 0.0f) == 0);
+	NS_Validate(nsQuantization::EncodeRange16(-7.0f, 42.0f, 0.0f) == 0);
+	NS_Validate(nsQuantization::DecodeRange16(nsQuantization::EncodeRange16(42.0f, 42.0f, 0.0f), 42.0f, 0.0f) == 42.0f);
+}
+
+
+// Decoded quaternion must be the same rotation (q or -q) with positive largest component
+static void TestQuantization_ValidateQuaternion(const nsQuaternion& rotation, int expectedLargest)
+{
+	uint16 values[3];
+	nsQuantization::EncodeQuaternion48(rotation, values);
+
+	const int largest = (values[0] >> 15) | ((values[1] >> 15) << 1);
+	NS_Validate(largest == expectedLargest);
+	NS_Validate((values[2] & 0x8000) == 0);
+
+	const nsQuaternion normalized = rotation.GetNormalized();
+	const nsQuaternion decoded = nsQuantization::DecodeQuaternion48(values);
+	const float source[4] = { normalized.X, normalized.Y, normalized.Z, normalized.W };
+	const float result[4] = { decoded.X, decoded.Y, decoded.Z, decoded.W };
+	const float sign = source[largest] < 0.0f ? -1.0f : 1.0f;
+
+	NS_Validate(result[largest] >= 0.0f);
+	NS_Validate(nsMath::Abs(decoded.GetMagnitude() - 1.0f) <= 1e-4f);
+
+	// Smallest three within half 15-bit step, largest is reconstructed from them
+	const float halfStep = 1.41421356f / 32767.0f * 0.5f + 1e-6f;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		NS_Validate(nsMath::Abs(result[i] - source[i] * sign) <= (i == largest ? 1e-4f : halfStep));
+	}
+}
+
+
+static void TestQuantization_Quaternion()
+{
+	TestQuantization_ValidateQuaternion(nsQuaternion::IDENTITY, 3);
+
+	uint32 seed = 6789;
+
+	for (int largest = 0; largest < 4; ++largest)
+	{
+		for (int i = 0; i < 250; ++i)
+		{
+			float components[4];
+
+			for (int c = 0; c < 4; ++c)
+			{
+				components[c] = TestQuantization_Random(seed, -0.5f, 0.5f);
+			}
+
+			// Alternate sign of largest component, negative largest is flipped to -q by encoder
+			components[largest] = (i & 1) ? -1.0f : 1.0f;
+			TestQuantization_ValidateQuaternion(nsQuaternion(components[0], components[1], components[2], components[3]), largest);
+		}
+	}
+
+	// Smallest three at range limits (two components of 1/sqrt(2))
+	TestQuantization_ValidateQuaternion(nsQuaternion(0.70710678f, 0.0f, 0.0f, -0.70710677f), 0);
+	TestQuantization_ValidateQuaternion(nsQuaternion(0.0f, -0.5f, 0.0f, 0.8660254f), 3);
+	TestQuantization_ValidateQuaternion(nsQuaternion(0.0f, 0.0f, -1.0f, 0.0f), 2);
+}
+
+
+void nsUnitTest::TestQuantization()
+{
+	TestQuantization_Range();
+	TestQuantization_Quaternion();
+}
@@ -0,0 +1,226 @@
+#include "nsUnitTest.h"
+#include "nsStream.h"
+#include "nsFileSystem.h"
+
+
+
+struct nsTestStreamVertex
+{
+	float Position[3];
+	uint32 Color;
+};
+
+
+// Custom serialization skips Padding, must never be serialized as memory block
+struct nsTestStreamCustom
+{
+	int Value;
+	int Padding;
+
+
+	friend NS_INLINE void operator|(nsStream& stream, nsTestStreamCustom& custom) noexcept
+	{
+		stream | custom.Value;
+	}
+
+};
+
+
+static_assert(nsTStreamBitwise<uint8>::Value, "uint8 must be serialized as memory block!");
+static_assert(nsTStreamBitwise<nsTestStreamVertex>::Value, "Trivially copyable struct must be serialized as memory block!");
+static_assert(!nsTStreamBitwise<nsTestStreamCustom>::Value, "Type with custom serialization must be serialized per element!");
+static_assert(!nsTStreamBitwise<nsName>::Value, "nsName must be serialized per element!");
+static_assert(!nsTStreamBitwise<nsString>::Value, "nsString must be serialized per element!");
+
+
+
+static void TestStream_RoundTrip()
+{
+	nsTArray<nsTestStreamVertex> vertices(100);
+	nsTArray<nsTestStreamCustom> customs(10);
+	nsTArrayInline<uint32, 8> indices;
+	nsTArray<nsName> names;
+	nsTArray<nsString> strings;
+
+	for (int i = 0; i < vertices.GetCount(); ++i)
+	{
+		vertices[i] = { { static_cast<float>(i), 1.0f, 2.0f }, static_cast<uint32>(i * 3) };
+	}
+
+	for (int i = 0; i < customs.GetCount(); ++i)
+	{
+		customs[i] = { i, 12345 };
+	}
+
+	for (int i = 0; i < 8; ++i)
+	{
+		indices.Add(static_cast<uint32>(i * 2));
+	}
+
+	names.Add("root");
+	names.Add("spine_01");
+	strings.Add(TEXT("Hello"));
+	strings.Add(TEXT("World"));
+
+	nsBinaryStreamWriter writer;
+	writer | vertices;
+	writer | customs;
+	writer | indices;
+	writer | names;
+	writer | strings;
+
+	// Bulk arrays are count + raw block, custom elements only write Value
+	const int expectedSize = 4 + vertices.GetCount() * static_cast<int>(sizeof(nsTestStreamVertex)) + 4 + customs.GetCount() * 4 + 4 + 8 * 4;
+	NS_Validate(writer.GetBufferSize() > expectedSize);
+
+	nsTArray<uint8> data = writer.GetBuffer();
+	nsBinaryStreamReader reader(std::move(data));
+
+	nsTArray<nsTestStreamVertex> loadedVertices;
+	nsTArray<nsTestStreamCustom> loadedCustoms;
+	nsTArrayInline<uint32, 8> loadedIndices;
+	nsTArray<nsName> loadedNames;
+	nsTArray<nsString> loadedStrings;
+
+	reader | loadedVertices;
+	reader | loadedCustoms;
+	NS_Validate(reader.GetCurrentOffset() == 4 + vertices.GetCount() * static_cast<int>(sizeof(nsTestStreamVertex)) + 4 + customs.GetCount() * 4);
+
+	reader | loadedIndices;
+	reader | loadedNames;
+	reader | loadedStrings;
+	NS_Validate(reader.GetCurrentOffset() == writer.GetBufferSize());
+
+	NS_Validate(loadedVertices.GetCount() == vertices.GetCount());
+
+	for (int i = 0; i < loadedVertices.GetCount(); ++i)
+	{
+		NS_Validate(loadedVertices[i].Position[0] == static_cast<float>(i) && loadedVertices[i].Color == static_cast<uint32>(i * 3));
+	}
+
+	for (int i = 0; i < loadedCustoms.GetCount(); ++i)
+	{
+		NS_Validate(loadedCustoms[i].Value == i);
+	}
+
+	for (int i = 0; i < 8; ++i)
+	{
+		NS_Validate(loadedIndices[i] == static_cast<uint32>(i * 2));
+	}
+
+	NS_Validate(loadedNames.GetCount() == 2 && loadedNames[1] == "spine_01");
+	NS_Validate(loadedStrings.GetCount() == 2 && loadedStrings[1] == TEXT("World"));
+}
+
+
+static void TestStream_FileMap()
+{
+	const nsString file = TEXT("nsTestStream_FileMap.bin");
+
+	nsTArray<uint32> values(10000);
+
+	for (int i = 0; i < values.GetCount(); ++i)
+	{
+		values[i] = static_cast<uint32>(i * 7);
+	}
+
+	nsBinaryStreamWriter writer;
+	writer | values;
+	NS_Validate(nsFileSystem::FileWriteBinary(file, writer.GetBuffer()));
+
+	nsFileAttributes attributes{};
+	NS_Validate(nsFileSystem::FileGetAttributes(file, attributes));
+	NS_Validate(attributes.Size == writer.GetBufferSize() && attributes.ModifiedTime > 0);
+
+	{
+		nsFileMappedView view;
+		NS_Validate(nsFileSystem::FileMap(file, view));
+		NS_Validate(view.IsValid() && view.Size == writer.GetBufferSize());
+
+		// Reader views mapped memory, no copy of file data
+		nsBinaryStreamReader reader(view.Data, view.Size);
+		NS_Validate(reader.GetBufferData() == view.Data);
+
+		nsTArray<uint32> loadedValues;
+		reader | loadedValues;
+		NS_Validate(reader.GetCurrentOffset() == view.Size);
+		NS_Validate(loadedValues.GetCount() == values.GetCount());
+
+		for (int i = 0; i < loadedValues.GetCount(); ++i)
+		{
+			NS_Validate(loadedValues[i] == values[i]);
+		}
+
+		nsFileSystem::FileUnmap(view);
+		NS_Validate(!view.IsValid());
+	}
+
+	nsFileMappedView missingView;
+	NS_Validate(!nsFileSystem::FileMap(TEXT("nsTestStream_Missing.bin"), missingView));
+	NS_Validate(!nsFileSystem::FileGetAttributes(TEXT("nsTestStream_Missing.bin"), attributes));
+
+	nsFileSystem::FileDelete(file);
+}
+
+
+void nsUnitTest::TestStream()
+{
+	TestStream_RoundTrip();
+	TestStream_FileMap();
+}
+
+
+
+// Same layout as uint8, custom operator forces previous per-element serialization
+struct nsTestStreamByte
+{
+	uint8 Value;
+
+
+	friend NS_INLINE void operator|(nsStream& stream, nsTestStreamByte& byte) noexcept
+	{
+		stream | byte.Value;
+	}
+
+};
+
+
+void nsUnitTest::BenchmarkStream()
+{
+	// Typical texture mip 1024x1024 RGBA8
+	const int PIXEL_BYTES = NS_MEMORY_SIZE_MiB(4);
+	const double msPerCounter = 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	nsTArray<uint8> pixels(PIXEL_BYTES);
+
+	for (int i = 0; i < PIXEL_BYTES; ++i)
+	{
+		pixels[i] = static_cast<uint8>(i * 31);
+	}
+
+	nsBinaryStreamWriter writer;
+	writer | pixels;
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] nsStream load nsTArray<uint8> (%i bytes)"), PIXEL_BYTES);
+
+	nsBinaryStreamReader elementReader(writer.GetBuffer());
+	nsTArray<nsTestStreamByte> elementPixels;
+	int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+	elementReader | elementPixels;
+	const double elementMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+	nsBinaryStreamReader bulkReader(writer.GetBuffer());
+	nsTArray<uint8> bulkPixels;
+	startCounter = nsPlatform::PerformanceQuery_Counter();
+	bulkReader | bulkPixels;
+	const double bulkMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+	NS_Validate(elementPixels.GetCount() == PIXEL_BYTES && bulkPixels.GetCount() == PIXEL_BYTES);
+
+	for (int i = 0; i < PIXEL_BYTES; ++i)
+	{
+		NS_Validate(bulkPixels[i] == pixels[i] && elementPixels[i].Value == pixels[i]);
+	}
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("Per element: %.3f ms, Bulk: %.3f ms, Speedup: %.1fx"), elementMs, bulkMs, elementMs / bulkMs);
+}
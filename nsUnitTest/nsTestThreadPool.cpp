@@ -0,0 +1,242 @@
+#include "nsUnitTest.h"
+#include "nsThreadPool.h"
+#include "nsMath.h"
+
+
+
+class nsTestCounterTask : public nsIThreadTask
+{
+private:
+	nsAtomic bDone;
+
+public:
+	nsAtomic* ExecuteCounter;
+	int Order;
+
+
+public:
+	nsTestCounterTask() noexcept
+		: ExecuteCounter(nullptr)
+		, Order(-1)
+	{
+	}
+
+
+	virtual void Reset() noexcept override
+	{
+		bDone.Set(0);
+		Order = -1;
+	}
+
+
+	virtual void Execute() noexcept override
+	{
+		Order = ExecuteCounter->Increment();
+		bDone.Set(1);
+	}
+
+
+	virtual bool IsIdle() const noexcept override
+	{
+		return IsDone();
+	}
+
+
+	virtual bool IsRunning() const noexcept override
+	{
+		return !IsDone();
+	}
+
+
+	virtual bool IsDone() const noexcept override
+	{
+		return bDone.Get() == 1;
+	}
+
+};
+
+
+
+static void TestThreadPool_Counter()
+{
+	const int TASK_COUNT = 1000;
+
+	nsAtomic executeCounter;
+	nsTArray<nsTestCounterTask> tasks;
+	tasks.Reserve(TASK_COUNT);
+
+	nsTArray<nsIThreadTask*> submitTasks;
+	submitTasks.Reserve(TASK_COUNT);
+
+	for (int i = 0; i < TASK_COUNT; ++i)
+	{
+		nsTestCounterTask& task = tasks.Add();
+		task.ExecuteCounter = &executeCounter;
+		task.Reset();
+		submitTasks.Add(&task);
+	}
+
+	nsThreadTaskCounter counter;
+	nsThreadPool::SubmitTasks(submitTasks.GetData(), TASK_COUNT, nsEThreadAffinity::Thread_ALL, &counter);
+	nsThreadPool::WaitForCounter(counter);
+
+	NS_Validate(counter.IsDone());
+	NS_Validate(executeCounter.Get() == TASK_COUNT);
+
+	for (int i = 0; i < TASK_COUNT; ++i)
+	{
+		NS_Validate(tasks[i].IsDone());
+	}
+}
+
+
+static void TestThreadPool_Graph()
+{
+	nsAtomic executeCounter;
+	nsTestCounterTask tasks[6];
+
+	for (int i = 0; i < 6; ++i)
+	{
+		tasks[i].ExecuteCounter = &executeCounter;
+	}
+
+	// 0 -> (1, 2, 3) -> 4 -> 5
+	nsThreadTaskGraph graph;
+	const int root = graph.AddTask(&tasks[0]);
+	const int forkA = graph.AddTask(&tasks[1]);
+	const int forkB = graph.AddTask(&tasks[2]);
+	const int forkC = graph.AddTask(&tasks[3]);
+	const int join = graph.AddTask(&tasks[4]);
+	const int last = graph.AddTask(&tasks[5]);
+
+	graph.AddContinuation(root, forkA);
+	graph.AddContinuation(root, forkB);
+	graph.AddContinuation(root, forkC);
+	graph.AddDependency(join, forkA);
+	graph.AddDependency(join, forkB);
+	graph.AddDependency(join, forkC);
+	graph.AddContinuation(join, last);
+
+	// Graph can be submitted multiple times
+	for (int run = 0; run < 3; ++run)
+	{
+		for (int i = 0; i < 6; ++i)
+		{
+			tasks[i].Reset();
+		}
+
+		executeCounter.Set(0);
+		graph.Submit();
+		graph.Wait();
+
+		NS_Validate(graph.IsDone());
+		NS_Validate(executeCounter.Get() == 6);
+		NS_Validate(tasks[root].Order == 1);
+		NS_Validate(tasks[forkA].Order > tasks[root].Order && tasks[forkA].Order < tasks[join].Order);
+		NS_Validate(tasks[forkB].Order > tasks[root].Order && tasks[forkB].Order < tasks[join].Order);
+		NS_Validate(tasks[forkC].Order > tasks[root].Order && tasks[forkC].Order < tasks[join].Order);
+		NS_Validate(tasks[join].Order == 5);
+		NS_Validate(tasks[last].Order == 6);
+	}
+}
+
+
+static void TestThreadPool_ParallelFor()
+{
+	const int COUNT = 100000;
+
+	nsTArray<int> values(COUNT);
+
+	// Every index must be visited exactly once, including nested loops executed from worker threads
+	nsParallelFor(0, COUNT, 64, [&values](int index)
+	{
+		values[index] += index;
+	});
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		NS_Validate(values[i] == i);
+	}
+
+	nsAtomic nestedCounter;
+	nsParallelFor(0, 16, 1, [&nestedCounter](int)
+	{
+		nsParallelFor(0, 1000, 10, [&nestedCounter](int)
+		{
+			nestedCounter.Increment();
+		});
+	});
+
+	NS_Validate(nestedCounter.Get() == 16 * 1000);
+
+	// Range offset and serial fallback
+	nsAtomic sum;
+	nsParallelFor(10, 20, 100, [&sum](int index)
+	{
+		sum.Add(index);
+	});
+
+	NS_Validate(sum.Get() == 145);
+
+	int callCount = 0;
+	nsParallelFor(5, 5, 0, [&callCount](int) { callCount++; });
+	NS_Validate(callCount == 0);
+}
+
+
+void nsUnitTest::TestThreadPool()
+{
+	TestThreadPool_Counter();
+	TestThreadPool_Graph();
+	TestThreadPool_ParallelFor();
+}
+
+
+void nsUnitTest::BenchmarkThreadPool()
+{
+	const int COUNT = 1 << 20;
+	const int RUN_COUNT = 5;
+
+	nsTArray<float> values(COUNT);
+	const int64 frequency = nsPlatform::PerformanceQuery_Frequency();
+	const int threadCount = nsThreadPool::GetThreadCount();
+	double singleThreadMs = 0.0;
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] nsParallelFor (%i elements)"), COUNT);
+
+	for (int t = 1; t <= threadCount; ++t)
+	{
+		double bestMs = 0.0;
+
+		for (int run = 0; run < RUN_COUNT; ++run)
+		{
+			const int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+
+			nsParallelFor(0, COUNT, 0, [&values](int index)
+			{
+				float x = static_cast<float>(index);
+
+				for (int i = 0; i < 32; ++i)
+				{
+					x = nsMath::Sqrt(x * 1.0001f + 1.0f);
+				}
+
+				values[index] = x;
+			}, t);
+
+			const double ms = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * 1000.0 / static_cast<double>(frequency);
+
+			if (run == 0 || ms < bestMs)
+			{
+				bestMs = ms;
+			}
+		}
+
+		if (t == 1)
+		{
+			singleThreadMs = bestMs;
+		}
+
+		nsPlatform::ConsoleOutputFormat(0, TEXT("Threads: %i, Time: %.3f ms, Speedup: %.2fx"), t, bestMs, singleThreadMs / bestMs);
+	}
+}
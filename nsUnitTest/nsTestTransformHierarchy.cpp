@@ -0,0 +1,407 @@
+#include "nsUnitTest.h"
+#include "nsTransformHierarchy.h"
+
+
+
+// Bone layout of animation instance before SoA hierarchy, kept as benchmark reference
+struct nsTestTransformHierarchyBone
+{
+	nsMatrix4 InverseBindPoseTransform;
+	nsMatrix4 PoseTransform;
+	nsTransform LocalTransform;
+	int ParentId;
+	bool bUpdated;
+};
+
+
+static float TestTransformHierarchy_Random(uint32& seed, float minValue, float maxValue)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return minValue + (maxValue - minValue) * (static_cast<float>(seed >> 8) / 16777215.0f);
+}
+
+
+static nsTransform TestTransformHierarchy_RandomTransform(uint32& seed)
+{
+	nsTransform transform;
+	transform.Position = nsVector3(TestTransformHierarchy_Random(seed, -20.0f, 20.0f), TestTransformHierarchy_Random(seed, -20.0f, 20.0f), TestTransformHierarchy_Random(seed, -20.0f, 20.0f));
+
+	// Sampled rotations are not always normalized
+	transform.Rotation = nsQuaternion(TestTransformHierarchy_Random(seed, -1.0f, 1.0f), TestTransformHierarchy_Random(seed, -1.0f, 1.0f), TestTransformHierarchy_Random(seed, -1.0f, 1.0f), TestTransformHierarchy_Random(seed, 0.1f, 1.0f));
+	transform.Scale = nsVector3(TestTransformHierarchy_Random(seed, 0.8f, 1.2f), TestTransformHierarchy_Random(seed, 0.8f, 1.2f), TestTransformHierarchy_Random(seed, 0.8f, 1.2f));
+
+	return transform;
+}
+
+
+// Skeleton like hierarchy in parent-first order
+static void TestTransformHierarchy_CreateBones(nsTArray<nsTestTransformHierarchyBone>& bones, int count, uint32& seed)
+{
+	bones.Resize(count);
+
+	for (int i = 0; i < count; ++i)
+	{
+		nsTestTransformHierarchyBone& bone = bones[i];
+		bone.LocalTransform = TestTransformHierarchy_RandomTransform(seed);
+		bone.InverseBindPoseTransform = TestTransformHierarchy_RandomTransform(seed).ToMatrix();
+		bone.PoseTransform = nsMatrix4::IDENTITY;
+		bone.ParentId = i == 0 ? -1 : static_cast<int>(TestTransformHierarchy_Random(seed, nsMath::Max(0.0f, i - 4.0f), static_cast<float>(i) - 0.01f));
+		bone.bUpdated = false;
+	}
+}
+
+
+static void TestTransformHierarchy_ComputeScalar(nsTArray<nsTestTransformHierarchyBone>& bones, nsMatrix4* outSkinMatrices)
+{
+	for (int j = 0; j < bones.GetCount(); ++j)
+	{
+		nsTestTransformHierarchyBone& bone = bones[j];
+		const nsTestTransformHierarchyBone* parentBone = bone.ParentId == -1 ? nullptr : &bones[bone.ParentId];
+
+		if (parentBone)
+		{
+			NS_Validate(parentBone->bUpdated);
+		}
+
+		bone.PoseTransform = parentBone ? bone.LocalTransform.ToMatrix() * parentBone->PoseTransform : bone.LocalTransform.ToMatrix();
+		outSkinMatrices[j] = bone.InverseBindPoseTransform * bone.PoseTransform;
+		bone.bUpdated = true;
+	}
+}
+
+
+static bool TestTransformHierarchy_MatrixEquals(const nsMatrix4& a, const nsMatrix4& b)
+{
+	for (int r = 0; r < 4; ++r)
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			if (!nsMath::FloatEquals(a[r][c], b[r][c], 1e-3f * nsMath::Max(1.0f, nsMath::Abs(b[r][c]))))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+static void TestTransformHierarchy_SortParentFirst()
+{
+	const int SORTED[6] = { -1, 0, 1, 0, 3, 3 };
+	int order[6];
+	NS_Validate(nsTransformHierarchy::SortParentFirst(SORTED, 6, order));
+
+	for (int i = 0; i < 6; ++i)
+	{
+		NS_Validate(order[i] == i);
+	}
+
+	// Children stored before parents
+	const int UNSORTED[6] = { 2, 5, -1, 1, 2, 2 };
+	NS_Validate(nsTransformHierarchy::SortParentFirst(UNSORTED, 6, order));
+
+	int positions[6];
+
+	for (int i = 0; i < 6; ++i)
+	{
+		positions[order[i]] = i;
+	}
+
+	for (int i = 0; i < 6; ++i)
+	{
+		NS_Validate(UNSORTED[i] == -1 || positions[UNSORTED[i]] < positions[i]);
+	}
+
+	const int CYCLE[4] = { -1, 2, 3, 1 };
+	NS_Validate(!nsTransformHierarchy::SortParentFirst(CYCLE, 4, order));
+
+	const int INVALID[3] = { -1, 0, 7 };
+	NS_Validate(!nsTransformHierarchy::SortParentFirst(INVALID, 3, order));
+}
+
+
+static void TestTransformHierarchy_ComputeMatrices()
+{
+	uint32 seed = 4321;
+
+	// Counts around SoA width
+	const int COUNTS[6] = { 1, 3, 4, 9, 37, 64 };
+
+	for (int c = 0; c < 6; ++c)
+	{
+		const int count = COUNTS[c];
+
+		nsTArray<nsTestTransformHierarchyBone> bones;
+		TestTransformHierarchy_CreateBones(bones, count, seed);
+
+		nsTArray<nsMatrix4> expected(count);
+		TestTransformHierarchy_ComputeScalar(bones, expected.GetData());
+
+		nsTransformSoA localTransforms;
+		localTransforms.Resize(count);
+		NS_Validate(localTransforms.GetCount() == count && localTransforms.GetPaddedCount() % NS_TRANSFORM_SOA_WIDTH == 0);
+
+		nsTArray<int> parentIds(count);
+		nsTArray<nsMatrix4> inverseBindPoses(count);
+		nsTArray<int> skinIds(count);
+
+		for (int i = 0; i < count; ++i)
+		{
+			localTransforms.Set(i, bones[i].LocalTransform);
+			parentIds[i] = bones[i].ParentId;
+			inverseBindPoses[i] = bones[i].InverseBindPoseTransform;
+
+			// Skinning palette in reversed order
+			skinIds[i] = count - 1 - i;
+		}
+
+		NS_Validate(localTransforms.Get(count - 1).Position.Z == bones[count - 1].LocalTransform.Position.Z);
+
+		nsTArray<nsMatrix4> modelMatrices(count);
+		nsTArray<nsMatrix4> skinMatrices(count);
+		nsTransformHierarchy::ComputeMatrices(localTransforms, parentIds.GetData(), inverseBindPoses.GetData(), skinIds.GetData(), modelMatrices.GetData(), skinMatrices.GetData());
+
+		for (int i = 0; i < count; ++i)
+		{
+			NS_Validate(TestTransformHierarchy_MatrixEquals(modelMatrices[i], bones[i].PoseTransform));
+			NS_Validate(TestTransformHierarchy_MatrixEquals(skinMatrices[skinIds[i]], expected[i]));
+		}
+	}
+}
+
+
+static bool TestTransformHierarchy_TransformEquals(const nsTransform& a, const nsTransform& b)
+{
+	const float EPS = 1e-4f;
+	const float sign = (a.Rotation.X * b.Rotation.X + a.Rotation.Y * b.Rotation.Y + a.Rotation.Z * b.Rotation.Z + a.Rotation.W * b.Rotation.W) < 0.0f ? -1.0f : 1.0f;
+
+	return nsMath::FloatEquals(a.Position.X, b.Position.X, EPS) && nsMath::FloatEquals(a.Position.Y, b.Position.Y, EPS) && nsMath::FloatEquals(a.Position.Z, b.Position.Z, EPS)
+		&& nsMath::FloatEquals(a.Rotation.X, b.Rotation.X * sign, EPS) && nsMath::FloatEquals(a.Rotation.Y, b.Rotation.Y * sign, EPS)
+		&& nsMath::FloatEquals(a.Rotation.Z, b.Rotation.Z * sign, EPS) && nsMath::FloatEquals(a.Rotation.W, b.Rotation.W * sign, EPS)
+		&& nsMath::FloatEquals(a.Scale.X, b.Scale.X, EPS) && nsMath::FloatEquals(a.Scale.Y, b.Scale.Y, EPS) && nsMath::FloatEquals(a.Scale.Z, b.Scale.Z, EPS);
+}
+
+
+static nsTransform TestTransformHierarchy_Lerp(const nsTransform& a, const nsTransform& b, float alpha)
+{
+	const float dot = a.Rotation.X * b.Rotation.X + a.Rotation.Y * b.Rotation.Y + a.Rotation.Z * b.Rotation.Z + a.Rotation.W * b.Rotation.W;
+	const nsQuaternion rotationB = dot < 0.0f ? nsQuaternion(-b.Rotation.X, -b.Rotation.Y, -b.Rotation.Z, -b.Rotation.W) : b.Rotation;
+
+	return nsTransform(nsVector3::Lerp(a.Position, b.Position, alpha), nsQuaternion::Lerp(a.Rotation, rotationB, alpha), nsVector3::Lerp(a.Scale, b.Scale, alpha));
+}
+
+
+static void TestTransformHierarchy_BlendPoses()
+{
+	const int COUNT = 9;
+	uint32 seed = 2468;
+
+	nsTransformSoA poses[3];
+	nsTransform transforms[3][COUNT];
+
+	for (int p = 0; p < 3; ++p)
+	{
+		poses[p].Resize(COUNT);
+
+		for (int i = 0; i < COUNT; ++i)
+		{
+			transforms[p][i] = TestTransformHierarchy_RandomTransform(seed);
+			transforms[p][i].Rotation.Normalize();
+			poses[p].Set(i, transforms[p][i]);
+		}
+	}
+
+	// Cross-fade, result written over one of inputs
+	nsTransformSoA result = poses[1];
+	const nsTransformSoA* crossFadePoses[2] = { &poses[0], &result };
+	const float crossFadeWeights[2] = { 0.7f, 0.3f };
+	nsTransformHierarchy::BlendPoses(crossFadePoses, crossFadeWeights, 2, nullptr, result);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		NS_Validate(TestTransformHierarchy_TransformEquals(result.Get(i), TestTransformHierarchy_Lerp(transforms[0][i], transforms[1][i], 0.3f)));
+	}
+
+	// Masked override of single pose
+	nsTArray<float> boneWeights;
+	boneWeights.ResizeConstructs(result.GetPaddedCount(), 0.0f);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		boneWeights[i] = static_cast<float>(i % 3) * 0.5f;
+	}
+
+	result = poses[2];
+	const nsTransformSoA* overridePose = &poses[0];
+	const float overrideWeight = 1.0f;
+	nsTransformHierarchy::BlendPoses(&overridePose, &overrideWeight, 1, boneWeights.GetData(), result);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		NS_Validate(TestTransformHierarchy_TransformEquals(result.Get(i), TestTransformHierarchy_Lerp(transforms[2][i], transforms[0][i], boneWeights[i])));
+	}
+
+	// Three way blend of same pose is the pose
+	const nsTransformSoA* samePoses[3] = { &poses[1], &poses[1], &poses[1] };
+	const float sameWeights[3] = { 0.2f, 0.5f, 0.3f };
+	nsTransformHierarchy::BlendPoses(samePoses, sameWeights, 3, nullptr, result);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		NS_Validate(TestTransformHierarchy_TransformEquals(result.Get(i), transforms[1][i]));
+	}
+}
+
+
+static void TestTransformHierarchy_AddPoses()
+{
+	const int COUNT = 6;
+	uint32 seed = 1357;
+
+	nsTransformSoA base;
+	nsTransformSoA additive;
+	nsTransformSoA identity;
+	base.Resize(COUNT);
+	additive.Resize(COUNT);
+	identity.Resize(COUNT);
+
+	nsTransform baseTransforms[COUNT];
+	nsTransform additiveTransforms[COUNT];
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		baseTransforms[i] = TestTransformHierarchy_RandomTransform(seed);
+		baseTransforms[i].Rotation.Normalize();
+		base.Set(i, baseTransforms[i]);
+
+		additiveTransforms[i] = TestTransformHierarchy_RandomTransform(seed);
+		additiveTransforms[i].Rotation.Normalize();
+		additive.Set(i, additiveTransforms[i]);
+	}
+
+	// Delta of pose relative to itself does not change base
+	nsTransformSoA result = base;
+	const nsTransformSoA* poses[1] = { &additive };
+	const float weights[1] = { 1.0f };
+	nsTransformHierarchy::AddPoses(poses, poses, weights, 1, nullptr, result);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		NS_Validate(TestTransformHierarchy_TransformEquals(result.Get(i), baseTransforms[i]));
+	}
+
+	// Delta relative to identity is the additive transform
+	result = base;
+	const nsTransformSoA* references[1] = { &identity };
+	nsTransformHierarchy::AddPoses(poses, references, weights, 1, nullptr, result);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		const nsTransform expected(baseTransforms[i].Position + additiveTransforms[i].Position, baseTransforms[i].Rotation * additiveTransforms[i].Rotation, baseTransforms[i].Scale * additiveTransforms[i].Scale);
+		NS_Validate(TestTransformHierarchy_TransformEquals(result.Get(i), expected));
+	}
+
+	// Zero bone weight keeps base
+	nsTArray<float> boneWeights;
+	boneWeights.ResizeConstructs(result.GetPaddedCount(), 0.0f);
+	result = base;
+	nsTransformHierarchy::AddPoses(poses, references, weights, 1, boneWeights.GetData(), result);
+
+	for (int i = 0; i < COUNT; ++i)
+	{
+		NS_Validate(TestTransformHierarchy_TransformEquals(result.Get(i), baseTransforms[i]));
+	}
+}
+
+
+void nsUnitTest::TestTransformHierarchy()
+{
+	TestTransformHierarchy_SortParentFirst();
+	TestTransformHierarchy_ComputeMatrices();
+	TestTransformHierarchy_BlendPoses();
+	TestTransformHierarchy_AddPoses();
+}
+
+
+
+void nsUnitTest::BenchmarkTransformHierarchy()
+{
+	const int INSTANCE_COUNT = 512;
+	const int BONE_COUNT = 64;
+	const int ITERATION_COUNT = 20;
+	const double msPerCounter = 1000.0 / static_cast<double>(nsPlatform::PerformanceQuery_Frequency());
+
+	uint32 seed = 8765;
+	nsTArray<nsTestTransformHierarchyBone> skeleton;
+	TestTransformHierarchy_CreateBones(skeleton, BONE_COUNT, seed);
+
+	nsTArray<nsTArray<nsTestTransformHierarchyBone>> scalarInstances(INSTANCE_COUNT);
+	nsTArray<nsTransformSoA> soaInstances(INSTANCE_COUNT);
+	nsTArray<int> parentIds(BONE_COUNT);
+	nsTArray<nsMatrix4> inverseBindPoses(BONE_COUNT);
+	nsTArray<int> skinIds(BONE_COUNT);
+
+	for (int j = 0; j < BONE_COUNT; ++j)
+	{
+		parentIds[j] = skeleton[j].ParentId;
+		inverseBindPoses[j] = skeleton[j].InverseBindPoseTransform;
+		skinIds[j] = j;
+	}
+
+	for (int i = 0; i < INSTANCE_COUNT; ++i)
+	{
+		scalarInstances[i] = skeleton;
+		soaInstances[i].Resize(BONE_COUNT);
+
+		for (int j = 0; j < BONE_COUNT; ++j)
+		{
+			scalarInstances[i][j].LocalTransform = TestTransformHierarchy_RandomTransform(seed);
+			soaInstances[i].Set(j, scalarInstances[i][j].LocalTransform);
+		}
+	}
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("\n[Benchmark] nsTransformHierarchy (%i instances, %i bones, %i iterations, SoA width: %i)"), INSTANCE_COUNT, BONE_COUNT, ITERATION_COUNT, NS_TRANSFORM_SOA_WIDTH);
+
+	nsTArray<nsMatrix4> scalarSkinMatrices(INSTANCE_COUNT * BONE_COUNT);
+	int64 startCounter = nsPlatform::PerformanceQuery_Counter();
+
+	for (int it = 0; it < ITERATION_COUNT; ++it)
+	{
+		for (int i = 0; i < INSTANCE_COUNT; ++i)
+		{
+			nsTArray<nsTestTransformHierarchyBone>& bones = scalarInstances[i];
+
+			for (int j = 0; j < BONE_COUNT; ++j)
+			{
+				bones[j].bUpdated = false;
+			}
+
+			TestTransformHierarchy_ComputeScalar(bones, scalarSkinMatrices.GetData() + i * BONE_COUNT);
+		}
+	}
+
+	const double scalarMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+	nsTArray<nsMatrix4> modelMatrices(BONE_COUNT);
+	nsTArray<nsMatrix4> soaSkinMatrices(INSTANCE_COUNT * BONE_COUNT);
+	startCounter = nsPlatform::PerformanceQuery_Counter();
+
+	for (int it = 0; it < ITERATION_COUNT; ++it)
+	{
+		for (int i = 0; i < INSTANCE_COUNT; ++i)
+		{
+			nsTransformHierarchy::ComputeMatrices(soaInstances[i], parentIds.GetData(), inverseBindPoses.GetData(), skinIds.GetData(), modelMatrices.GetData(), soaSkinMatrices.GetData() + i * BONE_COUNT);
+		}
+	}
+
+	const double soaMs = static_cast<double>(nsPlatform::PerformanceQuery_Counter() - startCounter) * msPerCounter;
+
+	for (int i = 0; i < INSTANCE_COUNT * BONE_COUNT; ++i)
+	{
+		NS_Validate(TestTransformHierarchy_MatrixEquals(soaSkinMatrices[i], scalarSkinMatrices[i]));
+	}
+
+	nsPlatform::ConsoleOutputFormat(0, TEXT("Scalar: %.3f ms, SoA: %.3f ms, Speedup: %.1fx"), scalarMs, soaMs, scalarMs / soaMs);
+}
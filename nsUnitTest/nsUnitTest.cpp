@@ -1,13 +1,28 @@
 #include "nsUnitTest.h"
 #include "nsFileSystem.h"
+#include "nsLogger.h"
+#include "nsThreadPool.h"
 
 
 
 int main(int argc, char* argv[])
 {
+	nsPlatform::Initialize();
+	nsLogger::Get().Initialize(nsELogVerbosity::LV_WARNING, TEXT(""));
+	nsThreadPool::Initialize();
+
 	nsUnitTest::TestArray();
 	nsUnitTest::TestString();
 	nsUnitTest::TestMath();
+	nsUnitTest::TestThreadPool();
+	nsUnitTest::TestMap();
+	nsUnitTest::TestMemory();
+	nsUnitTest::TestAlgorithm();
+	nsUnitTest::TestStream();
+	nsUnitTest::TestCompression();
+	nsUnitTest::TestTransformHierarchy();
+	nsUnitTest::TestQuantization();
+	nsUnitTest::TestAsyncLoad();
 
 	const nsString file = TEXT("C:/Users/Buddy/AppData/Local/Temp.txt");
 	
@@ -20,5 +35,16 @@ int main(int argc, char* argv[])
 	const nsString ext = nsFileSystem::FileGetExtension(file);
 	NS_Validate(ext == TEXT(".txt"));
 
+	nsUnitTest::BenchmarkThreadPool();
+	nsUnitTest::BenchmarkMap();
+	nsUnitTest::BenchmarkMemory();
+	nsUnitTest::BenchmarkAlgorithm();
+	nsUnitTest::BenchmarkStream();
+	nsUnitTest::BenchmarkCompression();
+	nsUnitTest::BenchmarkTransformHierarchy();
+
+	nsThreadPool::Shutdown();
+	nsPlatform::Shutdown();
+
 	return 0;
 }
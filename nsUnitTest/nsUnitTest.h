@@ -28,5 +28,22 @@ namespace nsUnitTest
 	extern void TestArray();
 	extern void TestString();
 	extern void TestMath();
+	extern void TestThreadPool();
+	extern void TestMap();
+	extern void TestMemory();
+	extern void TestAlgorithm();
+	extern void TestStream();
+	extern void TestCompression();
+	extern void TestTransformHierarchy();
+	extern void TestQuantization();
+	extern void TestAsyncLoad();
+
+	extern void BenchmarkThreadPool();
+	extern void BenchmarkMap();
+	extern void BenchmarkMemory();
+	extern void BenchmarkAlgorithm();
+	extern void BenchmarkStream();
+	extern void BenchmarkCompression();
+	extern void BenchmarkTransformHierarchy();
 
 };